@@ -1,15 +1,36 @@
 #include "audio_common.h"
 
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define AUDIO_MIX_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define AUDIO_MIX_KERNELS_X86 0
+#endif
+
+// NOTE: MSVC allows using any intrinsics without changing the target architecture of the entire file, GCC / Clang need it per function
+#if defined(__GNUC__) || defined(__clang__)
+#define AUDIO_TARGET_SSE2 __attribute__((target("sse2")))
+#define AUDIO_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define AUDIO_TARGET_SSE2
+#define AUDIO_TARGET_AVX2
+#endif
+
 namespace Audio
 {
-	i64 PCMSampleBuffer::ReadAtOrFillSilence(i64 inFrameOffset, i64 inFrameCount, i16 outSamples[]) const
+	i64 PCMSampleBuffer::ReadAtOrFillSilence(i64 inFrameOffset, i64 inFrameCount, i16 outSamples[], i64 inReadableFrameCount) const
 	{
 		// TODO: Handle channel count mismatch (?) 
 		// assert(ChannelCount == 2);
 
 		const i64 sourceChannelCount = ChannelCount;
-		const i64 sourceFrameCount = FrameCount;
-		const i64 sourceSampleCount = SampleCount();
+		const i64 sourceFrameCount = Min(FrameCount, inReadableFrameCount);
+		const i64 sourceSampleCount = (sourceFrameCount * sourceChannelCount);
 
 		std::fill(outSamples, outSamples + (inFrameCount * sourceChannelCount), 0);
 
@@ -40,3 +61,336 @@ namespace Audio
 		return inFrameCount;
 	}
 }
+
+
+namespace Audio
+{
+	static void MixStereoI16WithFrameGains_Scalar(f32* out, const i16* in, const f32* frameGains, size_t frameCount, f32 panGainL, f32 panGainR)
+	{
+		for (size_t f = 0, i = 0; f < frameCount; f++, i += 2)
+		{
+			out[i + 0] += in[i + 0] * (frameGains[f] * panGainL);
+			out[i + 1] += in[i + 1] * (frameGains[f] * panGainR);
+		}
+	}
+
+	static void MixStereoI16WithConstantGain_Scalar(f32* out, const i16* in, size_t frameCount, f32 gainL, f32 gainR)
+	{
+		for (size_t f = 0, i = 0; f < frameCount; f++, i += 2)
+		{
+			out[i + 0] += in[i + 0] * gainL;
+			out[i + 1] += in[i + 1] * gainR;
+		}
+	}
+
+	static void MixStereoF32IntoI16Clamped_Scalar(i16* out, const f32* in, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain)
+	{
+		for (size_t f = 0, i = 0; f < frameCount; f++, i += 2)
+		{
+			out[i + 0] += ClampSampleI<i16>(((in[i + 0] * preGain) * frameGains[f]) * postGain);
+			out[i + 1] += ClampSampleI<i16>(((in[i + 1] * preGain) * frameGains[f]) * postGain);
+		}
+	}
+
+	static void MixStereoF32IntoF32_Scalar(f32* out, const f32* in, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain)
+	{
+		for (size_t f = 0, i = 0; f < frameCount; f++, i += 2)
+		{
+			out[i + 0] += ((in[i + 0] * preGain) * frameGains[f]) * postGain;
+			out[i + 1] += ((in[i + 1] * preGain) * frameGains[f]) * postGain;
+		}
+	}
+
+	static void DuplicateMonoToStereoI16_Scalar(i16* out, const i16* in, size_t frameCount)
+	{
+		for (size_t f = 0; f < frameCount; f++)
+		{
+			out[(f * 2) + 0] = in[f];
+			out[(f * 2) + 1] = in[f];
+		}
+	}
+
+	static void CombineQuadToStereoI16_Scalar(i16* out, const i16* in, size_t frameCount)
+	{
+		for (size_t f = 0; f < frameCount; f++)
+		{
+			out[(f * 2) + 0] = MixSamplesI_Clamped<i16, i32>(in[(f * 4) + 0], in[(f * 4) + 2]);
+			out[(f * 2) + 1] = MixSamplesI_Clamped<i16, i32>(in[(f * 4) + 1], in[(f * 4) + 3]);
+		}
+	}
+
+#if AUDIO_MIX_KERNELS_X86
+	// NOTE: Processing 4 stereo frames (8 samples) per iteration, with the remainder handled by the scalar versions
+	AUDIO_TARGET_SSE2 static void MixStereoI16WithFrameGains_SSE2(f32* out, const i16* in, const f32* frameGains, size_t frameCount, f32 panGainL, f32 panGainR)
+	{
+		const __m128 panGain = _mm_setr_ps(panGainL, panGainR, panGainL, panGainR);
+		size_t f = 0;
+		for (; (f + 4) <= frameCount; f += 4)
+		{
+			const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[f * 2]));
+			const __m128 samplesLo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16));
+			const __m128 samplesHi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16));
+
+			const __m128 gains = _mm_loadu_ps(&frameGains[f]);
+			const __m128 gainsLo = _mm_mul_ps(_mm_unpacklo_ps(gains, gains), panGain);
+			const __m128 gainsHi = _mm_mul_ps(_mm_unpackhi_ps(gains, gains), panGain);
+
+			_mm_storeu_ps(&out[(f * 2) + 0], _mm_add_ps(_mm_loadu_ps(&out[(f * 2) + 0]), _mm_mul_ps(samplesLo, gainsLo)));
+			_mm_storeu_ps(&out[(f * 2) + 4], _mm_add_ps(_mm_loadu_ps(&out[(f * 2) + 4]), _mm_mul_ps(samplesHi, gainsHi)));
+		}
+		MixStereoI16WithFrameGains_Scalar(&out[f * 2], &in[f * 2], &frameGains[f], frameCount - f, panGainL, panGainR);
+	}
+
+	AUDIO_TARGET_SSE2 static void MixStereoI16WithConstantGain_SSE2(f32* out, const i16* in, size_t frameCount, f32 gainL, f32 gainR)
+	{
+		const __m128 gain = _mm_setr_ps(gainL, gainR, gainL, gainR);
+		size_t f = 0;
+		for (; (f + 4) <= frameCount; f += 4)
+		{
+			const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[f * 2]));
+			const __m128 samplesLo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16));
+			const __m128 samplesHi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16));
+
+			_mm_storeu_ps(&out[(f * 2) + 0], _mm_add_ps(_mm_loadu_ps(&out[(f * 2) + 0]), _mm_mul_ps(samplesLo, gain)));
+			_mm_storeu_ps(&out[(f * 2) + 4], _mm_add_ps(_mm_loadu_ps(&out[(f * 2) + 4]), _mm_mul_ps(samplesHi, gain)));
+		}
+		MixStereoI16WithConstantGain_Scalar(&out[f * 2], &in[f * 2], frameCount - f, gainL, gainR);
+	}
+
+	AUDIO_TARGET_SSE2 static void MixStereoF32IntoI16Clamped_SSE2(i16* out, const f32* in, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain)
+	{
+		const __m128 pre = _mm_set1_ps(preGain), post = _mm_set1_ps(postGain);
+		const __m128 min = _mm_set1_ps(static_cast<f32>(I16Min)), max = _mm_set1_ps(static_cast<f32>(I16Max));
+		size_t f = 0;
+		for (; (f + 4) <= frameCount; f += 4)
+		{
+			const __m128 gains = _mm_loadu_ps(&frameGains[f]);
+			const __m128 lo = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&in[(f * 2) + 0]), pre), _mm_unpacklo_ps(gains, gains)), post);
+			const __m128 hi = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&in[(f * 2) + 4]), pre), _mm_unpackhi_ps(gains, gains)), post);
+
+			// NOTE: Clamping first then truncating towards zero, same as the static_cast inside ClampSampleI()
+			const __m128i clampedLo = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(lo, min), max));
+			const __m128i clampedHi = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(hi, min), max));
+
+			__m128i* outVector = reinterpret_cast<__m128i*>(&out[f * 2]);
+			_mm_storeu_si128(outVector, _mm_add_epi16(_mm_loadu_si128(outVector), _mm_packs_epi32(clampedLo, clampedHi)));
+		}
+		MixStereoF32IntoI16Clamped_Scalar(&out[f * 2], &in[f * 2], &frameGains[f], frameCount - f, preGain, postGain);
+	}
+
+	AUDIO_TARGET_SSE2 static void MixStereoF32IntoF32_SSE2(f32* out, const f32* in, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain)
+	{
+		const __m128 pre = _mm_set1_ps(preGain), post = _mm_set1_ps(postGain);
+		size_t f = 0;
+		for (; (f + 4) <= frameCount; f += 4)
+		{
+			const __m128 gains = _mm_loadu_ps(&frameGains[f]);
+			const __m128 lo = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&in[(f * 2) + 0]), pre), _mm_unpacklo_ps(gains, gains)), post);
+			const __m128 hi = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&in[(f * 2) + 4]), pre), _mm_unpackhi_ps(gains, gains)), post);
+
+			_mm_storeu_ps(&out[(f * 2) + 0], _mm_add_ps(_mm_loadu_ps(&out[(f * 2) + 0]), lo));
+			_mm_storeu_ps(&out[(f * 2) + 4], _mm_add_ps(_mm_loadu_ps(&out[(f * 2) + 4]), hi));
+		}
+		MixStereoF32IntoF32_Scalar(&out[f * 2], &in[f * 2], &frameGains[f], frameCount - f, preGain, postGain);
+	}
+
+	AUDIO_TARGET_SSE2 static void DuplicateMonoToStereoI16_SSE2(i16* out, const i16* in, size_t frameCount)
+	{
+		size_t f = 0;
+		for (; (f + 8) <= frameCount; f += 8)
+		{
+			const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[f]));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&out[(f * 2) + 0]), _mm_unpacklo_epi16(samples, samples));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&out[(f * 2) + 8]), _mm_unpackhi_epi16(samples, samples));
+		}
+		DuplicateMonoToStereoI16_Scalar(&out[f * 2], &in[f], frameCount - f);
+	}
+
+	AUDIO_TARGET_SSE2 static void CombineQuadToStereoI16_SSE2(i16* out, const i16* in, size_t frameCount)
+	{
+		size_t f = 0;
+		for (; (f + 4) <= frameCount; f += 4)
+		{
+			// NOTE: Treating each channel pair as a single 32-bit lane, so that (0, 1) and (2, 3) of each frame can be shuffled apart
+			const __m128i framesA = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[(f * 4) + 0]));
+			const __m128i framesB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[(f * 4) + 8]));
+			const __m128i leadingPairs = _mm_unpacklo_epi64(_mm_shuffle_epi32(framesA, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_epi32(framesB, _MM_SHUFFLE(2, 0, 2, 0)));
+			const __m128i trailingPairs = _mm_unpacklo_epi64(_mm_shuffle_epi32(framesA, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_epi32(framesB, _MM_SHUFFLE(3, 1, 3, 1)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&out[f * 2]), _mm_adds_epi16(leadingPairs, trailingPairs));
+		}
+		CombineQuadToStereoI16_Scalar(&out[f * 2], &in[f * 4], frameCount - f);
+	}
+
+	// NOTE: Processing 8 stereo frames (16 samples) per iteration
+	AUDIO_TARGET_AVX2 static void MixStereoI16WithFrameGains_AVX2(f32* out, const i16* in, const f32* frameGains, size_t frameCount, f32 panGainL, f32 panGainR)
+	{
+		const __m256 panGain = _mm256_setr_ps(panGainL, panGainR, panGainL, panGainR, panGainL, panGainR, panGainL, panGainR);
+		const __m256i duplicateLo = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3), duplicateHi = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+		size_t f = 0;
+		for (; (f + 8) <= frameCount; f += 8)
+		{
+			const __m256 samplesLo = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[(f * 2) + 0]))));
+			const __m256 samplesHi = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[(f * 2) + 8]))));
+
+			const __m256 gains = _mm256_loadu_ps(&frameGains[f]);
+			const __m256 gainsLo = _mm256_mul_ps(_mm256_permutevar8x32_ps(gains, duplicateLo), panGain);
+			const __m256 gainsHi = _mm256_mul_ps(_mm256_permutevar8x32_ps(gains, duplicateHi), panGain);
+
+			_mm256_storeu_ps(&out[(f * 2) + 0], _mm256_add_ps(_mm256_loadu_ps(&out[(f * 2) + 0]), _mm256_mul_ps(samplesLo, gainsLo)));
+			_mm256_storeu_ps(&out[(f * 2) + 8], _mm256_add_ps(_mm256_loadu_ps(&out[(f * 2) + 8]), _mm256_mul_ps(samplesHi, gainsHi)));
+		}
+		MixStereoI16WithFrameGains_SSE2(&out[f * 2], &in[f * 2], &frameGains[f], frameCount - f, panGainL, panGainR);
+	}
+
+	AUDIO_TARGET_AVX2 static void MixStereoI16WithConstantGain_AVX2(f32* out, const i16* in, size_t frameCount, f32 gainL, f32 gainR)
+	{
+		const __m256 gain = _mm256_setr_ps(gainL, gainR, gainL, gainR, gainL, gainR, gainL, gainR);
+		size_t f = 0;
+		for (; (f + 8) <= frameCount; f += 8)
+		{
+			const __m256 samplesLo = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[(f * 2) + 0]))));
+			const __m256 samplesHi = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[(f * 2) + 8]))));
+
+			_mm256_storeu_ps(&out[(f * 2) + 0], _mm256_add_ps(_mm256_loadu_ps(&out[(f * 2) + 0]), _mm256_mul_ps(samplesLo, gain)));
+			_mm256_storeu_ps(&out[(f * 2) + 8], _mm256_add_ps(_mm256_loadu_ps(&out[(f * 2) + 8]), _mm256_mul_ps(samplesHi, gain)));
+		}
+		MixStereoI16WithConstantGain_SSE2(&out[f * 2], &in[f * 2], frameCount - f, gainL, gainR);
+	}
+
+	AUDIO_TARGET_AVX2 static void MixStereoF32IntoI16Clamped_AVX2(i16* out, const f32* in, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain)
+	{
+		const __m256 pre = _mm256_set1_ps(preGain), post = _mm256_set1_ps(postGain);
+		const __m256 min = _mm256_set1_ps(static_cast<f32>(I16Min)), max = _mm256_set1_ps(static_cast<f32>(I16Max));
+		const __m256i duplicateLo = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3), duplicateHi = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+		size_t f = 0;
+		for (; (f + 8) <= frameCount; f += 8)
+		{
+			const __m256 gains = _mm256_loadu_ps(&frameGains[f]);
+			const __m256 lo = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(&in[(f * 2) + 0]), pre), _mm256_permutevar8x32_ps(gains, duplicateLo)), post);
+			const __m256 hi = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(&in[(f * 2) + 8]), pre), _mm256_permutevar8x32_ps(gains, duplicateHi)), post);
+
+			const __m256i clampedLo = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(lo, min), max));
+			const __m256i clampedHi = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(hi, min), max));
+
+			// NOTE: Packing works per 128-bit lane, so the 64-bit quarters have to be put back into order afterwards
+			const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(clampedLo, clampedHi), _MM_SHUFFLE(3, 1, 2, 0));
+
+			__m256i* outVector = reinterpret_cast<__m256i*>(&out[f * 2]);
+			_mm256_storeu_si256(outVector, _mm256_add_epi16(_mm256_loadu_si256(outVector), packed));
+		}
+		MixStereoF32IntoI16Clamped_SSE2(&out[f * 2], &in[f * 2], &frameGains[f], frameCount - f, preGain, postGain);
+	}
+
+	AUDIO_TARGET_AVX2 static void MixStereoF32IntoF32_AVX2(f32* out, const f32* in, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain)
+	{
+		const __m256 pre = _mm256_set1_ps(preGain), post = _mm256_set1_ps(postGain);
+		const __m256i duplicateLo = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3), duplicateHi = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+		size_t f = 0;
+		for (; (f + 8) <= frameCount; f += 8)
+		{
+			const __m256 gains = _mm256_loadu_ps(&frameGains[f]);
+			const __m256 lo = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(&in[(f * 2) + 0]), pre), _mm256_permutevar8x32_ps(gains, duplicateLo)), post);
+			const __m256 hi = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(&in[(f * 2) + 8]), pre), _mm256_permutevar8x32_ps(gains, duplicateHi)), post);
+
+			_mm256_storeu_ps(&out[(f * 2) + 0], _mm256_add_ps(_mm256_loadu_ps(&out[(f * 2) + 0]), lo));
+			_mm256_storeu_ps(&out[(f * 2) + 8], _mm256_add_ps(_mm256_loadu_ps(&out[(f * 2) + 8]), hi));
+		}
+		MixStereoF32IntoF32_SSE2(&out[f * 2], &in[f * 2], &frameGains[f], frameCount - f, preGain, postGain);
+	}
+
+	static b8 CPUSupportsAVX2()
+	{
+#if defined(_MSC_VER)
+		i32 cpuInfo[4] = {};
+		__cpuid(cpuInfo, 1);
+		const b8 osSupportsAVX = ((cpuInfo[2] & (1 << 27)) != 0) && ((cpuInfo[2] & (1 << 28)) != 0) && ((_xgetbv(0) & 0x6) == 0x6);
+		if (!osSupportsAVX)
+			return false;
+		__cpuidex(cpuInfo, 7, 0);
+		return ((cpuInfo[1] & (1 << 5)) != 0);
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+#endif
+
+	static constexpr MixKernels ScalarMixKernels =
+	{
+		MixStereoI16WithFrameGains_Scalar,
+		MixStereoI16WithConstantGain_Scalar,
+		MixStereoF32IntoI16Clamped_Scalar,
+		MixStereoF32IntoF32_Scalar,
+		DuplicateMonoToStereoI16_Scalar,
+		CombineQuadToStereoI16_Scalar,
+	};
+
+#if AUDIO_MIX_KERNELS_X86
+	static constexpr MixKernels SSE2MixKernels =
+	{
+		MixStereoI16WithFrameGains_SSE2,
+		MixStereoI16WithConstantGain_SSE2,
+		MixStereoF32IntoI16Clamped_SSE2,
+		MixStereoF32IntoF32_SSE2,
+		DuplicateMonoToStereoI16_SSE2,
+		CombineQuadToStereoI16_SSE2,
+	};
+
+	// NOTE: The channel mixing kernels are memory bound and don't benefit from wider vectors
+	static constexpr MixKernels AVX2MixKernels =
+	{
+		MixStereoI16WithFrameGains_AVX2,
+		MixStereoI16WithConstantGain_AVX2,
+		MixStereoF32IntoI16Clamped_AVX2,
+		MixStereoF32IntoF32_AVX2,
+		DuplicateMonoToStereoI16_SSE2,
+		CombineQuadToStereoI16_SSE2,
+	};
+#endif
+
+	b8 IsMixKernelSetSupported(MixKernelSet set)
+	{
+		switch (set)
+		{
+		case MixKernelSet::Scalar: return true;
+#if AUDIO_MIX_KERNELS_X86
+		case MixKernelSet::SSE2: return true;
+		case MixKernelSet::AVX2: { static const b8 supported = CPUSupportsAVX2(); return supported; }
+#endif
+		default: return false;
+		}
+	}
+
+	const MixKernels& GetMixKernels(MixKernelSet set)
+	{
+		assert(IsMixKernelSetSupported(set));
+		switch (set)
+		{
+#if AUDIO_MIX_KERNELS_X86
+		case MixKernelSet::SSE2: return SSE2MixKernels;
+		case MixKernelSet::AVX2: return AVX2MixKernels;
+#endif
+		default: return ScalarMixKernels;
+		}
+	}
+
+	MixKernelSet GetBestSupportedMixKernelSet()
+	{
+		static const MixKernelSet bestSupportedSet = []
+		{
+			for (MixKernelSet set = MixKernelSet::Count; set > MixKernelSet::Scalar;)
+			{
+				set = static_cast<MixKernelSet>(EnumToIndex(set) - 1);
+				if (IsMixKernelSetSupported(set))
+					return set;
+			}
+			return MixKernelSet::Scalar;
+		}();
+		return bestSupportedSet;
+	}
+
+	const MixKernels& GetMixKernels()
+	{
+		static const MixKernels& bestSupportedKernels = GetMixKernels(GetBestSupportedMixKernelSet());
+		return bestSupportedKernels;
+	}
+}
@@ -42,9 +42,49 @@ namespace Audio
 
 		constexpr size_t SampleCount() const { return (FrameCount * ChannelCount); }
 		constexpr size_t ByteSize() const { return (FrameCount * ChannelCount * sizeof(i16)); }
-		i64 ReadAtOrFillSilence(i64 inFrameOffset, i64 inFrameCount, i16 outSamples[]) const;
+		// NOTE: Frames at or past inReadableFrameCount are treated as silence, for buffers that are still being written to while being read
+		i64 ReadAtOrFillSilence(i64 inFrameOffset, i64 inFrameCount, i16 outSamples[], i64 inReadableFrameCount = I64Max) const;
 	};
 
+	enum class MixKernelSet : u8
+	{
+		Scalar,
+		SSE2,
+		AVX2,
+		Count
+	};
+
+	constexpr cstr MixKernelSetNames[EnumCount<MixKernelSet>] =
+	{
+		"Scalar",
+		"SSE2",
+		"AVX2",
+	};
+
+	// NOTE: Inner loops of the render callback, all operating on interleaved stereo frames.
+	//		 The vectorized versions produce bit-identical results to the scalar ones (no FMA, same order of operations)
+	struct MixKernels
+	{
+		// NOTE: out[i] += in[i] * (frameGains[frame] * panGain[channel])
+		void(*MixStereoI16WithFrameGains)(f32* out, const i16* in, const f32* frameGains, size_t frameCount, f32 panGainL, f32 panGainR);
+		// NOTE: out[i] += in[i] * gain[channel]
+		void(*MixStereoI16WithConstantGain)(f32* out, const i16* in, size_t frameCount, f32 gainL, f32 gainR);
+		// NOTE: out[i] += ClampSampleI<i16>(((in[i] * preGain) * frameGains[frame]) * postGain)
+		void(*MixStereoF32IntoI16Clamped)(i16* out, const f32* in, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain);
+		// NOTE: out[i] += ((in[i] * preGain) * frameGains[frame]) * postGain
+		void(*MixStereoF32IntoF32)(f32* out, const f32* in, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain);
+		// NOTE: Channel mixing of mono to stereo and of 4 channels to stereo by saturated adding (0 + 2, 1 + 3)
+		void(*DuplicateMonoToStereoI16)(i16* out, const i16* in, size_t frameCount);
+		void(*CombineQuadToStereoI16)(i16* out, const i16* in, size_t frameCount);
+	};
+
+	b8 IsMixKernelSetSupported(MixKernelSet set);
+	const MixKernels& GetMixKernels(MixKernelSet set);
+
+	// NOTE: Best set supported by the current CPU, determined once on first use
+	const MixKernels& GetMixKernels();
+	MixKernelSet GetBestSupportedMixKernelSet();
+
 	enum class ChannelMixingBehavior : u8
 	{
 		Combine,
@@ -67,18 +107,18 @@ namespace Audio
 		u32 TargetChannels = 2;
 		std::vector<i16> MixBuffer;
 
-		i64 MixChannels(PCMSampleBuffer& buffer, i16 bufferToFill[], i64 frameOffset, i64 framesToRead);
+		i64 MixChannels(PCMSampleBuffer& buffer, i16 bufferToFill[], i64 frameOffset, i64 framesToRead, i64 readableFrameCount = I64Max);
 		i64 MixChannels(u32 sourceChannels, i16 sampleSwapBuffer[], i64 framesRead, i16 bufferToFill[], i64 frameOffset, i64 framesToRead);
 
 		inline i16* GetMixSampleBufferWithMinSize(size_t minSampleCount) { if (MixBuffer.size() < minSampleCount) MixBuffer.resize(minSampleCount); return MixBuffer.data(); }
 	};
 
-	inline i64 ChannelMixer::MixChannels(PCMSampleBuffer& buffer, i16 bufferToFill[], i64 frameOffset, i64 framesToRead)
+	inline i64 ChannelMixer::MixChannels(PCMSampleBuffer& buffer, i16 bufferToFill[], i64 frameOffset, i64 framesToRead, i64 readableFrameCount)
 	{
 		const u32 sourceChannels = buffer.ChannelCount;
 		i16* mixBuffer = GetMixSampleBufferWithMinSize(framesToRead * sourceChannels);
 
-		const i64 framesRead = buffer.ReadAtOrFillSilence(frameOffset, framesToRead, mixBuffer);
+		const i64 framesRead = buffer.ReadAtOrFillSilence(frameOffset, framesToRead, mixBuffer, readableFrameCount);
 		return MixChannels(sourceChannels, mixBuffer, framesRead, bufferToFill, frameOffset, framesToRead);
 	}
 
@@ -86,7 +126,11 @@ namespace Audio
 	{
 		const i64 samplesRead = framesRead * sourceChannels;
 
-		if (sourceChannels < TargetChannels)
+		if (sourceChannels == 1 && TargetChannels == 2)
+		{
+			GetMixKernels().DuplicateMonoToStereoI16(bufferToFill, mixBuffer, static_cast<size_t>(framesRead));
+		}
+		else if (sourceChannels < TargetChannels)
 		{
 			// NOTE: Duplicate existing channel(s)
 			size_t targetIndex = 0;
@@ -131,6 +175,12 @@ namespace Audio
 			}
 			case ChannelMixingBehavior::Combine:
 			{
+				if (sourceChannels == 4)
+				{
+					GetMixKernels().CombineQuadToStereoI16(bufferToFill, mixBuffer, static_cast<size_t>(framesRead));
+					break;
+				}
+
 				for (i64 i = 0; i < framesRead * TargetChannels;)
 				{
 					bufferToFill[i++] = MixSamplesI_Clamped<i16, i32>(mixBuffer[swapBufferIndex + 0], mixBuffer[swapBufferIndex + 2]);
@@ -159,16 +209,8 @@ namespace Audio
 
 	// TODO: Switch to f32 instead (?)
 	template <typename SampleType>
-	constexpr SampleType LinearSampleAtTimeOrZero(f64 atSecond, u32 atChannel, const SampleType* samples, size_t sampleCount, f64 sampleRate, u32 channelCount)
+	constexpr SampleType LinearlyInterpolateSamples(SampleType startValue, SampleType endValue, f64 inbetween)
 	{
-		const f64 frameFaction = (atSecond * sampleRate);
-		const i64 startFrame = static_cast<i64>(frameFaction);
-		const i64 endFrame = (startFrame + 1);
-
-		const SampleType startValue = SampleAtFrameIndexOrZero<SampleType>(startFrame, atChannel, samples, sampleCount, channelCount);
-		const SampleType endValue = SampleAtFrameIndexOrZero<SampleType>(endFrame, atChannel, samples, sampleCount, channelCount);
-		const f64 inbetween = (frameFaction - static_cast<f64>(startFrame));
-
 		static constexpr f64 maxSampleValueF64 = static_cast<f64>(std::numeric_limits<SampleType>::max());
 		const f64 normalizedStart = static_cast<f64>(startValue / maxSampleValueF64);
 		const f64 normalizedEnd = static_cast<f64>(endValue / maxSampleValueF64);
@@ -180,49 +222,18 @@ namespace Audio
 		return sampleTypeResult;
 	}
 
-	// NOTE: Low quallity linear resampling lacking a low pass filter, should however still be better than having sped up audio for now
 	template <typename SampleType>
-	void LinearlyResampleBuffer(std::unique_ptr<SampleType[]>& inOutSamples, size_t& inOutFrameCount, u32& inOutSampleRate, const u32 inChannelCount, const u32 targetSampleRate)
+	constexpr SampleType LinearSampleAtTimeOrZero(f64 atSecond, u32 atChannel, const SampleType* samples, size_t sampleCount, f64 sampleRate, u32 channelCount)
 	{
-		if (inOutSampleRate == targetSampleRate) { assert(false); return; }
-
-		const SampleType* inSamples = inOutSamples.get();
-		const size_t inSampleCount = (inOutFrameCount * inChannelCount);
-
-		const f64 sourceRate = static_cast<f64>(inOutSampleRate);
-		const f64 targetRate = static_cast<f64>(targetSampleRate);
-
-		const size_t inFrameCount = (inSampleCount / inChannelCount);
-		const size_t outFrameCount = static_cast<size_t>(inFrameCount * targetRate / sourceRate + 0.5);
-
-		const size_t outSampleCount = (outFrameCount * inChannelCount);
-		// auto outSamples = std::make_unique<SampleType[]>(outSampleCount);
-		auto outSamples = std::unique_ptr<SampleType[]>(new SampleType[outSampleCount]);
-
-		const f64 outFrameToSecond = (1.0 / targetRate);
-		SampleType* outSampleWriteHead = outSamples.get();
-
-		for (size_t frame = 0; frame < outFrameCount; frame++)
-		{
-			const f64 second = (static_cast<f64>(frame) * outFrameToSecond);
-
-			for (u32 channel = 0; channel < inChannelCount; channel++)
-				outSampleWriteHead[channel] = LinearSampleAtTimeOrZero<SampleType>(second, channel, inSamples, inSampleCount, sourceRate, inChannelCount);
-
-			outSampleWriteHead += inChannelCount;
-		}
+		const f64 frameFaction = (atSecond * sampleRate);
+		const i64 startFrame = static_cast<i64>(frameFaction);
+		const i64 endFrame = (startFrame + 1);
 
-		inOutSamples = std::move(outSamples);
-		inOutFrameCount = outFrameCount;
-		inOutSampleRate = targetSampleRate;
-	}
+		const SampleType startValue = SampleAtFrameIndexOrZero<SampleType>(startFrame, atChannel, samples, sampleCount, channelCount);
+		const SampleType endValue = SampleAtFrameIndexOrZero<SampleType>(endFrame, atChannel, samples, sampleCount, channelCount);
+		const f64 inbetween = (frameFaction - static_cast<f64>(startFrame));
 
-	template <typename SampleType>
-	void LinearlyResampleBuffer(std::unique_ptr<SampleType[]>& inOutSamples, i64& inOutFrameCount, u32& inOutSampleRate, const u32 inChannelCount, const u32 targetSampleRate)
-	{
-		size_t inOutFrameCountSizeT = static_cast<size_t>(inOutFrameCount);
-		Audio::LinearlyResampleBuffer(inOutSamples, inOutFrameCountSizeT, inOutSampleRate, inChannelCount, targetSampleRate);
-		inOutFrameCount = static_cast<i64>(inOutFrameCountSizeT);
+		return LinearlyInterpolateSamples<SampleType>(startValue, endValue, inbetween);
 	}
 
 	template <typename T>
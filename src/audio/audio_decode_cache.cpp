@@ -0,0 +1,248 @@
+#include "audio_decode_cache.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace Audio
+{
+	struct DecodeCacheFileHeader
+	{
+		u32 Magic;
+		u32 Version;
+		DecodeCacheKey Key;
+		u32 ChannelCount;
+		u32 SampleRate;
+		i64 FrameCount;
+		u32 WaveformCount;
+		b8 WaveformIncludesFullSizeMip;
+		// NOTE: Even for samples that didn't have to be resampled, as the source sample rate isn't known before having opened the file for decoding
+		ResamplerQuality ResamplerQuality;
+		u8 Padding[2];
+		u64 WaveformBucketDataCount;
+	};
+
+	static_assert(sizeof(DecodeCacheFileHeader) == 56, "Changing the header layout also requires bumping the cache file version");
+
+	// NOTE: Followed by the interleaved samples and then the stored coarse mip bucket data of each waveform, all stored as native (little endian) i16 arrays
+	static constexpr u32 DecodeCacheFileMagic = 0x41444B50; // 'PKDA'
+	// NOTE: Also has to be bumped whenever the decoded samples or the waveform mip layout would change (2: polyphase resampling, 3: coarser base mip, 4: coarse mips only, 5: resampler quality)
+	static constexpr u32 DecodeCacheFileVersion = 5;
+
+	// NOTE: The stored mips are always a contiguous tail of the bucket data, starting at the bucket offset of this mip
+	static size_t GetFirstStoredWaveformMipIndex(const WaveformMipChain& waveform)
+	{
+		const size_t usedMipCount = static_cast<size_t>(waveform.GetUsedMipCount());
+		for (size_t i = 0; i < usedMipCount; i++)
+		{
+			if ((waveform.GetBaseMipFramesPerBucket() << i) >= DecodeCacheMinStoredWaveformFramesPerBucket)
+				return i;
+		}
+		return (usedMipCount > 0) ? (usedMipCount - 1) : 0;
+	}
+
+	// NOTE: Small enough for a cancellation request to be noticed quickly
+	static constexpr size_t DecodeCacheWriteBlockByteSize = (1024 * 1024);
+
+	static std::string GetDecodeCacheEntryFilePath(std::string_view cacheDirectory, const DecodeCacheKey& key)
+	{
+		char fileName[64];
+		const int fileNameLength = sprintf_s(fileName, "%016llX_%llu", static_cast<unsigned long long>(key.ContentHash), static_cast<unsigned long long>(key.FileSize));
+
+		std::string filePath;
+		filePath.reserve(cacheDirectory.size() + 1 + fileNameLength + DecodeCacheFileExtension.size());
+		filePath.append(cacheDirectory);
+		filePath.push_back(Path::DirectorySeparator);
+		filePath.append(fileName, fileNameLength);
+		filePath.append(DecodeCacheFileExtension);
+		return filePath;
+	}
+
+	DecodeCacheKey ComputeDecodeCacheKey(const void* fileContent, size_t fileSize)
+	{
+		static constexpr u64 prime1 = 0x9E3779B185EBCA87ull, prime2 = 0xC2B2AE3D27D4EB4Full, prime3 = 0x165667B19E3779F9ull;
+		auto rotateLeft = [](u64 value, u32 bits) { return (value << bits) | (value >> (64 - bits)); };
+
+		// NOTE: Four independent lanes of 8 byte words so that hashing isn't bound by the multiply latency, making it a small fraction of the decoding cost
+		const u8* bytes = static_cast<const u8*>(fileContent);
+		u64 lanes[4] = { prime1 + prime2, prime2, 0, 0 - prime1 };
+		size_t byteIndex = 0;
+		for (; (byteIndex + 32) <= fileSize; byteIndex += 32)
+		{
+			for (size_t lane = 0; lane < 4; lane++)
+			{
+				u64 word; ::memcpy(&word, &bytes[byteIndex + (lane * sizeof(u64))], sizeof(u64));
+				lanes[lane] = rotateLeft(lanes[lane] + (word * prime2), 31) * prime1;
+			}
+		}
+
+		u64 hash = (static_cast<u64>(fileSize) * prime3);
+		for (size_t lane = 0; lane < 4; lane++)
+			hash = (rotateLeft(hash ^ lanes[lane], 27) * prime1) + prime3;
+		for (; byteIndex < fileSize; byteIndex++)
+			hash = rotateLeft(hash ^ (bytes[byteIndex] * prime3), 11) * prime1;
+
+		hash ^= (hash >> 33); hash *= prime2;
+		hash ^= (hash >> 29); hash *= prime3;
+		hash ^= (hash >> 32);
+		return DecodeCacheKey { hash, static_cast<u64>(fileSize) };
+	}
+
+	b8 DecodeCacheEntry::Open(std::string_view cacheDirectory, const DecodeCacheKey& key, u32 expectedSampleRate, ResamplerQuality expectedResamplerQuality)
+	{
+		Close();
+		const std::string filePath = GetDecodeCacheEntryFilePath(cacheDirectory, key);
+
+		// NOTE: Touched before being mapped because the mapped file can't be written to, not even its attributes
+		std::error_code errorCode;
+		std::filesystem::last_write_time(std::filesystem::u8path(filePath), std::filesystem::file_time_type::clock::now(), errorCode);
+		if (errorCode || !view.Open(filePath))
+			return false;
+
+		DecodeCacheFileHeader header = {};
+		if (view.Size() >= sizeof(header))
+			::memcpy(&header, view.Data(), sizeof(header));
+
+		const b8 headerIsValid =
+			(header.Magic == DecodeCacheFileMagic && header.Version == DecodeCacheFileVersion) &&
+			(header.Key.ContentHash == key.ContentHash && header.Key.FileSize == key.FileSize) &&
+			(header.SampleRate == expectedSampleRate && header.ResamplerQuality == expectedResamplerQuality) &&
+			(header.ChannelCount > 0 && header.FrameCount > 0 && header.WaveformCount <= header.ChannelCount);
+
+		const u64 sampleCount = (static_cast<u64>(header.FrameCount) * header.ChannelCount);
+		const u64 expectedFileSize = sizeof(header) + (sampleCount * sizeof(i16)) + (static_cast<u64>(header.WaveformCount) * header.WaveformBucketDataCount * sizeof(i16));
+		if (!headerIsValid || view.Size() != expectedFileSize)
+		{
+			Close();
+			return false;
+		}
+
+		const i16* fileSamples = reinterpret_cast<const i16*>(view.Data() + sizeof(header));
+		channelCount = header.ChannelCount;
+		sampleRate = header.SampleRate;
+		frameCount = header.FrameCount;
+		interleavedSamples = fileSamples;
+		waveformCount = header.WaveformCount;
+		waveformIncludesFullSizeMip = header.WaveformIncludesFullSizeMip;
+		waveformBucketDataCount = static_cast<size_t>(header.WaveformBucketDataCount);
+		waveformBucketData = (fileSamples + sampleCount);
+		return true;
+	}
+
+	void DecodeCacheEntry::Close()
+	{
+		view.Close();
+		channelCount = 0;
+		sampleRate = 0;
+		frameCount = 0;
+		interleavedSamples = nullptr;
+		waveformCount = 0;
+		waveformIncludesFullSizeMip = false;
+		waveformBucketDataCount = 0;
+		waveformBucketData = nullptr;
+	}
+
+	b8 DecodeCacheEntry::CopyWaveform(size_t waveformIndex, WaveformMipChain& outWaveform) const
+	{
+		if (!IsOpen() || waveformIndex >= waveformCount)
+			return false;
+
+		// NOTE: The mip layout itself isn't stored as it only depends on the frame count and sample rate, leaving just the bucket count to be validated
+		outWaveform.BeginIncrementalMipChainGeneration(frameCount, sampleRate, waveformIncludesFullSizeMip);
+		const size_t firstStoredMipIndex = GetFirstStoredWaveformMipIndex(outWaveform);
+		const size_t storedBucketOffset = outWaveform.AllMips[firstStoredMipIndex].BucketOffset;
+		if ((outWaveform.BucketData.size() - storedBucketOffset) != waveformBucketDataCount)
+		{
+			outWaveform = {};
+			return false;
+		}
+
+		::memcpy(outWaveform.BucketData.data() + storedBucketOffset, waveformBucketData + (waveformIndex * waveformBucketDataCount), waveformBucketDataCount * sizeof(i16));
+		for (size_t i = firstStoredMipIndex; i < WaveformMipChain::MaxMipLevels; i++)
+			outWaveform.AllMips[i].GeneratedBucketCount = (outWaveform.AllMips[i].PowerOfTwoSampleCount != 0) ? outWaveform.AllMips[i].BucketCount : 0;
+		return true;
+	}
+
+	b8 WriteDecodeCacheEntry(std::string_view cacheDirectory, const DecodeCacheKey& key, const PCMSampleBuffer& sampleBuffer, ResamplerQuality resamplerQuality, const WaveformMipChain* waveforms, size_t waveformCount, const std::atomic<b8>* cancelRequested)
+	{
+		assert(sampleBuffer.InterleavedSamples != nullptr && waveformCount <= sampleBuffer.ChannelCount);
+		for (size_t i = 1; i < waveformCount; i++)
+			assert(waveforms[i].BucketData.size() == waveforms[0].BucketData.size() && waveforms[i].IncludesFullSizeMip == waveforms[0].IncludesFullSizeMip);
+
+		const size_t firstStoredMipIndex = (waveformCount > 0) ? GetFirstStoredWaveformMipIndex(waveforms[0]) : 0;
+		const size_t storedBucketOffset = (waveformCount > 0) ? waveforms[0].AllMips[firstStoredMipIndex].BucketOffset : 0;
+		for (size_t i = 0; i < waveformCount; i++)
+		{
+			for (size_t mipIndex = firstStoredMipIndex; mipIndex < WaveformMipChain::MaxMipLevels; mipIndex++)
+				assert(waveforms[i].AllMips[mipIndex].GeneratedBucketCount == waveforms[i].AllMips[mipIndex].BucketCount);
+		}
+
+		DecodeCacheFileHeader header = {};
+		header.Magic = DecodeCacheFileMagic;
+		header.Version = DecodeCacheFileVersion;
+		header.Key = key;
+		header.ChannelCount = sampleBuffer.ChannelCount;
+		header.SampleRate = sampleBuffer.SampleRate;
+		header.FrameCount = sampleBuffer.FrameCount;
+		header.WaveformCount = static_cast<u32>(waveformCount);
+		header.WaveformIncludesFullSizeMip = (waveformCount > 0) ? waveforms[0].IncludesFullSizeMip : false;
+		header.ResamplerQuality = resamplerQuality;
+		header.WaveformBucketDataCount = (waveformCount > 0) ? (waveforms[0].BucketData.size() - storedBucketOffset) : 0;
+
+		if (!Directory::Exists(cacheDirectory) && !Directory::Create(cacheDirectory))
+			return false;
+
+		const size_t fileSize = sizeof(header) + sampleBuffer.ByteSize() + (waveformCount * header.WaveformBucketDataCount * sizeof(i16));
+		File::AtomicFileWriter writer;
+		if (!writer.Open(GetDecodeCacheEntryFilePath(cacheDirectory, key), fileSize))
+			return false;
+
+		auto isCancelRequested = [&]() { return (cancelRequested != nullptr && cancelRequested->load(std::memory_order_relaxed)); };
+
+		writer.Write(&header, sizeof(header));
+		const u8* sampleBytes = reinterpret_cast<const u8*>(sampleBuffer.InterleavedSamples.get());
+		for (size_t byteOffset = 0; byteOffset < sampleBuffer.ByteSize(); byteOffset += DecodeCacheWriteBlockByteSize)
+		{
+			if (isCancelRequested())
+				return false;
+			writer.Write(&sampleBytes[byteOffset], Min(DecodeCacheWriteBlockByteSize, sampleBuffer.ByteSize() - byteOffset));
+		}
+		for (size_t i = 0; i < waveformCount; i++)
+			writer.Write(waveforms[i].BucketData.data() + storedBucketOffset, header.WaveformBucketDataCount * sizeof(i16));
+
+		if (isCancelRequested())
+			return false;
+		return writer.Commit();
+	}
+
+	void EvictDecodeCacheEntries(std::string_view cacheDirectory, u64 maxTotalByteSize)
+	{
+		struct CacheFileInfo { std::filesystem::path Path; u64 Size; std::filesystem::file_time_type LastUsed; };
+		std::vector<CacheFileInfo> cacheFiles;
+
+		std::error_code errorCode;
+		for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::u8path(cacheDirectory), errorCode))
+		{
+			if (!entry.is_regular_file(errorCode) || entry.path().extension() != std::filesystem::path(DecodeCacheFileExtension))
+				continue;
+
+			CacheFileInfo& info = cacheFiles.emplace_back();
+			info.Path = entry.path();
+			info.Size = entry.file_size(errorCode);
+			info.LastUsed = entry.last_write_time(errorCode);
+		}
+
+		std::sort(cacheFiles.begin(), cacheFiles.end(), [](const CacheFileInfo& a, const CacheFileInfo& b) { return a.LastUsed > b.LastUsed; });
+
+		// NOTE: Keeping the most recently used entries up until the first one that no longer fits, with everything used before that being evicted
+		//		 (even smaller entries which would still fit, as those are the least recently used ones)
+		u64 totalByteSize = 0;
+		b8 isOverBudget = false;
+		for (const CacheFileInfo& info : cacheFiles)
+		{
+			isOverBudget |= ((totalByteSize + info.Size) > maxTotalByteSize);
+			if (isOverBudget)
+				std::filesystem::remove(info.Path, errorCode);
+			else
+				totalByteSize += info.Size;
+		}
+	}
+}
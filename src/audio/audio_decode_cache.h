@@ -0,0 +1,72 @@
+#pragma once
+#include "core_types.h"
+#include "core_io.h"
+#include "audio_common.h"
+#include "audio_resampler.h"
+#include "audio_waveform.h"
+#include <atomic>
+
+namespace Audio
+{
+	// NOTE: Persistent on-disk cache of decoded (and resampled) audio files together with their waveform mip chains, so that opening the same file again
+	//		 doesn't have to decode anything at all. Entries are keyed by a hash of the source file content and its size instead of its path or last write time,
+	//		 so that moved, copied or re-saved but otherwise unchanged files still hit. The last write time of each entry is used to track when it was last used.
+	//		 Only the coarse waveform mips are stored, as the finer ones would take up a sizable fraction of the samples themselves while being quick to generate again
+	struct DecodeCacheKey
+	{
+		u64 ContentHash;
+		u64 FileSize;
+	};
+
+	constexpr std::string_view DecodeCacheFileExtension = ".pdkaudio";
+	// NOTE: Only the mips with at least this many source frames per bucket are stored (along with the coarsest one for very short files)
+	constexpr size_t DecodeCacheMinStoredWaveformFramesPerBucket = 4096;
+
+	// NOTE: Only has to tell apart different files, not withstand any deliberate collisions
+	DecodeCacheKey ComputeDecodeCacheKey(const void* fileContent, size_t fileSize);
+
+	// NOTE: Read-only view of a memory mapped cache entry, with the samples and waveform buckets pointing directly into the mapped file
+	class DecodeCacheEntry : NonCopyable
+	{
+	public:
+		DecodeCacheEntry() = default;
+		~DecodeCacheEntry() = default;
+
+		// NOTE: Fails for missing, corrupted or outdated entries (or ones decoded at a different sample rate or resampler quality), otherwise marking the entry as the most recently used one
+		b8 Open(std::string_view cacheDirectory, const DecodeCacheKey& key, u32 sampleRate, ResamplerQuality resamplerQuality);
+		void Close();
+
+		inline b8 IsOpen() const { return view.IsOpen(); }
+		inline u32 GetChannelCount() const { return channelCount; }
+		inline u32 GetSampleRate() const { return sampleRate; }
+		inline i64 GetFrameCount() const { return frameCount; }
+		inline const i16* GetInterleavedSamples() const { return interleavedSamples; }
+		inline size_t GetWaveformCount() const { return waveformCount; }
+		inline size_t GetFileSize() const { return view.Size(); }
+
+		// NOTE: Identical to a mip chain begun for the cached samples but with all of the stored coarse mips already generated.
+		//		 Continuing its incremental generation from the cached samples then fills in the finer ones, giving the same result as generating it entirely
+		b8 CopyWaveform(size_t waveformIndex, WaveformMipChain& outWaveform) const;
+
+	private:
+		File::MappedView view;
+		u32 channelCount = 0;
+		u32 sampleRate = 0;
+		i64 frameCount = 0;
+		const i16* interleavedSamples = nullptr;
+		size_t waveformCount = 0;
+		b8 waveformIncludesFullSizeMip = false;
+		size_t waveformBucketDataCount = 0;
+		const i16* waveformBucketData = nullptr;
+	};
+
+	// NOTE: Written through a temporary file so that a cancelled or failed write never leaves behind a partial entry that could later be opened.
+	//		 All waveforms have to be generated from the sample buffer with the same arguments, with at least their stored coarse mips being complete.
+	//		 The resampler quality is the one the sample buffer has been decoded with, as entries are only ever opened again for the same quality.
+	//		 Checks for cancellation in between writing blocks of samples, returning false without having written the entry once it has been requested
+	b8 WriteDecodeCacheEntry(std::string_view cacheDirectory, const DecodeCacheKey& key, const PCMSampleBuffer& sampleBuffer, ResamplerQuality resamplerQuality, const WaveformMipChain* waveforms, size_t waveformCount, const std::atomic<b8>* cancelRequested = nullptr);
+
+	// NOTE: Deletes the least recently used entries until all remaining ones together take up at most maxTotalByteSize.
+	//		 Entries that are still being read from can't be deleted and are simply skipped over
+	void EvictDecodeCacheEntries(std::string_view cacheDirectory, u64 maxTotalByteSize);
+}
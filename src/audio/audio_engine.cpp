@@ -3,6 +3,7 @@
 #include "audio_backend.h"
 #include "core_io.h"
 #include <mutex>
+#include <thread>
 
 namespace Audio
 {
@@ -38,9 +39,11 @@ namespace Audio
 		VoiceFlags_VariablePlaybackSpeed = 1 << 6,
 	};
 
-	// NOTE: Indexed into by VoiceHandle, slot valid if Flags != VoiceFlags_Dead
+	// NOTE: Indexed into by VoiceHandle, slot valid if Flags != VoiceFlags_Dead.
+	//		 Claimed by whichever thread adds the voice and only released again by the render callback once it has stopped referencing it
 	struct VoiceData
 	{
+		std::atomic<bool> SlotClaimed;
 		// NOTE: Automatically resets to SourceHandle::Invalid when the source is unloaded
 		std::atomic<VoiceFlags> Flags;
 		std::atomic<SourceHandle> Source;
@@ -63,28 +66,87 @@ namespace Audio
 		// TODO: Loop between
 		// std::atomic<i64> LoopStartFrame, LoopEndFrame;
 
+		struct VoiceVolumeMap
+		{
+			i64 StartFrame, EndFrame;
+			f32 StartVolume, EndVolume;
+		};
+
+		// NOTE: Published through a sequence counter (odd while being written) so that the render callback never reads a mix of an old and a new map.
+		//		 Writers only serialize among themselves, while the render callback keeps using its last consistent copy instead of waiting
 		struct AtomicVoiceVolumeMap
 		{
+			std::atomic<u32> Sequence;
 			std::atomic<i64> StartFrame, EndFrame;
 			std::atomic<f32> StartVolume, EndVolume;
+
+			void Store(const VoiceVolumeMap& value)
+			{
+				u32 sequence = Sequence.load(std::memory_order_relaxed) & ~1u;
+				while (!Sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_relaxed))
+					sequence &= ~1u;
+				std::atomic_thread_fence(std::memory_order_release);
+
+				StartFrame.store(value.StartFrame, std::memory_order_relaxed);
+				EndFrame.store(value.EndFrame, std::memory_order_relaxed);
+				StartVolume.store(value.StartVolume, std::memory_order_relaxed);
+				EndVolume.store(value.EndVolume, std::memory_order_relaxed);
+				Sequence.store(sequence + 2, std::memory_order_release);
+			}
+
+			b8 TryLoad(VoiceVolumeMap& outValue) const
+			{
+				const u32 sequenceBefore = Sequence.load(std::memory_order_acquire);
+				if (sequenceBefore & 1u)
+					return false;
+
+				const VoiceVolumeMap value = { StartFrame.load(std::memory_order_relaxed), EndFrame.load(std::memory_order_relaxed), StartVolume.load(std::memory_order_relaxed), EndVolume.load(std::memory_order_relaxed) };
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (Sequence.load(std::memory_order_relaxed) != sequenceBefore)
+					return false;
+
+				outValue = value;
+				return true;
+			}
 		} VolumeMap;
+		// NOTE: Only accessed by the render callback (or whoever claimed the slot before adding the voice)
+		VoiceVolumeMap CallbackVolumeMap;
 
 		char Name[64];
 	};
 
-	// NOTE: Indexed into by SourceHandle, slot valid if SlotUsed
+	// NOTE: Indexed into by SourceHandle, slot valid if SlotUsed. Claimed while loading and only released again after unloading
+	//		 once no render callback can still be reading the buffer.
+	//		 Streaming sources start out with none of their frames readable, with the producer writing the rest of the buffer while it's already being played
 	struct SourceData
 	{
+		std::atomic<bool> SlotClaimed;
 		std::atomic<bool> SlotUsed;
+		// NOTE: Non-zero after unloading while waiting to be released, being the completed callback count that has to be reached first
+		std::atomic<u64> RetiredUntilCallbackCount;
 		PCMSampleBuffer Buffer;
+		std::atomic<i64> ReadableFrameCount = 0;
 		std::atomic<f32> BaseVolume = 0.0f;
 		char Name[256];
 	};
 
+	struct ScheduledOneShotSound
+	{
+		SourceHandle Source;
+		VoiceHandle ClockVoice;
+		i32 SoundGroup;
+		f32 Volume, Pan;
+		f64 ClockVoicePositionSec;
+		u32 Generation;
+	};
+
 	struct AudioEngine::Impl
 	{
 	public:
-		b8 IsStreamOpenRunning = false;
+		std::atomic<b8> IsStreamOpenRunning = false;
+		// NOTE: Held while opening or closing the stream, so that whoever holds it while the stream isn't running can safely take over
+		//		 the state otherwise owned by the render callback (without the render callback itself ever having to lock it)
+		std::mutex StreamStateMutex;
 		std::array<std::atomic<f32>, MaxSoundGroups> SoundGroupVolume = InitializedArray<std::atomic<f32>, MaxSoundGroups>(AudioEngine::MaxVolume);
 
 	public:
@@ -94,16 +156,41 @@ namespace Audio
 		std::unique_ptr<IAudioBackend> CurrentBackend = nullptr;
 
 	public:
-		std::mutex VoiceRenderMutex;
-
 		// NOTE: Slot maps indexed into via handles
 		std::array<VoiceData, MaxSimultaneousVoices> VoicePool;
 		std::array<SourceData, MaxLoadedSources> LoadedSources;
 
+		// NOTE: Compact list of claimed voice slots in the order they were added, to avoid scanning all the dead slots every callback.
+		//		 Only ever accessed by the render callback which also releases the slots of dead voices (or by the StreamStateMutex owner without a stream)
+		std::array<HandleBaseType, MaxSimultaneousVoices> ActiveVoiceIndices = {};
+		size_t ActiveVoiceCount = 0;
+
+		// NOTE: Multi producer single consumer ring buffer of newly added voices to be appended to the active list by the render callback.
+		//		 Producers only serialize among themselves so the render callback never has to wait on any other thread.
+		//		 As slots aren't released before being consumed there can never be more than MaxSimultaneousVoices entries
+		std::array<HandleBaseType, MaxSimultaneousVoices> AddedVoiceQueue = {};
+		std::atomic<u32> AddedVoiceQueueReadIndex = 0, AddedVoiceQueueWriteIndex = 0;
+		std::mutex AddedVoiceQueueProducerMutex;
+
+		// NOTE: For waiting on any render callback that might still be referencing something that has just been removed
+		std::atomic<u64> CompletedCallbackCount = 0;
+
+		// NOTE: Single producer (ScheduleOneShotSound() caller) single consumer (render callback) ring buffer, indices wrapping around naturally.
+		//		 Incrementing the generation discards everything scheduled before it
+		std::array<ScheduledOneShotSound, MaxScheduledOneShotSounds> ScheduledSoundQueue = {};
+		std::atomic<u32> ScheduledSoundQueueReadIndex = 0, ScheduledSoundQueueWriteIndex = 0;
+		std::atomic<u32> ScheduledSoundGeneration = 0;
+
+		// NOTE: Only ever accessed by the render callback, holding all sounds taken from the queue whose start position hasn't been reached yet
+		std::array<ScheduledOneShotSound, MaxScheduledOneShotSounds> PendingScheduledSounds = {};
+		size_t PendingScheduledSoundCount = 0;
+
 	public:
 		std::array<i16, (MaxBufferFrameCount * OutputChannelCount)> TempOutputBuffer = {};
 		std::array<f32, (MaxBufferFrameCount* OutputChannelCount)> MasterBuffer = {};
-		std::array<f32, (MaxBufferFrameCount* OutputChannelCount)> SoundGroupBuffer = {};
+		std::array<std::array<f32, (MaxBufferFrameCount* OutputChannelCount)>, MaxSoundGroups> SoundGroupBuffers = {};
+		std::array<f32, MaxBufferFrameCount> TempFrameGains = {};
+		const MixKernels& Kernels = GetMixKernels();
 		u32 CurrentBufferFrameSize = DefaultBufferFrameCount;
 		u32 TargetBufferFrameSize = DefaultBufferFrameCount;
 
@@ -178,6 +265,32 @@ namespace Audio
 				CopyStringViewIntoFixedBuffer(sourceData->Name, newName);
 		}
 
+		SourceHandle LoadSourceFromBufferMove(std::string_view sourceName, PCMSampleBuffer bufferToMove, i64 readableFrameCount)
+		{
+			ReleaseRetiredSources();
+			for (HandleBaseType index = 0; index < static_cast<HandleBaseType>(LoadedSources.size()); index++)
+			{
+				SourceData& sourceData = LoadedSources[index];
+				bool expected = false;
+				if (!sourceData.SlotClaimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+					continue;
+
+				sourceData.Buffer = std::move(bufferToMove);
+				sourceData.ReadableFrameCount.store(readableFrameCount, std::memory_order_relaxed);
+				sourceData.BaseVolume = 1.0f;
+				CopyStringViewIntoFixedBuffer(sourceData.Name, sourceName);
+				sourceData.SlotUsed.store(true, std::memory_order_release);
+
+				return static_cast<SourceHandle>(index);
+			}
+
+#if PEEPO_DEBUG
+			assert(!"Consider increasing MaxLoadedSources");
+#endif
+
+			return SourceHandle::Invalid;
+		}
+
 		template <typename T>
 		void CallbackClearOutBuffer(T* outputBuffer, const size_t sampleCount)
 		{
@@ -198,28 +311,27 @@ namespace Audio
 			return lerpVolume;
 		}
 
-		void CallbackApplyVoiceVolumeAndMixTempBufferIntoOutput(f32* outputBuffer, const i64 frameCount, const VoiceData& voiceData, const u32 sampleRate)
+		void CallbackApplyVoiceVolumeAndMixTempBufferIntoOutput(f32* outputBuffer, const i64 frameCount, VoiceData& voiceData, const u32 sampleRate)
 		{
 			const f32 voiceVolume = voiceData.Volume * GetSourceBaseVolume(voiceData.Source);
-			const f32 startVolume = voiceData.VolumeMap.StartVolume;
-			const f32 endVolume = voiceData.VolumeMap.EndVolume;
+			for (size_t attempt = 0; attempt < 4 && !voiceData.VolumeMap.TryLoad(voiceData.CallbackVolumeMap); attempt++)
+				continue;
+			const f32 startVolume = voiceData.CallbackVolumeMap.StartVolume;
+			const f32 endVolume = voiceData.CallbackVolumeMap.EndVolume;
 
 			// NOTE: currently pan as L/R balance rather than true stereo pan for simplicity
-			const b8 doPan = (OutputChannelCount >= 2) && !ApproxmiatelySame(voiceData.Pan, 0);
+			static_assert(OutputChannelCount == 2, "The mix kernels only handle interleaved stereo");
+			const b8 doPan = !ApproxmiatelySame(voiceData.Pan, 0);
 			const auto panGain = doPan ? GetPanGain(voiceData.Pan, PanLaw) : std::array{ 1.0f, 1.0f };
-			auto channelGain = [&](u32 iCh, f32 vol) { return (doPan && iCh < 2) ? vol * panGain[iCh] : vol; };
 
 			if (startVolume == endVolume)
 			{
-				for (i64 i = 0, n = (frameCount * OutputChannelCount); i < n;) {
-					for (u32 c = 0; c < OutputChannelCount; ++c, ++i)
-						outputBuffer[i] += TempOutputBuffer[i] * channelGain(c, voiceVolume);
-				}
+				Kernels.MixStereoI16WithConstantGain(outputBuffer, TempOutputBuffer.data(), static_cast<size_t>(frameCount), voiceVolume * panGain[0], voiceVolume * panGain[1]);
 			}
 			else
 			{
-				const i64 volumeMapStartFrame = voiceData.VolumeMap.StartFrame;
-				const i64 volumeMapEndFrame = voiceData.VolumeMap.EndFrame;
+				const i64 volumeMapStartFrame = voiceData.CallbackVolumeMap.StartFrame;
+				const i64 volumeMapEndFrame = voiceData.CallbackVolumeMap.EndFrame;
 
 				if (voiceData.Flags & VoiceFlags_VariablePlaybackSpeed)
 				{
@@ -227,109 +339,316 @@ namespace Audio
 					const Time bufferDuration = Time::FromSec(frameDuration.ToSec() * frameCount);
 					const Time voiceStartTime = Time::FromSec(voiceData.TimePositionSec) - bufferDuration;
 
-					for (i64 f = 0, i = 0; f < frameCount; ++f)
+					for (i64 f = 0; f < frameCount; ++f)
 					{
 						const Time frameTime = Time::FromSec(voiceStartTime.ToSec() + (f * frameDuration.ToSec()));
-						const f32 frameVolume = SampleVolumeMapAt(volumeMapStartFrame, volumeMapEndFrame, startVolume, endVolume, TimeToFrames(frameTime, sampleRate)) * voiceVolume;
-						for (u32 c = 0; c < OutputChannelCount; ++c, ++i)
-							outputBuffer[i] += TempOutputBuffer[i] * channelGain(c, frameVolume);
+						TempFrameGains[f] = SampleVolumeMapAt(volumeMapStartFrame, volumeMapEndFrame, startVolume, endVolume, TimeToFrames(frameTime, sampleRate)) * voiceVolume;
 					}
 				}
 				else
 				{
 					const i64 voiceStartFrame = (voiceData.FramePosition - frameCount);
 
-					for (i64 f = 0, i = 0; f < frameCount; ++f)
-					{
-						const f32 frameVolume = SampleVolumeMapAt(volumeMapStartFrame, volumeMapEndFrame, startVolume, endVolume, voiceStartFrame + f) * voiceVolume;
-						for (u32 c = 0; c < OutputChannelCount; ++c, ++i)
-							outputBuffer[i] += TempOutputBuffer[i] * channelGain(c, frameVolume);
-					}
+					for (i64 f = 0; f < frameCount; ++f)
+						TempFrameGains[f] = SampleVolumeMapAt(volumeMapStartFrame, volumeMapEndFrame, startVolume, endVolume, voiceStartFrame + f) * voiceVolume;
 				}
+
+				Kernels.MixStereoI16WithFrameGains(outputBuffer, TempOutputBuffer.data(), TempFrameGains.data(), static_cast<size_t>(frameCount), panGain[0], panGain[1]);
 			}
 		}
 
-		void CallbackProcessVoices(f32* outputBuffer, const u32 bufferFrameCount, const u32 bufferSampleCount, i32 soundGroup)
+		HandleBaseType TryClaimFreeVoiceSlot(b8 releaseDeadVoicesIfNoStream)
+		{
+			for (size_t attempt = 0; attempt < 2; attempt++)
+			{
+				for (HandleBaseType voiceIndex = 0; voiceIndex < static_cast<HandleBaseType>(VoicePool.size()); voiceIndex++)
+				{
+					bool expected = false;
+					if (VoicePool[voiceIndex].SlotClaimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+						return voiceIndex;
+				}
+
+				if (!releaseDeadVoicesIfNoStream || !TryReleaseDeadVoicesWithoutStream())
+					break;
+			}
+
+#if PEEPO_DEBUG
+			assert(!"Consider increasing MaxSimultaneousVoices");
+#endif
+			return VoiceHandleToIndex(VoiceHandle::Invalid);
+		}
+
+		// NOTE: Without a running stream there is no render callback to ever release the slots of removed voices.
+		//		 Instead they are released by whichever thread runs out of free slots first, while holding the lock that keeps the stream from being opened in the meantime
+		b8 TryReleaseDeadVoicesWithoutStream()
+		{
+			if (IsStreamOpenRunning)
+				return false;
+
+			const auto lock = std::scoped_lock(StreamStateMutex);
+			if (IsStreamOpenRunning)
+				return false;
+
+			CallbackConsumeAddedVoices();
+			CallbackReleaseDeadVoices();
+			return true;
+		}
+
+		HandleBaseType TryClaimVoiceSlot() { return TryClaimFreeVoiceSlot(true); }
+
+		void PushAddedVoice(HandleBaseType voiceIndex)
+		{
+			const auto lock = std::scoped_lock(AddedVoiceQueueProducerMutex);
+			const u32 writeIndex = AddedVoiceQueueWriteIndex.load(std::memory_order_relaxed);
+			assert((writeIndex - AddedVoiceQueueReadIndex.load(std::memory_order_acquire)) < AddedVoiceQueue.size());
+
+			AddedVoiceQueue[writeIndex % AddedVoiceQueue.size()] = voiceIndex;
+			AddedVoiceQueueWriteIndex.store(writeIndex + 1, std::memory_order_release);
+		}
+
+		void InitializeVoiceData(VoiceData& voiceToUpdate, VoiceFlags flags, SourceHandle source, std::string_view name, f32 volume, f32 pan, i32 soundGroup)
+		{
+			voiceToUpdate.Source = source;
+			voiceToUpdate.SoundGroup = soundGroup;
+			voiceToUpdate.Volume = volume;
+			voiceToUpdate.Pan = pan;
+			voiceToUpdate.FramePosition = 0;
+			voiceToUpdate.VolumeMap.Store(VoiceData::VoiceVolumeMap {});
+			voiceToUpdate.CallbackVolumeMap = VoiceData::VoiceVolumeMap {};
+			CopyStringViewIntoFixedBuffer(voiceToUpdate.Name, name);
+			voiceToUpdate.Flags = flags;
+		}
+
+		// NOTE: Only for the render callback itself, which can directly append to its own active list
+		VoiceData* CallbackTryAddOneShotVoiceData(SourceHandle source, std::string_view name, f32 volume, f32 pan, i32 soundGroup)
+		{
+			const HandleBaseType voiceIndex = TryClaimFreeVoiceSlot(false);
+			if (!InBounds(voiceIndex, VoicePool))
+				return nullptr;
+
+			InitializeVoiceData(VoicePool[voiceIndex], VoiceFlags_Alive | VoiceFlags_Playing | VoiceFlags_RemoveOnEnd, source, name, volume, pan, soundGroup);
+			ActiveVoiceIndices[ActiveVoiceCount++] = voiceIndex;
+			return &VoicePool[voiceIndex];
+		}
+
+		void CallbackConsumeAddedVoices()
+		{
+			const u32 writeIndex = AddedVoiceQueueWriteIndex.load(std::memory_order_acquire);
+			u32 readIndex = AddedVoiceQueueReadIndex.load(std::memory_order_relaxed);
+			for (; readIndex != writeIndex; readIndex++)
+				ActiveVoiceIndices[ActiveVoiceCount++] = AddedVoiceQueue[readIndex % AddedVoiceQueue.size()];
+			AddedVoiceQueueReadIndex.store(readIndex, std::memory_order_release);
+		}
+
+		// NOTE: Bounded so that a device that has stopped calling back (say after being unplugged) can't hang the caller
+		static constexpr Time MaxInFlightRenderCallbackWait = Time::FromMS(100.0);
+
+		void WaitForInFlightRenderCallback(u64 completedCallbackCount)
+		{
+			const CPUStopwatch stopwatch = CPUStopwatch::StartNew();
+			while (IsStreamOpenRunning && CompletedCallbackCount.load() == completedCallbackCount && stopwatch.GetElapsed() < MaxInFlightRenderCallbackWait)
+				std::this_thread::yield();
+		}
+
+		// NOTE: Frees the buffers of all unloaded sources that the render callback can no longer be reading from,
+		//		 either because a callback has completed since or because there is no stream (with the lock keeping it from being opened in the meantime)
+		void ReleaseRetiredSources()
 		{
-			const auto lock = std::scoped_lock(VoiceRenderMutex);
+			const auto lock = std::scoped_lock(StreamStateMutex);
+			const b8 noRenderCallback = !IsStreamOpenRunning;
+			const u64 completedCallbackCount = CompletedCallbackCount.load();
 
-			for (size_t voiceIndex = 0; voiceIndex < VoicePool.size(); voiceIndex++)
+			for (SourceData& sourceData : LoadedSources)
 			{
-				VoiceData& voiceData = VoicePool[voiceIndex];
-				if (i32 group = voiceData.SoundGroup; !(group == soundGroup || ((soundGroup == 0) && !(group >= 0 && group < MaxSoundGroups))))
+				const u64 retiredUntilCallbackCount = sourceData.RetiredUntilCallbackCount.load(std::memory_order_acquire);
+				if (retiredUntilCallbackCount == 0 || (!noRenderCallback && completedCallbackCount < retiredUntilCallbackCount))
 					continue;
-				if (!(voiceData.Flags & VoiceFlags_Alive))
-					continue;
-
-				// TODO: Handle sample rate mismatch (by always setting variable playback speed?)
-				SourceData* sourceData = TryGetSourceData(voiceData.Source, GetSourceDataParam::ValidateBuffer);
 
-				const b8 variablePlaybackSpeed = (voiceData.Flags & VoiceFlags_VariablePlaybackSpeed);
-				const b8 playPastEnd = (voiceData.Flags & VoiceFlags_PlayPastEnd);
-				b8 hasReachedEnd = (sourceData == nullptr) ? false :
-					(variablePlaybackSpeed ? (voiceData.TimePositionSec >= FramesToTime(sourceData->Buffer.FrameCount, sourceData->Buffer.SampleRate).ToSec()) :
-					(voiceData.FramePosition >= sourceData->Buffer.FrameCount));
+				sourceData.Buffer = PCMSampleBuffer {};
+				sourceData.ReadableFrameCount.store(0, std::memory_order_relaxed);
+				sourceData.RetiredUntilCallbackCount.store(0, std::memory_order_relaxed);
+				sourceData.SlotClaimed.store(false, std::memory_order_release);
+			}
+		}
 
-				if (sourceData == nullptr && (voiceData.Flags & VoiceFlags_RemoveOnEnd))
-					hasReachedEnd = true;
+		// NOTE: Sounds scheduled this far behind their clock voice (say after a stall or with a too short schedule-ahead time) are no longer worth playing
+		static constexpr Time MaxScheduledSoundLateness = Time::FromMS(250.0);
 
-				if (voiceData.SmoothTime.RequestUpdate.exchange(false))
-				{
-					voiceData.SmoothTime.BaseCPUTimeTicks = CPUTime::GetNow().Ticks;
-					voiceData.SmoothTime.BaseVoiceTimeSec =
-						variablePlaybackSpeed ? voiceData.TimePositionSec.load() :
-						FramesToTime(voiceData.FramePosition, (sourceData != nullptr) ? sourceData->Buffer.SampleRate : OutputSampleRate).ToSec();
-				}
+		void CallbackStartScheduledOneShotSounds(const u32 bufferFrameCount)
+		{
+			const u32 generation = ScheduledSoundGeneration.load(std::memory_order_acquire);
+			const u32 writeIndex = ScheduledSoundQueueWriteIndex.load(std::memory_order_acquire);
+			u32 readIndex = ScheduledSoundQueueReadIndex.load(std::memory_order_relaxed);
+			for (; readIndex != writeIndex; readIndex++)
+			{
+				const ScheduledOneShotSound& scheduled = ScheduledSoundQueue[readIndex % ScheduledSoundQueue.size()];
+				if (scheduled.Generation == generation && PendingScheduledSoundCount < PendingScheduledSounds.size())
+					PendingScheduledSounds[PendingScheduledSoundCount++] = scheduled;
+			}
+			ScheduledSoundQueueReadIndex.store(readIndex, std::memory_order_release);
 
-				if (voiceData.Flags & VoiceFlags_Playing)
-				{
-					if (variablePlaybackSpeed)
-						CallbackProcessVariableSpeedVoiceSamples(outputBuffer, bufferFrameCount, playPastEnd, hasReachedEnd, voiceData, sourceData);
-					else
-						CallbackProcessNormalSpeedVoiceSamples(outputBuffer, bufferFrameCount, playPastEnd, hasReachedEnd, voiceData, sourceData);
-				}
+			for (size_t i = 0; i < PendingScheduledSoundCount;)
+			{
+				const ScheduledOneShotSound& scheduled = PendingScheduledSounds[i];
+				const VoiceData* clockVoice = TryGetVoiceData(scheduled.ClockVoice);
 
-				if (hasReachedEnd)
+				b8 keepPending = false;
+				if (scheduled.Generation == generation && clockVoice != nullptr && (clockVoice->Flags & VoiceFlags_Playing))
 				{
-					if (!playPastEnd && (voiceData.Flags & VoiceFlags_RemoveOnEnd))
+					// NOTE: At this point no voice has been rendered yet, so the clock position corresponds to the first frame of the output buffer
+					//		 and advances by (playback speed / sample rate) per rendered frame, see CallbackProcessNormalSpeedVoiceSamples() and CallbackProcessVariableSpeedVoiceSamples()
+					const SourceData* clockSource = TryGetSourceData(clockVoice->Source, GetSourceDataParam::ValidateBuffer);
+					const u32 clockSampleRate = (clockSource != nullptr) ? clockSource->Buffer.SampleRate : OutputSampleRate;
+					const b8 clockVariableSpeed = (clockVoice->Flags & VoiceFlags_VariablePlaybackSpeed);
+					const f64 clockSpeed = clockVariableSpeed ? clockVoice->PlaybackSpeed.load() : 1.0;
+					const f64 clockPositionSec = clockVariableSpeed ? clockVoice->TimePositionSec.load() : FramesToTime(clockVoice->FramePosition, clockSampleRate).ToSec();
+
+					// NOTE: The output runs at the output sample rate whereas the clock position advances by (1 / source sample rate) per rendered frame,
+					//		 because sources aren't resampled by the engine itself. So converted to output time first, which is also what the lateness is measured in
+					const f64 clockSecPerOutputSec = clockSpeed * (static_cast<f64>(OutputSampleRate) / static_cast<f64>(clockSampleRate));
+					const f64 secUntilStart = (scheduled.ClockVoicePositionSec - clockPositionSec) / clockSecPerOutputSec;
+					const i64 framesUntilStart = static_cast<i64>(Round(secUntilStart * static_cast<f64>(OutputSampleRate)));
+
+					if (framesUntilStart >= static_cast<i64>(bufferFrameCount))
 					{
-						voiceData.Flags = VoiceFlags_Dead;
-						continue;
+						keepPending = true;
 					}
-					else if (voiceData.Flags & VoiceFlags_PauseOnEnd)
+					else if (secUntilStart >= -MaxScheduledSoundLateness.ToSec())
 					{
-						voiceData.Flags &= ~VoiceFlags_Playing;
-						continue;
+						// NOTE: Starting at a negative frame position to fill the frames before the exact start offset with silence
+						if (VoiceData* voiceData = CallbackTryAddOneShotVoiceData(scheduled.Source, GetSourceName(scheduled.Source), scheduled.Volume, scheduled.Pan, scheduled.SoundGroup); voiceData != nullptr)
+							voiceData->FramePosition = -Max<i64>(framesUntilStart, 0);
 					}
 				}
+				else if (scheduled.Generation == generation && clockVoice != nullptr)
+				{
+					keepPending = true;
+				}
+
+				if (keepPending)
+					i++;
+				else
+					PendingScheduledSounds[i] = PendingScheduledSounds[--PendingScheduledSoundCount];
 			}
+		}
 
-			if (soundGroup == 0)
-				TotalRenderedFrames += bufferFrameCount;
+		void CallbackReleaseDeadVoices()
+		{
+			size_t activeVoicesKept = 0;
+			for (size_t activeIndex = 0; activeIndex < ActiveVoiceCount; activeIndex++)
+			{
+				const HandleBaseType voiceIndex = ActiveVoiceIndices[activeIndex];
+				if (VoicePool[voiceIndex].Flags & VoiceFlags_Alive)
+					ActiveVoiceIndices[activeVoicesKept++] = voiceIndex;
+				else
+					VoicePool[voiceIndex].SlotClaimed.store(false, std::memory_order_release);
+			}
+			ActiveVoiceCount = activeVoicesKept;
 		}
 
-		void CallbackProcessNormalSpeedVoiceSamples(f32* outputBuffer, const u32 bufferFrameCount, const b8 playPastEnd, const b8 hasReachedEnd, VoiceData& voiceData, SourceData* sourceData)
+		// NOTE: Renders all active voices in a single pass, each into the buffer of its own sound group
+		//		 with sound group 0 (or any invalid group) rendering directly to master
+		void CallbackProcessVoices(const u32 bufferFrameCount)
 		{
-			if (sourceData == nullptr)
+			size_t activeVoicesKept = 0;
+			for (size_t activeIndex = 0; activeIndex < ActiveVoiceCount; activeIndex++)
 			{
-				voiceData.FramePosition += bufferFrameCount;
-				return;
+				const HandleBaseType voiceIndex = ActiveVoiceIndices[activeIndex];
+				VoiceData& voiceData = VoicePool[voiceIndex];
+				if (voiceData.Flags & VoiceFlags_Alive)
+					CallbackProcessVoice(bufferFrameCount, voiceData);
+
+				// NOTE: Compacting while preserving the order the voices are mixed in
+				if (voiceData.Flags & VoiceFlags_Alive)
+					ActiveVoiceIndices[activeVoicesKept++] = voiceIndex;
+				else
+					voiceData.SlotClaimed.store(false, std::memory_order_release);
+			}
+			ActiveVoiceCount = activeVoicesKept;
+
+			TotalRenderedFrames += bufferFrameCount;
+		}
+
+		void CallbackProcessVoice(const u32 bufferFrameCount, VoiceData& voiceData)
+		{
+			const i32 group = voiceData.SoundGroup;
+			f32* outputBuffer = (group > 0 && group < MaxSoundGroups) ? SoundGroupBuffers[group].data() : MasterBuffer.data();
+
+			// TODO: Handle sample rate mismatch (by always setting variable playback speed?)
+			SourceData* sourceData = TryGetSourceData(voiceData.Source, GetSourceDataParam::ValidateBuffer);
+
+			// NOTE: Other threads can change the voice at any point during rendering, so everything is based on the state at the start
+			//		 with the updated position and flags only written back if they haven't been changed in the meantime
+			const VoiceFlags startFlags = voiceData.Flags;
+			const i64 startFramePosition = voiceData.FramePosition;
+			const f64 startTimePositionSec = voiceData.TimePositionSec;
+
+			const b8 variablePlaybackSpeed = (startFlags & VoiceFlags_VariablePlaybackSpeed);
+			const b8 playPastEnd = (startFlags & VoiceFlags_PlayPastEnd);
+			b8 hasReachedEnd = (sourceData == nullptr) ? false :
+				(variablePlaybackSpeed ? (startTimePositionSec >= FramesToTime(sourceData->Buffer.FrameCount, sourceData->Buffer.SampleRate).ToSec()) :
+				(startFramePosition >= sourceData->Buffer.FrameCount));
+
+			if (sourceData == nullptr && (startFlags & VoiceFlags_RemoveOnEnd))
+				hasReachedEnd = true;
+
+			if (voiceData.SmoothTime.RequestUpdate.exchange(false))
+			{
+				voiceData.SmoothTime.BaseCPUTimeTicks = CPUTime::GetNow().Ticks;
+				voiceData.SmoothTime.BaseVoiceTimeSec =
+					variablePlaybackSpeed ? voiceData.TimePositionSec.load() :
+					FramesToTime(voiceData.FramePosition, (sourceData != nullptr) ? sourceData->Buffer.SampleRate : OutputSampleRate).ToSec();
 			}
 
+			b8 positionUnchangedByOtherThread;
+			if (startFlags & VoiceFlags_Playing)
+			{
+				if (variablePlaybackSpeed)
+					positionUnchangedByOtherThread = CallbackProcessVariableSpeedVoiceSamples(outputBuffer, bufferFrameCount, playPastEnd, hasReachedEnd, startTimePositionSec, voiceData, sourceData);
+				else
+					positionUnchangedByOtherThread = CallbackProcessNormalSpeedVoiceSamples(outputBuffer, bufferFrameCount, playPastEnd, hasReachedEnd, startFramePosition, voiceData, sourceData);
+			}
+			else
+			{
+				positionUnchangedByOtherThread = variablePlaybackSpeed ? (voiceData.TimePositionSec == startTimePositionSec) : (voiceData.FramePosition == startFramePosition);
+			}
+
+			// NOTE: A voice restarted by another thread while being rendered (say a pooled voice reused by SoundEffectsVoicePool::PlaySound()) must not be
+			//		 paused or removed for having reached the end of its previous position. This used to be prevented by Voice::SetIsPlaying() locking the entire render
+			//		 (which left the same race for every other setter), where any such change now makes the compare exchange fail until the next callback sees the new state
+			if (hasReachedEnd && positionUnchangedByOtherThread)
+			{
+				VoiceFlags expectedFlags = startFlags;
+				if (!playPastEnd && (startFlags & VoiceFlags_RemoveOnEnd))
+					voiceData.Flags.compare_exchange_strong(expectedFlags, VoiceFlags_Dead);
+				else if (startFlags & VoiceFlags_PauseOnEnd)
+					voiceData.Flags.compare_exchange_strong(expectedFlags, static_cast<VoiceFlags>(startFlags & ~VoiceFlags_Playing));
+			}
+		}
+
+		// NOTE: Returns false if the position has been changed by another thread in the meantime, in which case that new position is kept
+		b8 CallbackProcessNormalSpeedVoiceSamples(f32* outputBuffer, const u32 bufferFrameCount, const b8 playPastEnd, const b8 hasReachedEnd, i64 startFramePosition, VoiceData& voiceData, SourceData* sourceData)
+		{
+			if (sourceData == nullptr)
+				return voiceData.FramePosition.compare_exchange_strong(startFramePosition, startFramePosition + bufferFrameCount);
+
+			const i64 readableFrameCount = sourceData->ReadableFrameCount.load(std::memory_order_acquire);
 			i64 framesRead = 0;
 			if (sourceData->Buffer.ChannelCount != 0 && sourceData->Buffer.ChannelCount != OutputChannelCount)
-				framesRead = ChannelMixer.MixChannels(sourceData->Buffer, TempOutputBuffer.data(), voiceData.FramePosition, bufferFrameCount);
+				framesRead = ChannelMixer.MixChannels(sourceData->Buffer, TempOutputBuffer.data(), startFramePosition, bufferFrameCount, readableFrameCount);
 			else
-				framesRead = sourceData->Buffer.ReadAtOrFillSilence(voiceData.FramePosition, bufferFrameCount, TempOutputBuffer.data());
+				framesRead = sourceData->Buffer.ReadAtOrFillSilence(startFramePosition, bufferFrameCount, TempOutputBuffer.data(), readableFrameCount);
 
-			voiceData.FramePosition += framesRead;
+			i64 newFramePosition = (startFramePosition + framesRead);
 			if (hasReachedEnd && !playPastEnd)
-				voiceData.FramePosition = (voiceData.Flags & VoiceFlags_Looping) ? 0 : sourceData->Buffer.FrameCount;
+				newFramePosition = (voiceData.Flags & VoiceFlags_Looping) ? 0 : sourceData->Buffer.FrameCount;
+			const b8 positionUnchangedByOtherThread = voiceData.FramePosition.compare_exchange_strong(startFramePosition, newFramePosition);
 
 			CallbackApplyVoiceVolumeAndMixTempBufferIntoOutput(outputBuffer, framesRead, voiceData, sourceData->Buffer.SampleRate);
+			return positionUnchangedByOtherThread;
 		}
 
-		void CallbackProcessVariableSpeedVoiceSamples(f32* outputBuffer, const u32 bufferFrameCount, const b8 playPastEnd, const b8 hasReachedEnd, VoiceData& voiceData, SourceData* sourceData)
+		b8 CallbackProcessVariableSpeedVoiceSamples(f32* outputBuffer, const u32 bufferFrameCount, const b8 playPastEnd, const b8 hasReachedEnd, f64 startTimePositionSec, VoiceData& voiceData, SourceData* sourceData)
 		{
 			const u32 sampleRate = (sourceData != nullptr) ? sourceData->Buffer.SampleRate : OutputSampleRate;
 			const f64 bufferDurationSec = (FramesToTime(bufferFrameCount, sampleRate).ToSec() * voiceData.PlaybackSpeed);
@@ -337,19 +656,16 @@ namespace Audio
 			const i16* rawSamples = (sourceData != nullptr) ? sourceData->Buffer.InterleavedSamples.get() : nullptr;
 
 			if (sourceData == nullptr || rawSamples == nullptr)
-			{
-				voiceData.TimePositionSec = voiceData.TimePositionSec + bufferDurationSec;
-				return;
-			}
+				return voiceData.TimePositionSec.compare_exchange_strong(startTimePositionSec, startTimePositionSec + bufferDurationSec);
 
 			const f64 sampleDurationSec = (1.0 / static_cast<i64>(sampleRate)) * voiceData.PlaybackSpeed;
 			const i64 framesRead = static_cast<i64>(Round(bufferDurationSec / sampleDurationSec));
 
-			const size_t providerSampleCount = sourceData->Buffer.SampleCount();
 			const u32 providerChannelCount = sourceData->Buffer.ChannelCount;
+			const size_t providerSampleCount = static_cast<size_t>(Min(sourceData->Buffer.FrameCount, sourceData->ReadableFrameCount.load(std::memory_order_acquire)) * providerChannelCount);
 
 			const f64 sampleRateF64 = static_cast<f64>(sampleRate);
-			const f64 voiceStartTimeSec = voiceData.TimePositionSec;
+			const f64 voiceStartTimeSec = startTimePositionSec;
 
 			if (providerChannelCount != OutputChannelCount)
 			{
@@ -374,11 +690,13 @@ namespace Audio
 				}
 			}
 
-			voiceData.TimePositionSec = voiceData.TimePositionSec + bufferDurationSec;
+			f64 newTimePositionSec = (startTimePositionSec + bufferDurationSec);
 			if (hasReachedEnd && !playPastEnd)
-				voiceData.TimePositionSec = (voiceData.Flags & VoiceFlags_Looping) ? 0.0 : FramesToTime(sourceData->Buffer.FrameCount, sampleRate).ToSec();
+				newTimePositionSec = (voiceData.Flags & VoiceFlags_Looping) ? 0.0 : FramesToTime(sourceData->Buffer.FrameCount, sampleRate).ToSec();
+			const b8 positionUnchangedByOtherThread = voiceData.TimePositionSec.compare_exchange_strong(startTimePositionSec, newTimePositionSec);
 
 			CallbackApplyVoiceVolumeAndMixTempBufferIntoOutput(outputBuffer, framesRead, voiceData, sampleRate);
+			return positionUnchangedByOtherThread;
 		}
 
 		template <typename T>
@@ -386,24 +704,21 @@ namespace Audio
 		{
 			const f32 limitMin = (std::is_integral_v<T> || soundGroup == 0) ? I16Min : SoundGroupVolumeLimit * I16Min;
 			const f32 limitMax = (std::is_integral_v<T> || soundGroup == 0) ? I16Max : SoundGroupVolumeLimit * I16Max;
-			std::array<f32, OutputChannelCount> frame;
-			for (size_t f = 0, i = 0; f < frameCount; ++f) {
-				// get gain for all channels first
+			// NOTE: The limiter envelope depends on the previous frame so the gain for all frames is computed serially first
+			for (size_t f = 0, i = 0; f < frameCount; ++f, i += OutputChannelCount) {
 				f32 frameMaxValue = 0;
 				for (i32 c = 0; c < OutputChannelCount; ++c) {
-					frame[c] = mixedBuffer[i + c] * preGain;
-					if (std::abs(frame[c]) > std::abs(frameMaxValue))
-						frameMaxValue = frame[c];
-				}
-				auto gain = Limiter[soundGroup].GetGain(frameMaxValue, limitMin, limitMax);
-				// apply gain
-				for (i32 c = 0; c < OutputChannelCount; ++c, ++i) {
-					if constexpr (std::is_integral_v<T>)
-						outputBuffer[i] += ClampSampleI<T>(frame[c] * gain * postGain);
-					else
-						outputBuffer[i] += frame[c] * gain * postGain;
+					const f32 frameValue = mixedBuffer[i + c] * preGain;
+					if (std::abs(frameValue) > std::abs(frameMaxValue))
+						frameMaxValue = frameValue;
 				}
+				TempFrameGains[f] = Limiter[soundGroup].GetGain(frameMaxValue, limitMin, limitMax);
 			}
+			// apply gain
+			if constexpr (std::is_same_v<T, i16>)
+				Kernels.MixStereoF32IntoI16Clamped(outputBuffer, mixedBuffer, TempFrameGains.data(), frameCount, preGain, postGain);
+			else
+				Kernels.MixStereoF32IntoF32(outputBuffer, mixedBuffer, TempFrameGains.data(), frameCount, preGain, postGain);
 		}
 
 		void CallbackUpdateLastPlayedSamplesRingBuffer(i16* outputBuffer, const size_t frameCount)
@@ -459,19 +774,21 @@ namespace Audio
 
 			CallbackClearOutBuffer(outputBuffer, bufferSampleCount);
 			CallbackClearOutBuffer(MasterBuffer.data(), bufferSampleCount);
+			for (i32 g = 1; g < MaxSoundGroups; ++g)
+				CallbackClearOutBuffer(SoundGroupBuffers[g].data(), bufferSampleCount);
 
-			// render each sound group separately, adjust volume, and then to master (except group 0)
-			for (i32 g = 1; g < MaxSoundGroups; ++g) {
-				CallbackClearOutBuffer(SoundGroupBuffer.data(), bufferSampleCount);
-				CallbackProcessVoices(SoundGroupBuffer.data(), bufferFrameCount, bufferSampleCount, g);
-				CallbackAdjustVolumeAndMix(MasterBuffer.data(), SoundGroupBuffer.data(), bufferFrameCount, 1, SoundGroupVolume[g], g);
-			}
+			CallbackConsumeAddedVoices();
+			CallbackStartScheduledOneShotSounds(bufferFrameCount);
+			CallbackProcessVoices(bufferFrameCount);
+
+			// adjust the volume of each sound group separately and then mix them to master (except group 0)
+			for (i32 g = 1; g < MaxSoundGroups; ++g)
+				CallbackAdjustVolumeAndMix(MasterBuffer.data(), SoundGroupBuffers[g].data(), bufferFrameCount, 1, SoundGroupVolume[g], g);
 
-			// sound group 0 (or any invalid group) renders directly to master
-			CallbackProcessVoices(MasterBuffer.data(), bufferFrameCount, bufferSampleCount, 0);
 			CallbackAdjustVolumeAndMix(outputBuffer, MasterBuffer.data(), bufferFrameCount, SoundGroupVolume[0], 1, 0);
 			CallbackUpdateLastPlayedSamplesRingBuffer(outputBuffer, bufferFrameCount);
 			CallbackUpdateCallbackDurationRingBuffer(stopwatch.Stop());
+			CompletedCallbackCount.fetch_add(1, std::memory_order_release);
 		}
 	};
 
@@ -506,6 +823,7 @@ namespace Audio
 
 	void AudioEngine::OpenStartStream()
 	{
+		const auto lock = std::scoped_lock(impl->StreamStateMutex);
 		if (impl->IsStreamOpenRunning)
 			return;
 
@@ -523,29 +841,37 @@ namespace Audio
 
 		impl->OnOpenStream();
 
+		// NOTE: Restarted before the render callback can first be called and read it
+		impl->StreamTimeStopwatch.Restart();
 		const b8 openStreamSuccess = impl->CurrentBackend->OpenStartStream(streamParam, [this](i16* outputBuffer, const u32 bufferFrameCount, const u32 bufferChannelCount)
 		{
 			impl->RenderAudioCallback(outputBuffer, bufferFrameCount, bufferChannelCount);
 		});
 
-		if (openStreamSuccess)
-			impl->StreamTimeStopwatch.Restart();
+		if (!openStreamSuccess)
+			impl->StreamTimeStopwatch.Stop();
 
 		impl->IsStreamOpenRunning = openStreamSuccess;
 	}
 
 	void AudioEngine::StopCloseStream()
 	{
-		if (!impl->IsStreamOpenRunning)
-			return;
+		{
+			const auto lock = std::scoped_lock(impl->StreamStateMutex);
+			if (!impl->IsStreamOpenRunning)
+				return;
+
+			if (impl->CurrentBackend != nullptr)
+				impl->CurrentBackend->StopCloseStream();
 
-		if (impl->CurrentBackend != nullptr)
-			impl->CurrentBackend->StopCloseStream();
+			impl->OnCloseStream();
+			impl->StreamTimeStopwatch.Stop();
 
-		impl->OnCloseStream();
-		impl->StreamTimeStopwatch.Stop();
+			impl->IsStreamOpenRunning = false;
+		}
 
-		impl->IsStreamOpenRunning = false;
+		// NOTE: Including those that were still waiting on a device that had stopped calling back
+		impl->ReleaseRetiredSources();
 	}
 
 	void AudioEngine::EnsureStreamRunning()
@@ -571,8 +897,9 @@ namespace Audio
 
 	SourceHandle AudioEngine::LoadSourceFromFileSync(std::string_view filePath)
 	{
-		auto[fileContent, fileSize] = File::ReadAllBytes(filePath);
-		return LoadSourceFromFileContentSync(Path::GetFileName(filePath), fileContent.get(), fileSize);
+		File::MappedView fileView;
+		fileView.Open(filePath);
+		return LoadSourceFromFileContentSync(Path::GetFileName(filePath), fileView.Data(), fileView.Size());
 	}
 
 	SourceHandle AudioEngine::LoadSourceFromFileContentSync(std::string_view fileName, const void* fileContent, size_t fileSize)
@@ -586,27 +913,25 @@ namespace Audio
 
 	SourceHandle AudioEngine::LoadSourceFromBufferMove(std::string_view sourceName, PCMSampleBuffer bufferToMove)
 	{
-		const auto lock = std::scoped_lock(impl->VoiceRenderMutex);
-		for (HandleBaseType index = 0; index < static_cast<HandleBaseType>(impl->LoadedSources.size()); index++)
-		{
-			const SourceHandle handleIt = IndexToSourceHandle(index);
-			SourceData& sourceData = impl->LoadedSources[index];
-			if (sourceData.SlotUsed)
-				continue;
-
-			sourceData.SlotUsed = true;
-			sourceData.Buffer = std::move(bufferToMove);
-			sourceData.BaseVolume = 1.0f;
-			CopyStringViewIntoFixedBuffer(sourceData.Name, sourceName);
+		const i64 readableFrameCount = bufferToMove.FrameCount;
+		return impl->LoadSourceFromBufferMove(sourceName, std::move(bufferToMove), readableFrameCount);
+	}
 
-			return static_cast<SourceHandle>(index);
-		}
+	SourceHandle AudioEngine::LoadStreamingSourceFromBufferMove(std::string_view sourceName, PCMSampleBuffer bufferToMove)
+	{
+		return impl->LoadSourceFromBufferMove(sourceName, std::move(bufferToMove), 0);
+	}
 
-#if PEEPO_DEBUG
-		assert(!"Consider increasing MaxLoadedSources");
-#endif
+	void AudioEngine::PublishStreamingSourceFrames(SourceHandle source, i64 readableFrameCount)
+	{
+		if (SourceData* sourceData = impl->TryGetSourceData(source, Impl::GetSourceDataParam::None); sourceData != nullptr)
+			sourceData->ReadableFrameCount.store(Clamp<i64>(readableFrameCount, 0, sourceData->Buffer.FrameCount), std::memory_order_release);
+	}
 
-		return SourceHandle::Invalid;
+	i64 AudioEngine::GetSourceReadableFrameCount(SourceHandle source)
+	{
+		const SourceData* sourceData = impl->TryGetSourceData(source, Impl::GetSourceDataParam::None);
+		return (sourceData != nullptr) ? sourceData->ReadableFrameCount.load(std::memory_order_acquire) : 0;
 	}
 
 	void AudioEngine::UnloadSource(SourceHandle source)
@@ -614,7 +939,6 @@ namespace Audio
 		if (source == SourceHandle::Invalid)
 			return;
 
-		const auto lock = std::scoped_lock(impl->VoiceRenderMutex);
 		SourceData* sourceData = impl->TryGetSourceData(source, Impl::GetSourceDataParam::None);
 		if (sourceData == nullptr)
 			return;
@@ -625,6 +949,13 @@ namespace Audio
 			if ((voice.Flags & VoiceFlags_Alive) && voice.Source == source)
 				voice.Source = SourceHandle::Invalid;
 		}
+
+		// NOTE: The render callback never waits on anyone so instead the buffer is only freed once it can no longer be reading it.
+		//		 Usually that's right after waiting for the in-flight callback, otherwise the slot stays retired until a later unload or load releases it
+		const u64 completedCallbackCount = impl->CompletedCallbackCount.load();
+		sourceData->RetiredUntilCallbackCount.store(completedCallbackCount + 1, std::memory_order_release);
+		impl->WaitForInFlightRenderCallback(completedCallbackCount);
+		impl->ReleaseRetiredSources();
 	}
 
 	const PCMSampleBuffer* AudioEngine::GetSourceSampleBufferView(SourceHandle source)
@@ -655,35 +986,17 @@ namespace Audio
 
 	VoiceHandle AudioEngine::AddVoice(SourceHandle source, std::string_view name, b8 playing, f32 volume, f32 pan, b8 playPastEnd, i32 soundGroup)
 	{
-		const auto lock = std::scoped_lock(impl->VoiceRenderMutex);
+		const HandleBaseType voiceIndex = impl->TryClaimVoiceSlot();
+		if (!InBounds(voiceIndex, impl->VoicePool))
+			return VoiceHandle::Invalid;
 
-		for (size_t i = 0; i < impl->VoicePool.size(); i++)
-		{
-			VoiceData& voiceToUpdate = impl->VoicePool[i];
-			if (voiceToUpdate.Flags & VoiceFlags_Alive)
-				continue;
-
-			voiceToUpdate.Flags = VoiceFlags_Alive;
-			if (playing) voiceToUpdate.Flags |= VoiceFlags_Playing;
-			if (playPastEnd) voiceToUpdate.Flags |= VoiceFlags_PlayPastEnd;
-
-			voiceToUpdate.Source = source;
-			voiceToUpdate.SoundGroup = soundGroup;
-			voiceToUpdate.Volume = volume;
-			voiceToUpdate.Pan = pan;
-			voiceToUpdate.FramePosition = 0;
-			voiceToUpdate.VolumeMap.StartVolume = 0.0f;
-			voiceToUpdate.VolumeMap.EndVolume = 0.0f;
-			CopyStringViewIntoFixedBuffer(voiceToUpdate.Name, name);
+		VoiceFlags flags = VoiceFlags_Alive;
+		if (playing) flags |= VoiceFlags_Playing;
+		if (playPastEnd) flags |= VoiceFlags_PlayPastEnd;
 
-			return static_cast<VoiceHandle>(i);
-		}
-
-#if PEEPO_DEBUG
-		assert(!"Consider increasing MaxSimultaneousVoices");
-#endif
-
-		return VoiceHandle::Invalid;
+		impl->InitializeVoiceData(impl->VoicePool[voiceIndex], flags, source, name, volume, pan, soundGroup);
+		impl->PushAddedVoice(voiceIndex);
+		return IndexToVoiceHandle(voiceIndex);
 	}
 
 	void AudioEngine::RemoveVoice(VoiceHandle voice)
@@ -691,9 +1004,7 @@ namespace Audio
 		if (voice == VoiceHandle::Invalid)
 			return;
 
-		// TODO: Think these locks through again
-		const auto lock = std::scoped_lock(impl->VoiceRenderMutex);
-
+		// NOTE: The slot itself is released by the render callback
 		VoiceData* voiceData = impl->TryGetVoiceData(voice);
 		if (voiceData != nullptr)
 			voiceData->Flags = VoiceFlags_Dead;
@@ -704,24 +1015,41 @@ namespace Audio
 		if (source == SourceHandle::Invalid)
 			return;
 
-		const auto lock = std::scoped_lock(impl->VoiceRenderMutex);
+		const HandleBaseType voiceIndex = impl->TryClaimVoiceSlot();
+		if (!InBounds(voiceIndex, impl->VoicePool))
+			return;
 
-		for (VoiceData& voiceToUpdate : impl->VoicePool)
-		{
-			if (voiceToUpdate.Flags & VoiceFlags_Alive)
-				continue;
+		impl->InitializeVoiceData(impl->VoicePool[voiceIndex], VoiceFlags_Alive | VoiceFlags_Playing | VoiceFlags_RemoveOnEnd, source, name, volume, pan, soundGroup);
+		impl->PushAddedVoice(voiceIndex);
+	}
 
-			voiceToUpdate.Flags = VoiceFlags_Alive | VoiceFlags_Playing | VoiceFlags_RemoveOnEnd;
-			voiceToUpdate.Source = source;
-			voiceToUpdate.SoundGroup = soundGroup;
-			voiceToUpdate.Volume = volume;
-			voiceToUpdate.Pan = pan;
-			voiceToUpdate.FramePosition = 0;
-			voiceToUpdate.VolumeMap.StartVolume = 0.0f;
-			voiceToUpdate.VolumeMap.EndVolume = 0.0f;
-			CopyStringViewIntoFixedBuffer(voiceToUpdate.Name, name);
+	void AudioEngine::ScheduleOneShotSound(SourceHandle source, VoiceHandle clockVoice, Time clockVoicePosition, f32 volume, f32 pan, i32 soundGroup)
+	{
+		if (source == SourceHandle::Invalid || clockVoice == VoiceHandle::Invalid)
+			return;
+
+		const u32 writeIndex = impl->ScheduledSoundQueueWriteIndex.load(std::memory_order_relaxed);
+		const u32 readIndex = impl->ScheduledSoundQueueReadIndex.load(std::memory_order_acquire);
+		if ((writeIndex - readIndex) >= impl->ScheduledSoundQueue.size())
+		{
+#if PEEPO_DEBUG
+			assert(!"Consider increasing MaxScheduledOneShotSounds");
+#endif
 			return;
 		}
+
+		impl->ScheduledSoundQueue[writeIndex % impl->ScheduledSoundQueue.size()] = ScheduledOneShotSound { source, clockVoice, soundGroup, volume, pan, clockVoicePosition.ToSec(), impl->ScheduledSoundGeneration.load(std::memory_order_relaxed) };
+		impl->ScheduledSoundQueueWriteIndex.store(writeIndex + 1, std::memory_order_release);
+	}
+
+	void AudioEngine::ClearScheduledOneShotSounds()
+	{
+		impl->ScheduledSoundGeneration.fetch_add(1, std::memory_order_release);
+	}
+
+	u32 AudioEngine::GetScheduledOneShotSoundGeneration() const
+	{
+		return impl->ScheduledSoundGeneration.load(std::memory_order_relaxed);
 	}
 
 	Backend AudioEngine::GetBackend() const
@@ -805,6 +1133,21 @@ namespace Audio
 		return impl->ChannelMixer;
 	}
 
+	b8 AudioEngine::DebugRenderWithoutStream(i16* outputBuffer, u32 frameCount)
+	{
+		const auto lock = std::scoped_lock(impl->StreamStateMutex);
+		if (impl->IsStreamOpenRunning)
+			return false;
+
+		for (u32 framesRendered = 0; framesRendered < frameCount;)
+		{
+			const u32 bufferFrameCount = Min<u32>(frameCount - framesRendered, impl->TargetBufferFrameSize);
+			impl->RenderAudioCallback(outputBuffer + (framesRendered * OutputChannelCount), bufferFrameCount, OutputChannelCount);
+			framesRendered += bufferFrameCount;
+		}
+		return true;
+	}
+
 	i64 AudioEngine::DebugGetTotalRenderedFrames() const
 	{
 		return impl->TotalRenderedFrames;
@@ -834,6 +1177,16 @@ namespace Audio
 		return out;
 	}
 
+	AudioEngine::DebugClaimedSlotCounts AudioEngine::DebugGetClaimedSlotCounts()
+	{
+		DebugClaimedSlotCounts out = {};
+		for (const VoiceData& voice : impl->VoicePool)
+			out.Voices += voice.SlotClaimed;
+		for (const SourceData& source : impl->LoadedSources)
+			out.Sources += source.SlotClaimed;
+		return out;
+	}
+
 	i32 AudioEngine::DebugGetSourceVoiceInstanceCount(SourceHandle source)
 	{
 		if (impl->TryGetSourceData(source, Impl::GetSourceDataParam::None) == nullptr)
@@ -1010,12 +1363,7 @@ namespace Audio
 
 	void Voice::SetIsPlaying(b8 value)
 	{
-		// TODO: Allow manual render thread locking from outside code to then be used for playback sounds
-		//		 This should then become lockfree again!
-
-		// HACK: Prevent randomly "stacking" playback button sounds... need to find a better solution, definitely don't want any locks like this
-		const auto lock = std::scoped_lock(Engine.impl->VoiceRenderMutex);
-
+		// NOTE: Restarting a voice while it's being rendered is handled by the render callback itself, see CallbackProcessVoice()
 		SetInternalFlag(VoiceFlags_Playing, value);
 	}
 
@@ -1072,10 +1420,7 @@ namespace Audio
 	{
 		if (VoiceData* voice = Engine.impl->TryGetVoiceData(Handle); voice != nullptr)
 		{
-			voice->VolumeMap.StartFrame = 0;
-			voice->VolumeMap.EndFrame = 0;
-			voice->VolumeMap.StartVolume = 0.0f;
-			voice->VolumeMap.EndVolume = 0.0f;
+			voice->VolumeMap.Store(VoiceData::VoiceVolumeMap {});
 		}
 	}
 
@@ -1088,10 +1433,7 @@ namespace Audio
 			const SourceData* source = impl->TryGetSourceData(voice->Source, AudioEngine::Impl::GetSourceDataParam::ValidateBuffer);
 			const u32 sampleRate = (source != nullptr) ? source->Buffer.SampleRate : AudioEngine::OutputSampleRate;
 
-			voice->VolumeMap.StartFrame = TimeToFrames(startTime, sampleRate);
-			voice->VolumeMap.EndFrame = TimeToFrames(endTime, sampleRate);
-			voice->VolumeMap.StartVolume = startVolume;
-			voice->VolumeMap.EndVolume = endVolume;
+			voice->VolumeMap.Store(VoiceData::VoiceVolumeMap { TimeToFrames(startTime, sampleRate), TimeToFrames(endTime, sampleRate), startVolume, endVolume });
 		}
 	}
 
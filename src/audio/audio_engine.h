@@ -131,6 +131,7 @@ namespace Audio
 		static constexpr size_t MaxSoundGroups = 3;
 		static constexpr size_t MaxSimultaneousVoices = 128;
 		static constexpr size_t MaxLoadedSources = 256;
+		static constexpr size_t MaxScheduledOneShotSounds = 1024;
 
 		static constexpr u32 OutputChannelCount = 2;
 		static constexpr u32 OutputSampleRate = 44100;
@@ -163,6 +164,13 @@ namespace Audio
 		SourceHandle LoadSourceFromBufferMove(std::string_view sourceName, PCMSampleBuffer bufferToMove);
 		void UnloadSource(SourceHandle source);
 
+		// NOTE: For progressively decoded sources which can already be played while the rest of their buffer is still being written.
+		//		 The (single) producer keeps writing through its own pointer to the moved samples and publishes them as it goes,
+		//		 with the render callback treating everything past the published frames as silence. It has to be done writing before the source is unloaded
+		SourceHandle LoadStreamingSourceFromBufferMove(std::string_view sourceName, PCMSampleBuffer bufferToMove);
+		void PublishStreamingSourceFrames(SourceHandle source, i64 readableFrameCount);
+		i64 GetSourceReadableFrameCount(SourceHandle source);
+
 		const PCMSampleBuffer* GetSourceSampleBufferView(SourceHandle source);
 
 		f32 GetSourceBaseVolume(SourceHandle source);
@@ -178,6 +186,16 @@ namespace Audio
 		// NOTE: Add a voice, play it once then discard
 		void PlayOneShotSound(SourceHandle source, std::string_view name, f32 volume = MaxVolume, f32 pan = 0, i32 soundGroup = 0);
 
+		// NOTE: Same as PlayOneShotSound() but only started by the render callback at the exact sample the (playing) clock voice reaches the given position.
+		//		 Queued lock-free so it must only ever be called from a single thread
+		void ScheduleOneShotSound(SourceHandle source, VoiceHandle clockVoice, Time clockVoicePosition, f32 volume = MaxVolume, f32 pan = 0, i32 soundGroup = 0);
+
+		// NOTE: Discard all scheduled one shot sounds that haven't been started yet, for when their clock voice has been paused or seeked
+		void ClearScheduledOneShotSounds();
+
+		// NOTE: Incremented by every ClearScheduledOneShotSounds() call, so that the scheduling thread can tell when it has to start over
+		u32 GetScheduledOneShotSoundGeneration() const;
+
 	public:
 		Backend GetBackend() const;
 		void SetBackend(Backend value);
@@ -198,12 +216,20 @@ namespace Audio
 		ChannelMixer& GetChannelMixer();
 
 	public:
+		// NOTE: Runs the render callback on the calling thread in buffers of the target buffer size, only while no stream is open.
+		//		 For deterministic offline tests, returns false without rendering anything if the stream is open
+		b8 DebugRenderWithoutStream(i16* outputBuffer, u32 frameCount);
+
 		i64 DebugGetTotalRenderedFrames() const;
 
 		struct DebugVoicesArray { Voice Slots[MaxSimultaneousVoices]; size_t Count; };
 		struct DebugSourcesArray { SourceHandle Slots[MaxLoadedSources]; size_t Count; };
 		DebugVoicesArray DebugGetAllActiveVoices();
 		DebugSourcesArray DebugGetAllLoadedSources();
+
+		// NOTE: Including the slots of dead voices and unloaded sources that haven't been released yet
+		struct DebugClaimedSlotCounts { size_t Voices; size_t Sources; };
+		DebugClaimedSlotCounts DebugGetClaimedSlotCounts();
 		i32 DebugGetSourceVoiceInstanceCount(SourceHandle source);
 
 		std::array<Time, CallbackDurationRingBufferSize> DebugGetRenderPerformanceHistory();
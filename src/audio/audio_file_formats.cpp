@@ -18,6 +18,17 @@
 // TODO: Forward declare because visual studio is having a stroke parsing the C header (something about the typedef union { ... } Floor; ???)
 //		 even though it was working perfectly fine in a different C++ project before :PeepoShrug:
 extern "C" int stb_vorbis_decode_memory(const unsigned char* mem, int len, int* channels, int* sample_rate, short** output);
+extern "C"
+{
+	typedef struct stb_vorbis stb_vorbis;
+	typedef struct stb_vorbis_alloc stb_vorbis_alloc;
+	typedef struct { unsigned int sample_rate; int channels; unsigned int setup_memory_required, setup_temp_memory_required, temp_memory_required; int max_frame_size; } stb_vorbis_info;
+	stb_vorbis* stb_vorbis_open_memory(const unsigned char* data, int len, int* error, const stb_vorbis_alloc* alloc_buffer);
+	stb_vorbis_info stb_vorbis_get_info(stb_vorbis* f);
+	unsigned int stb_vorbis_stream_length_in_samples(stb_vorbis* f);
+	int stb_vorbis_get_samples_short_interleaved(stb_vorbis* f, int channels, short* buffer, int num_shorts);
+	void stb_vorbis_close(stb_vorbis* f);
+}
 
 namespace Audio
 {
@@ -145,4 +156,196 @@ namespace Audio
 
 		return DecodeFileResult::FeelsGoodMan;
 	}
+
+	struct BlockDecoder::Impl
+	{
+		SupportedFileFormat FileFormat = SupportedFileFormat::Count;
+		::drwav WAV = {};
+		::drflac* FLAC = nullptr;
+		::drmp3 MP3 = {};
+		::stb_vorbis* Vorbis = nullptr;
+
+		// NOTE: Only used for files without a known length, which are decoded upfront instead
+		PCMSampleBuffer UpfrontBuffer = {};
+
+		u32 ChannelCount = 0;
+		u32 SourceSampleRate = 0, OutputSampleRate = 0;
+		i64 SourceFrameCount = 0, SourceFramesRead = 0;
+		i64 OutputFrameCount = 0, OutputFramesWritten = 0;
+		b8 IsFinished = false;
+
+		b8 NeedsResampling = false;
+		BlockResampler Resampler = {};
+		std::unique_ptr<i16[]> SourceBlockSamples = nullptr;
+
+		i64 ReadSourceFrames(i16* outSamples, i64 frameCount)
+		{
+			switch (FileFormat)
+			{
+			case SupportedFileFormat::OggVorbis: return static_cast<i64>(::stb_vorbis_get_samples_short_interleaved(Vorbis, static_cast<int>(ChannelCount), outSamples, static_cast<int>(frameCount * ChannelCount)));
+			case SupportedFileFormat::WAV: return static_cast<i64>(::drwav_read_pcm_frames_s16(&WAV, static_cast<drwav_uint64>(frameCount), outSamples));
+			case SupportedFileFormat::FLAC: return static_cast<i64>(::drflac_read_pcm_frames_s16(FLAC, static_cast<drflac_uint64>(frameCount), outSamples));
+			case SupportedFileFormat::MP3: return static_cast<i64>(::drmp3_read_pcm_frames_s16(&MP3, static_cast<drmp3_uint64>(frameCount), outSamples));
+			case SupportedFileFormat::Count:
+			{
+				const i64 framesToCopy = ClampBot<i64>(Min(frameCount, UpfrontBuffer.FrameCount - SourceFramesRead), 0);
+				const i16* upfrontSamples = &UpfrontBuffer.InterleavedSamples[SourceFramesRead * ChannelCount];
+				std::copy(upfrontSamples, upfrontSamples + (framesToCopy * ChannelCount), outSamples);
+				return framesToCopy;
+			}
+			default: return 0;
+			}
+		}
+
+		void CloseDecoder()
+		{
+			switch (FileFormat)
+			{
+			case SupportedFileFormat::OggVorbis: if (Vorbis != nullptr) ::stb_vorbis_close(Vorbis); Vorbis = nullptr; break;
+			case SupportedFileFormat::WAV: ::drwav_uninit(&WAV); break;
+			case SupportedFileFormat::FLAC: if (FLAC != nullptr) ::drflac_close(FLAC); FLAC = nullptr; break;
+			case SupportedFileFormat::MP3: ::drmp3_uninit(&MP3); break;
+			default: break;
+			}
+			FileFormat = SupportedFileFormat::Count;
+		}
+	};
+
+	BlockDecoder::BlockDecoder() : impl(std::make_unique<Impl>()) {}
+	BlockDecoder::~BlockDecoder() { impl->CloseDecoder(); }
+
+	b8 BlockDecoder::Open(std::string_view fileNameWithExtension, const void* inFileContent, size_t inFileSize, u32 targetSampleRate, ResamplerQuality resamplerQuality)
+	{
+		Close();
+		if (inFileContent == nullptr || inFileSize == 0)
+			return false;
+
+		Impl& d = *impl;
+		switch (TryToDetermineFileFormatFromExtension(fileNameWithExtension))
+		{
+		case SupportedFileFormat::OggVorbis:
+		{
+			d.Vorbis = ::stb_vorbis_open_memory(static_cast<const unsigned char*>(inFileContent), static_cast<int>(inFileSize), nullptr, nullptr);
+			if (d.Vorbis == nullptr)
+				return false;
+			d.FileFormat = SupportedFileFormat::OggVorbis;
+			const ::stb_vorbis_info info = ::stb_vorbis_get_info(d.Vorbis);
+			d.ChannelCount = static_cast<u32>(info.channels);
+			d.SourceSampleRate = info.sample_rate;
+			d.SourceFrameCount = static_cast<i64>(::stb_vorbis_stream_length_in_samples(d.Vorbis));
+		} break;
+
+		case SupportedFileFormat::WAV:
+		{
+			if (!::drwav_init_memory(&d.WAV, inFileContent, inFileSize, nullptr))
+				return false;
+			d.FileFormat = SupportedFileFormat::WAV;
+			d.ChannelCount = static_cast<u32>(d.WAV.channels);
+			d.SourceSampleRate = d.WAV.sampleRate;
+			d.SourceFrameCount = static_cast<i64>(d.WAV.totalPCMFrameCount);
+		} break;
+
+		case SupportedFileFormat::FLAC:
+		{
+			d.FLAC = ::drflac_open_memory(inFileContent, inFileSize, nullptr);
+			if (d.FLAC == nullptr)
+				return false;
+			d.FileFormat = SupportedFileFormat::FLAC;
+			d.ChannelCount = static_cast<u32>(d.FLAC->channels);
+			d.SourceSampleRate = d.FLAC->sampleRate;
+			d.SourceFrameCount = static_cast<i64>(d.FLAC->totalPCMFrameCount);
+		} break;
+
+		case SupportedFileFormat::MP3:
+		{
+			if (!::drmp3_init_memory(&d.MP3, inFileContent, inFileSize, nullptr))
+				return false;
+			d.FileFormat = SupportedFileFormat::MP3;
+			d.ChannelCount = static_cast<u32>(d.MP3.channels);
+			d.SourceSampleRate = d.MP3.sampleRate;
+			// NOTE: Only parses the frame headers without decoding anything, then seeks back to the start
+			d.SourceFrameCount = static_cast<i64>(::drmp3_get_pcm_frame_count(&d.MP3));
+		} break;
+
+		default:
+		{
+			return false;
+		} break;
+		}
+
+		if (d.SourceFrameCount <= 0)
+		{
+			d.CloseDecoder();
+			if (DecodeEntireFile(fileNameWithExtension, inFileContent, inFileSize, d.UpfrontBuffer) != DecodeFileResult::FeelsGoodMan)
+				return false;
+			d.ChannelCount = d.UpfrontBuffer.ChannelCount;
+			d.SourceSampleRate = d.UpfrontBuffer.SampleRate;
+			d.SourceFrameCount = d.UpfrontBuffer.FrameCount;
+		}
+
+		if (d.ChannelCount == 0 || d.SourceSampleRate == 0 || d.SourceFrameCount <= 0)
+		{
+			Close();
+			return false;
+		}
+
+		d.NeedsResampling = (targetSampleRate != 0 && targetSampleRate != d.SourceSampleRate);
+		if (d.NeedsResampling)
+		{
+			d.Resampler.Reset(d.ChannelCount, d.SourceSampleRate, targetSampleRate, static_cast<size_t>(d.SourceFrameCount), resamplerQuality);
+			d.SourceBlockSamples = std::unique_ptr<i16[]>(new i16[BlockFrameCount * d.ChannelCount]);
+			d.OutputSampleRate = targetSampleRate;
+			d.OutputFrameCount = static_cast<i64>(d.Resampler.OutputFrameCount);
+		}
+		else
+		{
+			d.OutputSampleRate = d.SourceSampleRate;
+			d.OutputFrameCount = d.SourceFrameCount;
+		}
+
+		return true;
+	}
+
+	void BlockDecoder::Close()
+	{
+		impl->CloseDecoder();
+		impl = std::make_unique<Impl>();
+	}
+
+	b8 BlockDecoder::IsOpen() const { return (impl->OutputFrameCount > 0); }
+	b8 BlockDecoder::IsFinished() const { return impl->IsFinished; }
+	u32 BlockDecoder::GetChannelCount() const { return impl->ChannelCount; }
+	u32 BlockDecoder::GetSampleRate() const { return impl->OutputSampleRate; }
+	i64 BlockDecoder::GetFrameCount() const { return impl->OutputFrameCount; }
+	i64 BlockDecoder::GetDecodedFrameCount() const { return impl->OutputFramesWritten; }
+
+	i64 BlockDecoder::DecodeNextBlock(i16* outInterleavedSamples)
+	{
+		Impl& d = *impl;
+		if (!IsOpen() || d.IsFinished)
+			return d.OutputFramesWritten;
+
+		const i64 framesToRead = Min(BlockFrameCount, d.SourceFrameCount - d.SourceFramesRead);
+		if (d.NeedsResampling)
+		{
+			const i64 framesRead = ClampBot<i64>(d.ReadSourceFrames(d.SourceBlockSamples.get(), framesToRead), 0);
+			d.SourceFramesRead += framesRead;
+			d.IsFinished = (framesRead < framesToRead || d.SourceFramesRead >= d.SourceFrameCount);
+			d.OutputFramesWritten = static_cast<i64>(d.Resampler.ProcessBlock(d.SourceBlockSamples.get(), framesRead, outInterleavedSamples, d.IsFinished));
+		}
+		else
+		{
+			const i64 framesRead = ClampBot<i64>(d.ReadSourceFrames(&outInterleavedSamples[d.OutputFramesWritten * d.ChannelCount], framesToRead), 0);
+			d.SourceFramesRead += framesRead;
+			d.OutputFramesWritten += framesRead;
+			d.IsFinished = (framesRead < framesToRead || d.SourceFramesRead >= d.SourceFrameCount);
+			if (d.IsFinished)
+			{
+				std::fill(&outInterleavedSamples[d.OutputFramesWritten * d.ChannelCount], &outInterleavedSamples[d.OutputFrameCount * d.ChannelCount], static_cast<i16>(0));
+				d.OutputFramesWritten = d.OutputFrameCount;
+			}
+		}
+
+		return d.OutputFramesWritten;
+	}
 }
@@ -2,6 +2,7 @@
 #include "core_types.h"
 #include "core_string.h"
 #include "audio_common.h"
+#include "audio_resampler.h"
 
 namespace Audio
 {
@@ -37,4 +38,37 @@ namespace Audio
 	//		 but for now everything will be stored in one big continuous buffer since it greatly reduces complexity.
 	//		 Instead of constantly reading a streamed file from disk it might also be an option to read the entire file upfront but then only decode chunks on demand (?)
 	DecodeFileResult DecodeEntireFile(std::string_view fileNameWithExtension, const void* inFileContent, size_t inFileSize, PCMSampleBuffer& outBuffer);
+
+	// NOTE: Decodes an in-memory file one block at a time, directly into the final (continuous) buffer so that the already decoded part can be used
+	//		 while the rest is still being decoded. Optionally resampled on the fly, with the output frame count always being known upfront.
+	//		 Files that don't specify their length are decoded entirely when opened and then handed out in blocks all the same
+	class BlockDecoder : NonCopyable
+	{
+	public:
+		static constexpr i64 BlockFrameCount = 16384;
+
+		BlockDecoder();
+		~BlockDecoder();
+
+	public:
+		// NOTE: The file content has to outlive the decoder. A target sample rate of zero keeps the original one
+		b8 Open(std::string_view fileNameWithExtension, const void* inFileContent, size_t inFileSize, u32 targetSampleRate = 0, ResamplerQuality resamplerQuality = DefaultResamplerQuality);
+		void Close();
+
+		b8 IsOpen() const;
+		b8 IsFinished() const;
+
+		u32 GetChannelCount() const;
+		u32 GetSampleRate() const;
+		i64 GetFrameCount() const;
+		i64 GetDecodedFrameCount() const;
+
+		// NOTE: Writes the next block into its place inside the GetFrameCount() sized outInterleavedSamples and returns the total number of frames decoded so far.
+		//		 Should the file end early the remaining frames are filled with silence so that the output is always complete once finished
+		i64 DecodeNextBlock(i16* outInterleavedSamples);
+
+	private:
+		struct Impl;
+		std::unique_ptr<Impl> impl;
+	};
 }
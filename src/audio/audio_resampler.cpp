@@ -0,0 +1,313 @@
+#include "audio_resampler.h"
+#include <numeric>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define AUDIO_RESAMPLER_KERNELS_X86 1
+#include <immintrin.h>
+#else
+#define AUDIO_RESAMPLER_KERNELS_X86 0
+#endif
+
+// NOTE: See audio_common.cpp
+#if defined(__GNUC__) || defined(__clang__)
+#define AUDIO_TARGET_SSE2 __attribute__((target("sse2")))
+#define AUDIO_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define AUDIO_TARGET_SSE2
+#define AUDIO_TARGET_AVX2
+#endif
+
+namespace Audio
+{
+	// NOTE: The f32 PI isn't precise enough for filter design
+	static constexpr f64 PI_F64 = 3.14159265358979323846;
+
+	// NOTE: Zeroth order modified Bessel function of the first kind, for the Kaiser window
+	static f64 BesselI0(f64 x)
+	{
+		const f64 halfX = (x * 0.5);
+		f64 sum = 1.0, term = 1.0;
+		for (i32 k = 1; k < 64 && term > (sum * 1e-21); k++)
+		{
+			const f64 factor = (halfX / static_cast<f64>(k));
+			term *= (factor * factor);
+			sum += term;
+		}
+		return sum;
+	}
+
+	static f64 NormalizedSinc(f64 x)
+	{
+		return (x == 0.0) ? 1.0 : (::sin(PI_F64 * x) / (PI_F64 * x));
+	}
+
+	void PolyphaseFilterTable::Build(u32 sourceSampleRate, u32 targetSampleRate, ResamplerQuality quality)
+	{
+		assert(sourceSampleRate > 0 && targetSampleRate > 0);
+		const u32 divisor = std::gcd(sourceSampleRate, targetSampleRate);
+		const u32 reducedSource = (sourceSampleRate / divisor), reducedTarget = (targetSampleRate / divisor);
+
+		SourceSampleRate = sourceSampleRate;
+		TargetSampleRate = targetSampleRate;
+		Quality = quality;
+		PhaseDenominator = reducedTarget;
+		InputStep = (reducedSource / reducedTarget);
+		PhaseStep = (reducedSource % reducedTarget);
+		PhaseCount = Min(reducedTarget, MaxExactPhaseCount);
+
+		// NOTE: When downsampling the filter has to cut off at the target Nyquist frequency instead, which (relative to the input frames) needs proportionally more taps
+		const ResamplerQualityPreset& preset = ResamplerQualityPresets[EnumToIndex(quality)];
+		const f64 downsamplingRatio = Max(1.0, static_cast<f64>(reducedSource) / static_cast<f64>(reducedTarget));
+		const u32 unalignedTapCount = static_cast<u32>(Ceil(static_cast<f64>(preset.BaseTapCount) * downsamplingRatio));
+		TapCount = ((unalignedTapCount + (TapCountAlignment - 1)) / TapCountAlignment) * TapCountAlignment;
+		TapsBeforeCenter = ((TapCount / 2) - 1);
+
+		// NOTE: Kaiser's estimates for the stopband attenuation of a given beta and the resulting transition width (in cycles per input frame)
+		const f64 stopbandAttenuation = (preset.KaiserBeta / 0.1102) + 8.7;
+		const f64 transitionWidth = (stopbandAttenuation - 7.95) / (2.285 * (2.0 * PI_F64) * static_cast<f64>(TapCount - 1));
+		const f64 nyquist = (0.5 / downsamplingRatio);
+		const f64 cutoff = Max(nyquist - (transitionWidth * 0.5), nyquist * 0.5);
+
+		const f64 halfWindowWidth = static_cast<f64>(TapCount / 2);
+		const f64 windowNormalization = (1.0 / BesselI0(preset.KaiserBeta));
+
+		Coefficients.resize(static_cast<size_t>(PhaseCount + 1) * TapCount);
+		std::vector<f64> phaseCoefficients(TapCount);
+		for (u32 tableIndex = 0; tableIndex <= PhaseCount; tableIndex++)
+		{
+			const f64 phaseFraction = static_cast<f64>(tableIndex) / static_cast<f64>(PhaseCount);
+
+			f64 coefficientSum = 0.0;
+			for (u32 tap = 0; tap < TapCount; tap++)
+			{
+				const f64 distance = static_cast<f64>(tap) - static_cast<f64>(TapsBeforeCenter) - phaseFraction;
+				const f64 windowPosition = Clamp(distance / halfWindowWidth, -1.0, 1.0);
+				const f64 window = BesselI0(preset.KaiserBeta * ::sqrt(1.0 - (windowPosition * windowPosition))) * windowNormalization;
+				phaseCoefficients[tap] = (2.0 * cutoff) * NormalizedSinc(2.0 * cutoff * distance) * window;
+				coefficientSum += phaseCoefficients[tap];
+			}
+
+			// NOTE: Normalizing each phase individually so that silence with a DC offset stays exactly that, without any ripple across phases
+			f32* outCoefficients = &Coefficients[static_cast<size_t>(tableIndex) * TapCount];
+			for (u32 tap = 0; tap < TapCount; tap++)
+				outCoefficients[tap] = static_cast<f32>(phaseCoefficients[tap] / coefficientSum);
+		}
+	}
+
+	// NOTE: Adding and subtracting 1.5 * 2^23 rounds to the nearest even integer independently of the current rounding mode
+	static inline i16 RoundFilteredSample(f32 value)
+	{
+		const f32 clamped = Clamp(value, static_cast<f32>(I16Min), static_cast<f32>(I16Max));
+		return static_cast<i16>(static_cast<i32>((clamped + 12582912.0f) - 12582912.0f));
+	}
+
+	static inline void AdvancePhase(size_t& inOutInputIndex, u32& inOutPhase, const PolyphaseFilterTable& table)
+	{
+		inOutInputIndex += table.InputStep;
+		inOutPhase += table.PhaseStep;
+		if (inOutPhase >= table.PhaseDenominator)
+		{
+			inOutPhase -= table.PhaseDenominator;
+			inOutInputIndex++;
+		}
+	}
+
+	static void FilterChannel_Scalar(i16* outSamples, size_t outStride, size_t outFrameCount, const f32* inSamples, size_t inputIndex, u32 phase, const PolyphaseFilterTable& table)
+	{
+		const size_t tapCount = table.TapCount;
+		for (size_t i = 0; i < outFrameCount; i++)
+		{
+			const f32* coefficients = &table.Coefficients[table.GetCoefficientTableIndex(phase) * tapCount];
+			const f32* input = &inSamples[inputIndex];
+
+			f32 partialSums[8] = {};
+			for (size_t tap = 0; tap < tapCount; tap += 8)
+			{
+				for (size_t lane = 0; lane < 8; lane++)
+					partialSums[lane] += (input[tap + lane] * coefficients[tap + lane]);
+			}
+
+			const f32 sum = ((partialSums[0] + partialSums[4]) + (partialSums[2] + partialSums[6])) + ((partialSums[1] + partialSums[5]) + (partialSums[3] + partialSums[7]));
+			outSamples[i * outStride] = RoundFilteredSample(sum);
+			AdvancePhase(inputIndex, phase, table);
+		}
+	}
+
+#if AUDIO_RESAMPLER_KERNELS_X86
+	// NOTE: Partial sums 0-3 in lo and 4-7 in hi, added up in the same order as the scalar version
+	AUDIO_TARGET_SSE2 static inline f32 SumPartialSums_SSE2(__m128 lo, __m128 hi)
+	{
+		const __m128 quad = _mm_add_ps(lo, hi);
+		const __m128 pair = _mm_add_ps(quad, _mm_movehl_ps(quad, quad));
+		return _mm_cvtss_f32(_mm_add_ss(pair, _mm_shuffle_ps(pair, pair, _MM_SHUFFLE(1, 1, 1, 1))));
+	}
+
+	AUDIO_TARGET_SSE2 static void FilterChannel_SSE2(i16* outSamples, size_t outStride, size_t outFrameCount, const f32* inSamples, size_t inputIndex, u32 phase, const PolyphaseFilterTable& table)
+	{
+		const size_t tapCount = table.TapCount;
+		for (size_t i = 0; i < outFrameCount; i++)
+		{
+			const f32* coefficients = &table.Coefficients[table.GetCoefficientTableIndex(phase) * tapCount];
+			const f32* input = &inSamples[inputIndex];
+
+			__m128 sumsLo = _mm_setzero_ps(), sumsHi = _mm_setzero_ps();
+			for (size_t tap = 0; tap < tapCount; tap += 8)
+			{
+				sumsLo = _mm_add_ps(sumsLo, _mm_mul_ps(_mm_loadu_ps(&input[tap + 0]), _mm_loadu_ps(&coefficients[tap + 0])));
+				sumsHi = _mm_add_ps(sumsHi, _mm_mul_ps(_mm_loadu_ps(&input[tap + 4]), _mm_loadu_ps(&coefficients[tap + 4])));
+			}
+
+			outSamples[i * outStride] = RoundFilteredSample(SumPartialSums_SSE2(sumsLo, sumsHi));
+			AdvancePhase(inputIndex, phase, table);
+		}
+	}
+
+	// NOTE: Filtering two output frames at once to hide the add latency of the single accumulator each of them is limited to
+	AUDIO_TARGET_AVX2 static void FilterChannel_AVX2(i16* outSamples, size_t outStride, size_t outFrameCount, const f32* inSamples, size_t inputIndex, u32 phase, const PolyphaseFilterTable& table)
+	{
+		const size_t tapCount = table.TapCount;
+		size_t i = 0;
+		for (; (i + 2) <= outFrameCount; i += 2)
+		{
+			const f32* coefficientsA = &table.Coefficients[table.GetCoefficientTableIndex(phase) * tapCount];
+			const f32* inputA = &inSamples[inputIndex];
+			AdvancePhase(inputIndex, phase, table);
+			const f32* coefficientsB = &table.Coefficients[table.GetCoefficientTableIndex(phase) * tapCount];
+			const f32* inputB = &inSamples[inputIndex];
+			AdvancePhase(inputIndex, phase, table);
+
+			__m256 sumsA = _mm256_setzero_ps(), sumsB = _mm256_setzero_ps();
+			for (size_t tap = 0; tap < tapCount; tap += 8)
+			{
+				sumsA = _mm256_add_ps(sumsA, _mm256_mul_ps(_mm256_loadu_ps(&inputA[tap]), _mm256_loadu_ps(&coefficientsA[tap])));
+				sumsB = _mm256_add_ps(sumsB, _mm256_mul_ps(_mm256_loadu_ps(&inputB[tap]), _mm256_loadu_ps(&coefficientsB[tap])));
+			}
+
+			outSamples[(i + 0) * outStride] = RoundFilteredSample(SumPartialSums_SSE2(_mm256_castps256_ps128(sumsA), _mm256_extractf128_ps(sumsA, 1)));
+			outSamples[(i + 1) * outStride] = RoundFilteredSample(SumPartialSums_SSE2(_mm256_castps256_ps128(sumsB), _mm256_extractf128_ps(sumsB, 1)));
+		}
+		FilterChannel_SSE2(&outSamples[i * outStride], outStride, outFrameCount - i, inSamples, inputIndex, phase, table);
+	}
+#endif
+
+	static constexpr ResamplerKernels ScalarResamplerKernels = { FilterChannel_Scalar, };
+#if AUDIO_RESAMPLER_KERNELS_X86
+	static constexpr ResamplerKernels SSE2ResamplerKernels = { FilterChannel_SSE2, };
+	static constexpr ResamplerKernels AVX2ResamplerKernels = { FilterChannel_AVX2, };
+#endif
+
+	const ResamplerKernels& GetResamplerKernels(MixKernelSet set)
+	{
+		assert(IsMixKernelSetSupported(set));
+		switch (set)
+		{
+#if AUDIO_RESAMPLER_KERNELS_X86
+		case MixKernelSet::SSE2: return SSE2ResamplerKernels;
+		case MixKernelSet::AVX2: return AVX2ResamplerKernels;
+#endif
+		default: return ScalarResamplerKernels;
+		}
+	}
+
+	const ResamplerKernels& GetResamplerKernels()
+	{
+		static const ResamplerKernels& bestSupportedKernels = GetResamplerKernels(GetBestSupportedMixKernelSet());
+		return bestSupportedKernels;
+	}
+
+	void BlockResampler::Reset(u32 channelCount, u32 sourceSampleRate, u32 targetSampleRate, size_t inputFrameCount, ResamplerQuality quality, const ResamplerKernels& kernels)
+	{
+		if (Table.SourceSampleRate != sourceSampleRate || Table.TargetSampleRate != targetSampleRate || Table.Quality != quality || Table.Coefficients.empty())
+			Table.Build(sourceSampleRate, targetSampleRate, quality);
+
+		ChannelCount = channelCount;
+		OutputFrameCount = static_cast<size_t>(inputFrameCount * static_cast<f64>(targetSampleRate) / static_cast<f64>(sourceSampleRate) + 0.5);
+		OutputFramesWritten = 0;
+		InputFramesConsumed = 0;
+		Kernels = &kernels;
+		ChannelBuffers.resize(channelCount);
+		for (std::vector<f32>& buffer : ChannelBuffers)
+			buffer.assign(Table.TapsBeforeCenter, 0.0f);
+		BufferStartIndex = 0;
+	}
+
+	size_t BlockResampler::ProcessBlock(const i16* inSamples, i64 inFrameCount, i16* outSamples, b8 isLastBlock)
+	{
+		assert(ChannelCount > 0 && Kernels != nullptr);
+
+		// NOTE: Output frame N starts filtering at padded input frame ((N * reducedSource) / reducedTarget) and needs TapCount frames from there on
+		const u64 reducedSource = (static_cast<u64>(Table.InputStep) * Table.PhaseDenominator) + Table.PhaseStep;
+		const u64 reducedTarget = Table.PhaseDenominator;
+
+		// NOTE: Padded with enough trailing silence for every remaining output frame, even if fewer input frames were passed in than initially expected
+		const i64 requiredEndIndex = (isLastBlock && OutputFrameCount > 0) ? static_cast<i64>((static_cast<u64>(OutputFrameCount - 1) * reducedSource) / reducedTarget) + Table.TapCount : 0;
+		for (u32 channel = 0; channel < ChannelCount; channel++)
+		{
+			std::vector<f32>& buffer = ChannelBuffers[channel];
+			const size_t previousFrameCount = buffer.size();
+			buffer.resize(Max(previousFrameCount + static_cast<size_t>(inFrameCount), static_cast<size_t>(ClampBot(requiredEndIndex - BufferStartIndex, static_cast<i64>(0)))), 0.0f);
+
+			f32* bufferWriteHead = (buffer.data() + previousFrameCount);
+			for (i64 frame = 0; frame < inFrameCount; frame++)
+				bufferWriteHead[frame] = static_cast<f32>(inSamples[(frame * ChannelCount) + channel]);
+		}
+		InputFramesConsumed += inFrameCount;
+
+		const i64 bufferEndIndex = BufferStartIndex + static_cast<i64>(ChannelBuffers[0].size());
+
+		size_t endOutputFrame = OutputFrameCount;
+		if (!isLastBlock)
+		{
+			const i64 lastStartIndex = (bufferEndIndex - static_cast<i64>(Table.TapCount));
+			const size_t computableFrameCount = (lastStartIndex < 0) ? 0 : static_cast<size_t>(((static_cast<u64>(lastStartIndex + 1) * reducedTarget) - 1) / reducedSource + 1);
+			endOutputFrame = Clamp(computableFrameCount, OutputFramesWritten, OutputFrameCount);
+		}
+
+		if (endOutputFrame > OutputFramesWritten)
+		{
+			const u64 position = (static_cast<u64>(OutputFramesWritten) * reducedSource);
+			const size_t inputIndex = static_cast<size_t>(static_cast<i64>(position / reducedTarget) - BufferStartIndex);
+			const u32 phase = static_cast<u32>(position % reducedTarget);
+
+			for (u32 channel = 0; channel < ChannelCount; channel++)
+				Kernels->FilterChannel(&outSamples[(OutputFramesWritten * ChannelCount) + channel], ChannelCount, endOutputFrame - OutputFramesWritten, ChannelBuffers[channel].data(), inputIndex, phase, Table);
+			OutputFramesWritten = endOutputFrame;
+		}
+
+		// NOTE: Dropping every input frame before the first one needed by the next output frame
+		const i64 nextStartIndex = static_cast<i64>((static_cast<u64>(OutputFramesWritten) * reducedSource) / reducedTarget);
+		const size_t droppedFrameCount = static_cast<size_t>(Clamp(nextStartIndex - BufferStartIndex, static_cast<i64>(0), bufferEndIndex - BufferStartIndex));
+		if (droppedFrameCount > 0)
+		{
+			for (std::vector<f32>& buffer : ChannelBuffers)
+				buffer.erase(buffer.begin(), buffer.begin() + droppedFrameCount);
+			BufferStartIndex += static_cast<i64>(droppedFrameCount);
+		}
+
+		return OutputFramesWritten;
+	}
+
+	void ResampleBuffer(std::unique_ptr<i16[]>& inOutSamples, i64& inOutFrameCount, u32& inOutSampleRate, u32 channelCount, u32 targetSampleRate, ResamplerQuality quality)
+	{
+		if (inOutSampleRate == targetSampleRate) { assert(false); return; }
+
+		BlockResampler resampler;
+		resampler.Reset(channelCount, inOutSampleRate, targetSampleRate, static_cast<size_t>(inOutFrameCount), quality);
+		auto outSamples = std::unique_ptr<i16[]>(new i16[resampler.OutputFrameCount * channelCount]);
+
+		static constexpr i64 blockFrameCount = 16384;
+		i64 blockStartFrame = 0;
+		do
+		{
+			const i64 blockFrames = Min(blockFrameCount, inOutFrameCount - blockStartFrame);
+			resampler.ProcessBlock(inOutSamples.get() + (blockStartFrame * channelCount), blockFrames, outSamples.get(), (blockStartFrame + blockFrames) >= inOutFrameCount);
+			blockStartFrame += blockFrames;
+		}
+		while (blockStartFrame < inOutFrameCount);
+		assert(resampler.OutputFramesWritten == resampler.OutputFrameCount);
+
+		inOutSamples = std::move(outSamples);
+		inOutFrameCount = static_cast<i64>(resampler.OutputFrameCount);
+		inOutSampleRate = targetSampleRate;
+	}
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include "core_types.h"
+#include "audio_common.h"
+
+namespace Audio
+{
+	enum class ResamplerQuality : u8
+	{
+		Low,
+		Medium,
+		High,
+		Count
+	};
+
+	constexpr cstr ResamplerQualityNames[EnumCount<ResamplerQuality>] =
+	{
+		"Low",
+		"Medium",
+		"High",
+	};
+
+	constexpr ResamplerQuality DefaultResamplerQuality = ResamplerQuality::Medium;
+
+	// NOTE: Kaiser windowed sinc filters, with the tap count being per output frame when not downsampling (and scaled up by the downsampling ratio otherwise).
+	//		 The cutoff is placed so that the transition band (as estimated for the given window) ends right at the lower of the two Nyquist frequencies
+	struct ResamplerQualityPreset
+	{
+		u32 BaseTapCount;
+		f64 KaiserBeta;
+	};
+
+	constexpr ResamplerQualityPreset ResamplerQualityPresets[EnumCount<ResamplerQuality>] =
+	{
+		{ 16, 5.0 },
+		{ 32, 7.5 },
+		{ 96, 10.0 },
+	};
+
+	// NOTE: Precomputed coefficients for every phase of the reduced (source / target) sample rate ratio, so output frame N is the dot product of the
+	//		 coefficients of phase ((N * source) % target) with TapCount input frames starting at ((N * source) / target) - (TapCount / 2 - 1).
+	//		 Ratios with more than MaxExactPhaseCount phases instead round each output frame to the closest of MaxExactPhaseCount evenly spaced phases
+	struct PolyphaseFilterTable
+	{
+		static constexpr u32 MaxExactPhaseCount = 4096;
+		// NOTE: Tap count is always rounded up to a multiple of this so that the kernels never need a remainder loop
+		static constexpr u32 TapCountAlignment = 8;
+
+		u32 SourceSampleRate = {}, TargetSampleRate = {};
+		ResamplerQuality Quality = {};
+		// NOTE: Reduced ratio, with each output frame advancing the input position by (InputStep + (PhaseStep / PhaseDenominator)) frames
+		u32 PhaseDenominator = {};
+		u32 InputStep = {}, PhaseStep = {};
+		// NOTE: (PhaseCount + 1) tables with the last one only reached by rounding up inexact phases, equal to the first one shifted by a single frame
+		u32 PhaseCount = {};
+		u32 TapCount = {};
+		u32 TapsBeforeCenter = {};
+		std::vector<f32> Coefficients;
+
+		void Build(u32 sourceSampleRate, u32 targetSampleRate, ResamplerQuality quality);
+
+		inline u32 GetCoefficientTableIndex(u32 phase) const
+		{
+			return (PhaseCount == PhaseDenominator) ? phase : static_cast<u32>(((static_cast<u64>(phase) * PhaseCount) + (PhaseDenominator / 2)) / PhaseDenominator);
+		}
+	};
+
+	// NOTE: Inner loop of the resampler, filtering outFrameCount frames of a single channel into every outStride'th i16 of outSamples
+	//		 (starting at input frame inputIndex of the de-interleaved inSamples at the given phase). The dot products are summed up in the same fixed order of
+	//		 8 partial sums by every kernel set (no FMA), so the vectorized versions produce bit-identical results to the scalar one
+	struct ResamplerKernels
+	{
+		void(*FilterChannel)(i16* outSamples, size_t outStride, size_t outFrameCount, const f32* inSamples, size_t inputIndex, u32 phase, const PolyphaseFilterTable& table);
+	};
+
+	// NOTE: Using the same kernel sets as the mix kernels
+	const ResamplerKernels& GetResamplerKernels(MixKernelSet set);
+	const ResamplerKernels& GetResamplerKernels();
+
+	// NOTE: Block by block polyphase resampling for resampling while still decoding without first having to store the entire input at its original sample rate.
+	//		 Only the input frames still needed by upcoming output frames are kept around (de-interleaved and converted to f32),
+	//		 so that the output is identical no matter how the input is split up into blocks
+	struct BlockResampler
+	{
+		u32 ChannelCount = {};
+		size_t OutputFrameCount = {}, OutputFramesWritten = {};
+		i64 InputFramesConsumed = {};
+		PolyphaseFilterTable Table;
+		const ResamplerKernels* Kernels = nullptr;
+		// NOTE: Zero padded input frames starting at BufferStartIndex, with input frame 0 located at index (Table.TapsBeforeCenter)
+		std::vector<std::vector<f32>> ChannelBuffers;
+		i64 BufferStartIndex = {};
+
+		void Reset(u32 channelCount, u32 sourceSampleRate, u32 targetSampleRate, size_t inputFrameCount, ResamplerQuality quality = DefaultResamplerQuality, const ResamplerKernels& kernels = GetResamplerKernels());
+
+		// NOTE: Blocks have to be passed in order with the last one flagged as such, so that the trailing output frames are filtered against silence.
+		//		 Writes every output frame computable so far into the OutputFrameCount sized outSamples and returns the total number of output frames written
+		size_t ProcessBlock(const i16* inSamples, i64 inFrameCount, i16* outSamples, b8 isLastBlock);
+	};
+
+	// NOTE: Resamples the entire buffer by passing it to a BlockResampler piece by piece, to avoid converting all of it to f32 at once
+	void ResampleBuffer(std::unique_ptr<i16[]>& inOutSamples, i64& inOutFrameCount, u32& inOutSampleRate, u32 channelCount, u32 targetSampleRate, ResamplerQuality quality = DefaultResamplerQuality);
+}
@@ -0,0 +1,458 @@
+#include "audio_waveform.h"
+#include <atomic>
+#include <thread>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define AUDIO_WAVEFORM_KERNELS_X86 1
+#include <immintrin.h>
+#else
+#define AUDIO_WAVEFORM_KERNELS_X86 0
+#endif
+
+// NOTE: See audio_common.cpp
+#if defined(__GNUC__) || defined(__clang__)
+#define AUDIO_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define AUDIO_TARGET_SSE2
+#endif
+
+namespace Audio
+{
+	// NOTE: Squaring in integer space so that the only rounding happens when converting the (exact) sum to f32.
+	//		 The min sample value is clamped to -I16Max first so that two of them can't overflow the i32 sum
+	static inline i16 RootMeanSquareOfTwo(i16 a, i16 b)
+	{
+		const i32 clampedA = Max<i32>(a, -I16Max), clampedB = Max<i32>(b, -I16Max);
+		const f32 meanSquare = static_cast<f32>((clampedA * clampedA) + (clampedB * clampedB)) * 0.5f;
+		return static_cast<i16>(static_cast<i32>(::sqrtf(meanSquare) + 0.5f));
+	}
+
+	static void ReduceBucketPairs_Scalar(i16* outMin, i16* outMax, i16* outRMS, const i16* inMin, const i16* inMax, const i16* inRMS, size_t outBucketCount)
+	{
+		for (size_t i = 0; i < outBucketCount; i++)
+		{
+			outMin[i] = Min(inMin[(i * 2) + 0], inMin[(i * 2) + 1]);
+			outMax[i] = Max(inMax[(i * 2) + 0], inMax[(i * 2) + 1]);
+			outRMS[i] = RootMeanSquareOfTwo(inRMS[(i * 2) + 0], inRMS[(i * 2) + 1]);
+		}
+	}
+
+	static void ReduceInterleavedStereoFramePairs_Scalar(i16* outMinL, i16* outMaxL, i16* outRMSL, i16* outMinR, i16* outMaxR, i16* outRMSR, const i16* interleavedSamples, size_t outBucketCount)
+	{
+		for (size_t i = 0; i < outBucketCount; i++)
+		{
+			const i16* frames = &interleavedSamples[i * 4];
+			outMinL[i] = Min(frames[0], frames[2]);
+			outMaxL[i] = Max(frames[0], frames[2]);
+			outRMSL[i] = RootMeanSquareOfTwo(frames[0], frames[2]);
+			outMinR[i] = Min(frames[1], frames[3]);
+			outMaxR[i] = Max(frames[1], frames[3]);
+			outRMSR[i] = RootMeanSquareOfTwo(frames[1], frames[3]);
+		}
+	}
+
+#if AUDIO_WAVEFORM_KERNELS_X86
+	// NOTE: Sign extending the even / odd i16 lanes to i32 and packing them back together to get two vectors of the left and right pair elements
+	AUDIO_TARGET_SSE2 static inline __m128i EvenI16Lanes(__m128i lo, __m128i hi) { return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(lo, 16), 16), _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16)); }
+	AUDIO_TARGET_SSE2 static inline __m128i OddI16Lanes(__m128i lo, __m128i hi) { return _mm_packs_epi32(_mm_srai_epi32(lo, 16), _mm_srai_epi32(hi, 16)); }
+
+	AUDIO_TARGET_SSE2 static inline __m128i RootMeanSquareOfPairs(__m128i samples, __m128i minSampleValue)
+	{
+		const __m128i clamped = _mm_max_epi16(samples, minSampleValue);
+		const __m128 meanSquare = _mm_mul_ps(_mm_cvtepi32_ps(_mm_madd_epi16(clamped, clamped)), _mm_set1_ps(0.5f));
+		return _mm_cvttps_epi32(_mm_add_ps(_mm_sqrt_ps(meanSquare), _mm_set1_ps(0.5f)));
+	}
+
+	// NOTE: Processing 16 input buckets (8 output buckets) per iteration, with the remainder handled by the scalar version
+	AUDIO_TARGET_SSE2 static void ReduceBucketPairs_SSE2(i16* outMin, i16* outMax, i16* outRMS, const i16* inMin, const i16* inMax, const i16* inRMS, size_t outBucketCount)
+	{
+		const __m128i minSampleValue = _mm_set1_epi16(-I16Max);
+		size_t i = 0;
+		for (; (i + 8) <= outBucketCount; i += 8)
+		{
+			const __m128i minLo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&inMin[(i * 2) + 0]));
+			const __m128i minHi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&inMin[(i * 2) + 8]));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&outMin[i]), _mm_min_epi16(EvenI16Lanes(minLo, minHi), OddI16Lanes(minLo, minHi)));
+
+			const __m128i maxLo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&inMax[(i * 2) + 0]));
+			const __m128i maxHi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&inMax[(i * 2) + 8]));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&outMax[i]), _mm_max_epi16(EvenI16Lanes(maxLo, maxHi), OddI16Lanes(maxLo, maxHi)));
+
+			const __m128i rmsLo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&inRMS[(i * 2) + 0]));
+			const __m128i rmsHi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&inRMS[(i * 2) + 8]));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&outRMS[i]), _mm_packs_epi32(RootMeanSquareOfPairs(rmsLo, minSampleValue), RootMeanSquareOfPairs(rmsHi, minSampleValue)));
+		}
+		ReduceBucketPairs_Scalar(&outMin[i], &outMax[i], &outRMS[i], &inMin[i * 2], &inMax[i * 2], &inRMS[i * 2], outBucketCount - i);
+	}
+
+	// NOTE: Processing 16 stereo frames (8 output buckets per channel) per iteration, first splitting the left and right samples
+	//		 and then the even and odd frames of each channel, with the remainder handled by the scalar version
+	AUDIO_TARGET_SSE2 static void ReduceInterleavedStereoFramePairs_SSE2(i16* outMinL, i16* outMaxL, i16* outRMSL, i16* outMinR, i16* outMaxR, i16* outRMSR, const i16* interleavedSamples, size_t outBucketCount)
+	{
+		const __m128i minSampleValue = _mm_set1_epi16(-I16Max);
+		size_t i = 0;
+		for (; (i + 8) <= outBucketCount; i += 8)
+		{
+			const __m128i frames0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&interleavedSamples[(i * 4) + 0]));
+			const __m128i frames1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&interleavedSamples[(i * 4) + 8]));
+			const __m128i frames2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&interleavedSamples[(i * 4) + 16]));
+			const __m128i frames3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&interleavedSamples[(i * 4) + 24]));
+
+			const __m128i leftLo = EvenI16Lanes(frames0, frames1), leftHi = EvenI16Lanes(frames2, frames3);
+			const __m128i leftEven = EvenI16Lanes(leftLo, leftHi), leftOdd = OddI16Lanes(leftLo, leftHi);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&outMinL[i]), _mm_min_epi16(leftEven, leftOdd));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&outMaxL[i]), _mm_max_epi16(leftEven, leftOdd));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&outRMSL[i]), _mm_packs_epi32(RootMeanSquareOfPairs(leftLo, minSampleValue), RootMeanSquareOfPairs(leftHi, minSampleValue)));
+
+			const __m128i rightLo = OddI16Lanes(frames0, frames1), rightHi = OddI16Lanes(frames2, frames3);
+			const __m128i rightEven = EvenI16Lanes(rightLo, rightHi), rightOdd = OddI16Lanes(rightLo, rightHi);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&outMinR[i]), _mm_min_epi16(rightEven, rightOdd));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&outMaxR[i]), _mm_max_epi16(rightEven, rightOdd));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&outRMSR[i]), _mm_packs_epi32(RootMeanSquareOfPairs(rightLo, minSampleValue), RootMeanSquareOfPairs(rightHi, minSampleValue)));
+		}
+		ReduceInterleavedStereoFramePairs_Scalar(&outMinL[i], &outMaxL[i], &outRMSL[i], &outMinR[i], &outMaxR[i], &outRMSR[i], &interleavedSamples[i * 4], outBucketCount - i);
+	}
+#endif
+
+	static constexpr WaveformKernels ScalarWaveformKernels = { ReduceBucketPairs_Scalar, ReduceInterleavedStereoFramePairs_Scalar, };
+#if AUDIO_WAVEFORM_KERNELS_X86
+	static constexpr WaveformKernels SSE2WaveformKernels = { ReduceBucketPairs_SSE2, ReduceInterleavedStereoFramePairs_SSE2, };
+#endif
+
+	const WaveformKernels& GetWaveformKernels(MixKernelSet set)
+	{
+		assert(IsMixKernelSetSupported(set));
+		switch (set)
+		{
+#if AUDIO_WAVEFORM_KERNELS_X86
+		case MixKernelSet::SSE2: return SSE2WaveformKernels;
+		case MixKernelSet::AVX2: return SSE2WaveformKernels;
+#endif
+		default: return ScalarWaveformKernels;
+		}
+	}
+
+	const WaveformKernels& GetWaveformKernels()
+	{
+		static const WaveformKernels& bestSupportedKernels = GetWaveformKernels(GetBestSupportedMixKernelSet());
+		return bestSupportedKernels;
+	}
+
+	void WaveformMipChain::BeginIncrementalMipChainGeneration(i64 frameCount, u32 sampleRate, b8 includeFullSizeMip)
+	{
+		Duration = FramesToTime(frameCount, sampleRate);
+		SourceFrameCount = frameCount;
+		IncludesFullSizeMip = includeFullSizeMip;
+		for (auto& mip : AllMips)
+			mip = {};
+
+		// NOTE: No need to waste memory storing the full size mip (nor the next few finer ones) if they are already duplicated inside the source buffer,
+		//		 which can then be read from directly instead
+		const size_t framesPerBucket = GetBaseMipFramesPerBucket();
+		WaveformMip& baseMip = AllMips[0];
+		baseMip.PowerOfTwoSampleCount = (frameCount > 0) ? ClampBot<size_t>(RoundUpToPowerOfTwo(static_cast<u32>(frameCount)) / framesPerBucket, 1) : 0;
+		baseMip.TimePerSample = Time::FromSec(static_cast<f64>(framesPerBucket) / static_cast<f64>(sampleRate));
+		baseMip.SamplesPerSecond = static_cast<f64>(sampleRate) / static_cast<f64>(framesPerBucket);
+		baseMip.BucketCount = static_cast<size_t>((frameCount + static_cast<i64>(framesPerBucket - 1)) / static_cast<i64>(framesPerBucket));
+
+		// NOTE: Only storing buckets that actually cover source frames instead of padding each mip up to its power of two size.
+		//		 Going all the way down to a single bucket so that no matter how far zoomed out there is always a mip with at most one bucket per pixel
+		size_t totalBucketCount = baseMip.BucketCount;
+		for (size_t i = 1; i < MaxMipLevels; i++)
+		{
+			const WaveformMip& parentMip = AllMips[i - 1];
+			if (parentMip.BucketCount <= 1)
+				break;
+
+			WaveformMip& newMip = AllMips[i];
+			newMip.PowerOfTwoSampleCount = (parentMip.PowerOfTwoSampleCount / 2);
+			newMip.TimePerSample = (parentMip.TimePerSample * 2.0);
+			newMip.SamplesPerSecond = (parentMip.SamplesPerSecond / 2.0);
+			newMip.BucketOffset = (parentMip.BucketOffset + (parentMip.BucketCount * 3));
+			newMip.BucketCount = (parentMip.BucketCount + 1) / 2;
+			totalBucketCount += newMip.BucketCount;
+		}
+
+		BucketData.clear();
+		BucketData.resize(totalBucketCount * 3, 0);
+	}
+
+	// NOTE: Source frames processed at once when generating base mip buckets, each chunk being reduced on the stack before being stored into the base mip
+	static constexpr size_t BaseMipChunkFrameCount = 4096;
+	static_assert((WaveformMipChain::BaseMipFramesPerBucket & (WaveformMipChain::BaseMipFramesPerBucket - 1)) == 0 && WaveformMipChain::BaseMipFramesPerBucket >= 2);
+	static_assert((BaseMipChunkFrameCount % WaveformMipChain::BaseMipFramesPerBucket) == 0);
+
+	// NOTE: Number of pairwise reductions from buckets of two frames down to base mip buckets
+	static constexpr size_t BaseMipFramePairReductionLevels = []() { size_t levels = 0; for (size_t frames = 2; frames < WaveformMipChain::BaseMipFramesPerBucket; frames *= 2) levels++; return levels; }();
+
+	// NOTE: Trailing bucket of an odd frame count only covering a single frame
+	static inline void SetSingleFrameBucket(i16* outMin, i16* outMax, i16* outRMS, i16 sample)
+	{
+		*outMin = *outMax = sample;
+		*outRMS = static_cast<i16>(Min<i32>(Absolute(static_cast<i32>(sample)), I16Max));
+	}
+
+	// NOTE: Reduces buckets of frame pairs in place down to base mip buckets, carrying over the trailing bucket of an odd bucket count as is at every level.
+	//		 Bit-identical to generating all of the finer mip levels in between (as GenerateChildMipBuckets() would) and then copying over the last one
+	static void StoreBaseMipBuckets(WaveformMipChain& chain, size_t baseBucket, i16* pairMin, i16* pairMax, i16* pairRMS, size_t pairBucketCount, const WaveformKernels& kernels)
+	{
+		size_t bucketCount = pairBucketCount;
+		for (size_t level = 0; level < BaseMipFramePairReductionLevels; level++)
+		{
+			const size_t pairCount = (bucketCount / 2);
+			kernels.ReduceBucketPairs(pairMin, pairMax, pairRMS, pairMin, pairMax, pairRMS, pairCount);
+			if ((bucketCount % 2) != 0)
+			{
+				pairMin[pairCount] = pairMin[bucketCount - 1];
+				pairMax[pairCount] = pairMax[bucketCount - 1];
+				pairRMS[pairCount] = pairRMS[bucketCount - 1];
+			}
+			bucketCount = (pairCount + (bucketCount % 2));
+		}
+
+		const WaveformMip& baseMip = chain.AllMips[0];
+		assert((baseBucket + bucketCount) <= baseMip.BucketCount);
+		::memcpy(&chain.GetMinBuckets(baseMip)[baseBucket], pairMin, bucketCount * sizeof(i16));
+		::memcpy(&chain.GetMaxBuckets(baseMip)[baseBucket], pairMax, bucketCount * sizeof(i16));
+		::memcpy(&chain.GetRMSBuckets(baseMip)[baseBucket], pairRMS, bucketCount * sizeof(i16));
+	}
+
+	// NOTE: Base mip buckets [firstBucket, endBucket) of a single channel, gathering the channel samples into a contiguous stack buffer first
+	//		 so that they can be reduced by the same kernel as all other mips
+	static void GenerateBaseMipBuckets(WaveformMipChain& chain, const PCMSampleBuffer& inSampleBuffer, u32 channelIndex, size_t firstBucket, size_t endBucket, const WaveformKernels& kernels)
+	{
+		static constexpr size_t gatherFrameCount = BaseMipChunkFrameCount;
+		i16 channelSamples[gatherFrameCount];
+		i16 pairMin[gatherFrameCount / 2], pairMax[gatherFrameCount / 2], pairRMS[gatherFrameCount / 2];
+
+		const WaveformMip& baseMip = chain.AllMips[0];
+		const size_t framesPerBucket = chain.GetBaseMipFramesPerBucket();
+		const size_t endFrame = Min(endBucket * framesPerBucket, static_cast<size_t>(chain.SourceFrameCount));
+
+		i16* minBuckets = chain.GetMinBuckets(baseMip);
+		i16* maxBuckets = chain.GetMaxBuckets(baseMip);
+		i16* rmsBuckets = chain.GetRMSBuckets(baseMip);
+		const i16* interleavedSamples = inSampleBuffer.InterleavedSamples.get();
+		const size_t channelCount = inSampleBuffer.ChannelCount;
+
+		for (size_t chunkFrame = (firstBucket * framesPerBucket); chunkFrame < endFrame; chunkFrame += gatherFrameCount)
+		{
+			const size_t chunkFrameCount = Min(gatherFrameCount, endFrame - chunkFrame);
+			for (size_t i = 0; i < chunkFrameCount; i++)
+				channelSamples[i] = interleavedSamples[((chunkFrame + i) * channelCount) + channelIndex];
+
+			const size_t chunkBucket = (chunkFrame / framesPerBucket);
+			if (chain.IncludesFullSizeMip)
+			{
+				for (size_t i = 0; i < chunkFrameCount; i++)
+				{
+					minBuckets[chunkBucket + i] = maxBuckets[chunkBucket + i] = channelSamples[i];
+					rmsBuckets[chunkBucket + i] = static_cast<i16>(Min<i32>(Absolute(static_cast<i32>(channelSamples[i])), I16Max));
+				}
+			}
+			else
+			{
+				const size_t pairCount = (chunkFrameCount / 2);
+				kernels.ReduceBucketPairs(pairMin, pairMax, pairRMS, channelSamples, channelSamples, channelSamples, pairCount);
+				if ((chunkFrameCount % 2) != 0)
+					SetSingleFrameBucket(&pairMin[pairCount], &pairMax[pairCount], &pairRMS[pairCount], channelSamples[chunkFrameCount - 1]);
+
+				StoreBaseMipBuckets(chain, chunkBucket, pairMin, pairMax, pairRMS, pairCount + (chunkFrameCount % 2), kernels);
+			}
+		}
+	}
+
+	// NOTE: Same as calling GenerateBaseMipBuckets() for both channels but reading each interleaved stereo frame only once
+	static void GenerateStereoBaseMipBuckets(WaveformMipChain& left, WaveformMipChain& right, const PCMSampleBuffer& inSampleBuffer, size_t firstBucket, size_t endBucket, const WaveformKernels& kernels)
+	{
+		if (inSampleBuffer.ChannelCount != 2 || left.IncludesFullSizeMip)
+		{
+			GenerateBaseMipBuckets(left, inSampleBuffer, 0, firstBucket, endBucket, kernels);
+			GenerateBaseMipBuckets(right, inSampleBuffer, 1, firstBucket, endBucket, kernels);
+			return;
+		}
+
+		i16 pairMinL[BaseMipChunkFrameCount / 2], pairMaxL[BaseMipChunkFrameCount / 2], pairRMSL[BaseMipChunkFrameCount / 2];
+		i16 pairMinR[BaseMipChunkFrameCount / 2], pairMaxR[BaseMipChunkFrameCount / 2], pairRMSR[BaseMipChunkFrameCount / 2];
+
+		const size_t framesPerBucket = left.GetBaseMipFramesPerBucket();
+		const size_t endFrame = Min(endBucket * framesPerBucket, static_cast<size_t>(left.SourceFrameCount));
+		const i16* interleavedSamples = inSampleBuffer.InterleavedSamples.get();
+
+		for (size_t chunkFrame = (firstBucket * framesPerBucket); chunkFrame < endFrame; chunkFrame += BaseMipChunkFrameCount)
+		{
+			const size_t chunkFrameCount = Min(BaseMipChunkFrameCount, endFrame - chunkFrame);
+			const size_t pairCount = (chunkFrameCount / 2);
+			kernels.ReduceInterleavedStereoFramePairs(pairMinL, pairMaxL, pairRMSL, pairMinR, pairMaxR, pairRMSR, &interleavedSamples[chunkFrame * 2], pairCount);
+			if ((chunkFrameCount % 2) != 0)
+			{
+				const i16* lastFrame = &interleavedSamples[(chunkFrame + chunkFrameCount - 1) * 2];
+				SetSingleFrameBucket(&pairMinL[pairCount], &pairMaxL[pairCount], &pairRMSL[pairCount], lastFrame[0]);
+				SetSingleFrameBucket(&pairMinR[pairCount], &pairMaxR[pairCount], &pairRMSR[pairCount], lastFrame[1]);
+			}
+
+			const size_t chunkBucket = (chunkFrame / framesPerBucket);
+			StoreBaseMipBuckets(left, chunkBucket, pairMinL, pairMaxL, pairRMSL, pairCount + (chunkFrameCount % 2), kernels);
+			StoreBaseMipBuckets(right, chunkBucket, pairMinR, pairMaxR, pairRMSR, pairCount + (chunkFrameCount % 2), kernels);
+		}
+	}
+
+	// NOTE: Mip buckets [firstBucket, endBucket) reduced from their parent buckets, with endBucket possibly being the trailing bucket of an odd parent bucket count
+	static void GenerateChildMipBuckets(WaveformMipChain& chain, size_t mipIndex, size_t firstBucket, size_t endBucket, const WaveformKernels& kernels)
+	{
+		const WaveformMip& parentMip = chain.AllMips[mipIndex - 1];
+		const WaveformMip& thisMip = chain.AllMips[mipIndex];
+
+		const i16* parentMin = chain.GetMinBuckets(parentMip);
+		const i16* parentMax = chain.GetMaxBuckets(parentMip);
+		const i16* parentRMS = chain.GetRMSBuckets(parentMip);
+		i16* thisMin = chain.GetMinBuckets(thisMip);
+		i16* thisMax = chain.GetMaxBuckets(thisMip);
+		i16* thisRMS = chain.GetRMSBuckets(thisMip);
+
+		const size_t pairsToFill = Min(endBucket, parentMip.BucketCount / 2);
+		if (pairsToFill > firstBucket)
+			kernels.ReduceBucketPairs(&thisMin[firstBucket], &thisMax[firstBucket], &thisRMS[firstBucket], &parentMin[firstBucket * 2], &parentMax[firstBucket * 2], &parentRMS[firstBucket * 2], pairsToFill - firstBucket);
+
+		// NOTE: Trailing bucket of an odd parent bucket count only covering a single parent bucket
+		if (endBucket > pairsToFill)
+		{
+			thisMin[pairsToFill] = parentMin[pairsToFill * 2];
+			thisMax[pairsToFill] = parentMax[pairsToFill * 2];
+			thisRMS[pairsToFill] = parentRMS[pairsToFill * 2];
+		}
+	}
+
+	static size_t GetReadableBaseMipBucketCount(const WaveformMipChain& chain, i64 readableFrameCount)
+	{
+		const b8 allFramesReadable = (readableFrameCount >= chain.SourceFrameCount);
+		return allFramesReadable ? chain.AllMips[0].BucketCount : (static_cast<size_t>(readableFrameCount) / chain.GetBaseMipFramesPerBucket());
+	}
+
+	// NOTE: Catches up all non-base mips to the generated buckets of their parent
+	static void ContinueChildMipGeneration(WaveformMipChain& chain, const WaveformKernels& kernels)
+	{
+		for (size_t i = 1; i < WaveformMipChain::MaxMipLevels; i++)
+		{
+			const WaveformMip& parentMip = chain.AllMips[i - 1];
+			WaveformMip& thisMip = chain.AllMips[i];
+			if (thisMip.PowerOfTwoSampleCount == 0)
+				break;
+
+			const b8 parentIsComplete = (parentMip.GeneratedBucketCount == parentMip.BucketCount);
+			const size_t bucketsToFill = parentIsComplete ? thisMip.BucketCount : (parentMip.GeneratedBucketCount / 2);
+			if (bucketsToFill <= thisMip.GeneratedBucketCount)
+				continue;
+
+			GenerateChildMipBuckets(chain, i, thisMip.GeneratedBucketCount, bucketsToFill, kernels);
+			thisMip.GeneratedBucketCount = bucketsToFill;
+		}
+	}
+
+	void WaveformMipChain::ContinueIncrementalMipChainGeneration(const PCMSampleBuffer& inSampleBuffer, u32 channelIndex, i64 readableFrameCount, const WaveformKernels& kernels)
+	{
+		assert(inSampleBuffer.InterleavedSamples != nullptr && channelIndex < inSampleBuffer.ChannelCount && inSampleBuffer.FrameCount == SourceFrameCount);
+		readableFrameCount = Clamp<i64>(readableFrameCount, 0, SourceFrameCount);
+
+		WaveformMip& baseMip = AllMips[0];
+		if (baseMip.PowerOfTwoSampleCount == 0)
+			return;
+
+		const size_t bucketsToFill = GetReadableBaseMipBucketCount(*this, readableFrameCount);
+		if (bucketsToFill > baseMip.GeneratedBucketCount)
+			GenerateBaseMipBuckets(*this, inSampleBuffer, channelIndex, baseMip.GeneratedBucketCount, bucketsToFill, kernels);
+		baseMip.GeneratedBucketCount = Max(baseMip.GeneratedBucketCount, bucketsToFill);
+
+		ContinueChildMipGeneration(*this, kernels);
+	}
+
+	// NOTE: Base mip buckets per segment, with every mip up to ParallelSegmentMipLevels having an integer number of buckets inside each aligned segment.
+	//		 Large enough to amortize the thread overhead while still splitting a few seconds of audio across multiple threads (about 1.4 seconds per segment at 48 kHz)
+	static constexpr size_t ParallelSegmentMipLevels = 10;
+	static constexpr size_t ParallelSegmentBucketCount = (static_cast<size_t>(1) << ParallelSegmentMipLevels);
+
+	void WaveformMipChain::ContinueIncrementalStereoMipChainGeneration(WaveformMipChain& left, WaveformMipChain* right, const PCMSampleBuffer& inSampleBuffer, i64 readableFrameCount, u32 maxThreadCount, const WaveformKernels& kernels)
+	{
+		assert(inSampleBuffer.InterleavedSamples != nullptr && inSampleBuffer.FrameCount == left.SourceFrameCount);
+		if (right != nullptr && (inSampleBuffer.ChannelCount < 2 || right->IsEmpty()))
+			right = nullptr;
+		assert(right == nullptr || (right->SourceFrameCount == left.SourceFrameCount && right->IncludesFullSizeMip == left.IncludesFullSizeMip && right->AllMips[0].GeneratedBucketCount == left.AllMips[0].GeneratedBucketCount));
+		readableFrameCount = Clamp<i64>(readableFrameCount, 0, left.SourceFrameCount);
+
+		if (left.IsEmpty())
+			return;
+
+		const auto continueSerial = [&](i64 serialReadableFrameCount)
+		{
+			WaveformMip& baseMip = left.AllMips[0];
+			const size_t bucketsToFill = GetReadableBaseMipBucketCount(left, serialReadableFrameCount);
+			if (bucketsToFill > baseMip.GeneratedBucketCount)
+			{
+				if (right != nullptr)
+					GenerateStereoBaseMipBuckets(left, *right, inSampleBuffer, baseMip.GeneratedBucketCount, bucketsToFill, kernels);
+				else
+					GenerateBaseMipBuckets(left, inSampleBuffer, 0, baseMip.GeneratedBucketCount, bucketsToFill, kernels);
+
+				baseMip.GeneratedBucketCount = bucketsToFill;
+				if (right != nullptr)
+					right->AllMips[0].GeneratedBucketCount = bucketsToFill;
+			}
+
+			ContinueChildMipGeneration(left, kernels);
+			if (right != nullptr)
+				ContinueChildMipGeneration(*right, kernels);
+		};
+
+		// NOTE: Only the segments entirely within the readable frames are processed in parallel, each one going through all of its contained mip levels
+		//		 so that no thread ever has to wait on another. Everything before the first and after the last full segment is then handled serially,
+		//		 including all mip levels too coarse to be contained within a single segment
+		const size_t framesPerBucket = left.GetBaseMipFramesPerBucket();
+		const size_t firstSegment = (left.AllMips[0].GeneratedBucketCount + (ParallelSegmentBucketCount - 1)) / ParallelSegmentBucketCount;
+		const size_t endSegment = (static_cast<size_t>(readableFrameCount) / framesPerBucket) / ParallelSegmentBucketCount;
+		const size_t segmentCount = (endSegment > firstSegment) ? (endSegment - firstSegment) : 0;
+		const size_t threadCount = Min<size_t>((maxThreadCount > 0) ? maxThreadCount : Max(std::thread::hardware_concurrency(), 1u), segmentCount);
+
+		if (threadCount > 1)
+		{
+			continueSerial(static_cast<i64>(firstSegment * ParallelSegmentBucketCount * framesPerBucket));
+
+			std::atomic<size_t> nextSegment = firstSegment;
+			const auto workerFunc = [&]()
+			{
+				for (size_t segment = nextSegment++; segment < endSegment; segment = nextSegment++)
+				{
+					const size_t firstBucket = (segment * ParallelSegmentBucketCount), endBucket = (firstBucket + ParallelSegmentBucketCount);
+					if (right != nullptr)
+						GenerateStereoBaseMipBuckets(left, *right, inSampleBuffer, firstBucket, endBucket, kernels);
+					else
+						GenerateBaseMipBuckets(left, inSampleBuffer, 0, firstBucket, endBucket, kernels);
+
+					// NOTE: Skipping the mips that are already complete, such as the coarse ones loaded from a cache entry
+					for (size_t i = 1; i <= ParallelSegmentMipLevels && left.AllMips[i].PowerOfTwoSampleCount != 0; i++)
+					{
+						if (left.AllMips[i].GeneratedBucketCount < left.AllMips[i].BucketCount)
+							GenerateChildMipBuckets(left, i, (firstBucket >> i), (endBucket >> i), kernels);
+						if (right != nullptr && right->AllMips[i].GeneratedBucketCount < right->AllMips[i].BucketCount)
+							GenerateChildMipBuckets(*right, i, (firstBucket >> i), (endBucket >> i), kernels);
+					}
+				}
+			};
+
+			std::vector<std::thread> workerThreads;
+			workerThreads.reserve(threadCount - 1);
+			for (size_t i = 1; i < threadCount; i++)
+				workerThreads.emplace_back(workerFunc);
+			workerFunc();
+			for (std::thread& thread : workerThreads)
+				thread.join();
+
+			for (WaveformMipChain* chain : { &left, right })
+			{
+				for (size_t i = 0; chain != nullptr && i <= ParallelSegmentMipLevels && chain->AllMips[i].PowerOfTwoSampleCount != 0; i++)
+					chain->AllMips[i].GeneratedBucketCount = Max(chain->AllMips[i].GeneratedBucketCount, ((endSegment * ParallelSegmentBucketCount) >> i));
+			}
+		}
+
+		continueSerial(readableFrameCount);
+	}
+}
@@ -6,76 +6,68 @@
 
 namespace Audio
 {
-	constexpr i16 AverageTwoI16SamplesTogether(i16 a, i16 b) { return static_cast<i16>((static_cast<i32>(a) + static_cast<i32>(b)) / 2); };
+	// NOTE: Signed min / max sample values and the root mean square of all source samples covered by a single mip bucket
+	struct WaveformBucket
+	{
+		i16 Min, Max, RMS;
+	};
+
+	// NOTE: Inner loop of the mip generation, reducing each pair of input buckets into a single output bucket (out[i] = in[(i * 2) + 0] + in[(i * 2) + 1]).
+	//		 Raw samples are reduced by passing the same array for all three inputs. The vectorized versions produce bit-identical results to the scalar one.
+	//		 The outputs may alias the inputs (out == in) to reduce buckets in place, as no input is ever read after its output index has been written
+	struct WaveformKernels
+	{
+		void(*ReduceBucketPairs)(i16* outMin, i16* outMax, i16* outRMS, const i16* inMin, const i16* inMax, const i16* inRMS, size_t outBucketCount);
+		// NOTE: Same as de-interleaving both channels of (outBucketCount * 2) stereo frames and passing each of them to ReduceBucketPairs()
+		void(*ReduceInterleavedStereoFramePairs)(i16* outMinL, i16* outMaxL, i16* outRMSL, i16* outMinR, i16* outMaxR, i16* outRMSR, const i16* interleavedSamples, size_t outBucketCount);
+	};
+
+	// NOTE: Using the same kernel sets as the mix kernels, with the AVX2 set falling back to SSE2 as this is entirely memory bound
+	const WaveformKernels& GetWaveformKernels(MixKernelSet set);
+	const WaveformKernels& GetWaveformKernels();
 
 	struct WaveformMip
 	{
 		size_t PowerOfTwoSampleCount = {};
 		Time TimePerSample = {};
 		f64 SamplesPerSecond = {};
-		std::vector<i16> AbsoluteSamples {};
+		size_t BucketOffset = {};
+		size_t BucketCount = {};
+		size_t GeneratedBucketCount = {};
 
 		inline Time GetDuration() const
 		{
-			return Time::FromSec(static_cast<f64>(AbsoluteSamples.size()) / SamplesPerSecond);
-		}
-
-		inline i16 SampleAtIndexOrZero(size_t sampleIndex) const
-		{
-			return (sampleIndex < AbsoluteSamples.size()) ? AbsoluteSamples[sampleIndex] : static_cast<i16>(0);
-		}
-
-		inline i16 LinearSampleAtTimeOrZero(Time time) const
-		{
-			const f32 sampleIndexF32 = static_cast<f32>(time.Seconds * SamplesPerSecond);
-			const f32 sampleIndexFraction = sampleIndexF32 - static_cast<i32>(sampleIndexF32);
-
-			const size_t sampleIndexLo = (sampleIndexF32 <= 0.0f) ? 0 : static_cast<size_t>(sampleIndexF32);
-			const size_t sampleIndexHi = (sampleIndexLo + 1);
-
-			const i16 sampleLo = SampleAtIndexOrZero(sampleIndexLo);
-			const i16 sampleHi = SampleAtIndexOrZero(sampleIndexHi);
-
-			const f32 normalizedSampleLo = static_cast<f32>(sampleLo / static_cast<f32>(I16Max));
-			const f32 normalizedSampleHi = static_cast<f32>(sampleHi / static_cast<f32>(I16Max));
-			const f32 normalizedSample = Lerp(normalizedSampleLo, normalizedSampleHi, sampleIndexFraction);
-
-			return static_cast<i16>(normalizedSample * static_cast<f32>(I16Max));
-		}
-
-		f32 AverageNormalizedSampleInTimeRange(Time startTime, Time endTime) const
-		{
-			if (TimePerSample.Seconds <= 0.0) { assert(false); return 0.0f; }
-
-			i32 sampleSum = 0, sampleCount = 0;
-			for (Time timeIt = startTime; timeIt < endTime; timeIt += TimePerSample) { sampleSum += LinearSampleAtTimeOrZero(timeIt); sampleCount++; }
-
-			const i32 sampleAverage = (sampleSum / Max(sampleCount, 1));
-			return sampleAverage / static_cast<f32>(I16Max);
-		}
-
-		void Clear()
-		{
-			PowerOfTwoSampleCount = {};
-			TimePerSample = {};
-			SamplesPerSecond = {};
-			AbsoluteSamples.clear();
+			return Time::FromSec(static_cast<f64>(BucketCount) / SamplesPerSecond);
 		}
 	};
 
 	struct WaveformMipChain
 	{
-		static constexpr size_t MaxMipLevels = 24;
-		static constexpr size_t MinMipSampleCount = 256;
+		// NOTE: Enough for the coarsest mip to cover any u32 frame count with a single bucket
+		static constexpr size_t MaxMipLevels = 32;
+		// NOTE: A pixel never covers more than two buckets of the mip returned by FindClosestMip(), plus the partially covered ones at either end
+		static constexpr size_t MaxBucketsPerQuery = 4;
+		// NOTE: Source frames covered by each base mip bucket (unless the full size mip is included), instead of only two.
+		//		 Keeps the chain of a long song down to a few MB per channel, with anything zoomed in further than that reading the source samples directly
+		static constexpr size_t BaseMipFramesPerBucket = 64;
 
 		WaveformMip AllMips[MaxMipLevels] {};
+		// NOTE: Single allocation for all mips, each storing its min, max and RMS arrays back to back starting at its BucketOffset
+		std::vector<i16> BucketData {};
 		Time Duration {};
+		i64 SourceFrameCount {};
+		b8 IncludesFullSizeMip {};
 
 		inline b8 IsEmpty() const
 		{
 			return AllMips[0].PowerOfTwoSampleCount == 0;
 		}
 
+		inline size_t GetBaseMipFramesPerBucket() const
+		{
+			return IncludesFullSizeMip ? 1 : BaseMipFramesPerBucket;
+		}
+
 		inline i32 GetUsedMipCount() const
 		{
 			for (i32 i = 0; i < static_cast<i32>(MaxMipLevels); i++)
@@ -86,95 +78,113 @@ namespace Audio
 			return static_cast<i32>(MaxMipLevels);
 		}
 
+		inline const i16* GetMinBuckets(const WaveformMip& mip) const { return BucketData.data() + mip.BucketOffset + (mip.BucketCount * 0); }
+		inline const i16* GetMaxBuckets(const WaveformMip& mip) const { return BucketData.data() + mip.BucketOffset + (mip.BucketCount * 1); }
+		inline const i16* GetRMSBuckets(const WaveformMip& mip) const { return BucketData.data() + mip.BucketOffset + (mip.BucketCount * 2); }
+		inline i16* GetMinBuckets(const WaveformMip& mip) { return BucketData.data() + mip.BucketOffset + (mip.BucketCount * 0); }
+		inline i16* GetMaxBuckets(const WaveformMip& mip) { return BucketData.data() + mip.BucketOffset + (mip.BucketCount * 1); }
+		inline i16* GetRMSBuckets(const WaveformMip& mip) { return BucketData.data() + mip.BucketOffset + (mip.BucketCount * 2); }
+
+		inline WaveformBucket GetBucketAtIndexOrZero(const WaveformMip& mip, size_t bucketIndex) const
+		{
+			if (bucketIndex >= mip.BucketCount)
+				return WaveformBucket {};
+			return WaveformBucket { GetMinBuckets(mip)[bucketIndex], GetMaxBuckets(mip)[bucketIndex], GetRMSBuckets(mip)[bucketIndex] };
+		}
+
+		// NOTE: Coarsest mip that still has at least one bucket per pixel, so that no peak can ever be skipped over
 		inline const WaveformMip& FindClosestMip(Time timePerPixel) const
 		{
 			const WaveformMip* closestMip = &AllMips[0];
 			for (size_t i = 1; i < MaxMipLevels; i++)
 			{
-				if (AllMips[i].PowerOfTwoSampleCount == 0)
+				if (AllMips[i].PowerOfTwoSampleCount == 0 || AllMips[i].TimePerSample > timePerPixel)
 					break;
-				if (Absolute((AllMips[i].TimePerSample - timePerPixel).Seconds < Absolute((closestMip->TimePerSample - timePerPixel).Seconds)))
-					closestMip = &AllMips[i];
+				closestMip = &AllMips[i];
 			}
 			return *closestMip;
 		}
 
-		inline f32 GetAmplitudeAt(const WaveformMip& mip, Time time, Time timePerPixel) const
+		// NOTE: Combines all buckets overlapping the time range, reading at most MaxBucketsPerQuery of them
+		inline WaveformBucket GetBucketInTimeRange(const WaveformMip& mip, Time startTime, Time endTime) const
 		{
-			return mip.AverageNormalizedSampleInTimeRange(time, time + timePerPixel);
+			const i64 firstBucketIndex = ClampBot(static_cast<i64>(Floor(startTime.Seconds * mip.SamplesPerSecond)), static_cast<i64>(0));
+			const i64 lastBucketIndex = Min(Min(static_cast<i64>(Ceil(endTime.Seconds * mip.SamplesPerSecond)), firstBucketIndex + static_cast<i64>(MaxBucketsPerQuery)), static_cast<i64>(mip.BucketCount));
+			if (firstBucketIndex >= lastBucketIndex)
+				return WaveformBucket {};
+
+			const i16* minBuckets = GetMinBuckets(mip);
+			const i16* maxBuckets = GetMaxBuckets(mip);
+			const i16* rmsBuckets = GetRMSBuckets(mip);
+
+			WaveformBucket result = { I16Max, I16Min, 0 };
+			i64 squaredSum = 0;
+			for (i64 i = firstBucketIndex; i < lastBucketIndex; i++)
+			{
+				result.Min = Min(result.Min, minBuckets[i]);
+				result.Max = Max(result.Max, maxBuckets[i]);
+				squaredSum += (static_cast<i64>(rmsBuckets[i]) * static_cast<i64>(rmsBuckets[i]));
+			}
+			result.RMS = static_cast<i16>(::sqrt(static_cast<f64>(squaredSum) / static_cast<f64>(lastBucketIndex - firstBucketIndex)) + 0.5);
+			return result;
 		}
 
-		inline void GenerateEntireMipChainFromSampleBuffer(const PCMSampleBuffer& inSampleBuffer, u32 channelIndex, b8 includeFullSizeMip = false)
+		// NOTE: Normalized peak amplitude of the time range
+		inline f32 GetAmplitudeAt(const WaveformMip& mip, Time time, Time timePerPixel) const
 		{
-			assert(inSampleBuffer.InterleavedSamples != nullptr && channelIndex < inSampleBuffer.ChannelCount);
+			const WaveformBucket bucket = GetBucketInTimeRange(mip, time, time + timePerPixel);
+			const i32 peak = Max(-static_cast<i32>(bucket.Min), static_cast<i32>(bucket.Max));
+			return ClampTop(static_cast<f32>(peak) / static_cast<f32>(I16Max), 1.0f);
+		}
 
-			Duration = FramesToTime(inSampleBuffer.FrameCount, inSampleBuffer.SampleRate);
-			if (AllMips[0].PowerOfTwoSampleCount != 0)
-				for (auto& mip : AllMips) mip.Clear();
+		// NOTE: Same as GetAmplitudeAt() but reading the source samples of a single channel directly, for when zoomed in further than the base mip.
+		//		 Limited to the frames the base mip has already been generated from, as the ones after might not have been decoded yet
+		inline f32 GetSourceAmplitudeAt(const PCMSampleBuffer& inSampleBuffer, u32 channelIndex, Time time, Time timePerPixel) const
+		{
+			assert(inSampleBuffer.InterleavedSamples != nullptr && channelIndex < inSampleBuffer.ChannelCount && inSampleBuffer.FrameCount == SourceFrameCount);
+
+			const WaveformMip& baseMip = AllMips[0];
+			const i64 readableFrameCount = (baseMip.GeneratedBucketCount >= baseMip.BucketCount) ? SourceFrameCount : static_cast<i64>(baseMip.GeneratedBucketCount * GetBaseMipFramesPerBucket());
+			const i64 maxFramesPerQuery = static_cast<i64>(MaxBucketsPerQuery * GetBaseMipFramesPerBucket());
+
+			const f64 sampleRate = static_cast<f64>(inSampleBuffer.SampleRate);
+			const i64 firstFrame = ClampBot(static_cast<i64>(Floor(time.Seconds * sampleRate)), static_cast<i64>(0));
+			const i64 endFrame = Min(Min(static_cast<i64>(Ceil((time + timePerPixel).Seconds * sampleRate)), firstFrame + maxFramesPerQuery), readableFrameCount);
+
+			const i16* interleavedSamples = inSampleBuffer.InterleavedSamples.get();
+			const i64 channelCount = static_cast<i64>(inSampleBuffer.ChannelCount);
+			i32 peak = 0;
+			for (i64 frame = firstFrame; frame < endFrame; frame++)
+				peak = Max(peak, Absolute(static_cast<i32>(interleavedSamples[(frame * channelCount) + channelIndex])));
+			return ClampTop(static_cast<f32>(peak) / static_cast<f32>(I16Max), 1.0f);
+		}
 
-			WaveformMip& baseMip = AllMips[0];
-			baseMip.PowerOfTwoSampleCount = RoundUpToPowerOfTwo(static_cast<u32>(inSampleBuffer.FrameCount));
-			baseMip.TimePerSample = Time::FromSec(1.0 / static_cast<f64>(inSampleBuffer.SampleRate));
-			baseMip.SamplesPerSecond = static_cast<f64>(inSampleBuffer.SampleRate);
+		inline void GenerateEntireMipChainFromSampleBuffer(const PCMSampleBuffer& inSampleBuffer, u32 channelIndex, b8 includeFullSizeMip = false, const WaveformKernels& kernels = GetWaveformKernels())
+		{
+			assert(inSampleBuffer.InterleavedSamples != nullptr && channelIndex < inSampleBuffer.ChannelCount);
 
-			if (includeFullSizeMip)
-			{
-				baseMip.AbsoluteSamples.resize(inSampleBuffer.FrameCount);
-				for (size_t frameIndex = 0; frameIndex < static_cast<size_t>(inSampleBuffer.FrameCount); frameIndex++)
-					baseMip.AbsoluteSamples[frameIndex] = Absolute(inSampleBuffer.InterleavedSamples[(frameIndex * inSampleBuffer.ChannelCount) + channelIndex]);
-			}
-			else // NOTE: No need to waste memory storing the full size mip if it won't even get sampled AND is already duplicated inside the source buffer
-			{
-				baseMip.PowerOfTwoSampleCount /= 2;
-				baseMip.TimePerSample = baseMip.TimePerSample * 2.0;
-				baseMip.SamplesPerSecond = baseMip.SamplesPerSecond / 2.0;
-				baseMip.AbsoluteSamples.resize(baseMip.PowerOfTwoSampleCount);
-				const size_t samplesToFill = ClampTop(baseMip.AbsoluteSamples.size(), static_cast<size_t>(inSampleBuffer.FrameCount / 2));
-				for (size_t frameIndex = 0; frameIndex < samplesToFill; frameIndex++)
-				{
-					baseMip.AbsoluteSamples[frameIndex] = AverageTwoI16SamplesTogether(
-						Absolute(inSampleBuffer.InterleavedSamples[(((frameIndex * 2 + 0) * inSampleBuffer.ChannelCount) + channelIndex)]),
-						Absolute(inSampleBuffer.InterleavedSamples[(((frameIndex * 2 + 1) * inSampleBuffer.ChannelCount) + channelIndex)]));
-				}
-			}
+			BeginIncrementalMipChainGeneration(inSampleBuffer.FrameCount, inSampleBuffer.SampleRate, includeFullSizeMip);
+			ContinueIncrementalMipChainGeneration(inSampleBuffer, channelIndex, inSampleBuffer.FrameCount, kernels);
+		}
 
-			// NOTE: First loop (separated) to compute sample counts
-			for (size_t i = 1; i < MaxMipLevels; i++)
-			{
-				const WaveformMip& parentMip = AllMips[i - 1];
-				if (parentMip.PowerOfTwoSampleCount <= MinMipSampleCount)
-					break;
+		// NOTE: For sample buffers that are still being decoded, with all mips allocated upfront and their not yet generated buckets left at zero.
+		//		 Once all frames have been made available the result is identical to that of GenerateEntireMipChainFromSampleBuffer()
+		void BeginIncrementalMipChainGeneration(i64 frameCount, u32 sampleRate, b8 includeFullSizeMip = false);
 
-				WaveformMip& newMip = AllMips[i];
-				newMip.PowerOfTwoSampleCount = (parentMip.PowerOfTwoSampleCount / 2);
-				newMip.TimePerSample = (parentMip.TimePerSample * 2.0);
-				newMip.SamplesPerSecond = (parentMip.SamplesPerSecond / 2.0);
-			}
+		// NOTE: Generates every mip bucket whose source frames are all within the first readableFrameCount frames and hasn't been generated yet
+		void ContinueIncrementalMipChainGeneration(const PCMSampleBuffer& inSampleBuffer, u32 channelIndex, i64 readableFrameCount, const WaveformKernels& kernels = GetWaveformKernels());
 
-			// TODO: Consider having single continuous sample buffer and store view pointer (or start index) inside each WaveformMip
-			[[maybe_unused]] size_t totalSampleCountAcrossAllMips = 0;
-			for (const WaveformMip& mip : AllMips)
-				totalSampleCountAcrossAllMips += (&mip == &baseMip) ? baseMip.AbsoluteSamples.size() : mip.PowerOfTwoSampleCount;
+		// NOTE: Identical result to calling ContinueIncrementalMipChainGeneration() for the first two channels (with the right one being optional)
+		//		 but generating both from a single pass over the interleaved samples, splitting large ranges across up to maxThreadCount threads (zero for all cores).
+		//		 Both chains must have been begun with the same arguments, blocking until all newly readable buckets have been generated
+		static void ContinueIncrementalStereoMipChainGeneration(WaveformMipChain& left, WaveformMipChain* right, const PCMSampleBuffer& inSampleBuffer, i64 readableFrameCount, u32 maxThreadCount = 0, const WaveformKernels& kernels = GetWaveformKernels());
 
-			// NOTE: Second loop to then generate the actual mip sample buffers
-			for (size_t i = 1; i < MaxMipLevels; i++)
-			{
-				const WaveformMip& parentMip = AllMips[i - 1];
-				if (parentMip.PowerOfTwoSampleCount == 0)
-					break;
-				const size_t parentSampleCount = parentMip.AbsoluteSamples.size();
-				const i16* parentSamples = parentMip.AbsoluteSamples.data();
-
-				WaveformMip& thisMip = AllMips[i];
-				thisMip.AbsoluteSamples.resize(thisMip.PowerOfTwoSampleCount);
-				const size_t samplesToFill = ClampTop(thisMip.AbsoluteSamples.size(), (parentSampleCount / 2));
-				for (size_t sampleIndex = 0; sampleIndex < samplesToFill; sampleIndex++)
-				{
-					// ... assert(parentSamples >= &parentMip.AbsoluteSamples.front() && parentSamples <= &parentMip.AbsoluteSamples.back());
-					thisMip.AbsoluteSamples[sampleIndex] = AverageTwoI16SamplesTogether(parentSamples[0], parentSamples[1]);
-					parentSamples += 2;
-				}
-			}
+		inline static void GenerateEntireStereoMipChainsFromSampleBuffer(WaveformMipChain& left, WaveformMipChain* right, const PCMSampleBuffer& inSampleBuffer, b8 includeFullSizeMip = false, u32 maxThreadCount = 0, const WaveformKernels& kernels = GetWaveformKernels())
+		{
+			left.BeginIncrementalMipChainGeneration(inSampleBuffer.FrameCount, inSampleBuffer.SampleRate, includeFullSizeMip);
+			if (right != nullptr)
+				right->BeginIncrementalMipChainGeneration(inSampleBuffer.FrameCount, inSampleBuffer.SampleRate, includeFullSizeMip);
+			ContinueIncrementalStereoMipChainGeneration(left, right, inSampleBuffer, inSampleBuffer.FrameCount, maxThreadCount, kernels);
 		}
 	};
 }
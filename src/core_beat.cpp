@@ -1,9 +1,9 @@
 #include "core_beat.h"
 #include <algorithm>
 
-Time TempoMapAccelerationStructure::ConvertBeatToTimeUsingLookupTableIndexing(Beat beat) const
+Time TempoMapAccelerationStructure::ConvertBeatToTimeUsingSegmentBinarySearch(Beat beat) const
 {
-	const i32 beatTickToTimesCount = static_cast<i32>(BeatTickToTimes.size());
+	const i32 beatTickToTimesCount = Segments.empty() ? 0 : (Segments.back().BeatTicks + 1);
 	const i32 totalBeatTicks = beat.Ticks;
 
 	if (totalBeatTicks < 0) // NOTE: Negative tick (tempo changes are assumed to only be positive)
@@ -26,20 +26,20 @@ Time TempoMapAccelerationStructure::ConvertBeatToTimeUsingLookupTableIndexing(Be
 		const i32 remainingTicks = (totalBeatTicks - beatTickToTimesCount) + 1;
 		return lastTime + (lastTickDuration * remainingTicks);
 	}
-	else // NOTE: Use the pre calculated lookup table directly
+	else // NOTE: Find the containing tempo segment and offset from its start
 	{
-		return BeatTickToTimes.at(totalBeatTicks);
+		return GetTickTime(FindSegmentIndexForBeatTicks(totalBeatTicks), totalBeatTicks);
 	}
 }
 
-Beat TempoMapAccelerationStructure::ConvertTimeToBeatUsingLookupTableBinarySearch(Time time) const
+Beat TempoMapAccelerationStructure::ConvertTimeToBeatUsingSegmentBinarySearch(Time time) const
 {
-	return ConvertTimeToBeatUsingLookupTableBinarySearch(time, false);
+	return ConvertTimeToBeatUsingSegmentBinarySearch(time, false);
 }
 
-Beat TempoMapAccelerationStructure::ConvertTimeToBeatUsingLookupTableBinarySearch(Time time, bool truncTo0) const
+Beat TempoMapAccelerationStructure::ConvertTimeToBeatUsingSegmentBinarySearch(Time time, bool truncTo0) const
 {
-	const i32 beatTickToTimesCount = static_cast<i32>(BeatTickToTimes.size());
+	const i32 beatTickToTimesCount = Segments.empty() ? 0 : (Segments.back().BeatTicks + 1);
 	const Time lastTime = GetLastCalculatedTime();
 
 	if (time < Time::FromSec(0.0)) // NOTE: Negative time
@@ -63,33 +63,40 @@ Beat TempoMapAccelerationStructure::ConvertTimeToBeatUsingLookupTableBinarySearc
 		// NOTE: And add it to the last tick
 		return Beat(static_cast<i32>(beatTickToTimesCount + ticks - 1));
 	}
-	else // NOTE: Perform a binary search
+	else // NOTE: Binary search for the containing tempo segment then solve for the tick within it
 	{
-		i32 left = 0, right = beatTickToTimesCount - 1;
-
-		while (left <= right)
-		{
-			const i32 mid = (left + right) / 2;
-
-			if (time < BeatTickToTimes[mid])
-				right = mid - 1;
-			else if (time > BeatTickToTimes[mid])
-				left = mid + 1;
-			else
-				return Beat::FromTicks(mid);
-		}
-
-		// left > right
+		// NOTE: The last segment always starts at the last calculated time so (segmentIndex + 1) is guaranteed to be valid here
+		const auto segmentIt = std::upper_bound(Segments.begin(), Segments.end(), time, [](Time t, const TempoSegment& segment) { return t.Seconds < segment.StartTime; });
+		const size_t segmentIndex = static_cast<size_t>(std::distance(Segments.begin(), segmentIt)) - 1;
+		const TempoSegment& segment = Segments[segmentIndex];
+		const TempoSegment& nextSegment = Segments[segmentIndex + 1];
+
+		// NOTE: Estimate analytically first and then correct by stepping so the result exactly matches that of searching through all tick times
+		const i32 segmentTickCount = (nextSegment.BeatTicks - segment.BeatTicks);
+		const f64 estimatedTicks = (segment.TickDuration > 0.0) ? Floor((time.Seconds - segment.StartTime) / segment.TickDuration) : 0.0;
+		i32 right = segment.BeatTicks + ((estimatedTicks >= 0.0) ? static_cast<i32>(Min(estimatedTicks, static_cast<f64>(segmentTickCount - 1))) : 0);
+
+		while (right > segment.BeatTicks && GetTickTime(segmentIndex, right) > time)
+			right--;
+		while ((right + 1) < nextSegment.BeatTicks && GetTickTime(segmentIndex, right + 1) <= time)
+			right++;
+
+		const Time rightTime = GetTickTime(segmentIndex, right);
+		if (rightTime == time)
+			return Beat::FromTicks(right);
+
+		const i32 left = (right + 1);
+		const Time leftTime = (left < nextSegment.BeatTicks) ? GetTickTime(segmentIndex, left) : Time::FromSec(nextSegment.StartTime);
 		return Beat::FromTicks((truncTo0) ? right
-			: (BeatTickToTimes[left] - time) < (time - BeatTickToTimes[right]) ? left : right);
+			: (leftTime - time) < (time - rightTime) ? left : right);
 	}
 }
 
 // find the integer HBScroll beat tick by `beat`, and then interpolate or extrapolate to `time`
 // allow over-extrapolating for reproducing TaikoJiro "time offset over tempo change" behavior
-f64 TempoMapAccelerationStructure::ConvertBeatAndTimeToHBScrollBeatTickUsingLookupTableIndexing(Beat beat, Time time) const
+f64 TempoMapAccelerationStructure::ConvertBeatAndTimeToHBScrollBeatTickUsingSegmentBinarySearch(Beat beat, Time time) const
 {
-	const i32 beatTickToTimesCount = static_cast<i32>(BeatTickToTimes.size());
+	const i32 beatTickToTimesCount = Segments.empty() ? 0 : (Segments.back().BeatTicks + 1);
 	const i32 totalBeatTicks = beat.Ticks;
 
 	if (totalBeatTicks < 0) // NOTE: Negative tick (tempo changes are assumed to only be positive)
@@ -115,14 +122,16 @@ f64 TempoMapAccelerationStructure::ConvertBeatAndTimeToHBScrollBeatTickUsingLook
 		// NOTE: And add it to the last tick
 		return (lastHBScrollBeatTick + ticks);
 	}
-	else // NOTE: Use the pre calculated lookup table directly
+	else // NOTE: Use the containing tempo segment directly
 	{
 		// find the integer HBScroll beat tick using `beat`, and then interpolate by `time`
-		const i32 totalBeatTicks = beat.Ticks;
-		const f64 timeLeft = BeatTickToTimes.at(totalBeatTicks).Seconds;
-		const f64 timeRight = BeatTickToTimes.at(totalBeatTicks + 1).Seconds;
-		const f64 ticksLeft = BeatTickToHBScrollBeatTicks.at(totalBeatTicks);
-		const f64 ticksRight = BeatTickToHBScrollBeatTicks.at(totalBeatTicks + 1);
+		// NOTE: The next tick might already belong to the next segment (which is guaranteed to exist for all ticks before the last tempo change)
+		const size_t segmentIndexLeft = FindSegmentIndexForBeatTicks(totalBeatTicks);
+		const size_t segmentIndexRight = ((totalBeatTicks + 1) < Segments[segmentIndexLeft + 1].BeatTicks) ? segmentIndexLeft : (segmentIndexLeft + 1);
+		const f64 timeLeft = GetTickTime(segmentIndexLeft, totalBeatTicks).Seconds;
+		const f64 timeRight = GetTickTime(segmentIndexRight, totalBeatTicks + 1).Seconds;
+		const f64 ticksLeft = GetTickHBScrollBeatTick(segmentIndexLeft, totalBeatTicks);
+		const f64 ticksRight = GetTickHBScrollBeatTick(segmentIndexRight, totalBeatTicks + 1);
 
 		return ConvertRange(timeLeft, timeRight, ticksLeft, ticksRight, time.Seconds);
 	}
@@ -130,15 +139,39 @@ f64 TempoMapAccelerationStructure::ConvertBeatAndTimeToHBScrollBeatTickUsingLook
 
 Time TempoMapAccelerationStructure::GetLastCalculatedTime() const
 {
-	return BeatTickToTimes.empty() ? Time::Zero() : BeatTickToTimes.back();
+	return Segments.empty() ? Time::Zero() : Time::FromSec(Segments.back().StartTime);
 }
 
 f64 TempoMapAccelerationStructure::GetLastCalculatedHBScrollBeatTick() const
 {
-	return BeatTickToHBScrollBeatTicks.empty() ? 0.0 : BeatTickToHBScrollBeatTicks.back();
+	return Segments.empty() ? 0.0 : Segments.back().StartHBScrollBeatTick;
+}
+
+size_t TempoMapAccelerationStructure::FindSegmentIndexForBeatTicks(i32 beatTicks) const
+{
+	const auto segmentIt = std::upper_bound(Segments.begin(), Segments.end(), beatTicks, [](i32 ticks, const TempoSegment& segment) { return ticks < segment.BeatTicks; });
+	assert(segmentIt != Segments.begin());
+	return static_cast<size_t>(std::distance(Segments.begin(), segmentIt)) - 1;
+}
+
+Time TempoMapAccelerationStructure::GetTickTime(size_t segmentIndex, i32 beatTicks) const
+{
+	const TempoSegment& segment = Segments[segmentIndex];
+	return Time::FromSec((segment.TickDuration * static_cast<f64>(beatTicks - segment.BeatTicks)) + segment.StartTime);
+}
+
+i32 TempoMapAccelerationStructure::GetTickHBScrollBeatTick(size_t segmentIndex, i32 beatTicks) const
+{
+	const TempoSegment& segment = Segments[segmentIndex];
+	return static_cast<i32>((segment.TickSign * static_cast<f64>(beatTicks - segment.BeatTicks)) + segment.StartHBScrollBeatTick);
 }
 
 void TempoMapAccelerationStructure::Rebuild(const TempoChange* inTempoChanges, size_t inTempoCount)
+{
+	RebuildFromBeat(inTempoChanges, inTempoCount, Beat::Zero());
+}
+
+void TempoMapAccelerationStructure::RebuildFromBeat(const TempoChange* inTempoChanges, size_t inTempoCount, Beat firstModifiedBeat)
 {
 	const TempoChange* tempoChanges = inTempoChanges;
 	size_t tempoCount = inTempoCount;
@@ -154,13 +187,26 @@ void TempoMapAccelerationStructure::Rebuild(const TempoChange* inTempoChanges, s
 		tempoCount = TempoBuffer.size();
 	}
 
-	size_t nTickValues = (tempoCount > 0) ? tempoChanges[tempoCount - 1].Beat.Ticks + 1 : 0;
-	BeatTickToTimes.resize(nTickValues);
-	BeatTickToHBScrollBeatTicks.resize(nTickValues);
+	// NOTE: Each segment only depends on the previous one and the beat of the next tempo change, so all segments before the first modified tempo change remain valid.
+	//		 The first segment is always recalculated when starting at beat zero, which also covers the (un)inserted fallback tempo
+	const size_t firstModifiedIndex = static_cast<size_t>(std::distance(tempoChanges,
+		std::lower_bound(tempoChanges, tempoChanges + tempoCount, firstModifiedBeat, [](const TempoChange& v, Beat beat) { return v.Beat < beat; })));
+	const size_t startIndex = (firstModifiedBeat > Beat::Zero()) ? Min(firstModifiedIndex, Segments.size()) : 0;
+
+	Segments.resize(tempoCount);
 
+	// NOTE: Accumulated in the exact same order as a per-tick table would have been filled in, to get bit-identical start times
 	f64 lastEndTime = 0.0;
 	i32 lastEndHBScrollBeatTick = 0;
-	for (size_t tempoChangeIndex = 0; tempoChangeIndex < tempoCount; tempoChangeIndex++)
+	if (startIndex > 0 && startIndex < tempoCount)
+	{
+		const f64 lastTickDuration = Segments[startIndex - 1].TickDuration, lastTickSign = Segments[startIndex - 1].TickSign;
+		const i32 lastTickWithinSegment = (tempoChanges[startIndex].Beat.Ticks - 1);
+		lastEndTime = GetTickTime(startIndex - 1, lastTickWithinSegment).ToSec() + lastTickDuration;
+		lastEndHBScrollBeatTick = static_cast<i32>(GetTickHBScrollBeatTick(startIndex - 1, lastTickWithinSegment) + lastTickSign);
+	}
+
+	for (size_t tempoChangeIndex = startIndex; tempoChangeIndex < tempoCount; tempoChangeIndex++)
 	{
 		const TempoChange& tempoChange = tempoChanges[tempoChangeIndex];
 
@@ -169,24 +215,28 @@ void TempoMapAccelerationStructure::Rebuild(const TempoChange* inTempoChanges, s
 		const f64 tickDuration = abs(beatDuration / Beat::TicksPerBeat);
 		const f64 tickSign = Sign(beatDuration);
 
-		const b8 isSingleOrLastTempo = (tempoCount == 1) || (tempoChangeIndex == (tempoCount - 1));
-		const size_t timesCount = isSingleOrLastTempo ? BeatTickToTimes.size() : (tempoChanges[tempoChangeIndex + 1].Beat.Ticks);
+		Segments[tempoChangeIndex] = TempoSegment { tempoChange.Beat.Ticks, lastEndHBScrollBeatTick, lastEndTime, tickDuration, tickSign };
 
-		for (size_t i = 0, t = tempoChange.Beat.Ticks; t < timesCount; i++, t++)
+		const b8 isSingleOrLastTempo = (tempoCount == 1) || (tempoChangeIndex == (tempoCount - 1));
+		if (!isSingleOrLastTempo)
 		{
-			BeatTickToTimes[t] = Time::FromSec((tickDuration * i) + lastEndTime);
-			BeatTickToHBScrollBeatTicks[t] = ((tickSign * i) + lastEndHBScrollBeatTick);
+			const i32 lastTickWithinSegment = (tempoChanges[tempoChangeIndex + 1].Beat.Ticks - 1);
+			lastEndTime = GetTickTime(tempoChangeIndex, lastTickWithinSegment).ToSec() + tickDuration;
+			lastEndHBScrollBeatTick = static_cast<i32>(GetTickHBScrollBeatTick(tempoChangeIndex, lastTickWithinSegment) + tickSign);
 		}
+	}
 
-		if (tempoCount > 1)
-		{
-			lastEndTime = BeatTickToTimes[timesCount - 1].ToSec() + tickDuration;
-			lastEndHBScrollBeatTick = BeatTickToHBScrollBeatTicks[timesCount - 1] + tickSign;
-		}
+	FirstTempoBPM = SafetyCheckTempo(tempoChanges[0].Tempo).BPM;
+	LastTempoBPM = SafetyCheckTempo(tempoChanges[tempoCount - 1].Tempo).BPM;
 
-		FirstTempoBPM = (tempoChangeIndex == 0) ? bpm : FirstTempoBPM;
-		LastTempoBPM = bpm;
+#if PEEPO_DEBUG
+	if (startIndex > 0)
+	{
+		TempoMapAccelerationStructure fullRebuild;
+		fullRebuild.Rebuild(tempoChanges, tempoCount);
+		assert(fullRebuild.Segments.size() == Segments.size() && memcmp(fullRebuild.Segments.data(), Segments.data(), sizeof(TempoSegment) * Segments.size()) == 0 && "Incremental tempo map rebuild mismatch");
 	}
+#endif
 
 	if (!TempoBuffer.empty())
 		TempoBuffer.clear();
@@ -21,7 +21,7 @@ struct Beat
 	static constexpr Beat FromTicks(i32 ticks) { return Beat(ticks); }
 	static constexpr Beat FromBeats(i32 beats) { return Beat(TicksPerBeat * beats); }
 	static constexpr Beat FromBars(i32 bars, i32 beatsPerBar = 4) { return FromBeats(bars * beatsPerBar); }
-	static constexpr Beat FromBeatsFraction(f64 fraction) { return FromTicks(static_cast<i32>(Round(fraction * static_cast<f64>(TicksPerBeat)))); }
+	static Beat FromBeatsFraction(f64 fraction) { return FromTicks(static_cast<i32>(Round(fraction * static_cast<f64>(TicksPerBeat)))); }
 
 	constexpr b8 operator==(const Beat& other) const { return Ticks == other.Ticks; }
 	constexpr b8 operator!=(const Beat& other) const { return Ticks != other.Ticks; }
@@ -202,6 +202,11 @@ struct BeatSortedList
 	// return the insertion or update index
 	size_t InsertOrUpdate(const T& valueToInsertOrUpdate);
 
+	// NOTE: Bulk versions merging in an already sorted range (unique by beat) in a single pass, instead of shifting the list once per inserted value
+	template <typename Func> void InsertSortedRangeOrFunc(const T* sortedValuesToInsert, size_t valueCount, Func funcExist);
+	void InsertSortedRange(const T* sortedValuesToInsert, size_t valueCount);
+	void RemoveSortedRangeAtBeats(const T* sortedValuesToFindAndRemove, size_t valueCount);
+
 	void RemoveAtBeat(Beat beatToFindAndRemove);
 	void RemoveAtIndex(size_t indexToRemove);
 
@@ -226,20 +231,37 @@ struct BeatSortedList
 
 struct TempoMapAccelerationStructure
 {
-	// NOTE: Pre calculated beat times up to the last tempo change
-	std::vector<Time> BeatTickToTimes;
-	std::vector<i32> BeatTickToHBScrollBeatTicks;
+	// NOTE: Pre calculated start values of each tempo segment, with each segment covering all ticks up until the next tempo change
+	//		 which (unlike a per-tick lookup table) keeps the memory usage independent of the chart length
+	struct TempoSegment
+	{
+		i32 BeatTicks;
+		i32 StartHBScrollBeatTick;
+		f64 StartTime;
+		f64 TickDuration;
+		f64 TickSign;
+	};
+
+	std::vector<TempoSegment> Segments;
 	std::vector<TempoChange> TempoBuffer;
 	f64 FirstTempoBPM = 0.0, LastTempoBPM = 0.0;
 
-	Time ConvertBeatToTimeUsingLookupTableIndexing(Beat beat) const;
-	Beat ConvertTimeToBeatUsingLookupTableBinarySearch(Time time) const;
-	Beat ConvertTimeToBeatUsingLookupTableBinarySearch(Time time, bool truncTo0) const;
-	f64 ConvertBeatAndTimeToHBScrollBeatTickUsingLookupTableIndexing(Beat beat, Time time) const;
+	Time ConvertBeatToTimeUsingSegmentBinarySearch(Beat beat) const;
+	Beat ConvertTimeToBeatUsingSegmentBinarySearch(Time time) const;
+	Beat ConvertTimeToBeatUsingSegmentBinarySearch(Time time, bool truncTo0) const;
+	f64 ConvertBeatAndTimeToHBScrollBeatTickUsingSegmentBinarySearch(Beat beat, Time time) const;
 
 	Time GetLastCalculatedTime() const;
 	f64 GetLastCalculatedHBScrollBeatTick() const;
 	void Rebuild(const TempoChange* inTempoChanges, size_t inTempoCount);
+	// NOTE: Only recalculates the segments starting at the first tempo change at or after the modified beat, assuming all changes before it are unchanged
+	void RebuildFromBeat(const TempoChange* inTempoChanges, size_t inTempoCount, Beat firstModifiedBeat);
+
+private:
+	// NOTE: Both expect (0 <= beatTicks <= last segment BeatTicks), matching the range of the previous per-tick lookup table
+	size_t FindSegmentIndexForBeatTicks(i32 beatTicks) const;
+	Time GetTickTime(size_t segmentIndex, i32 beatTicks) const;
+	i32 GetTickHBScrollBeatTick(size_t segmentIndex, i32 beatTicks) const;
 };
 
 // NOTE: Used when no other tempo / time signature change is defined (empty list or pre-first beat)
@@ -261,10 +283,12 @@ struct SortedTempoMap
 
 	// NOTE: Must manually be called every time a TempoChange has been edited otherwise Beat <-> Time conversions will be incorrect
 	inline void RebuildAccelerationStructure() { AccelerationStructure.Rebuild(Tempo.data(), Tempo.size()); }
-	inline Time BeatToTime(Beat beat) const { return AccelerationStructure.ConvertBeatToTimeUsingLookupTableIndexing(beat); }
+	// NOTE: Cheaper alternative for localized edits, where the beat is the earliest of all added, removed or changed (old and new) tempo change beats
+	inline void RebuildAccelerationStructureFromBeat(Beat firstModifiedBeat) { AccelerationStructure.RebuildFromBeat(Tempo.data(), Tempo.size(), firstModifiedBeat); }
+	inline Time BeatToTime(Beat beat) const { return AccelerationStructure.ConvertBeatToTimeUsingSegmentBinarySearch(beat); }
 	inline Beat TimeToBeat(Time time) const { return TimeToBeat(time, false); }
-	inline Beat TimeToBeat(Time time, bool truncTo0) const { return AccelerationStructure.ConvertTimeToBeatUsingLookupTableBinarySearch(time, truncTo0); }
-	inline f64 BeatAndTimeToHBScrollBeatTick(Beat beat, Time time) const { return AccelerationStructure.ConvertBeatAndTimeToHBScrollBeatTickUsingLookupTableIndexing(beat, time); }
+	inline Beat TimeToBeat(Time time, bool truncTo0) const { return AccelerationStructure.ConvertTimeToBeatUsingSegmentBinarySearch(time, truncTo0); }
+	inline f64 BeatAndTimeToHBScrollBeatTick(Beat beat, Time time) const { return AccelerationStructure.ConvertBeatAndTimeToHBScrollBeatTickUsingSegmentBinarySearch(beat, time); }
 
 	struct ForEachBeatBarData { TimeSignature Signature; Beat Beat; i32 BarIndex; b8 IsBar; };
 	template <typename Func>
@@ -319,6 +343,13 @@ inline const T* BeatSortedForwardIterator<T>::Next(const std::vector<T>& sortedL
 	return next;
 }
 
+template <typename T>
+inline size_t BinarySearchForInsertionIndex(const BeatSortedList<T>& sortedList, Beat beat)
+{
+	const auto it = std::lower_bound(sortedList.begin(), sortedList.end(), beat, [](const T& v, Beat target) { return GetBeat(v) < target; });
+	return static_cast<size_t>(std::distance(sortedList.begin(), it));
+}
+
 template <typename T>
 T* BeatSortedList<T>::TryFindLastAtBeat(Beat beat)
 {
@@ -334,31 +365,15 @@ T* BeatSortedList<T>::TryFindExactAtBeat(Beat beat)
 template <typename T>
 const T* BeatSortedList<T>::TryFindLastAtBeat(Beat beat) const
 {
-	// TODO: Optimize using binary search
-	if (Sorted.size() == 0)
-		return nullptr;
-	if (Sorted.size() == 1)
-		return (GetBeat(Sorted[0]) <= beat) ? &Sorted[0] : nullptr;
-	if (beat < GetBeat(Sorted[0]))
-		return nullptr;
-	for (size_t i = 0; i < Sorted.size() - 1; i++)
-	{
-		if (GetBeat(Sorted[i]) <= beat && GetBeat(Sorted[i + 1]) > beat)
-			return &Sorted[i];
-	}
-	return &Sorted.back();
+	const auto it = std::upper_bound(Sorted.begin(), Sorted.end(), beat, [](Beat target, const T& v) { return target < GetBeat(v); });
+	return (it == Sorted.begin()) ? nullptr : &(*(it - 1));
 }
 
 template <typename T>
 const T* BeatSortedList<T>::TryFindExactAtBeat(Beat beat) const
 {
-	// TODO: Optimize using binary search
-	for (const T& v : Sorted)
-	{
-		if (GetBeat(v) == beat)
-			return &v;
-	}
-	return nullptr;
+	const size_t index = BinarySearchForInsertionIndex(*this, beat);
+	return (index < Sorted.size() && GetBeat(Sorted[index]) == beat) ? &Sorted[index] : nullptr;
 }
 
 template <typename T>
@@ -383,40 +398,37 @@ T* BeatSortedList<T>::TryFindOverlappingBeatUntrusted(Beat beatStart, Beat beatE
 template <typename T>
 const T* BeatSortedList<T>::TryFindOverlappingBeatUntrusted(Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck) const
 {
-	// TODO: Optimize using binary search
-	const T* found = nullptr;
-	if (inclusiveBeatCheck)
+	auto isOverlapping = [&](const T& v)
 	{
-		for (const T& v : Sorted)
-		{
-			// NOTE: Only break after a large beat has been found to correctly handle long notes with other notes "inside"
-			//		 (even if they should't be placable in the first place)
-			if (GetBeat(v) <= beatEnd && beatStart <= (GetBeat(v) + GetBeatDuration(v)))
-				found = &v;
-			else if ((GetBeat(v) + GetBeatDuration(v)) > beatEnd)
-				break;
-		}
-	}
-	else
+		return inclusiveBeatCheck ?
+			(GetBeat(v) <= beatEnd && beatStart <= (GetBeat(v) + GetBeatDuration(v))) :
+			(GetBeat(v) < beatEnd && beatStart < (GetBeat(v) + GetBeatDuration(v)));
+	};
+
+	// NOTE: A reversed range can stop at any long item ending in-between so it still has to be scanned from the front
+	if (beatStart > beatEnd)
 	{
+		const T* found = nullptr;
 		for (const T& v : Sorted)
 		{
-			if (GetBeat(v) < beatEnd && beatStart < (GetBeat(v) + GetBeatDuration(v)))
+			if (isOverlapping(v))
 				found = &v;
 			else if ((GetBeat(v) + GetBeatDuration(v)) > beatEnd)
 				break;
 		}
+		return found;
 	}
-	return found;
-}
 
-template <typename T>
-inline size_t LinearlySearchForInsertionIndex(const BeatSortedList<T>& sortedList, Beat beat)
-{
-	// TODO: Optimize using binary search
-	for (size_t i = 0; i < sortedList.size(); i++)
-		if (beat <= GetBeat(sortedList[i])) return i;
-	return sortedList.size();
+	// NOTE: Otherwise only items starting at or before the end can overlap, out of which the last overlapping one is returned.
+	//		 Searching backwards instead of breaking on the first non-overlapping item correctly handles long notes with other notes "inside"
+	//		 (even if they should't be placable in the first place)
+	const auto searchEnd = std::upper_bound(Sorted.begin(), Sorted.end(), beatEnd, [](Beat target, const T& v) { return target < GetBeat(v); });
+	for (auto it = searchEnd; it != Sorted.begin();)
+	{
+		if (--it; isOverlapping(*it))
+			return &(*it);
+	}
+	return nullptr;
 }
 
 template <typename T>
@@ -428,7 +440,7 @@ inline b8 ValidateIsSortedByBeat(const BeatSortedList<T>& sortedList)
 template <typename T> template <typename Func>
 size_t BeatSortedList<T>::InsertOrFunc(const T& valueToInsert, Func funcExist)
 {
-	const size_t insertionIndex = LinearlySearchForInsertionIndex(*this, GetBeat(valueToInsert));
+	const size_t insertionIndex = BinarySearchForInsertionIndex(*this, GetBeat(valueToInsert));
 	if (InBounds(insertionIndex, Sorted))
 	{
 		if (T& existing = Sorted[insertionIndex]; GetBeat(existing) == GetBeat(valueToInsert))
@@ -462,6 +474,89 @@ size_t BeatSortedList<T>::InsertOrUpdate(const T& valueToInsertOrUpdate)
 	return InsertOrFunc(valueToInsertOrUpdate, [&](T& existing, ...) { existing = valueToInsertOrUpdate; });
 }
 
+template <typename T> template <typename Func>
+void BeatSortedList<T>::InsertSortedRangeOrFunc(const T* sortedValuesToInsert, size_t valueCount, Func funcExist)
+{
+	if (valueCount == 0)
+		return;
+
+	// NOTE: Fast path for the common case of appending past the end (as done when importing)
+	if (Sorted.empty() || GetBeat(Sorted.back()) < GetBeat(sortedValuesToInsert[0]))
+	{
+		Sorted.insert(Sorted.end(), sortedValuesToInsert, sortedValuesToInsert + valueCount);
+	}
+	else
+	{
+		std::vector<T> merged;
+		merged.reserve(Sorted.size() + valueCount);
+
+		size_t existingIndex = 0, insertIndex = 0;
+		while (existingIndex < Sorted.size() && insertIndex < valueCount)
+		{
+			T& existing = Sorted[existingIndex];
+			const T& valueToInsert = sortedValuesToInsert[insertIndex];
+			if (GetBeat(existing) < GetBeat(valueToInsert))
+			{
+				merged.push_back(std::move(existing));
+				existingIndex++;
+			}
+			else if (GetBeat(valueToInsert) < GetBeat(existing))
+			{
+				merged.push_back(valueToInsert);
+				insertIndex++;
+			}
+			else
+			{
+				funcExist(existing, valueToInsert);
+				merged.push_back(std::move(existing));
+				existingIndex++;
+				insertIndex++;
+			}
+		}
+		for (; existingIndex < Sorted.size(); existingIndex++)
+			merged.push_back(std::move(Sorted[existingIndex]));
+		for (; insertIndex < valueCount; insertIndex++)
+			merged.push_back(sortedValuesToInsert[insertIndex]);
+
+		Sorted = std::move(merged);
+	}
+
+#if PEEPO_DEBUG
+	assert(ValidateIsSortedByBeat(*this));
+#endif
+}
+
+template <typename T>
+void BeatSortedList<T>::InsertSortedRange(const T* sortedValuesToInsert, size_t valueCount)
+{
+	InsertSortedRangeOrFunc(sortedValuesToInsert, valueCount, [&](T& existing, const T& valueToInsert) { existing = valueToInsert; });
+}
+
+template <typename T>
+void BeatSortedList<T>::RemoveSortedRangeAtBeats(const T* sortedValuesToFindAndRemove, size_t valueCount)
+{
+	if (valueCount == 0 || Sorted.empty())
+		return;
+
+	// NOTE: Only the part starting at the first removed beat has to be compacted
+	size_t readIndex = BinarySearchForInsertionIndex(*this, GetBeat(sortedValuesToFindAndRemove[0]));
+	size_t writeIndex = readIndex, removeIndex = 0;
+	for (; readIndex < Sorted.size(); readIndex++)
+	{
+		const Beat beat = GetBeat(Sorted[readIndex]);
+		while (removeIndex < valueCount && GetBeat(sortedValuesToFindAndRemove[removeIndex]) < beat)
+			removeIndex++;
+
+		if (removeIndex < valueCount && GetBeat(sortedValuesToFindAndRemove[removeIndex]) == beat)
+			continue;
+
+		if (writeIndex != readIndex)
+			Sorted[writeIndex] = std::move(Sorted[readIndex]);
+		writeIndex++;
+	}
+	Sorted.erase(Sorted.begin() + writeIndex, Sorted.end());
+}
+
 template <typename T>
 void BeatSortedList<T>::RemoveAtBeat(Beat beatToFindAndRemove)
 {
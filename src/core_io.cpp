@@ -2,11 +2,41 @@
 #include "core_string.h"
 #include <vector>
 #include <algorithm>
+#if defined(_WIN32)
 #include <shlwapi.h>
 #include <shobjidl.h>
 #include <Windows.h>
 #include <wrl.h>
 using Microsoft::WRL::ComPtr;
+#else
+#include <filesystem>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static b8 POSIXGetFileStatus(std::string_view filePath, struct stat& outStatus)
+{
+	return !filePath.empty() && (::stat(std::string(filePath).c_str(), &outStatus) == 0);
+}
+
+// NOTE: write() may write less than requested (or be interrupted by a signal) so keep writing until everything is written or an actual error occurs
+static b8 POSIXWriteAll(int fileDescriptor, const void* data, size_t dataSize, size_t& outBytesWritten)
+{
+	outBytesWritten = 0;
+	while (outBytesWritten < dataSize)
+	{
+		const ssize_t result = ::write(fileDescriptor, static_cast<const u8*>(data) + outBytesWritten, dataSize - outBytesWritten);
+		if (result < 0 && errno == EINTR)
+			continue;
+		if (result <= 0)
+			return false;
+		outBytesWritten += static_cast<size_t>(result);
+	}
+	return true;
+}
+#endif
 
 namespace Path
 {
@@ -66,12 +96,21 @@ namespace Path
 
 	b8 IsRelative(std::string_view filePath)
 	{
+#if defined(_WIN32)
 		return ::PathIsRelativeW(UTF8::WideArg(filePath).c_str());
+#else
+		return (filePath.empty() || filePath[0] != DirectorySeparator);
+#endif
 	}
 
 	b8 IsDirectory(std::string_view filePath)
 	{
+#if defined(_WIN32)
 		return ::PathIsDirectoryW(UTF8::WideArg(filePath).c_str());
+#else
+		struct stat fileStatus = {};
+		return POSIXGetFileStatus(filePath, fileStatus) && S_ISDIR(fileStatus.st_mode);
+#endif
 	}
 
 	std::string TryMakeAbsolute(std::string_view relativePath, std::string_view baseFileOrDirectory)
@@ -86,6 +125,7 @@ namespace Path
 
 	std::string TryMakeRelative(std::string_view absolutePath, std::string_view baseFileOrDirectory)
 	{
+#if defined(_WIN32)
 		auto basePathU16 = UTF8::WideArg(CopyAndNormalizeWin32(baseFileOrDirectory));
 		auto absolutePathU16 = UTF8::WideArg(CopyAndNormalizeWin32(absolutePath));
 
@@ -95,6 +135,10 @@ namespace Path
 			absolutePathU16.c_str(), ::PathIsDirectoryW(absolutePathU16.c_str()) ? FILE_ATTRIBUTE_DIRECTORY : 0);
 
 		return success ? std::string { ASCII::TrimPrefix(UTF8::Narrow(FixedBufferWStringView(outRelative)), Win32CurrentDirectoryPrefix) } : "";
+#else
+		const std::string baseDirectory { IsDirectory(baseFileOrDirectory) ? baseFileOrDirectory : GetDirectoryName(baseFileOrDirectory) };
+		return std::filesystem::path(std::string(absolutePath)).lexically_relative(baseDirectory).string();
+#endif
 	}
 
 	std::string CopyAndNormalize(std::string_view filePath)
@@ -131,6 +175,7 @@ namespace File
 		if (filePath.empty())
 			return UniqueFileContent {};
 
+#if defined(_WIN32)
 		const HANDLE fileHandle = ::CreateFileW(UTF8::WideArg(filePath).c_str(), GENERIC_READ, (FILE_SHARE_READ | FILE_SHARE_WRITE), NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
 		if (fileHandle == INVALID_HANDLE_VALUE)
 			return UniqueFileContent {};
@@ -153,6 +198,30 @@ namespace File
 			return UniqueFileContent {};
 
 		assert(bytesRead == fileSize);
+#else
+		const int fileDescriptor = ::open(std::string(filePath).c_str(), (O_RDONLY | O_CLOEXEC));
+		if (fileDescriptor < 0)
+			return UniqueFileContent {};
+
+		defer { ::close(fileDescriptor); };
+
+		struct stat fileStatus = {};
+		if (::fstat(fileDescriptor, &fileStatus) != 0)
+			return UniqueFileContent {};
+
+		const size_t fileSize = static_cast<size_t>(fileStatus.st_size);
+		auto fileContent = std::unique_ptr<u8[]>(new u8[fileSize + 1]);
+
+		for (size_t totalBytesRead = 0; totalBytesRead < fileSize;)
+		{
+			const ssize_t bytesRead = ::read(fileDescriptor, fileContent.get() + totalBytesRead, fileSize - totalBytesRead);
+			if (bytesRead < 0 && errno == EINTR)
+				continue;
+			if (bytesRead <= 0)
+				return UniqueFileContent {};
+			totalBytesRead += static_cast<size_t>(bytesRead);
+		}
+#endif
 		fileContent[fileSize] = '\0';
 
 		return UniqueFileContent { std::move(fileContent), fileSize };
@@ -163,6 +232,7 @@ namespace File
 		if (filePath.empty() || fileContent == nullptr)
 			return false;
 
+#if defined(_WIN32)
 		const HANDLE fileHandle = ::CreateFileW(UTF8::WideArg(filePath).c_str(), GENERIC_WRITE, (FILE_SHARE_READ | FILE_SHARE_WRITE), NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
 		if (fileHandle == INVALID_HANDLE_VALUE)
 			return false;
@@ -175,6 +245,16 @@ namespace File
 			return false;
 
 		return true;
+#else
+		const int fileDescriptor = ::open(std::string(filePath).c_str(), (O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC), 0644);
+		if (fileDescriptor < 0)
+			return false;
+
+		defer { ::close(fileDescriptor); };
+
+		size_t bytesWritten = 0;
+		return POSIXWriteAll(fileDescriptor, fileContent, fileSize, bytesWritten);
+#endif
 	}
 
 	b8 WriteAllBytes(std::string_view filePath, const UniqueFileContent& uniqueFileContent)
@@ -187,15 +267,255 @@ namespace File
 		return WriteAllBytes(filePath, textFileContent.data(), textFileContent.size());
 	}
 
+	b8 WriteAllBytesAtomic(std::string_view filePath, const void* fileContent, size_t fileSize)
+	{
+		if (filePath.empty() || fileContent == nullptr)
+			return false;
+
+		AtomicFileWriter fileWriter;
+		return fileWriter.Open(filePath, fileSize) && fileWriter.Write(fileContent, fileSize) && fileWriter.Commit();
+	}
+
+	b8 WriteAllBytesAtomic(std::string_view filePath, const std::string_view textFileContent)
+	{
+		return WriteAllBytesAtomic(filePath, textFileContent.data(), textFileContent.size());
+	}
+
+	AtomicFileWriter::~AtomicFileWriter()
+	{
+		Discard();
+	}
+
+	b8 AtomicFileWriter::Open(std::string_view filePath, size_t fileSizeHint)
+	{
+		Discard();
+		if (filePath.empty())
+			return false;
+
+		static constexpr std::string_view tempFileSuffix = ".tmp";
+		destinationFilePath = filePath;
+		tempFilePath = std::string(filePath).append(tempFileSuffix);
+
+#if defined(_WIN32)
+		const HANDLE newFileHandle = ::CreateFileW(UTF8::WideArg(tempFilePath).c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, (FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN), NULL);
+		if (newFileHandle == INVALID_HANDLE_VALUE)
+			return false;
+
+		fileHandle = newFileHandle;
+		hasWriteError = false;
+		bytesWritten = 0;
+
+		// NOTE: Only a hint so failing to preallocate isn't an error
+		if (fileSizeHint > 0)
+		{
+			FILE_ALLOCATION_INFO allocationInfo = {};
+			allocationInfo.AllocationSize.QuadPart = static_cast<LONGLONG>(fileSizeHint);
+			::SetFileInformationByHandle(newFileHandle, FileAllocationInfo, &allocationInfo, sizeof(allocationInfo));
+		}
+
+		return true;
+#else
+		// NOTE: There is no portable way to only reserve the space without also changing the file size so the size hint goes unused
+		const int newFileDescriptor = ::open(tempFilePath.c_str(), (O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC), 0644);
+		if (newFileDescriptor < 0)
+			return false;
+
+		// NOTE: Offset by one so that a valid file descriptor of zero can't be mistaken for a null handle
+		fileHandle = reinterpret_cast<void*>(static_cast<intptr_t>(newFileDescriptor) + 1);
+		hasWriteError = false;
+		bytesWritten = 0;
+		return true;
+#endif
+	}
+
+	b8 AtomicFileWriter::Write(const void* data, size_t dataSize)
+	{
+		if (fileHandle == nullptr || hasWriteError)
+			return false;
+
+#if defined(_WIN32)
+		// HACK: Assume every individual write fits inside a single DWORD for now
+		DWORD dataBytesWritten = 0;
+		if (::WriteFile(static_cast<HANDLE>(fileHandle), data, static_cast<DWORD>(dataSize), &dataBytesWritten, nullptr) == FALSE || dataBytesWritten != dataSize)
+			hasWriteError = true;
+#else
+		size_t dataBytesWritten = 0;
+		if (!POSIXWriteAll(static_cast<int>(reinterpret_cast<intptr_t>(fileHandle) - 1), data, dataSize, dataBytesWritten))
+			hasWriteError = true;
+#endif
+
+		bytesWritten += dataBytesWritten;
+		return !hasWriteError;
+	}
+
+	b8 AtomicFileWriter::Write(std::string_view text)
+	{
+		return Write(text.data(), text.size());
+	}
+
+	b8 AtomicFileWriter::Commit()
+	{
+		if (fileHandle == nullptr)
+			return false;
+
+#if defined(_WIN32)
+		const b8 flushSucceeded = !hasWriteError && (::FlushFileBuffers(static_cast<HANDLE>(fileHandle)) != FALSE);
+		::CloseHandle(static_cast<HANDLE>(fileHandle));
+		fileHandle = nullptr;
+
+		if (!flushSucceeded || ::MoveFileExW(UTF8::WideArg(tempFilePath).c_str(), UTF8::WideArg(destinationFilePath).c_str(), (MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) == FALSE)
+		{
+			::DeleteFileW(UTF8::WideArg(tempFilePath).c_str());
+			return false;
+		}
+#else
+		const int fileDescriptor = static_cast<int>(reinterpret_cast<intptr_t>(fileHandle) - 1);
+		const b8 flushSucceeded = !hasWriteError && (::fsync(fileDescriptor) == 0);
+		::close(fileDescriptor);
+		fileHandle = nullptr;
+
+		if (!flushSucceeded || ::rename(tempFilePath.c_str(), destinationFilePath.c_str()) != 0)
+		{
+			::unlink(tempFilePath.c_str());
+			return false;
+		}
+#endif
+
+		return true;
+	}
+
+	void AtomicFileWriter::Discard()
+	{
+		if (fileHandle == nullptr)
+			return;
+
+#if defined(_WIN32)
+		::CloseHandle(static_cast<HANDLE>(fileHandle));
+		::DeleteFileW(UTF8::WideArg(tempFilePath).c_str());
+#else
+		::close(static_cast<int>(reinterpret_cast<intptr_t>(fileHandle) - 1));
+		::unlink(tempFilePath.c_str());
+#endif
+		fileHandle = nullptr;
+	}
+
+	MappedView::~MappedView()
+	{
+		Close();
+	}
+
+	b8 MappedView::Open(std::string_view filePath)
+	{
+		Close();
+		if (filePath.empty())
+			return false;
+
+#if defined(_WIN32)
+		const HANDLE fileHandle = ::CreateFileW(UTF8::WideArg(filePath).c_str(), GENERIC_READ, (FILE_SHARE_READ | FILE_SHARE_WRITE), NULL, OPEN_EXISTING, (FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN), NULL);
+		if (fileHandle == INVALID_HANDLE_VALUE)
+			return false;
+
+		defer { ::CloseHandle(fileHandle); };
+
+		LARGE_INTEGER largeIntegerFileSize = {};
+		if (::GetFileSizeEx(fileHandle, &largeIntegerFileSize) == 0)
+			return false;
+
+		// NOTE: CreateFileMappingW() fails for empty files, which are still valid to "read" though
+		if (largeIntegerFileSize.QuadPart == 0)
+		{
+			isOpen = true;
+			return true;
+		}
+
+		const HANDLE mappingHandle = ::CreateFileMappingW(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mappingHandle == NULL)
+			return false;
+
+		// NOTE: The view keeps the mapping (and file) alive by itself so both handles can be closed right away
+		const void* mappedAddress = ::MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+		::CloseHandle(mappingHandle);
+		if (mappedAddress == nullptr)
+			return false;
+
+		data = static_cast<const u8*>(mappedAddress);
+		size = static_cast<size_t>(largeIntegerFileSize.QuadPart);
+		isOpen = true;
+		return true;
+#else
+		const int fileDescriptor = ::open(std::string(filePath).c_str(), (O_RDONLY | O_CLOEXEC));
+		if (fileDescriptor < 0)
+			return false;
+
+		defer { ::close(fileDescriptor); };
+
+		struct stat fileStatus = {};
+		if (::fstat(fileDescriptor, &fileStatus) != 0)
+			return false;
+
+		// NOTE: mmap() fails for empty files, which are still valid to "read" though
+		if (fileStatus.st_size == 0)
+		{
+			isOpen = true;
+			return true;
+		}
+
+		// NOTE: The mapping keeps the file alive by itself so the file descriptor can be closed right away
+		void* mappedAddress = ::mmap(nullptr, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		if (mappedAddress == MAP_FAILED)
+			return false;
+
+		::madvise(mappedAddress, static_cast<size_t>(fileStatus.st_size), MADV_SEQUENTIAL);
+		data = static_cast<const u8*>(mappedAddress);
+		size = static_cast<size_t>(fileStatus.st_size);
+		isOpen = true;
+		return true;
+#endif
+	}
+
+	void MappedView::Close()
+	{
+#if defined(_WIN32)
+		if (data != nullptr)
+			::UnmapViewOfFile(data);
+#else
+		if (data != nullptr)
+			::munmap(const_cast<u8*>(data), size);
+#endif
+
+		data = nullptr;
+		size = 0;
+		isOpen = false;
+	}
+
 	b8 Exists(std::string_view filePath)
 	{
+#if defined(_WIN32)
 		const DWORD attributes = ::GetFileAttributesW(UTF8::WideArg(filePath).c_str());
 		return (attributes != INVALID_FILE_ATTRIBUTES && !(attributes & FILE_ATTRIBUTE_DIRECTORY));
+#else
+		struct stat fileStatus = {};
+		return POSIXGetFileStatus(filePath, fileStatus) && !S_ISDIR(fileStatus.st_mode);
+#endif
 	}
 
 	b8 Copy(std::string_view source, std::string_view destination, b8 overwriteExisting)
 	{
+#if defined(_WIN32)
 		return ::CopyFileW(UTF8::WideArg(source).c_str(), UTF8::WideArg(destination).c_str(), !overwriteExisting);
+#else
+		std::error_code errorCode;
+		return std::filesystem::copy_file(std::string(source), std::string(destination), overwriteExisting ? std::filesystem::copy_options::overwrite_existing : std::filesystem::copy_options::none, errorCode);
+#endif
+	}
+
+	b8 Delete(std::string_view filePath)
+	{
+#if defined(_WIN32)
+		return ::DeleteFileW(UTF8::WideArg(filePath).c_str());
+#else
+		return !filePath.empty() && (::unlink(std::string(filePath).c_str()) == 0);
+#endif
 	}
 }
 
@@ -210,6 +530,7 @@ namespace CommandLine
 		if (initialized)
 			return CommandLineArrayView { argvStringViews.size(), argvStringViews.data() };
 
+#if defined(_WIN32)
 		int argc = 0;
 		auto argv = ::CommandLineToArgvW(::GetCommandLineW(), &argc);
 		{
@@ -220,9 +541,31 @@ namespace CommandLine
 				argvStringViews.emplace_back(argvString.emplace_back(UTF8::Narrow(argv[i])).c_str());
 		}
 		::LocalFree(argv);
+#else
+		// NOTE: Null separated arguments (Linux only), which are passed through as is and therefore assumed to already be UTF-8
+		std::string commandLine;
+		if (FILE* commandLineFile = ::fopen("/proc/self/cmdline", "rb"); commandLineFile != nullptr)
+		{
+			char buffer[4096];
+			for (size_t bytesRead; (bytesRead = ::fread(buffer, sizeof(char), sizeof(buffer), commandLineFile)) > 0;)
+				commandLine.append(buffer, bytesRead);
+			::fclose(commandLineFile);
+		}
+
+		const size_t argc = static_cast<size_t>(std::count(commandLine.begin(), commandLine.end(), '\0'));
+		argvString.reserve(argc);
+		argvStringViews.reserve(argc);
+
+		for (size_t argumentStart = 0; argumentStart < commandLine.size();)
+		{
+			const size_t argumentEnd = commandLine.find('\0', argumentStart);
+			argvStringViews.emplace_back(argvString.emplace_back(commandLine.substr(argumentStart, argumentEnd - argumentStart)).c_str());
+			argumentStart = (argumentEnd == std::string::npos) ? commandLine.size() : (argumentEnd + 1);
+		}
+#endif
 
 		initialized = true;
-		return CommandLineArrayView { static_cast<size_t>(argc), argvStringViews.data() };
+		return CommandLineArrayView { argvStringViews.size(), argvStringViews.data() };
 	}
 }
 
@@ -233,7 +576,11 @@ namespace Directory
 		if (directoryPath.empty())
 			return false;
 
+#if defined(_WIN32)
 		return ::CreateDirectoryW(UTF8::WideArg(directoryPath).c_str(), 0);
+#else
+		return (::mkdir(std::string(directoryPath).c_str(), 0755) == 0);
+#endif
 	}
 
 	b8 Exists(std::string_view directoryPath)
@@ -241,17 +588,28 @@ namespace Directory
 		if (directoryPath.empty())
 			return false;
 
+#if defined(_WIN32)
 		const DWORD attributes = ::GetFileAttributesW(UTF8::WideArg(directoryPath).c_str());
 		return (attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY));
+#else
+		struct stat fileStatus = {};
+		return POSIXGetFileStatus(directoryPath, fileStatus) && S_ISDIR(fileStatus.st_mode);
+#endif
 	}
 
 
 	std::string GetExecutablePath()
 	{
+#if defined(_WIN32)
 		// TODO: First ask for size then resize dynamic buffer accordingly
 		wchar_t buffer[MAX_PATH] = L"";
 		::GetModuleFileNameW(NULL, buffer, MAX_PATH);
 		return UTF8::Narrow(FixedBufferWStringView(buffer));
+#else
+		// NOTE: Linux only
+		std::error_code errorCode;
+		return std::filesystem::read_symlink("/proc/self/exe", errorCode).string();
+#endif
 	}
 
 	std::string GetExecutableDirectory()
@@ -261,18 +619,29 @@ namespace Directory
 
 	std::string GetWorkingDirectory()
 	{
+#if defined(_WIN32)
 		// TODO: First ask for size then resize dynamic buffer accordingly
 		wchar_t buffer[MAX_PATH] = L"";
 		::GetCurrentDirectoryW(MAX_PATH, buffer);
 		return UTF8::Narrow(FixedBufferWStringView(buffer));
+#else
+		std::error_code errorCode;
+		return std::filesystem::current_path(errorCode).string();
+#endif
 	}
 
 	void SetWorkingDirectory(std::string_view directoryPath)
 	{
+#if defined(_WIN32)
 		::SetCurrentDirectoryW(UTF8::WideArg(directoryPath).c_str());
+#else
+		::chdir(std::string(directoryPath).c_str());
+#endif
 	}
 }
 
+// NOTE: Only needed by the GUI which is Windows only anyway
+#if defined(_WIN32)
 namespace Shell
 {
 	void OpenInExplorer(std::string_view filePath)
@@ -577,3 +946,4 @@ namespace Shell
 	FileDialogResult FileDialog::OpenSave() { return CreateAndShowFileDialog(*this, DialogType::Save, DialogPickType::File); }
 	FileDialogResult FileDialog::OpenSelectFolder() { return CreateAndShowFileDialog(*this, DialogType::Open, DialogPickType::Folder); }
 }
+#endif
@@ -1,5 +1,6 @@
 #pragma once
 #include "core_types.h"
+#include <string>
 #include <string_view>
 #include <vector>
 #include <memory>
@@ -55,8 +56,62 @@ namespace File
 	b8 WriteAllBytes(std::string_view filePath, const UniqueFileContent& uniqueFileContent);
 	b8 WriteAllBytes(std::string_view filePath, const std::string_view textFileContent);
 
+	// NOTE: Writes to a temporary file next to the destination first, flushes it to disk and then renames it over the destination.
+	//		 A crash or power loss mid-write can therefore never leave behind a partially written destination file
+	b8 WriteAllBytesAtomic(std::string_view filePath, const void* fileContent, size_t fileSize);
+	b8 WriteAllBytesAtomic(std::string_view filePath, const std::string_view textFileContent);
+
+	// NOTE: Same as WriteAllBytesAtomic() but for sequentially streaming the content in multiple writes.
+	//		 Nothing is visible at the destination until Commit() succeeds and an uncommitted temporary file is deleted on destruction
+	class AtomicFileWriter : NonCopyable
+	{
+	public:
+		AtomicFileWriter() = default;
+		~AtomicFileWriter();
+
+		// NOTE: The size hint is only used to preallocate the file on disk up front
+		b8 Open(std::string_view filePath, size_t fileSizeHint = 0);
+		b8 Write(const void* data, size_t dataSize);
+		b8 Write(std::string_view text);
+		b8 Commit();
+		void Discard();
+
+		inline size_t GetBytesWritten() const { return bytesWritten; }
+
+	private:
+		void* fileHandle = nullptr;
+		b8 hasWriteError = false;
+		size_t bytesWritten = 0;
+		std::string destinationFilePath;
+		std::string tempFilePath;
+	};
+
+	// NOTE: Read-only memory mapping of an entire file to avoid copying large files (songs, jackets, etc.) into a heap buffer first.
+	//		 Pages are only read in once accessed and are file backed so they don't count against the committed memory like ReadAllBytes() does.
+	//		 Zero-length files can't be mapped but still open successfully with a null Data() and a Size() of zero
+	class MappedView : NonCopyable
+	{
+	public:
+		MappedView() = default;
+		~MappedView();
+
+		b8 Open(std::string_view filePath);
+		void Close();
+
+		inline b8 IsOpen() const { return isOpen; }
+		inline const u8* Data() const { return data; }
+		inline size_t Size() const { return size; }
+		inline std::string_view AsString() const { return std::string_view(reinterpret_cast<const char*>(data), size); }
+
+	private:
+		const u8* data = nullptr;
+		size_t size = 0;
+		b8 isOpen = false;
+	};
+
 	b8 Exists(std::string_view filePath);
 	b8 Copy(std::string_view source, std::string_view destination, b8 overwriteExisting = false);
+	b8 Delete(std::string_view filePath);
 }
 
 namespace Directory
@@ -1,5 +1,7 @@
 #include "core_string.h"
 #include <charconv>
+
+#if defined(_WIN32)
 #include <Windows.h>
 
 static std::string Win32NarrowStdStringWithCodePage(std::wstring_view input, UINT win32CodePage)
@@ -42,12 +44,6 @@ namespace UTF8
 		return Win32WidenStdStringWithCodePage(utf8Input, CP_UTF8);
 	}
 
-	std::string FromShiftJIS(std::string_view shiftJISInput)
-	{
-		// HACK: Quite inefficient of course but should work just fine for converting small amounts of text here and there
-		return UTF8::Narrow(ShiftJIS::Widen(shiftJISInput));
-	}
-
 	WideArg::WideArg(std::string_view utf8Input)
 	{
 		// NOTE: Length **without** null terminator
@@ -93,13 +89,8 @@ namespace ShiftJIS
 	{
 		return Win32WidenStdStringWithCodePage(utf8Input, CP_SHIFT_JIS);
 	}
-
-	std::string FromUTF8(std::string_view utf8Input)
-	{
-		// HACK: Same problem as UTF8::FromShiftJIS() ...
-		return ShiftJIS::Narrow(UTF8::WideArg(utf8Input).c_str());
-	}
 }
+#endif
 
 namespace ASCII
 {
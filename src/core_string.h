@@ -45,6 +45,7 @@ namespace UTF8
 	constexpr b8 HasBOM(std::string_view input) { return (input.size() >= sizeof(BOM_UTF8)) && (input.substr(0, sizeof(BOM_UTF8)) == std::string_view(BOM_UTF8, sizeof(BOM_UTF8))); }
 	constexpr std::string_view TrimBOM(std::string_view inputWithBOM) { return inputWithBOM.substr(sizeof(BOM_UTF8)); }
 
+#if defined(_WIN32)
 	// NOTE: Convert UTF-16 to UTF-8
 	std::string Narrow(std::wstring_view utf16Input);
 
@@ -64,18 +65,26 @@ namespace UTF8
 		wchar_t stackBuffer[260];
 		int convertedLength;
 	};
+#endif
 
+	// NOTE: Table-driven CP932 conversion without going through UTF-16 (see core_string_shift_jis.cpp)
 	std::string FromShiftJIS(std::string_view shiftJISInput);
+
+	// NOTE: Strict validation, rejecting overlong encodings, surrogates and truncated sequences
+	b8 IsValid(std::string_view input);
 }
 
 namespace ShiftJIS
 {
+#if defined(_WIN32)
 	// NOTE: Convert UTF-16 to Shift-JIS
 	std::string Narrow(std::wstring_view utf16Input);
 
 	// NOTE: Convert SHIFT-JIS to UTF-16
 	std::wstring Widen(std::string_view shiftJISInput);
+#endif
 
+	// NOTE: Characters without a Shift-JIS representation are replaced with '?'
 	std::string FromUTF8(std::string_view utf8Input);
 }
 
@@ -0,0 +1,254 @@
+#include "core_string.h"
+#include "core_string_cp932_table.h"
+#include <immintrin.h>
+
+// NOTE: Portable table-driven CP932 transcoding, going straight between Shift-JIS and UTF-8 without any intermediate UTF-16 string
+namespace ShiftJIS
+{
+	// NOTE: Same as the default characters used by MultiByteToWideChar() / WideCharToMultiByte() for code page 932
+	static constexpr u16 InvalidCharacterUTF16 = 0x30FB;
+	static constexpr char InvalidCharacterShiftJIS = '?';
+
+	constexpr b8 IsLeadByte(u8 byte) { return (byte >= 0x81 && byte <= 0x9F) || (byte >= 0xE0 && byte <= 0xFC); }
+	constexpr b8 IsTrailByte(u8 byte) { return (byte >= 0x40 && byte <= 0xFC && byte != 0x7F); }
+	constexpr size_t LeadByteToTableIndex(u8 leadByte) { return (leadByte <= 0x9F) ? (leadByte - 0x81) : (leadByte - 0xE0 + 31); }
+	constexpr u8 TableIndexToLeadByte(size_t index) { return static_cast<u8>((index <= 30) ? (index + 0x81) : (index - 31 + 0xE0)); }
+
+	// NOTE: Everything outside of ASCII, the double-byte lead bytes and the half-width katakana is mapped into the private use area
+	constexpr u16 SingleByteToUTF16(u8 byte)
+	{
+		if (byte < 0x80) return byte;
+		if (byte == 0x80) return 0x0080;
+		if (byte == 0xA0) return 0xF8F0;
+		if (byte >= 0xA1 && byte <= 0xDF) return static_cast<u16>(0xFF61 + (byte - 0xA1));
+		if (byte >= 0xFD) return static_cast<u16>(0xF8F1 + (byte - 0xFD));
+		return 0x0000;
+	}
+
+	// NOTE: UTF-8 bytes packed into the lower 24 bits (first byte lowest) and the byte count into the upper 8
+	constexpr u32 PackUTF8(u16 codePoint)
+	{
+		if (codePoint < 0x80)
+			return (1u << 24) | codePoint;
+		if (codePoint < 0x800)
+			return (2u << 24) | (0xC0 | (codePoint >> 6)) | ((0x80 | (codePoint & 0x3F)) << 8);
+		return (3u << 24) | (0xE0 | (codePoint >> 12)) | ((0x80 | ((codePoint >> 6) & 0x3F)) << 8) | ((0x80 | (codePoint & 0x3F)) << 16);
+	}
+
+	struct TranscodeTables
+	{
+		u32 SingleByteToPackedUTF8[256];
+		u32 DoubleByteToPackedUTF8[ArrayCount(CP932DoubleByteToUTF16)][ArrayCount(CP932DoubleByteToUTF16[0])];
+		// NOTE: Single byte characters are stored as values below 0x100, zero for unmapped code points
+		u16 UTF16ToShiftJIS[0x10000];
+	};
+
+	static std::unique_ptr<TranscodeTables> CreateTranscodeTables()
+	{
+		auto tables = std::make_unique<TranscodeTables>();
+		memset(tables->UTF16ToShiftJIS, 0, sizeof(tables->UTF16ToShiftJIS));
+
+		for (size_t byte = 0; byte < ArrayCount(tables->SingleByteToPackedUTF8); byte++)
+		{
+			const u16 codePoint = SingleByteToUTF16(static_cast<u8>(byte));
+			tables->SingleByteToPackedUTF8[byte] = PackUTF8((codePoint != 0x0000 || byte == 0) ? codePoint : InvalidCharacterUTF16);
+			if (codePoint != 0x0000)
+				tables->UTF16ToShiftJIS[codePoint] = static_cast<u16>(byte);
+		}
+
+		// NOTE: Some characters appear more than once (NEC special characters, NEC-selected and IBM extensions) so the first occurrence is used for encoding,
+		//		 except for the NEC-selected IBM extensions (lead bytes 0xED and 0xEE) which lose out to the IBM extensions (lead bytes 0xFA - 0xFC), same as Windows does it
+		for (const b8 necSelectedPass : { false, true })
+		{
+			for (size_t leadIndex = 0; leadIndex < ArrayCount(CP932DoubleByteToUTF16); leadIndex++)
+			{
+				const u8 leadByte = TableIndexToLeadByte(leadIndex);
+				if ((leadByte == 0xED || leadByte == 0xEE) != necSelectedPass)
+					continue;
+
+				for (size_t trailIndex = 0; trailIndex < ArrayCount(CP932DoubleByteToUTF16[leadIndex]); trailIndex++)
+				{
+					const u16 codePoint = CP932DoubleByteToUTF16[leadIndex][trailIndex];
+					tables->DoubleByteToPackedUTF8[leadIndex][trailIndex] = PackUTF8((codePoint != 0x0000) ? codePoint : InvalidCharacterUTF16);
+					if (codePoint != 0x0000 && tables->UTF16ToShiftJIS[codePoint] == 0x0000)
+						tables->UTF16ToShiftJIS[codePoint] = static_cast<u16>((leadByte << 8) | (trailIndex + 0x40));
+				}
+			}
+		}
+
+		// NOTE: Subset of the Windows "best fit" mappings for common look-alike characters that would otherwise all turn into '?'
+		static constexpr struct { u16 CodePoint, ShiftJIS; } bestFitMappings[] =
+		{
+			{ 0x00A2, 0x8191 }, { 0x00A3, 0x8192 }, { 0x00A5, 0x005C }, { 0x00AC, 0x81CA },
+			{ 0x2016, 0x8161 }, { 0x203E, 0x007E }, { 0x2212, 0x817C }, { 0x301C, 0x8160 },
+		};
+		for (const auto& mapping : bestFitMappings)
+		{
+			if (tables->UTF16ToShiftJIS[mapping.CodePoint] == 0x0000)
+				tables->UTF16ToShiftJIS[mapping.CodePoint] = mapping.ShiftJIS;
+		}
+
+		return tables;
+	}
+
+	static const TranscodeTables& GetTranscodeTables()
+	{
+		static const std::unique_ptr<TranscodeTables> tables = CreateTranscodeTables();
+		return *tables;
+	}
+
+	// NOTE: Returns the number of leading bytes within the next 16 bytes that are all ASCII, expects at least 16 readable bytes
+	static inline size_t CountASCIIBlockPrefix(const char* input)
+	{
+		const i32 nonASCIIMask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input)));
+		if (nonASCIIMask == 0)
+			return 16;
+
+		size_t count = 0;
+		while (!(nonASCIIMask & (1 << count)))
+			count++;
+		return count;
+	}
+
+	std::string FromUTF8(std::string_view utf8Input)
+	{
+		const TranscodeTables& tables = GetTranscodeTables();
+		const u8* const input = reinterpret_cast<const u8*>(utf8Input.data());
+		const size_t inputSize = utf8Input.size();
+
+		// NOTE: Shift-JIS never takes up more bytes than the UTF-8 input
+		std::string output;
+		output.resize(inputSize);
+		char* out = output.data();
+
+		size_t i = 0;
+		while (i < inputSize)
+		{
+			if (i + 16 <= inputSize)
+			{
+				const size_t asciiCount = CountASCIIBlockPrefix(reinterpret_cast<const char*>(&input[i]));
+				memcpy(out, &input[i], asciiCount);
+				out += asciiCount;
+				i += asciiCount;
+				if (asciiCount == 16)
+					continue;
+			}
+
+			const u8 byte = input[i];
+			if (byte < 0x80) { *out++ = static_cast<char>(byte); i++; continue; }
+
+			// NOTE: Code points outside the BMP and malformed sequences can't be represented either way
+			u32 codePoint = 0; size_t sequenceLength = 0;
+			if ((byte & 0xE0) == 0xC0) { codePoint = (byte & 0x1F); sequenceLength = 2; }
+			else if ((byte & 0xF0) == 0xE0) { codePoint = (byte & 0x0F); sequenceLength = 3; }
+			else if ((byte & 0xF8) == 0xF0) { codePoint = (byte & 0x07); sequenceLength = 4; }
+
+			size_t continuationCount = 0;
+			while (continuationCount + 1 < sequenceLength && i + continuationCount + 1 < inputSize && (input[i + continuationCount + 1] & 0xC0) == 0x80)
+				codePoint = (codePoint << 6) | (input[i + ++continuationCount] & 0x3F);
+
+			i += (1 + continuationCount);
+			const u16 shiftJIS = (sequenceLength > 0 && continuationCount + 1 == sequenceLength && codePoint < 0x10000) ? tables.UTF16ToShiftJIS[codePoint] : 0x0000;
+			if (shiftJIS == 0x0000)
+				*out++ = InvalidCharacterShiftJIS;
+			else if (shiftJIS < 0x100)
+				*out++ = static_cast<char>(shiftJIS);
+			else { *out++ = static_cast<char>(shiftJIS >> 8); *out++ = static_cast<char>(shiftJIS & 0xFF); }
+		}
+
+		output.resize(static_cast<size_t>(out - output.data()));
+		return output;
+	}
+}
+
+namespace UTF8
+{
+	std::string FromShiftJIS(std::string_view shiftJISInput)
+	{
+		const ShiftJIS::TranscodeTables& tables = ShiftJIS::GetTranscodeTables();
+		const u8* const input = reinterpret_cast<const u8*>(shiftJISInput.data());
+		const size_t inputSize = shiftJISInput.size();
+
+		// NOTE: Reserving for the worst case of only half-width katakana (one byte each turning into three) to avoid any capacity checks inside the loop.
+		//		 The padding allows always writing out three bytes at once
+		std::string output;
+		output.resize((inputSize * 3) + 4);
+		char* out = output.data();
+
+		size_t i = 0;
+		while (i < inputSize)
+		{
+			if (i + 16 <= inputSize)
+			{
+				const size_t asciiCount = ShiftJIS::CountASCIIBlockPrefix(reinterpret_cast<const char*>(&input[i]));
+				memcpy(out, &input[i], asciiCount);
+				out += asciiCount;
+				i += asciiCount;
+				if (asciiCount == 16)
+					continue;
+			}
+
+			const u8 byte = input[i];
+			u32 packedUTF8;
+			if (ShiftJIS::IsLeadByte(byte))
+			{
+				// NOTE: An invalid trail byte only invalidates the lead byte and is then treated as a character of its own
+				const b8 hasTrailByte = (i + 1 < inputSize) && ShiftJIS::IsTrailByte(input[i + 1]);
+				packedUTF8 = hasTrailByte ? tables.DoubleByteToPackedUTF8[ShiftJIS::LeadByteToTableIndex(byte)][input[i + 1] - 0x40] : ShiftJIS::PackUTF8(ShiftJIS::InvalidCharacterUTF16);
+				i += hasTrailByte ? 2 : 1;
+			}
+			else
+			{
+				packedUTF8 = tables.SingleByteToPackedUTF8[byte];
+				i += 1;
+			}
+
+			out[0] = static_cast<char>(packedUTF8 & 0xFF);
+			out[1] = static_cast<char>((packedUTF8 >> 8) & 0xFF);
+			out[2] = static_cast<char>((packedUTF8 >> 16) & 0xFF);
+			out += (packedUTF8 >> 24);
+		}
+
+		output.resize(static_cast<size_t>(out - output.data()));
+		return output;
+	}
+
+	b8 IsValid(std::string_view input)
+	{
+		const u8* const bytes = reinterpret_cast<const u8*>(input.data());
+		const size_t inputSize = input.size();
+
+		size_t i = 0;
+		while (i < inputSize)
+		{
+			if (i + 16 <= inputSize)
+			{
+				const size_t asciiCount = ShiftJIS::CountASCIIBlockPrefix(reinterpret_cast<const char*>(&bytes[i]));
+				i += asciiCount;
+				if (asciiCount == 16)
+					continue;
+			}
+
+			const u8 byte = bytes[i];
+			if (byte < 0x80) { i++; continue; }
+
+			// NOTE: Rejecting overlong encodings, surrogates and anything above U+10FFFF, see https://www.unicode.org/versions/Unicode15.0.0/ch03.pdf (Table 3-7)
+			size_t sequenceLength; u8 secondByteMin = 0x80, secondByteMax = 0xBF;
+			if (byte >= 0xC2 && byte <= 0xDF) { sequenceLength = 2; }
+			else if (byte >= 0xE0 && byte <= 0xEF) { sequenceLength = 3; if (byte == 0xE0) secondByteMin = 0xA0; if (byte == 0xED) secondByteMax = 0x9F; }
+			else if (byte >= 0xF0 && byte <= 0xF4) { sequenceLength = 4; if (byte == 0xF0) secondByteMin = 0x90; if (byte == 0xF4) secondByteMax = 0x8F; }
+			else { return false; }
+
+			if (i + sequenceLength > inputSize || bytes[i + 1] < secondByteMin || bytes[i + 1] > secondByteMax)
+				return false;
+			for (size_t c = 2; c < sequenceLength; c++)
+			{
+				if ((bytes[i + c] & 0xC0) != 0x80)
+					return false;
+			}
+			i += sequenceLength;
+		}
+
+		return true;
+	}
+}
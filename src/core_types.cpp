@@ -53,7 +53,7 @@ i32 Time::ToString(char* outBuffer, size_t bufferSize) const
 	static constexpr const char invalidFormatString[] = "--:--.---";
 
 	const f64 msRoundSeconds = RoundToMilliseconds(Time::FromSec(Absolute(Seconds))).Seconds;
-	if (::isnan(msRoundSeconds) || ::isinf(msRoundSeconds))
+	if (std::isnan(msRoundSeconds) || std::isinf(msRoundSeconds))
 	{
 		// NOTE: Array count of a string literal char array already accounts for the null terminator
 		memcpy(outBuffer, invalidFormatString, ArrayCount(invalidFormatString));
@@ -99,9 +99,14 @@ Time Time::FromString(cstr inBuffer)
 Date Date::GetToday()
 {
 	const time_t inTimeNow = ::time(nullptr); tm outDateNow;
+#if defined(_WIN32)
 	const errno_t timeToDateError = ::localtime_s(&outDateNow, &inTimeNow);
 	if (timeToDateError != 0)
 		return Date::Zero();
+#else
+	if (::localtime_r(&inTimeNow, &outDateNow) == nullptr)
+		return Date::Zero();
+#endif
 
 	Date result = {};
 	result.Year = static_cast<i16>(outDateNow.tm_year + 1900);
@@ -145,6 +150,7 @@ Date Date::FromString(cstr inBuffer, char separator)
 	return result;
 }
 
+#if defined(_WIN32)
 #include <Windows.h>
 
 static i64 Win32GetPerformanceCounterTicksPerSecond()
@@ -182,3 +188,31 @@ Time CPUTime::DeltaTime(const CPUTime& startTime, const CPUTime& endTime)
 	const i64 deltaTicks = (endTime.Ticks - startTime.Ticks);
 	return Time::FromSec(static_cast<f64>(deltaTicks) / static_cast<f64>(Win32GlobalPerformanceCounter.TicksPerSecond));
 }
+#else
+static constexpr i64 POSIXMonotonicClockTicksPerSecond = 1000000000;
+
+static i64 POSIXGetMonotonicClockTicksNow()
+{
+	timespec timeNow = {};
+	::clock_gettime(CLOCK_MONOTONIC, &timeNow);
+	return (static_cast<i64>(timeNow.tv_sec) * POSIXMonotonicClockTicksPerSecond) + static_cast<i64>(timeNow.tv_nsec);
+}
+
+static const i64 POSIXMonotonicClockTicksOnProgramStartup = POSIXGetMonotonicClockTicksNow();
+
+CPUTime CPUTime::GetNow()
+{
+	return CPUTime { POSIXGetMonotonicClockTicksNow() - POSIXMonotonicClockTicksOnProgramStartup };
+}
+
+CPUTime CPUTime::GetNowAbsolute()
+{
+	return CPUTime { POSIXGetMonotonicClockTicksNow() };
+}
+
+Time CPUTime::DeltaTime(const CPUTime& startTime, const CPUTime& endTime)
+{
+	const i64 deltaTicks = (endTime.Ticks - startTime.Ticks);
+	return Time::FromSec(static_cast<f64>(deltaTicks) / static_cast<f64>(POSIXMonotonicClockTicksPerSecond));
+}
+#endif
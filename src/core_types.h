@@ -2,6 +2,9 @@
 #include <memory>
 #include <stdint.h>
 #include <limits>
+#include <climits>
+#include <cstring>
+#include <utility>
 #include <cfloat>
 #include <cmath>
 #include <algorithm>
@@ -69,6 +72,55 @@ constexpr std::conditional_t<std::is_same_v<T, keep_deduced_t>, TValue, T> keep_
 	return value;
 }
 
+// NOTE: Stand-ins for the MSVC specific keywords and secure CRT functions used throughout, so that the non-GUI code can be built by other compilers too.
+//		 Unlike the MSVC versions a too small buffer only truncates the output (returning the truncated length) instead of invoking the invalid parameter handler
+#if !defined(_MSC_VER)
+#include <stdio.h>
+#include <stdarg.h>
+
+#ifndef __forceinline
+#define __forceinline inline __attribute__((always_inline))
+#endif
+
+inline int vsprintf_s(char* buffer, size_t bufferSize, const char* format, va_list args)
+{
+	const int result = ::vsnprintf(buffer, bufferSize, format, args);
+	return (result < 0 || bufferSize == 0) ? -1 : std::min(result, static_cast<int>(bufferSize - 1));
+}
+
+inline int sprintf_s(char* buffer, size_t bufferSize, const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	const int result = vsprintf_s(buffer, bufferSize, format, args);
+	va_end(args);
+	return result;
+}
+
+template <size_t BufferSize>
+inline int vsprintf_s(char (&buffer)[BufferSize], const char* format, va_list args) { return vsprintf_s(buffer, BufferSize, format, args); }
+
+template <size_t BufferSize>
+inline int sprintf_s(char (&buffer)[BufferSize], const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	const int result = vsprintf_s(buffer, BufferSize, format, args);
+	va_end(args);
+	return result;
+}
+
+// NOTE: Only valid for formats without any %s / %c / %[ conversions, which would require additional buffer size arguments
+inline int sscanf_s(const char* buffer, const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	const int result = ::vsscanf(buffer, format, args);
+	va_end(args);
+	return result;
+}
+#endif
+
 // NOTE: Example: defer { DoEndOfScopeCleanup(); };
 #ifndef defer
 struct defer_dummy {};
@@ -396,20 +448,21 @@ struct Complex {
 	constexpr b8 operator==(const Complex& other) const { return cpx == other.cpx; }
 	constexpr b8 operator!=(const Complex& other) const { return !(*this == other); }
 
-	constexpr Complex operator+(const Complex& other) const { return { (cpx + other.cpx) }; }
-	constexpr Complex operator-(const Complex& other) const { return { (cpx - other.cpx) }; }
-	constexpr Complex operator*(const Complex& other) const { return { (cpx * other.cpx) }; }
-	constexpr Complex operator/(const Complex& other) const { return { (cpx / other.cpx) }; }
-	constexpr Complex operator*(const f32 scalar) const { return { (cpx * scalar) }; }
-	constexpr Complex operator/(const f32 scalar) const { return { (cpx / scalar) }; }
-
-	constexpr Complex& operator+=(const Complex& other) { *this = (*this + other); return *this; }
-	constexpr Complex& operator-=(const Complex& other) { *this = (*this - other); return *this; }
-	constexpr Complex& operator*=(const Complex& other) { *this = (*this * other); return *this; }
-	constexpr Complex& operator/=(const Complex& other) { *this = (*this / other); return *this; }
-	constexpr Complex& operator*=(const f32 scalar) { *this = (*this * scalar); return *this; }
-	constexpr Complex& operator/=(const f32 scalar) { *this = (*this / scalar); return *this; }
-	constexpr Complex operator-() const { return { -cpx }; }
+	// NOTE: Not constexpr since the std::complex arithmetic operators only are since C++20
+	Complex operator+(const Complex& other) const { return { (cpx + other.cpx) }; }
+	Complex operator-(const Complex& other) const { return { (cpx - other.cpx) }; }
+	Complex operator*(const Complex& other) const { return { (cpx * other.cpx) }; }
+	Complex operator/(const Complex& other) const { return { (cpx / other.cpx) }; }
+	Complex operator*(const f32 scalar) const { return { (cpx * scalar) }; }
+	Complex operator/(const f32 scalar) const { return { (cpx / scalar) }; }
+
+	Complex& operator+=(const Complex& other) { *this = (*this + other); return *this; }
+	Complex& operator-=(const Complex& other) { *this = (*this - other); return *this; }
+	Complex& operator*=(const Complex& other) { *this = (*this * other); return *this; }
+	Complex& operator/=(const Complex& other) { *this = (*this / other); return *this; }
+	Complex& operator*=(const f32 scalar) { *this = (*this * scalar); return *this; }
+	Complex& operator/=(const f32 scalar) { *this = (*this / scalar); return *this; }
+	Complex operator-() const { return { -cpx }; }
 
 #define PAT_APLUSB_RE "[+-]?(?:\\d+(?:\\.\\d*)?|\\.\\d+)(?:[eE][+-]?\\d+)?(?![iI.\\d])"
 #define PAT_APLUSB_IM "[+-]?(?:\\d+(?:\\.\\d*)?|\\.\\d+)(?:[eE][+-]?\\d+)?[iI]"
@@ -598,7 +651,7 @@ constexpr void AnimateExponentialVec2(vec2* inOutCurrent, vec2 target, f32 anima
 constexpr f32 Dot(vec2 a, vec2 b) { return (a.x * b.x) + (a.y * b.y); }
 constexpr f32 LengthSqr(vec2 value) { return Dot(value, value); }
 inline f32 Length(vec2 value) { return std::sqrt(LengthSqr(value)); }
-inline vec2 Normalize(vec2 value) { value / Length(value); }
+inline vec2 Normalize(vec2 value) { return value / Length(value); }
 inline f32 Distance(f32 a, f32 b) { return Absolute(a - b); }
 inline f32 Distance(vec2 a, vec2 b) { return Length(a - b); }
 inline vec2 LookAtDirection(vec2 from, vec2 target) { return Normalize(target - from); }
@@ -2,6 +2,8 @@
 #include <algorithm>
 #include <array>
 #include <numeric>
+#include <charconv>
+#include <cmath>
 
 namespace TJA
 {
@@ -92,49 +94,127 @@ namespace TJA
 
 	static_assert(ArrayCount(KeyStrings) == EnumCount<Key>);
 
-	static const std::regex PatTJAHeader = std::regex("^\\.?[A-Z][A-Z0-9_]*$");
-	static const std::regex PatTJACommand = std::regex("^[A-Z]+$");
+	// NOTE: Equivalent to the regex patterns ^\.?[A-Z][A-Z0-9_]*$ and ^[A-Z]+$ respectively
+	static constexpr b8 IsValidKeyColonValueKeyString(std::string_view str)
+	{
+		size_t i = (!str.empty() && str[0] == '.') ? 1 : 0;
+		if (i >= str.size() || !(str[i] >= 'A' && str[i] <= 'Z'))
+			return false;
+		for (i++; i < str.size(); i++)
+		{
+			if (!((str[i] >= 'A' && str[i] <= 'Z') || (str[i] >= '0' && str[i] <= '9') || str[i] == '_'))
+				return false;
+		}
+		return true;
+	}
 
-	static bool MatchKeyString(Key key, std::string_view str)
+	static constexpr b8 IsValidHashCommandKeyString(std::string_view str)
 	{
-		switch (key) {
-		case Key::Main_Invalid:
-		case Key::Course_Invalid:
-			return !std::regex_match(begin(str), end(str), PatTJAHeader);
-		case Key::Chart_Invalid:
-			return !std::regex_match(begin(str), end(str), PatTJACommand);
-
-		case Key::Main_TITLE_localized:
-		case Key::Main_SUBTITLE_localized:
-		case Key::Course_NOTESDESIGNERs:
-		case Key::Course_EXAMs:
-			return ASCII::StartsWith(str, KeyStrings[EnumToIndex(key)]);
-
-		case Key::Unknown:
-		case Key::Course_Unknown: // ambiguous between Main and Course scope, reassigned later
-		case Key::Chart_Unknown:
-			return true;
-
-		case Key::Main_Unknown:
-			return false; // ambiguous between Main and Course scope, assigned separately
-
-		default:
-			return (str == KeyStrings[EnumToIndex(key)]);
+		if (str.empty())
+			return false;
+		for (const char c : str)
+		{
+			if (!(c >= 'A' && c <= 'Z'))
+				return false;
 		}
+		return true;
+	}
+
+	static constexpr b8 IsPrefixMatchKey(Key key)
+	{
+		return (key == Key::Main_TITLE_localized || key == Key::Main_SUBTITLE_localized || key == Key::Course_NOTESDESIGNERs || key == Key::Course_EXAMs);
+	}
+
+	static constexpr b8 IsExactMatchKey(Key key)
+	{
+		return !KeyStrings[EnumToIndex(key)].empty() && !IsPrefixMatchKey(key);
 	}
 
+	static constexpr u32 HashKeyString(std::string_view str, u32 seed)
+	{
+		// NOTE: FNV-1a with the seed used as the offset basis
+		u32 hash = seed;
+		for (const char c : str) { hash ^= static_cast<u8>(c); hash *= 0x01000193; }
+		return hash;
+	}
+
+	// NOTE: Collision-free hash table of all exact match key strings within a key range with the seed searched for at compile time,
+	//		 so that a lookup only has to hash the input once and then do a single string comparison
+	template <size_t TableSize>
+	struct PerfectHashKeyTable
+	{
+		static_assert((TableSize & (TableSize - 1)) == 0, "Table size must be a power of two");
+
+		u32 Seed = 0;
+		std::array<Key, TableSize> Slots = {};
+
+		static constexpr PerfectHashKeyTable Create(Key firstKey, Key lastKey)
+		{
+			PerfectHashKeyTable table = {};
+			for (u32 attempt = 1; attempt < 0x10000; attempt++)
+			{
+				table.Seed = 0x811C9DC5 ^ (attempt * 0x9E3779B9);
+				for (Key& slot : table.Slots)
+					slot = Key::Unknown;
+
+				b8 anyCollision = false;
+				for (Key key = firstKey; key <= lastKey && !anyCollision; IncrementEnum(key))
+				{
+					if (!IsExactMatchKey(key))
+						continue;
+
+					Key& slot = table.Slots[HashKeyString(KeyStrings[EnumToIndex(key)], table.Seed) & (TableSize - 1)];
+					anyCollision = (slot != Key::Unknown);
+					slot = key;
+				}
+
+				if (!anyCollision)
+					return table;
+			}
+			return PerfectHashKeyTable { 0, {} };
+		}
+
+		constexpr Key Find(std::string_view str) const
+		{
+			const Key key = Slots[HashKeyString(str, Seed) & (TableSize - 1)];
+			return (key != Key::Unknown && KeyStrings[EnumToIndex(key)] == str) ? key : Key::Unknown;
+		}
+	};
+
+	static constexpr auto KeyColonValueKeyTable = PerfectHashKeyTable<256>::Create(Key::KeyColonValue_First, Key::KeyColonValue_Last);
+	static constexpr auto HashCommandKeyTable = PerfectHashKeyTable<128>::Create(Key::HashCommand_First, Key::HashCommand_Last);
+	static_assert(KeyColonValueKeyTable.Seed != 0 && HashCommandKeyTable.Seed != 0, "Failed to find a collision-free seed, consider increasing the table size");
+
+	static_assert(KeyColonValueKeyTable.Find("TITLE") == Key::Main_TITLE && KeyColonValueKeyTable.Find("SIDE") == Key::Course_SIDE && KeyColonValueKeyTable.Find("TITLEJA") == Key::Unknown);
+	static_assert(HashCommandKeyTable.Find("START") == Key::Chart_START && HashCommandKeyTable.Find("JPOSSCROLL") == Key::Chart_JPOSSCROLL && HashCommandKeyTable.Find("BPM") == Key::Unknown);
+
 	Key GetKeyColonValueTokenKey(std::string_view str)
 	{
-		for (Key i = Key::KeyColonValue_First; i <= Key::KeyColonValue_Last; IncrementEnum(i))
-			if (MatchKeyString(i, str)) { return i; }
-		return Key::Course_Unknown; // already matched; should never be reached
+		if (!IsValidKeyColonValueKeyString(str))
+			return Key::Main_Invalid;
+
+		if (const Key exactKey = KeyColonValueKeyTable.Find(str); exactKey != Key::Unknown)
+			return exactKey;
+
+		// NOTE: None of the exact key strings start with any of these prefixes so checking them afterwards doesn't change the precedence
+		for (const Key prefixKey : { Key::Main_TITLE_localized, Key::Main_SUBTITLE_localized, Key::Course_NOTESDESIGNERs, Key::Course_EXAMs })
+		{
+			if (ASCII::StartsWith(str, KeyStrings[EnumToIndex(prefixKey)]))
+				return prefixKey;
+		}
+
+		return Key::Course_Unknown; // ambiguous between Main and Course scope, reassigned later
 	}
 
 	Key GetHashCommandTokenKey(std::string_view str)
 	{
-		for (Key i = Key::HashCommand_First; i <= Key::HashCommand_Last; IncrementEnum(i))
-			if (MatchKeyString(i, str)) { return i; }
-		return Key::Chart_Unknown; // already matched; should never be reached
+		if (!IsValidHashCommandKeyString(str))
+			return Key::Chart_Invalid;
+
+		if (const Key exactKey = HashCommandKeyTable.Find(str); exactKey != Key::Unknown)
+			return exactKey;
+
+		return Key::Chart_Unknown;
 	}
 
 	struct LinePrefixCommentSuffixSplit { std::string_view LinePrefix, CommentSuffix; };
@@ -153,6 +233,23 @@ namespace TJA
 		return { line, line.substr(0, 0) };
 	}
 
+	Encoding DetectFileContentEncoding(std::string_view fileContent)
+	{
+		if (UTF8::HasBOM(fileContent) || UTF8::IsValid(fileContent))
+			return Encoding::UTF8;
+		return Encoding::ShiftJIS;
+	}
+
+	std::string ConvertFileContentToUTF8(std::string_view fileContent, Encoding encoding)
+	{
+		if (encoding == Encoding::Unknown)
+			encoding = DetectFileContentEncoding(fileContent);
+
+		if (encoding == Encoding::ShiftJIS)
+			return UTF8::FromShiftJIS(fileContent);
+		return std::string(UTF8::HasBOM(fileContent) ? UTF8::TrimBOM(fileContent) : fileContent);
+	}
+
 	std::vector<std::string_view> SplitLines(std::string_view fileContent)
 	{
 		i32 lineCount = 0;
@@ -165,104 +262,145 @@ namespace TJA
 		return outLines;
 	}
 
-	std::vector<Token> TokenizeLines(const std::vector<std::string_view>& lines)
+	// NOTE: Shared by both the line list and the file content tokenizer, only state carried across lines are the current #START / COURSE: scopes
+	struct LineTokenizer
 	{
-		std::vector<Token> outTokens;
-		outTokens.reserve(lines.size());
-
-		b8 currentlyBetweenChartStartAndEnd = false;
-		b8 currentlyAfterFirstCourse = false;
+		std::vector<Token>& OutTokens;
+		b8 CurrentlyBetweenChartStartAndEnd = false;
+		b8 CurrentlyAfterFirstCourse = false;
 
-		for (size_t lineIndex = 0; lineIndex < lines.size(); lineIndex++)
+		void TokenizeLine(std::string_view lineFull, i32 lineIndex)
 		{
-			const std::string_view lineFull = lines[lineIndex];
 			std::string_view lineTrimmed = ASCII::Trim(lineFull);
 
 			if (lineTrimmed.empty() || ASCII::IsAllWhitespace(lineTrimmed))
 			{
-				Token& newToken = outTokens.emplace_back();
+				Token& newToken = OutTokens.emplace_back();
 				newToken.Type = TokenType::EmptyLine;
-				newToken.LineIndex = static_cast<i16>(lineIndex);
+				newToken.LineIndex = lineIndex;
 				newToken.Line = lineTrimmed;
+				return;
 			}
-			else
-			{
-				const LinePrefixCommentSuffixSplit lineCommentSplit = SplitLineIntoPrefixAndCommentSuffix(lineTrimmed);
-				if (!lineCommentSplit.CommentSuffix.empty())
-					lineTrimmed = ASCII::Trim(lineCommentSplit.LinePrefix);
 
-				if (!lineTrimmed.empty())
-				{
-					Token& newToken = outTokens.emplace_back();
-					newToken.Type = TokenType::Unknown;
-					newToken.LineIndex = static_cast<i16>(lineIndex);
-					newToken.Line = lineTrimmed;
+			const LinePrefixCommentSuffixSplit lineCommentSplit = SplitLineIntoPrefixAndCommentSuffix(lineTrimmed);
+			if (!lineCommentSplit.CommentSuffix.empty())
+				lineTrimmed = ASCII::Trim(lineCommentSplit.LinePrefix);
 
-					if (lineTrimmed[0] == '#')
-					{
-						newToken.Type = TokenType::HashChartCommand;
-						if (const size_t spaceSeparator = lineTrimmed.find_first_of(' '); spaceSeparator != std::string_view::npos)
-						{
-							newToken.KeyString = lineTrimmed.substr(sizeof('#'), spaceSeparator - sizeof('#'));
-							newToken.ValueString = lineTrimmed.substr(spaceSeparator + sizeof(' '));
-						}
-						else
-						{
-							newToken.KeyString = lineTrimmed.substr(sizeof('#'), lineTrimmed.size() - sizeof('#'));
-							newToken.ValueString = {};
-						}
+			if (!lineTrimmed.empty())
+			{
+				Token& newToken = OutTokens.emplace_back();
+				newToken.Type = TokenType::Unknown;
+				newToken.LineIndex = lineIndex;
+				newToken.Line = lineTrimmed;
 
-						newToken.Key = GetHashCommandTokenKey(newToken.KeyString);
-						if (newToken.Key == Key::Chart_START)
-							currentlyBetweenChartStartAndEnd = true;
-						else if (newToken.Key == Key::Chart_END)
-							currentlyBetweenChartStartAndEnd = false;
-					}
-					else if (const size_t colonSeparator = lineTrimmed.find_first_of(':'); colonSeparator != std::string_view::npos)
+				if (lineTrimmed[0] == '#')
+				{
+					newToken.Type = TokenType::HashChartCommand;
+					if (const size_t spaceSeparator = lineTrimmed.find_first_of(' '); spaceSeparator != std::string_view::npos)
 					{
-						newToken.Type = TokenType::KeyColonValue;
-						newToken.KeyString = lineTrimmed.substr(0, colonSeparator);
-						newToken.ValueString = lineTrimmed.substr(colonSeparator + sizeof(':'));
-
-						newToken.Key = GetKeyColonValueTokenKey(newToken.KeyString);
-						if (newToken.Key == Key::Course_COURSE) {
-							currentlyAfterFirstCourse = true;
-						} else if (currentlyAfterFirstCourse) {
-							// treat unknown headers after first COURSE: as course-scope header
-							if (newToken.Key == Key::Main_Invalid)
-								newToken.Key = Key::Course_Invalid;
-						} else {
-							// treat unknown headers before first COURSE: as file-scope header
-							if (newToken.Key == Key::Course_Unknown)
-								newToken.Key = Key::Main_Unknown;
-						}
+						newToken.KeyString = lineTrimmed.substr(sizeof('#'), spaceSeparator - sizeof('#'));
+						newToken.ValueString = lineTrimmed.substr(spaceSeparator + sizeof(' '));
 					}
 					else
 					{
-						newToken.Type = currentlyBetweenChartStartAndEnd ? TokenType::ChartData : TokenType::Unknown;
-						newToken.KeyString = {};
-						newToken.ValueString = lineTrimmed;
+						newToken.KeyString = lineTrimmed.substr(sizeof('#'), lineTrimmed.size() - sizeof('#'));
+						newToken.ValueString = {};
 					}
-				}
 
-				if (!lineCommentSplit.CommentSuffix.empty())
+					newToken.Key = GetHashCommandTokenKey(newToken.KeyString);
+					if (newToken.Key == Key::Chart_START)
+						CurrentlyBetweenChartStartAndEnd = true;
+					else if (newToken.Key == Key::Chart_END)
+						CurrentlyBetweenChartStartAndEnd = false;
+				}
+				else if (const size_t colonSeparator = lineTrimmed.find_first_of(':'); colonSeparator != std::string_view::npos)
+				{
+					newToken.Type = TokenType::KeyColonValue;
+					newToken.KeyString = lineTrimmed.substr(0, colonSeparator);
+					newToken.ValueString = lineTrimmed.substr(colonSeparator + sizeof(':'));
+
+					newToken.Key = GetKeyColonValueTokenKey(newToken.KeyString);
+					if (newToken.Key == Key::Course_COURSE) {
+						CurrentlyAfterFirstCourse = true;
+					} else if (CurrentlyAfterFirstCourse) {
+						// treat unknown headers after first COURSE: as course-scope header
+						if (newToken.Key == Key::Main_Invalid)
+							newToken.Key = Key::Course_Invalid;
+					} else {
+						// treat unknown headers before first COURSE: as file-scope header
+						if (newToken.Key == Key::Course_Unknown)
+							newToken.Key = Key::Main_Unknown;
+					}
+				}
+				else
 				{
-					Token& newCommentToken = outTokens.emplace_back();
-					newCommentToken.Type = TokenType::Comment;
-					newCommentToken.LineIndex = static_cast<i16>(lineIndex);
-					newCommentToken.Line = lineTrimmed;
-					newCommentToken.ValueString = ASCII::Trim(lineCommentSplit.CommentSuffix.substr(sizeof('/') * 2));
+					newToken.Type = CurrentlyBetweenChartStartAndEnd ? TokenType::ChartData : TokenType::Unknown;
+					newToken.KeyString = {};
+					newToken.ValueString = lineTrimmed;
 				}
 			}
+
+			if (!lineCommentSplit.CommentSuffix.empty())
+			{
+				Token& newCommentToken = OutTokens.emplace_back();
+				newCommentToken.Type = TokenType::Comment;
+				newCommentToken.LineIndex = lineIndex;
+				newCommentToken.Line = lineTrimmed;
+				newCommentToken.ValueString = ASCII::Trim(lineCommentSplit.CommentSuffix.substr(sizeof('/') * 2));
+			}
 		}
 
 		// end-of-file token as implicit `#END`
+		void PushEndOfFileToken(i32 lastLineIndex)
+		{
+			OutTokens.push_back({ TokenType::HashChartCommand, Key::Chart_END, lastLineIndex });
+		}
+	};
+
+	std::vector<Token> TokenizeLines(const std::vector<std::string_view>& lines)
+	{
+		std::vector<Token> outTokens;
+		outTokens.reserve(lines.size());
+
+		LineTokenizer tokenizer { outTokens };
+		for (size_t lineIndex = 0; lineIndex < lines.size(); lineIndex++)
+			tokenizer.TokenizeLine(lines[lineIndex], static_cast<i32>(lineIndex));
+
 		if (!lines.empty())
-			outTokens.push_back({ TokenType::HashChartCommand, Key::Chart_END, static_cast<i16>(size(lines) - 1) });
+			tokenizer.PushEndOfFileToken(static_cast<i32>(lines.size() - 1));
 
 		return outTokens;
 	}
 
+	void TokenizeFileContent(std::string_view fileContent, std::vector<Token>& outTokens)
+	{
+		outTokens.clear();
+		LineTokenizer tokenizer { outTokens };
+
+		// NOTE: Same line splitting rules as ASCII::ForEachLineInMultiLineString() (without an empty trailing line)
+		//		 but skipping ahead to the next line break using memchr instead of testing every character individually
+		const char* const contentEnd = fileContent.data() + fileContent.size();
+		const char* lineBegin = fileContent.data();
+		i32 lineIndex = 0;
+
+		while (lineBegin < contentEnd)
+		{
+			const char* lineBreak = static_cast<const char*>(::memchr(lineBegin, '\n', static_cast<size_t>(contentEnd - lineBegin)));
+			if (lineBreak == nullptr || (lineBreak + 1) == contentEnd)
+			{
+				tokenizer.TokenizeLine(std::string_view(lineBegin, static_cast<size_t>(contentEnd - lineBegin)), lineIndex++);
+				break;
+			}
+
+			const char* lineEnd = (lineBreak > fileContent.data() && lineBreak[-1] == '\r') ? (lineBreak - 1) : lineBreak;
+			tokenizer.TokenizeLine(std::string_view(lineBegin, static_cast<size_t>(lineEnd - lineBegin)), lineIndex++);
+			lineBegin = (lineBreak + 1);
+		}
+
+		if (lineIndex > 0)
+			tokenizer.PushEndOfFileToken(lineIndex - 1);
+	}
+
 	ParsedTJA ParseTokens(const std::vector<Token>& tokens, ErrorList& outErrors)
 	{
 		static constexpr auto tryParseDefaultForEmpty = [](std::string_view in, auto* out, auto dflt) -> b8 { if (in.empty()) { *out = dflt; return true; } else { return ASCII::TryParse(in, *out); } };
@@ -448,6 +586,20 @@ namespace TJA
 
 		ParsedTJA outTJA = {};
 
+		// NOTE: Reserving the arena upfront so that it only has to be allocated once per file (each parsed note takes up at least one character)
+		{
+			size_t noteCharacterCount = 0, stringCharacterCount = 0;
+			for (const Token& token : tokens)
+			{
+				if (token.Type == TokenType::ChartData)
+					noteCharacterCount += token.ValueString.size();
+				else if (token.Type == TokenType::HashChartCommand && (token.Key == Key::Chart_LYRIC || token.Key == Key::Chart_NEXTSONG))
+					stringCharacterCount += token.ValueString.size();
+			}
+			outTJA.Arena.Notes.reserve(noteCharacterCount);
+			outTJA.Arena.Strings.reserve(stringCharacterCount);
+		}
+
 		i32 currentMeasureNoteCount = 0;
 		b8 currentlyBetweenFirstCommandAndEnd = false;
 		b8 currentlyBetweenChartStartAndEnd = false;
@@ -494,7 +646,7 @@ namespace TJA
 
 		for (const Token& token : tokens)
 		{
-			const i16 lineIndex = token.LineIndex;
+			const i32 lineIndex = token.LineIndex;
 			switch (token.Type)
 			{
 			case TokenType::Unknown:
@@ -846,7 +998,7 @@ namespace TJA
 						pushChartCommand(ParsedChartCommandType::BranchEnd);
 					} break;
 					case Key::Chart_SECTION: { pushChartCommand(ParsedChartCommandType::ResetAccuracyValues); } break;
-					case Key::Chart_LYRIC: { pushChartCommand(ParsedChartCommandType::SetLyricLine).Param.SetLyricLine.Value = in; } break;
+					case Key::Chart_LYRIC: { pushChartCommand(ParsedChartCommandType::SetLyricLine).Param.SetLyricLine.Value = outTJA.Arena.PushString(in); } break;
 					case Key::Chart_LEVELHOLD: { pushChartCommand(ParsedChartCommandType::BranchLevelHold); } break;
 					case Key::Chart_BMSCROLL: { pushChartCommand(ParsedChartCommandType::BMScroll); } break;
 					case Key::Chart_HBSCROLL: { pushChartCommand(ParsedChartCommandType::HBScroll); } break;
@@ -857,7 +1009,7 @@ namespace TJA
 						else
 							pushChartCommand(ParsedChartCommandType::SENoteChange).Param.SENoteChange.Type = v;
 						break;
-					case Key::Chart_NEXTSONG: { pushChartCommand(ParsedChartCommandType::SetNextSong).Param.SetNextSong.CommaSeparatedList = in; } break;
+					case Key::Chart_NEXTSONG: { pushChartCommand(ParsedChartCommandType::SetNextSong).Param.SetNextSong.CommaSeparatedList = outTJA.Arena.PushString(in); } break;
 					case Key::Chart_DIRECTION: 
 					{
 						f32 scrollspeed = cachedScrollSpeed.GetRealPart();
@@ -995,7 +1147,7 @@ namespace TJA
 					currentlyInBetweenMeasure = true;
 
 					ParsedChartCommand& newCommand = pushChartCommand(ParsedChartCommandType::MeasureNotes);
-					newCommand.Param.MeasureNotes.Notes.reserve(token.ValueString.size());
+					newCommand.Param.MeasureNotes.Notes = outTJA.Arena.BeginNotes();
 					for (const char& c : token.ValueString)
 					{
 						if (c == ',')
@@ -1021,7 +1173,7 @@ namespace TJA
 							if (!tryParseNoteTypeChar(c, &parsedNoteTypeOrNone))
 								outErrors.Push(lineIndex, "Unknown note type '%c'", c);
 
-							newCommand.Param.MeasureNotes.Notes.push_back(parsedNoteTypeOrNone);
+							outTJA.Arena.PushNote(newCommand.Param.MeasureNotes.Notes, parsedNoteTypeOrNone);
 							currentMeasureNoteCount++;
 						}
 					}
@@ -1050,27 +1202,131 @@ namespace TJA
 	static const ParsedMainMetadata DefaultMainMetadata = {};
 	static const ParsedCourseMetadata DefaultCourseMetadata = {};
 
+	// NOTE: Reusable buffer for formatting values via std::to_chars, with floating point values being formatted the same as printf's "%g"
+	struct TextValueFormatter
+	{
+		char Buffer[128];
+		char* End = Buffer;
+
+		inline TextValueFormatter& Reset() { End = Buffer; return *this; }
+		inline TextValueFormatter& Append(char value) { if (End < std::end(Buffer)) { *End++ = value; } return *this; }
+		inline TextValueFormatter& Append(std::string_view value) { const size_t size = Min(value.size(), static_cast<size_t>(std::end(Buffer) - End)); memcpy(End, value.data(), size); End += size; return *this; }
+		inline TextValueFormatter& Append(i32 value) { End = std::to_chars(End, std::end(Buffer), value).ptr; return *this; }
+		inline TextValueFormatter& Append(f64 value) { End = std::to_chars(End, std::end(Buffer), value, std::chars_format::general, 6).ptr; return *this; }
+		inline TextValueFormatter& AppendFixed(f64 value, i32 precision) { End = std::to_chars(End, std::end(Buffer), value, std::chars_format::fixed, precision).ptr; return *this; }
+		// NOTE: Same output as Complex::toStringCompat(), the imaginary part always has its sign written out
+		inline TextValueFormatter& Append(const Complex& value)
+		{
+			Append(static_cast<f64>(value.GetRealPart()));
+			if (value.GetImaginaryPart() != 0)
+			{
+				if (!std::signbit(value.GetImaginaryPart()))
+					Append('+');
+				Append(static_cast<f64>(value.GetImaginaryPart())).Append('i');
+			}
+			return *this;
+		}
+		inline std::string_view View() const { return std::string_view(Buffer, static_cast<size_t>(End - Buffer)); }
+	};
+
+	// NOTE: Collects the output text in a fixed size chunk which is then passed on (and transcoded if needed) as a whole once full
+	struct TextChunkWriter
+	{
+		static constexpr size_t ChunkCapacity = 0x10000;
+
+		Encoding OutputEncoding;
+		TextChunkOutputFunc OutputFunc;
+		void* UserData;
+		std::unique_ptr<char[]> Chunk = std::unique_ptr<char[]>(new char[ChunkCapacity]);
+		size_t ChunkSize = 0;
+		b8 HasOutputError = false;
+
+		inline void Output(std::string_view text)
+		{
+			if (OutputEncoding == Encoding::ShiftJIS)
+				HasOutputError |= !OutputFunc(ShiftJIS::FromUTF8(text), UserData);
+			else
+				HasOutputError |= !OutputFunc(text, UserData);
+		}
+
+		inline void Flush()
+		{
+			if (ChunkSize == 0)
+				return;
+
+			Output(std::string_view(Chunk.get(), ChunkSize));
+			ChunkSize = 0;
+		}
+
+		inline TextChunkWriter& operator+=(std::string_view text)
+		{
+			if (ChunkSize + text.size() > ChunkCapacity)
+			{
+				Flush();
+				if (text.size() > ChunkCapacity) { Output(text); return *this; }
+			}
+			memcpy(&Chunk[ChunkSize], text.data(), text.size());
+			ChunkSize += text.size();
+			return *this;
+		}
+
+		inline TextChunkWriter& operator+=(char c)
+		{
+			if (ChunkSize >= ChunkCapacity)
+				Flush();
+			Chunk[ChunkSize++] = c;
+			return *this;
+		}
+	};
+
+	static size_t EstimateParsedTextSize(const ParsedTJA& inContent)
+	{
+		// NOTE: One character per note and a short line per command, plus some headroom for the metadata
+		size_t estimatedSize = 0x400 + inContent.Arena.Notes.size() + inContent.Arena.Strings.size();
+		for (const ParsedCourse& course : inContent.Courses)
+			estimatedSize += 0x200 + (course.ChartCommands.size() * 16);
+		return estimatedSize;
+	}
+
 	void ConvertParsedToText(const ParsedTJA& inContent, std::string& out, Encoding encoding)
+	{
+		out.reserve(out.size() + EstimateParsedTextSize(inContent));
+		ConvertParsedToText(inContent, encoding, [](std::string_view chunk, void* userData) -> b8 { static_cast<std::string*>(userData)->append(chunk); return true; }, &out);
+	}
+
+	b8 WriteParsedToTextFile(const ParsedTJA& inContent, std::string_view filePath, Encoding encoding)
+	{
+		File::AtomicFileWriter fileWriter;
+		if (!fileWriter.Open(filePath, EstimateParsedTextSize(inContent)))
+			return false;
+
+		if (!ConvertParsedToText(inContent, encoding, [](std::string_view chunk, void* userData) -> b8 { return static_cast<File::AtomicFileWriter*>(userData)->Write(chunk); }, &fileWriter))
+			return false;
+
+		return fileWriter.Commit();
+	}
+
+	b8 ConvertParsedToText(const ParsedTJA& inContent, Encoding encoding, TextChunkOutputFunc outputFunc, void* userData)
 	{
 		// TODO: ... or maybe tokenize first instead of going right to text..?
-		out.reserve(out.size() + 0x4000);
+		TextChunkWriter out { encoding, outputFunc, userData };
 		if (encoding == Encoding::UTF8)
 			out += std::string_view(UTF8::BOM_UTF8, sizeof(UTF8::BOM_UTF8));
 
-		static constexpr auto appendLine = [](std::string& out, std::string_view line) { out += line; out += '\n'; };
-		static constexpr auto appendProperyLine = [](std::string& out, Key key, std::string_view value) { out += KeyStrings[EnumToIndex(key)]; out += ':'; out += value; out += '\n'; };
-		static constexpr auto appendSuffixedPropertyLine = [](std::string& out, Key key, std::string_view suffix, std::string_view value)
+		static constexpr auto appendLine = [](TextChunkWriter& out, std::string_view line) { out += line; out += '\n'; };
+		static constexpr auto appendProperyLine = [](TextChunkWriter& out, Key key, std::string_view value) { out += KeyStrings[EnumToIndex(key)]; out += ':'; out += value; out += '\n'; };
+		static constexpr auto appendSuffixedPropertyLine = [](TextChunkWriter& out, Key key, std::string_view suffix, std::string_view value)
 		{ out += KeyStrings[EnumToIndex(key)]; out += suffix; out += ':'; out += value; out += '\n'; };
-		static constexpr auto appendCommandLine = [](std::string& out, Key key, std::string_view value) { out += '#'; out += KeyStrings[EnumToIndex(key)]; if (!value.empty()) { out += ' '; out += value; }out += '\n'; };
-		static constexpr auto appendBalloonProperyLine = [](std::string& out, Key key, const std::vector<i32>& popCounts)
+		static constexpr auto appendCommandLine = [](TextChunkWriter& out, Key key, std::string_view value) { out += '#'; out += KeyStrings[EnumToIndex(key)]; if (!value.empty()) { out += ' '; out += value; }out += '\n'; };
+		static constexpr auto appendBalloonProperyLine = [](TextChunkWriter& out, Key key, const std::vector<i32>& popCounts)
 		{
 			out += KeyStrings[EnumToIndex(key)];
 			out += ':';
-			char buffer[16];
-			for (size_t i = 0; i < popCounts.size(); i++) { if (i != 0) { out += ','; } out += std::string_view(buffer, sprintf_s(buffer, "%d", popCounts[i])); }
+			TextValueFormatter format;
+			for (size_t i = 0; i < popCounts.size(); i++) { if (i != 0) { out += ','; } out += format.Reset().Append(popCounts[i]).View(); }
 			out += '\n';
 		};
-		char buffer[512];
+		TextValueFormatter format;
 
 		static constexpr auto noteTypeToChar = [](NoteType in) -> char
 		{
@@ -1160,37 +1416,37 @@ namespace TJA
 			for (const auto& [locale, val] : inContent.Metadata.SUBTITLE_localized)
 				appendSuffixedPropertyLine(out, Key::Main_SUBTITLE_localized, locale, val);
 		}
-		appendProperyLine(out, Key::Main_BPM, std::string_view(buffer, sprintf_s(buffer, "%g", inContent.Metadata.BPM.BPM))); // Better to be explicit
+		appendProperyLine(out, Key::Main_BPM, format.Reset().Append(inContent.Metadata.BPM.BPM).View()); // Better to be explicit
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::WAVE))
 			appendProperyLine(out, Key::Main_WAVE, inContent.Metadata.WAVE);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::PREIMAGE))
 			appendProperyLine(out, Key::Main_PREIMAGE, inContent.Metadata.PREIMAGE);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::WAVE, &ParsedMainMetadata::OFFSET)) // Better to be explicit if `WAVE:` is given
-			appendProperyLine(out, Key::Main_OFFSET, std::string_view(buffer, sprintf_s(buffer, "%g", inContent.Metadata.OFFSET.Seconds)));
+			appendProperyLine(out, Key::Main_OFFSET, format.Reset().Append(inContent.Metadata.OFFSET.Seconds).View());
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::DEMOSTART))
-			appendProperyLine(out, Key::Main_DEMOSTART, std::string_view(buffer, sprintf_s(buffer, "%g", inContent.Metadata.DEMOSTART.Seconds)));
+			appendProperyLine(out, Key::Main_DEMOSTART, format.Reset().Append(inContent.Metadata.DEMOSTART.Seconds).View());
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::GENRE))
 			appendProperyLine(out, Key::Main_GENRE, inContent.Metadata.GENRE);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::SCOREMODE))
-			appendProperyLine(out, Key::Main_SCOREMODE, std::string_view(buffer, sprintf_s(buffer, "%d", static_cast<i32>(inContent.Metadata.SCOREMODE))));
+			appendProperyLine(out, Key::Main_SCOREMODE, format.Reset().Append(static_cast<i32>(inContent.Metadata.SCOREMODE)).View());
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::MAKER))
 			appendProperyLine(out, Key::Main_MAKER, inContent.Metadata.MAKER);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::LYRICS))
 			appendProperyLine(out, Key::Main_LYRICS, inContent.Metadata.LYRICS);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::SONGVOL))
-			appendProperyLine(out, Key::Main_SONGVOL, std::string_view(buffer, sprintf_s(buffer, "%g", ToPercent(inContent.Metadata.SONGVOL))));
+			appendProperyLine(out, Key::Main_SONGVOL, format.Reset().Append(ToPercent(inContent.Metadata.SONGVOL)).View());
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::SEVOL))
-			appendProperyLine(out, Key::Main_SEVOL, std::string_view(buffer, sprintf_s(buffer, "%g", ToPercent(inContent.Metadata.SEVOL))));
+			appendProperyLine(out, Key::Main_SEVOL, format.Reset().Append(ToPercent(inContent.Metadata.SEVOL)).View());
 		// TODO: Key::Main_SIDE;
 		// TODO: Key::Main_GAME;
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::HEADSCROLL))
-			appendProperyLine(out, Key::Main_HEADSCROLL, std::string_view(buffer, sprintf_s(buffer, "%g", inContent.Metadata.HEADSCROLL)));
+			appendProperyLine(out, Key::Main_HEADSCROLL, format.Reset().Append(inContent.Metadata.HEADSCROLL).View());
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::BGIMAGE))
 			appendProperyLine(out, Key::Main_BGIMAGE, inContent.Metadata.BGIMAGE);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::BGMOVIE))
 			appendProperyLine(out, Key::Main_BGMOVIE, inContent.Metadata.BGMOVIE);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::BGIMAGE, &ParsedMainMetadata::BGMOVIE, &ParsedMainMetadata::MOVIEOFFSET)) // Better to be explicit if bg is given
-			appendProperyLine(out, Key::Main_MOVIEOFFSET, std::string_view(buffer, sprintf_s(buffer, "%g", inContent.Metadata.MOVIEOFFSET.Seconds)));
+			appendProperyLine(out, Key::Main_MOVIEOFFSET, format.Reset().Append(inContent.Metadata.MOVIEOFFSET.Seconds).View());
 
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::Others)) {
 			for (const auto& [header, val] : inContent.Metadata.Others)
@@ -1257,14 +1513,14 @@ namespace TJA
 			// Unspecified default value
 			if (firstInGroup || shouldEmitCourseMetadata(&ParsedCourseMetadata::LEVEL, &ParsedCourseMetadata::LEVEL_DECIMALTAG)) {
 				if (course.Metadata.LEVEL_DECIMALTAG == -1)
-					appendProperyLine(out, Key::Course_LEVEL, std::string_view(buffer, sprintf_s(buffer, "%d", course.Metadata.LEVEL)));
+					appendProperyLine(out, Key::Course_LEVEL, format.Reset().Append(course.Metadata.LEVEL).View());
 				else
-					appendProperyLine(out, Key::Course_LEVEL, std::string_view(buffer, sprintf_s(buffer, "%.1f", course.Metadata.LEVEL + static_cast<float>(course.Metadata.LEVEL_DECIMALTAG) / 10.)));
+					appendProperyLine(out, Key::Course_LEVEL, format.Reset().AppendFixed(course.Metadata.LEVEL + static_cast<float>(course.Metadata.LEVEL_DECIMALTAG) / 10., 1).View());
 			}
 
 			// Better to be explicit
 			if (course.Metadata.COURSE == DifficultyType::Tower) {
-				appendProperyLine(out, Key::Course_LIFE, std::string_view(buffer, sprintf_s(buffer, "%d", course.Metadata.LIFE)));
+				appendProperyLine(out, Key::Course_LIFE, format.Reset().Append(course.Metadata.LIFE).View());
 				appendProperyLine(out, Key::Course_SIDE, sideToString(course.Metadata.SIDE));
 			}
 
@@ -1279,8 +1535,8 @@ namespace TJA
 			}
 
 			if (shouldEmitCourseMetadata(&ParsedCourseMetadata::SCOREINIT, &ParsedCourseMetadata::SCOREDIFF)) {
-				appendProperyLine(out, Key::Course_SCOREINIT, (course.Metadata.SCOREINIT == 0) ? "" : std::string_view(buffer, sprintf_s(buffer, "%d", course.Metadata.SCOREINIT)));
-				appendProperyLine(out, Key::Course_SCOREDIFF, (course.Metadata.SCOREDIFF == 0) ? "" : std::string_view(buffer, sprintf_s(buffer, "%d", course.Metadata.SCOREDIFF)));
+				appendProperyLine(out, Key::Course_SCOREINIT, (course.Metadata.SCOREINIT == 0) ? "" : format.Reset().Append(course.Metadata.SCOREINIT).View());
+				appendProperyLine(out, Key::Course_SCOREDIFF, (course.Metadata.SCOREDIFF == 0) ? "" : format.Reset().Append(course.Metadata.SCOREDIFF).View());
 			}
 
 			if (shouldEmitCourseMetadata(&ParsedCourseMetadata::NOTESDESIGNER))
@@ -1311,7 +1567,7 @@ namespace TJA
 				{
 				case ParsedChartCommandType::MeasureNotes:
 				{
-					for (const NoteType note : command.Param.MeasureNotes.Notes)
+					for (const NoteType note : inContent.Arena.GetNotes(command.Param.MeasureNotes.Notes))
 						out += noteTypeToChar(note);
 
 					if (ArrayItToIndex(&command, &course.ChartCommands[0]) + 1 < course.ChartCommands.size())
@@ -1323,19 +1579,19 @@ namespace TJA
 				case ParsedChartCommandType::MeasureEnd: { appendLine(out, ","); } break;
 				case ParsedChartCommandType::ChangeTimeSignature:
 				{
-					appendCommandLine(out, Key::Chart_MEASURE, std::string_view(buffer, sprintf_s(buffer, "%d/%d", command.Param.ChangeTimeSignature.Value.Numerator, command.Param.ChangeTimeSignature.Value.Denominator)));
+					appendCommandLine(out, Key::Chart_MEASURE, format.Reset().Append(command.Param.ChangeTimeSignature.Value.Numerator).Append('/').Append(command.Param.ChangeTimeSignature.Value.Denominator).View());
 				} break;
 				case ParsedChartCommandType::ChangeTempo:
 				{
-					appendCommandLine(out, Key::Chart_BPMCHANGE, std::string_view(buffer, sprintf_s(buffer, "%g", command.Param.ChangeTempo.Value.BPM)));
+					appendCommandLine(out, Key::Chart_BPMCHANGE, format.Reset().Append(command.Param.ChangeTempo.Value.BPM).View());
 				} break;
 				case ParsedChartCommandType::ChangeDelay:
 				{
-					appendCommandLine(out, Key::Chart_DELAY, std::string_view(buffer, sprintf_s(buffer, "%g", command.Param.ChangeDelay.Value.ToSec())));
+					appendCommandLine(out, Key::Chart_DELAY, format.Reset().Append(command.Param.ChangeDelay.Value.ToSec()).View());
 				} break;
 				case ParsedChartCommandType::ChangeScrollSpeed:
 				{
-					appendCommandLine(out, Key::Chart_SCROLL, std::string_view(buffer, sprintf_s(buffer, "%s", command.Param.ChangeScrollSpeed.Value.toStringCompat().c_str())));
+					appendCommandLine(out, Key::Chart_SCROLL, format.Reset().Append(command.Param.ChangeScrollSpeed.Value).View());
 				} break;
 				case ParsedChartCommandType::ChangeBarLine:
 				{
@@ -1351,7 +1607,7 @@ namespace TJA
 				} break;
 				case ParsedChartCommandType::BranchStart:
 				{
-					appendCommandLine(out, Key::Chart_BRANCHSTART, std::string_view(buffer, sprintf_s(buffer, "%c,%d,%d", BranchConditionToChar(command.Param.BranchStart.Condition), command.Param.BranchStart.RequirementExpert, command.Param.BranchStart.RequirementMaster)));
+					appendCommandLine(out, Key::Chart_BRANCHSTART, format.Reset().Append(BranchConditionToChar(command.Param.BranchStart.Condition)).Append(',').Append(command.Param.BranchStart.RequirementExpert).Append(',').Append(command.Param.BranchStart.RequirementMaster).View());
 				} break;
 				case ParsedChartCommandType::BranchNormal:
 				{
@@ -1380,7 +1636,7 @@ namespace TJA
 				case ParsedChartCommandType::SetLyricLine:
 				{
 					// TODO: Handle escape characters, most importantly "\n"
-					appendCommandLine(out, Key::Chart_LYRIC, command.Param.SetLyricLine.Value);
+					appendCommandLine(out, Key::Chart_LYRIC, inContent.Arena.GetString(command.Param.SetLyricLine.Value));
 				} break;
 				case ParsedChartCommandType::NMScroll:
 				{
@@ -1408,11 +1664,11 @@ namespace TJA
 				} break;
 				case ParsedChartCommandType::SetSudden:
 				{
-					appendCommandLine(out, Key::Chart_SUDDEN, std::string_view(buffer, sprintf_s(buffer, "%g %g", command.Param.SetSudden.AppearanceOffset.ToSec(), command.Param.SetSudden.MovementWaitDelay.ToSec())));
+					appendCommandLine(out, Key::Chart_SUDDEN, format.Reset().Append(command.Param.SetSudden.AppearanceOffset.ToSec()).Append(' ').Append(command.Param.SetSudden.MovementWaitDelay.ToSec()).View());
 				} break;
 				case ParsedChartCommandType::SetJPOSScroll:
 				{
-					appendCommandLine(out, Key::Chart_JPOSSCROLL, std::string_view(buffer, sprintf_s(buffer, "%g %s 1", command.Param.ChangeJPOSScroll.Duration.ToSec(), command.Param.ChangeJPOSScroll.Move.toStringCompat().c_str())));
+					appendCommandLine(out, Key::Chart_JPOSSCROLL, format.Reset().Append(command.Param.ChangeJPOSScroll.Duration.ToSec()).Append(' ').Append(command.Param.ChangeJPOSScroll.Move).Append(" 1").View());
 				} break;
 				default: { assert(!"Unhandled ParsedChartCommandType switch case"); } break;
 				}
@@ -1424,11 +1680,15 @@ namespace TJA
 			for (CourseIter it = itBeg; it != itEnd; ++it)
 				convertCourse(it, itBeg, itEnd);
 		}
+
+		out.Flush();
+		return !out.HasOutputError;
 	}
 
-	void ConvertConvertedMeasuresToParsedCommands(const std::vector<ConvertedMeasure>& inMeasures, std::vector<ParsedChartCommand>& outCommands)
+	void ConvertConvertedMeasuresToParsedCommands(const std::vector<ConvertedMeasure>& inMeasures, std::vector<ParsedChartCommand>& outCommands, ParsedArena& outArena)
 	{
-		struct TempCommand { Beat TimeWithinMeasure; ParsedChartCommand ParsedCommand; };
+		// NOTE: Single notes are only written into the arena once the commands have been sorted so that adjacent ones can be merged into a single contiguous span
+		struct TempCommand { Beat TimeWithinMeasure; ParsedChartCommand ParsedCommand; NoteType Note; };
 		std::vector<TempCommand> tempBuffer;
 		tempBuffer.reserve(64);
 
@@ -1495,7 +1755,7 @@ namespace TJA
 			{
 				ParsedChartCommand& tempCommand = tempBuffer.emplace_back(TempCommand { lyricChange.TimeWithinMeasure }).ParsedCommand;
 				tempCommand.Type = ParsedChartCommandType::SetLyricLine;
-				tempCommand.Param.SetLyricLine.Value = lyricChange.Lyric;
+				tempCommand.Param.SetLyricLine.Value = outArena.PushString(lyricChange.Lyric);
 			}
 
 			for (const ConvertedDelayChange& delayChange : inMeasure.DelayChanges)
@@ -1510,9 +1770,9 @@ namespace TJA
 			i32 actualNotesInThisMeasure = 0;
 			for (const ConvertedNote& note : inMeasure.Notes)
 			{
-				ParsedChartCommand& tempCommand = tempBuffer.emplace_back(TempCommand { note.TimeWithinMeasure }).ParsedCommand;
-				tempCommand.Type = ParsedChartCommandType::MeasureNotes;
-				tempCommand.Param.MeasureNotes.Notes.push_back(note.Type);
+				TempCommand& tempCommand = tempBuffer.emplace_back(TempCommand { note.TimeWithinMeasure });
+				tempCommand.ParsedCommand.Type = ParsedChartCommandType::MeasureNotes;
+				tempCommand.Note = note.Type;
 				actualNotesInThisMeasure++;
 			}
 			size_t noteCommandEnd = tempBuffer.size();
@@ -1559,9 +1819,9 @@ namespace TJA
 
 						if (!noteAlreadyExists)
 						{
-							ParsedChartCommand& tempCommand = tempBuffer.emplace_back(TempCommand { noteBeat }).ParsedCommand;
-							tempCommand.Type = ParsedChartCommandType::MeasureNotes;
-							tempCommand.Param.MeasureNotes.Notes.push_back(NoteType::None);
+							TempCommand& tempCommand = tempBuffer.emplace_back(TempCommand { noteBeat });
+							tempCommand.ParsedCommand.Type = ParsedChartCommandType::MeasureNotes;
+							tempCommand.Note = NoteType::None;
 						}
 					}
 
@@ -1585,12 +1845,16 @@ namespace TJA
 					// NOTE: Merge adjacent single-note MeasureNotes commands
 					if (lastNoteCommand != nullptr && (thisCommand.ParsedCommand.Type == ParsedChartCommandType::MeasureNotes))
 					{
-						for (NoteType note : thisCommand.ParsedCommand.Param.MeasureNotes.Notes)
-							lastNoteCommand->Param.MeasureNotes.Notes.push_back(note);
+						outArena.PushNote(lastNoteCommand->Param.MeasureNotes.Notes, thisCommand.Note);
 					}
 					else {
+						if (thisCommand.ParsedCommand.Type == ParsedChartCommandType::MeasureNotes)
+						{
+							thisCommand.ParsedCommand.Param.MeasureNotes.Notes = outArena.BeginNotes();
+							outArena.PushNote(thisCommand.ParsedCommand.Param.MeasureNotes.Notes, thisCommand.Note);
+						}
 						// Push first, modify later
-						outCommands.push_back(std::move(thisCommand.ParsedCommand));
+						outCommands.push_back(thisCommand.ParsedCommand);
 						lastNoteCommand = (outCommands.back().Type == ParsedChartCommandType::MeasureNotes) ?
 							&outCommands.back()
 							: nullptr;
@@ -1623,7 +1887,7 @@ namespace TJA
 			{
 				if (command.Type == ParsedChartCommandType::MeasureNotes)
 				{
-					for (const NoteType note : command.Param.MeasureNotes.Notes)
+					for (const NoteType note : inContent.Arena.GetNotes(command.Param.MeasureNotes.Notes))
 						currentMeasure->Notes.push_back(ConvertedNote { Beat::Zero(), note });
 				}
 				else if (command.Type == ParsedChartCommandType::MeasureEnd)
@@ -1662,7 +1926,7 @@ namespace TJA
 			{
 				if (command.Type == ParsedChartCommandType::MeasureNotes)
 				{
-					currentNotesInMeasure += static_cast<i32>(command.Param.MeasureNotes.Notes.size());
+					currentNotesInMeasure += static_cast<i32>(command.Param.MeasureNotes.Notes.Count);
 
 					if (!currentMeasure->Notes.empty() && currentNotesInMeasure > 0)
 						currentTimeWithinMeasure = currentMeasure->Notes[currentNotesInMeasure - 1].TimeWithinMeasure +
@@ -1703,7 +1967,7 @@ namespace TJA
 				}
 				else if (command.Type == ParsedChartCommandType::SetLyricLine)
 				{
-					currentMeasure->LyricChanges.push_back(ConvertedLyricChange { currentTimeWithinMeasure, command.Param.SetLyricLine.Value });
+					currentMeasure->LyricChanges.push_back(ConvertedLyricChange { currentTimeWithinMeasure, std::string(inContent.Arena.GetString(command.Param.SetLyricLine.Value)) });
 				}
 				else if (command.Type == ParsedChartCommandType::NMScroll || command.Type == ParsedChartCommandType::HBScroll || command.Type == ParsedChartCommandType::BMScroll) 
 				{
@@ -146,7 +146,7 @@ namespace TJA
 	{
 		TokenType Type;
 		Key Key;
-		i16 LineIndex;
+		i32 LineIndex;
 		std::string_view Line;
 		std::string_view KeyString;
 		std::string_view ValueString;
@@ -378,13 +378,43 @@ namespace TJA
 		Count
 	};
 
+	// NOTE: Offset + count into the flat per-file buffers of a ParsedArena, so that commands don't each own a separate heap allocation
+	struct ParsedNoteSpan { u32 Offset, Count; };
+	struct ParsedStringSpan { u32 Offset, Size; };
+
+	struct ParsedNoteRange
+	{
+		const NoteType* Begin;
+		const NoteType* End;
+
+		constexpr const NoteType* begin() const { return Begin; }
+		constexpr const NoteType* end() const { return End; }
+		constexpr size_t size() const { return static_cast<size_t>(End - Begin); }
+		constexpr b8 empty() const { return (Begin == End); }
+		constexpr const NoteType& back() const { return End[-1]; }
+	};
+
+	// NOTE: Bump allocated storage shared by all chart commands of all courses within a single parsed file.
+	//		 Notes of a single MeasureNotes command are always stored contiguously, strings are stored without null terminators
+	struct ParsedArena
+	{
+		std::vector<NoteType> Notes;
+		std::string Strings;
+
+		inline ParsedNoteRange GetNotes(ParsedNoteSpan span) const { return ParsedNoteRange { Notes.data() + span.Offset, Notes.data() + span.Offset + span.Count }; }
+		inline std::string_view GetString(ParsedStringSpan span) const { return std::string_view(Strings.data() + span.Offset, span.Size); }
+
+		inline ParsedNoteSpan BeginNotes() const { return ParsedNoteSpan { static_cast<u32>(Notes.size()), 0 }; }
+		inline void PushNote(ParsedNoteSpan& span, NoteType note) { assert(span.Offset + span.Count == Notes.size()); Notes.push_back(note); span.Count++; }
+		inline ParsedStringSpan PushString(std::string_view value) { const ParsedStringSpan span { static_cast<u32>(Strings.size()), static_cast<u32>(value.size()) }; Strings += value; return span; }
+	};
+
 	struct ParsedChartCommand
 	{
-		// TODO: Maybe store notes as index + count into single vector (?)
 		ParsedChartCommandType Type;
 		struct ParamData
 		{
-			struct { std::vector<NoteType> Notes; } MeasureNotes;
+			struct { ParsedNoteSpan Notes; } MeasureNotes;
 			struct { TimeSignature Value; } ChangeTimeSignature;
 			struct { Tempo Value; } ChangeTempo;
 			struct { Time Value; } ChangeDelay;
@@ -393,9 +423,9 @@ namespace TJA
 			struct { Time Duration; Complex Move; } ChangeJPOSScroll;
 			struct { b8 Visible; } ChangeBarLine;
 			struct { BranchCondition Condition; i32 RequirementExpert; i32 RequirementMaster; } BranchStart;
-			struct { std::string Value; } SetLyricLine;
+			struct { ParsedStringSpan Value; } SetLyricLine;
 			struct { i32 Type; } SENoteChange;
-			struct { std::string CommaSeparatedList; } SetNextSong;
+			struct { ParsedStringSpan CommaSeparatedList; } SetNextSong;
 			struct { ScrollDirection Direction; } ChangeDirection;
 			struct { Time AppearanceOffset, MovementWaitDelay; } SetSudden;
 			struct { Time Duration; f32 MovementDistance; ScrollDirection Direction; } SetScrollTransition;
@@ -413,6 +443,7 @@ namespace TJA
 	{
 		ParsedMainMetadata Metadata;
 		std::vector<ParsedCourse> Courses;
+		ParsedArena Arena;
 
 		// NOTE: Only for internal use within PeepoDrumKit. TJAs that have been exported with this special comment marker
 		//		 are assumed to only make use of known and supported features that can be safely converted without having to worry about potential data loss
@@ -420,11 +451,20 @@ namespace TJA
 		Date PeepoDrumKitCommentDate = {};
 	};
 
+	// NOTE: A UTF-8 BOM or otherwise strictly valid UTF-8 is detected as UTF-8, anything else as Shift-JIS (which most older TJA files still use)
+	Encoding DetectFileContentEncoding(std::string_view fileContent);
+	// NOTE: Returns the (BOM trimmed) file content as UTF-8, with Encoding::Unknown detecting the encoding first
+	std::string ConvertFileContentToUTF8(std::string_view fileContent, Encoding encoding = Encoding::Unknown);
+
 	std::vector<std::string_view> SplitLines(std::string_view fileContent);
 
 	// NOTE: Designed to never fail, invalid input data just means a different arrangements of (unknown / bad) tokens
 	std::vector<Token> TokenizeLines(const std::vector<std::string_view>& lines);
 
+	// NOTE: Same output as TokenizeLines(SplitLines(fileContent)) but in a single pass over the file content without an intermediate line list.
+	//		 The output vector is cleared first so reusing the same one across calls avoids reallocating once its capacity has grown large enough
+	void TokenizeFileContent(std::string_view fileContent, std::vector<Token>& outTokens);
+
 	struct ErrorList
 	{
 		// TODO: Have error enum type instead + std::string_view of the offending data (?)
@@ -446,6 +486,13 @@ namespace TJA
 
 	void ConvertParsedToText(const ParsedTJA& inContent, std::string& out, Encoding encoding);
 
+	// NOTE: Streams the text out in fixed size chunks instead of building it up in memory first, with any encoding conversion also being done per chunk.
+	//		 A chunk only ever ends in between two complete values so it never splits up a multi-byte character
+	using TextChunkOutputFunc = b8(*)(std::string_view chunk, void* userData);
+	b8 ConvertParsedToText(const ParsedTJA& inContent, Encoding encoding, TextChunkOutputFunc outputFunc, void* userData);
+	// NOTE: Streams straight into the file via a File::AtomicFileWriter, so the previous file content stays intact if anything fails
+	b8 WriteParsedToTextFile(const ParsedTJA& inContent, std::string_view filePath, Encoding encoding);
+
 	struct ConvertedNote
 	{
 		Beat TimeWithinMeasure;
@@ -538,7 +585,7 @@ namespace TJA
 		std::vector<ConvertedGoGoRange> GoGoRanges;
 	};
 
-	void ConvertConvertedMeasuresToParsedCommands(const std::vector<TJA::ConvertedMeasure>& inMeasures, std::vector<TJA::ParsedChartCommand>& outCommands);
+	void ConvertConvertedMeasuresToParsedCommands(const std::vector<TJA::ConvertedMeasure>& inMeasures, std::vector<TJA::ParsedChartCommand>& outCommands, TJA::ParsedArena& outArena);
 
 	ConvertedCourse ConvertParsedToConvertedCourse(const ParsedTJA& inContent, const ParsedCourse& inCourse);
 }
@@ -1,6 +1,9 @@
 #include "chart.h"
 #include "core_build_info.h"
 #include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
 
 namespace PeepoDrumKit
 {
@@ -11,7 +14,9 @@ namespace PeepoDrumKit
 			char buffer[512];
 			va_list args;
 			va_start(args, fmt);
-			onMessageFunc(std::string_view(buffer, _vsnprintf_s(buffer, ArrayCount(buffer), fmt, args)), userData);
+			// NOTE: Truncating long messages (such as lyrics) instead of failing
+			const int length = vsnprintf(buffer, sizeof(buffer), fmt, args);
+			onMessageFunc(std::string_view(buffer, static_cast<size_t>(Clamp(length, 0, static_cast<int>(sizeof(buffer) - 1)))), userData);
 			va_end(args);
 		};
 
@@ -55,6 +60,8 @@ namespace PeepoDrumKit
 						case GenericMember::TimeSignature_V: { memberName = "TimeSignature"; isSame = (valueA.TimeSignature == valueB.TimeSignature); } break;
 						case GenericMember::CStr_Lyric: { memberName = "Lyric"; isSame = safeCStrAreSame(valueA.CStr, valueB.CStr); } break;
 						case GenericMember::I8_ScrollType: { memberName = "ScrollType"; isSame = (valueA.I16 == valueB.I16); } break;
+						case GenericMember::F32_JPOSScroll: { memberName = "JPOSScrollMove"; isSame = ApproxmiatelySame(valueA.CPX, valueB.CPX); } break;
+						case GenericMember::F32_JPOSScrollDuration: { memberName = "JPOSScrollDuration"; isSame = ApproxmiatelySame(valueA.F32, valueB.F32); } break;
 						}
 
 						if (!isSame)
@@ -137,136 +144,425 @@ namespace PeepoDrumKit
 		return maxBeat;
 	}
 
-	b8 CreateChartProjectFromTJA(const TJA::ParsedTJA& inTJA, ChartProject& out)
+	std::pair<size_t, size_t> NoteTimingTable::FindPossiblyOverlappingIndexRange(Time minTime, Time maxTime) const
 	{
-		out.ChartDuration = Time::Zero();
-		out.ChartTitle = inTJA.Metadata.TITLE;
-		out.ChartTitleLocalized = inTJA.Metadata.TITLE_localized;
-		out.ChartSubtitle = inTJA.Metadata.SUBTITLE;
-		out.ChartSubtitleLocalized = inTJA.Metadata.SUBTITLE_localized;
-		out.ChartCreator = inTJA.Metadata.MAKER;
-		out.ChartGenre = inTJA.Metadata.GENRE;
-		out.ChartLyricsFileName = inTJA.Metadata.LYRICS;
-		out.SongOffset = inTJA.Metadata.OFFSET;
-		out.SongDemoStartTime = inTJA.Metadata.DEMOSTART;
-		out.SongFileName = inTJA.Metadata.WAVE;
-		out.SongJacket = inTJA.Metadata.PREIMAGE;
-		out.SongVolume = inTJA.Metadata.SONGVOL;
-		out.SoundEffectVolume = inTJA.Metadata.SEVOL;
-		out.BackgroundImageFileName = inTJA.Metadata.BGIMAGE;
-		out.BackgroundMovieFileName = inTJA.Metadata.BGMOVIE;
-		out.MovieOffset = inTJA.Metadata.MOVIEOFFSET;
-		out.OtherMetadata = inTJA.Metadata.Others;
-		for (size_t i = 0; i < inTJA.Courses.size(); i++)
+		const size_t first = static_cast<size_t>(std::distance(MaxTailTimesSoFar.begin(), std::lower_bound(MaxTailTimesSoFar.begin(), MaxTailTimesSoFar.end(), minTime)));
+		const size_t last = static_cast<size_t>(std::distance(MinHeadTimesFromBack.begin(), std::upper_bound(MinHeadTimesFromBack.begin(), MinHeadTimesFromBack.end(), maxTime)));
+		return { first, Max(first, last) };
+	}
+
+	const NoteTimingTable& ChartCourse::GetNoteTimings(BranchType branch) const
+	{
+		NoteTimingTable& out = TempNoteTimings[EnumToIndex(branch)];
+		const SortedNotesList& notes = GetNotes(branch);
+		if (out.Version == TimingsVersion && out.size() == notes.size())
+			return out;
+
+		const size_t noteCount = notes.size();
+		out.HeadTimes.resize(noteCount); out.TailTimes.resize(noteCount);
+		out.HeadTempos.resize(noteCount); out.TailTempos.resize(noteCount);
+		out.HeadScrollSpeeds.resize(noteCount); out.TailScrollSpeeds.resize(noteCount);
+		out.HeadScrollTypes.resize(noteCount); out.TailScrollTypes.resize(noteCount);
+		out.HeadHBScrollBeatTicks.resize(noteCount); out.TailHBScrollBeatTicks.resize(noteCount);
+		out.MaxTailTimesSoFar.resize(noteCount); out.MinHeadTimesFromBack.resize(noteCount);
+
+		auto getHBScrollBeatTick = [&](Beat beat, Time time, ScrollMethod scrollType)
 		{
-			if (!inTJA.Courses[i].HasChart) // metadata-only TJA section
-				continue;
+			return (scrollType == ScrollMethod::HBSCROLL || scrollType == ScrollMethod::BMSCROLL) ? TempoMap.BeatAndTimeToHBScrollBeatTick(beat, time) : 0.0;
+		};
 
-			const TJA::ConvertedCourse& inCourse = TJA::ConvertParsedToConvertedCourse(inTJA, inTJA.Courses[i]);
-			ChartCourse& outCourse = *out.Courses.emplace_back(std::make_unique<ChartCourse>());
+		// NOTE: Each forward iterator is advanced to the head and then to the tail of each note in order
+		BeatSortedForwardIterator<TempoChange> tempoChangeIt {};
+		BeatSortedForwardIterator<ScrollChange> scrollChangeIt {};
+		BeatSortedForwardIterator<ScrollType> scrollTypeIt {};
+		for (size_t i = 0; i < noteCount; i++)
+		{
+			const Note& note = notes[i];
+			const Beat beat = note.BeatTime;
+			const Beat beatTail = (note.BeatDuration > Beat::Zero()) ? (beat + note.BeatDuration) : beat;
+			const Time head = (TempoMap.BeatToTime(beat) + note.TimeOffset);
+			const Time tail = (note.BeatDuration > Beat::Zero()) ? (TempoMap.BeatToTime(beatTail) + note.TimeOffset) : head;
+
+			out.HeadTimes[i] = head;
+			out.HeadTempos[i] = TempoOrDefault(tempoChangeIt.Next(TempoMap.Tempo.Sorted, beat));
+			out.HeadScrollSpeeds[i] = ScrollOrDefault(scrollChangeIt.Next(ScrollChanges.Sorted, beat));
+			out.HeadScrollTypes[i] = ScrollTypeOrDefault(scrollTypeIt.Next(ScrollTypes.Sorted, beat));
+			out.HeadHBScrollBeatTicks[i] = getHBScrollBeatTick(beat, head, out.HeadScrollTypes[i]);
+
+			out.TailTimes[i] = tail;
+			out.TailTempos[i] = TempoOrDefault(tempoChangeIt.Next(TempoMap.Tempo.Sorted, beatTail));
+			out.TailScrollSpeeds[i] = ScrollOrDefault(scrollChangeIt.Next(ScrollChanges.Sorted, beatTail));
+			out.TailScrollTypes[i] = ScrollTypeOrDefault(scrollTypeIt.Next(ScrollTypes.Sorted, beatTail));
+			out.TailHBScrollBeatTicks[i] = getHBScrollBeatTick(beatTail, tail, out.TailScrollTypes[i]);
+
+			out.MaxTailTimesSoFar[i] = (i > 0) ? Max(out.MaxTailTimesSoFar[i - 1], tail) : tail;
+		}
+		for (size_t i = noteCount; i-- > 0;)
+			out.MinHeadTimesFromBack[i] = ((i + 1) < noteCount) ? Min(out.MinHeadTimesFromBack[i + 1], out.HeadTimes[i]) : out.HeadTimes[i];
 
-			// HACK: Write proper enum conversion functions
-			outCourse.Type = Clamp(static_cast<DifficultyType>(inCourse.CourseMetadata.COURSE), DifficultyType {}, DifficultyType::Count);
-			outCourse.Level = Clamp(static_cast<DifficultyLevel>(inCourse.CourseMetadata.LEVEL), DifficultyLevel::Min, DifficultyLevel::Max);
-			outCourse.Decimal = Clamp(static_cast<DifficultyLevelDecimal>(inCourse.CourseMetadata.LEVEL_DECIMALTAG), DifficultyLevelDecimal::None, DifficultyLevelDecimal::Max);
-			outCourse.Style = std::max(inCourse.CourseMetadata.STYLE, 1);
-			outCourse.PlayerSide = std::clamp(inCourse.CourseMetadata.START_PLAYERSIDE, 1, outCourse.Style);
+		out.Version = TimingsVersion;
+		return out;
+	}
 
-			outCourse.CourseCreator = inCourse.CourseMetadata.NOTESDESIGNER;
+	const NoteHitSoundSchedule& ChartCourse::GetHitSoundSchedule(BranchType branch, Beat drumrollHitInterval) const
+	{
+		NoteHitSoundSchedule& out = TempHitSoundSchedules[EnumToIndex(branch)];
+		const NoteTimingTable& timings = GetNoteTimings(branch);
+		if (out.Version == timings.Version && out.DrumrollHitInterval == drumrollHitInterval)
+			return out;
+
+		const SortedNotesList& notes = GetNotes(branch);
+		out.Events.clear();
+		out.Events.reserve(notes.size());
+		for (size_t i = 0; i < notes.size(); i++)
+		{
+			const Note& note = notes[i];
+			if (note.BeatDuration > Beat::Zero())
+			{
+				if (IsBalloonNote(note.Type))
+				{
+					for (i32 iPop = 0; iPop < note.BalloonPopCount; ++iPop)
+						out.Events.push_back(NoteHitSoundEvent { TempoMap.BeatToTime(ConvertRange(0, i32 { note.BalloonPopCount }, note.BeatTime, note.GetEnd(), iPop)) + note.TimeOffset, note.Type });
+				}
+				else if (drumrollHitInterval > Beat::Zero())
+				{
+					for (Beat subBeat = Beat::Zero(); subBeat <= note.BeatDuration; subBeat += drumrollHitInterval)
+						out.Events.push_back(NoteHitSoundEvent { TempoMap.BeatToTime(note.BeatTime + subBeat) + note.TimeOffset, note.Type });
+				}
+			}
+			else
+			{
+				out.Events.push_back(NoteHitSoundEvent { timings.HeadTimes[i], note.Type });
+			}
+		}
 
-			outCourse.Life = Clamp(static_cast<TowerLives>(inCourse.CourseMetadata.LIFE), TowerLives::Min, TowerLives::Max);
-			outCourse.Side = Clamp(static_cast<Side>(inCourse.CourseMetadata.SIDE), Side{}, Side::Count);
+		// NOTE: Time offsets, overlapping long notes and negative tempos can all break the beat order
+		std::stable_sort(out.Events.begin(), out.Events.end(), [](const NoteHitSoundEvent& a, const NoteHitSoundEvent& b) { return a.Time < b.Time; });
 
-			outCourse.TempoMap.Tempo.Sorted = { TempoChange(Beat::Zero(), inTJA.Metadata.BPM) };
-			outCourse.TempoMap.Signature.Sorted = { TimeSignatureChange(Beat::Zero(), TimeSignature(4, 4)) };
-			TimeSignature lastSignature = TimeSignature(4, 4);
+		out.DrumrollHitInterval = drumrollHitInterval;
+		out.Version = timings.Version;
+		out.CursorIndex = 0;
+		out.CursorTime = Time::FromSec(F64Min);
+		return out;
+	}
 
-			i32 currentBalloonIndex = 0;
+	struct ForEachNoteLaneData
+	{
+		const Note* OriginalNote;
+		Beat Beat;
+		Time Time;
+		Tempo Tempo;
+		Complex ScrollSpeed;
+		ScrollMethod ScrollType;
+		struct {
+			struct Beat Beat;
+			struct Time Time;
+			struct Tempo Tempo;
+			Complex ScrollSpeed;
+			ScrollMethod ScrollType;
+		} Tail;
+	};
+
+	template <typename Func>
+	static void ForEachNoteOnNoteLane(const ChartCourse& course, BranchType branch, Func perNoteFunc)
+	{
+		const SortedNotesList& notes = course.GetNotes(branch);
+		const NoteTimingTable& timings = course.GetNoteTimings(branch);
 
-			BeatSortedList<TempTimedDelayCommand> tempSortedDelayCommands;
-			BeatSortedForwardIterator<TempTimedDelayCommand> tempDelayCommandsIt;
-			for (const TJA::ConvertedMeasure& inMeasure : inCourse.Measures)
-			{
-				for (const TJA::ConvertedDelayChange& inDelayChange : inMeasure.DelayChanges)
-					tempSortedDelayCommands.InsertOrUpdate(TempTimedDelayCommand { inMeasure.StartTime + inDelayChange.TimeWithinMeasure, inDelayChange.Delay });
+		for (size_t i = 0; i < notes.size(); i++)
+		{
+			const Note& note = notes[i];
+			const Beat beatTail = (note.BeatDuration > Beat::Zero()) ? (note.BeatTime + note.BeatDuration) : note.BeatTime;
+			perNoteFunc(ForEachNoteLaneData { &note, note.BeatTime, timings.HeadTimes[i], timings.HeadTempos[i], timings.HeadScrollSpeeds[i], timings.HeadScrollTypes[i],
+				{ beatTail, timings.TailTimes[i], timings.TailTempos[i], timings.TailScrollSpeeds[i], timings.TailScrollTypes[i] },
+			});
+		}
+	}
+
+	void ChartCourse::RecalculateSENotes(BranchType branch) const
+	{
+		enum class SEFormType { Long, Short, Alternate, Final };
+
+		// prev, curr, next, n(ext)2nd
+		ForEachNoteLaneData noteDataRingBuffer[4] = {};
+		i32 noteDataRingOffset = 0;
+		auto getNoteData = [&](i32 idx) -> decltype(auto) { return noteDataRingBuffer[(noteDataRingOffset + idx) & 3]; };
+
+		// distance when curr is on the judgement mark
+		// other is NMScroll: visual beat distance = sec_time * visual_beat_per_second_other
+		// other is HBScroll: visual beat distance = scroll_other * beat_distance
+		auto getVisualBeat = [&](const auto& curr, const auto& other, f32 scrollOther, f32 vbpsOther, Time timeDistance)
+		{
+			return (other.OriginalNote == nullptr) ? F32Max
+				: (other.ScrollType == ScrollMethod::NMSCROLL) ? vbpsOther * timeDistance.Seconds
+				: (other.ScrollType == ScrollMethod::HBSCROLL) ? scrollOther * abs(curr.Beat - other.Beat).Ticks / Beat::TicksPerBeat
+				: /* (prev.ScrollType == ScrollMethod::BMSCROLL) ? */ abs(curr.Beat - other.Beat).Ticks / Beat::TicksPerBeat;
+		};
+
+		auto getNoteDistance = [&]()
+		{
+			const auto& prev = getNoteData(0);
+			const auto& curr = getNoteData(1);
+			const auto& next = getNoteData(2);
+			const auto& n2nd = getNoteData(3);
+			const f32 scrollPrev = abs(prev.ScrollSpeed.cpx);
+			const f32 scrollNextCapped = std::min(1.0f, abs(next.ScrollSpeed.cpx));
+			// visual beat per second
+			const f32 vbpsPrev = scrollPrev * prev.Tempo.BPM / 60;
+			const f32 vbpsNextCapped = scrollNextCapped * next.Tempo.BPM / 60;
+			// time distance
+			const Time tdToPrev = (prev.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (curr.Time - prev.Time);
+			const Time tdToNext = (next.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (next.Time - curr.Time);
+			const Time tdToN2nd = (n2nd.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (n2nd.Time - next.Time);
+			const f32 vbdToPrev = getVisualBeat(curr, prev, scrollPrev, vbpsPrev, tdToPrev);
+			const f32 vbdToNextCapped = getVisualBeat(curr, next, scrollNextCapped, vbpsNextCapped, tdToNext);
+			return std::tuple{ tdToPrev, vbdToPrev, tdToNext, vbdToNextCapped, tdToN2nd };
+		};
+
+		const SortedNotesList& notes = GetNotes(branch);
+		std::vector<const Note*> alterChain;
+		b8 isAlterChain = true;
+		Time timeIntervalAlter = Time::Zero();
+		Time timeStartAlter = Time::Zero();
+
+		auto assignSingleNote = [&]()
+		{
+			auto& curr = getNoteData(1);
+			const Note& it = *getNoteData(1).OriginalNote;
+			auto [tdToPrev, vbdToPrev, tdToNext, vbdToNextCapped, tdToN2nd] = getNoteDistance();
+			const Time timeEpsilon = Time::FromMS(1e-3);
+			const b8 denseToSparse = (tdToNext >= tdToPrev + timeEpsilon);
+			const b8 sparseToDense = (tdToN2nd <= tdToNext - timeEpsilon);
+			const f32 beatsEpsilon = 4 / 192.0;
+			const b8 isLongAvoided = (vbdToPrev <= 4 / 16.0 - beatsEpsilon
+				|| vbdToNextCapped <= 4 / 12.0 - beatsEpsilon); // avoid text from overlapping or extending under next note
+			const b8 isPrePause = (vbdToNextCapped >= 4 / 8.0 + beatsEpsilon);
+			auto se = (!isLongAvoided && (denseToSparse || sparseToDense || isPrePause)) ? SEFormType::Long : SEFormType::Short;
+			if (isAlterChain) {
+				if (it.Type == NoteType::Don && alterChain.empty()) {
+					timeIntervalAlter = tdToNext;
+					timeStartAlter = curr.Time;
+					alterChain.push_back(&it);
+				} else if (it.Type == NoteType::Don && abs(tdToPrev - timeIntervalAlter) < timeEpsilon && abs(timeStartAlter - curr.Time) < Time::FromSec(0.5) + timeEpsilon) {
+					alterChain.push_back(&it);
+				} else {
+					isAlterChain = false;
+					alterChain.clear();
+				}
+			}
+			if (denseToSparse || sparseToDense) {
+				if (denseToSparse && isAlterChain && !isLongAvoided && size(alterChain) % 2 != 0 && abs(timeStartAlter - curr.Time) < Time::FromSec(0.5) + timeEpsilon) {
+					for (i32 ia = 0; ia < size(alterChain); ++ia) {
+						if (ia % 2 == 1)
+							alterChain[ia]->TempSEType = NoteSEType::Ko;
+					}
+				}
+				alterChain.clear();
+				isAlterChain = sparseToDense;
 			}
 
-			for (const TJA::ConvertedMeasure& inMeasure : inCourse.Measures)
+			switch (it.Type)
 			{
-				for (const TJA::ConvertedNote& inNote : inMeasure.Notes)
-				{
-					if (inNote.Type == TJA::NoteType::End_BalloonOrDrumroll)
-					{
-						// TODO: Proper handling
-						if (!outCourse.Notes_Normal.Sorted.empty())
-							outCourse.Notes_Normal.Sorted.back().BeatDuration = (inMeasure.StartTime + inNote.TimeWithinMeasure) - outCourse.Notes_Normal.Sorted.back().BeatTime;
-						continue;
-					}
+			case NoteType::Don: { it.TempSEType = (se == SEFormType::Long) ? NoteSEType::Don : NoteSEType::Do; } break;
+			case NoteType::DonBig: { it.TempSEType = NoteSEType::DonBig; } break;
+			case NoteType::DonBigHand: { it.TempSEType = NoteSEType::DonHand; } break;
+			case NoteType::Ka: { it.TempSEType = (se == SEFormType::Long) ? NoteSEType::Katsu : NoteSEType::Ka; } break;
+			case NoteType::KaBig: { it.TempSEType = NoteSEType::KatsuBig; } break;
+			case NoteType::KaBigHand: { it.TempSEType = NoteSEType::KatsuHand; } break;
+			case NoteType::Drumroll: { it.TempSEType = NoteSEType::Drumroll; } break;
+			case NoteType::DrumrollBig: { it.TempSEType = NoteSEType::DrumrollBig; } break;
+			case NoteType::Balloon: { it.TempSEType = NoteSEType::Balloon; } break;
+			case NoteType::BalloonSpecial: { it.TempSEType = NoteSEType::BalloonSpecial; } break;
+			default: { it.TempSEType = NoteSEType::Count; } break;
+			}
+		};
 
-					const NoteType outNoteType = ConvertTJANoteType(inNote.Type);
-					if (outNoteType == NoteType::Count)
-						continue;
+		// fetch 2nd next note, update current note
+		i32 lastFilled = 0;
+		ForEachNoteOnNoteLane(*this, branch, [&](const ForEachNoteLaneData& dataIt)
+		{
+			if (getNoteData(1).OriginalNote != nullptr)
+				assignSingleNote();
+			noteDataRingOffset = (noteDataRingOffset + 1) & 3;
+			getNoteData(3) = dataIt;
+			lastFilled = 3;
+		});
+		for (; lastFilled >= 1; --lastFilled) {
+			if (getNoteData(1).OriginalNote != nullptr)
+				assignSingleNote();
+			noteDataRingOffset = (noteDataRingOffset + 1) & 3;
+			getNoteData(3).OriginalNote = nullptr;
+		}
+	}
 
-					Note& outNote = outCourse.Notes_Normal.Sorted.emplace_back();
-					outNote.BeatTime = (inMeasure.StartTime + inNote.TimeWithinMeasure);
-					outNote.Type = outNoteType;
+	// NOTE: Only reads from the parsed TJA and only writes to the output course so that multiple courses can safely be converted in parallel
+	static Time ConvertParsedTJACourseToChartCourse(const TJA::ParsedTJA& inTJA, const TJA::ParsedCourse& inParsedCourse, ChartCourse& outCourse)
+	{
+		const TJA::ConvertedCourse& inCourse = TJA::ConvertParsedToConvertedCourse(inTJA, inParsedCourse);
 
-					const TempTimedDelayCommand* delayCommandForThisNote = tempDelayCommandsIt.Next(tempSortedDelayCommands.Sorted, outNote.BeatTime);
-					outNote.TimeOffset = (delayCommandForThisNote != nullptr) ? delayCommandForThisNote->Delay : Time::Zero();
+		// HACK: Write proper enum conversion functions
+		outCourse.Type = Clamp(static_cast<DifficultyType>(inCourse.CourseMetadata.COURSE), DifficultyType {}, DifficultyType::Count);
+		outCourse.Level = Clamp(static_cast<DifficultyLevel>(inCourse.CourseMetadata.LEVEL), DifficultyLevel::Min, DifficultyLevel::Max);
+		outCourse.Decimal = Clamp(static_cast<DifficultyLevelDecimal>(inCourse.CourseMetadata.LEVEL_DECIMALTAG), DifficultyLevelDecimal::None, DifficultyLevelDecimal::Max);
+		outCourse.Style = std::max(inCourse.CourseMetadata.STYLE, 1);
+		outCourse.PlayerSide = std::clamp(inCourse.CourseMetadata.START_PLAYERSIDE, 1, outCourse.Style);
 
-					if (inNote.Type == TJA::NoteType::Start_Balloon || inNote.Type == TJA::NoteType::Start_BaloonSpecial || inNote.Type == TJA::NoteType::Fuse)
-					{
-						// TODO: Implement properly with correct branch handling
-						if (InBounds(currentBalloonIndex, inCourse.CourseMetadata.BALLOON))
-							outNote.BalloonPopCount = inCourse.CourseMetadata.BALLOON[currentBalloonIndex];
-						currentBalloonIndex++;
-					}
+		outCourse.CourseCreator = inCourse.CourseMetadata.NOTESDESIGNER;
+
+		outCourse.Life = Clamp(static_cast<TowerLives>(inCourse.CourseMetadata.LIFE), TowerLives::Min, TowerLives::Max);
+		outCourse.Side = Clamp(static_cast<Side>(inCourse.CourseMetadata.SIDE), Side{}, Side::Count);
+
+		outCourse.TempoMap.Tempo.Sorted = { TempoChange(Beat::Zero(), inTJA.Metadata.BPM) };
+		outCourse.TempoMap.Signature.Sorted = { TimeSignatureChange(Beat::Zero(), TimeSignature(4, 4)) };
+		TimeSignature lastSignature = TimeSignature(4, 4);
+
+		i32 currentBalloonIndex = 0;
+
+		BeatSortedList<TempTimedDelayCommand> tempSortedDelayCommands;
+		BeatSortedForwardIterator<TempTimedDelayCommand> tempDelayCommandsIt;
+		for (const TJA::ConvertedMeasure& inMeasure : inCourse.Measures)
+		{
+			for (const TJA::ConvertedDelayChange& inDelayChange : inMeasure.DelayChanges)
+				tempSortedDelayCommands.InsertOrUpdate(TempTimedDelayCommand { inMeasure.StartTime + inDelayChange.TimeWithinMeasure, inDelayChange.Delay });
+		}
+
+		for (const TJA::ConvertedMeasure& inMeasure : inCourse.Measures)
+		{
+			for (const TJA::ConvertedNote& inNote : inMeasure.Notes)
+			{
+				if (inNote.Type == TJA::NoteType::End_BalloonOrDrumroll)
+				{
+					// TODO: Proper handling
+					if (!outCourse.Notes_Normal.Sorted.empty())
+						outCourse.Notes_Normal.Sorted.back().BeatDuration = (inMeasure.StartTime + inNote.TimeWithinMeasure) - outCourse.Notes_Normal.Sorted.back().BeatTime;
+					continue;
 				}
 
-				if (inMeasure.TimeSignature != lastSignature)
+				const NoteType outNoteType = ConvertTJANoteType(inNote.Type);
+				if (outNoteType == NoteType::Count)
+					continue;
+
+				Note& outNote = outCourse.Notes_Normal.Sorted.emplace_back();
+				outNote.BeatTime = (inMeasure.StartTime + inNote.TimeWithinMeasure);
+				outNote.Type = outNoteType;
+
+				const TempTimedDelayCommand* delayCommandForThisNote = tempDelayCommandsIt.Next(tempSortedDelayCommands.Sorted, outNote.BeatTime);
+				outNote.TimeOffset = (delayCommandForThisNote != nullptr) ? delayCommandForThisNote->Delay : Time::Zero();
+
+				if (inNote.Type == TJA::NoteType::Start_Balloon || inNote.Type == TJA::NoteType::Start_BaloonSpecial || inNote.Type == TJA::NoteType::Fuse)
 				{
-					outCourse.TempoMap.Signature.InsertOrUpdate(TimeSignatureChange(inMeasure.StartTime, inMeasure.TimeSignature));
-					lastSignature = inMeasure.TimeSignature;
+					// TODO: Implement properly with correct branch handling
+					if (InBounds(currentBalloonIndex, inCourse.CourseMetadata.BALLOON))
+						outNote.BalloonPopCount = inCourse.CourseMetadata.BALLOON[currentBalloonIndex];
+					currentBalloonIndex++;
 				}
+			}
+
+			if (inMeasure.TimeSignature != lastSignature)
+			{
+				outCourse.TempoMap.Signature.InsertOrUpdate(TimeSignatureChange(inMeasure.StartTime, inMeasure.TimeSignature));
+				lastSignature = inMeasure.TimeSignature;
+			}
 
-				for (const TJA::ConvertedTempoChange& inTempoChange : inMeasure.TempoChanges)
-					outCourse.TempoMap.Tempo.InsertOrUpdate(TempoChange(inMeasure.StartTime + inTempoChange.TimeWithinMeasure, inTempoChange.Tempo));
+			for (const TJA::ConvertedTempoChange& inTempoChange : inMeasure.TempoChanges)
+				outCourse.TempoMap.Tempo.InsertOrUpdate(TempoChange(inMeasure.StartTime + inTempoChange.TimeWithinMeasure, inTempoChange.Tempo));
 
-				for (const TJA::ConvertedScrollChange& inScrollChange : inMeasure.ScrollChanges)
-					outCourse.ScrollChanges.Sorted.push_back(ScrollChange { (inMeasure.StartTime + inScrollChange.TimeWithinMeasure), inScrollChange.ScrollSpeed });
+			for (const TJA::ConvertedScrollChange& inScrollChange : inMeasure.ScrollChanges)
+				outCourse.ScrollChanges.Sorted.push_back(ScrollChange { (inMeasure.StartTime + inScrollChange.TimeWithinMeasure), inScrollChange.ScrollSpeed });
 
-				for (const TJA::ConvertedScrollType& inScrollType : inMeasure.ScrollTypes)
-					outCourse.ScrollTypes.Sorted.push_back(ScrollType{ (inMeasure.StartTime + inScrollType.TimeWithinMeasure),  static_cast<ScrollMethod>(inScrollType.Method) });
+			for (const TJA::ConvertedScrollType& inScrollType : inMeasure.ScrollTypes)
+				outCourse.ScrollTypes.Sorted.push_back(ScrollType{ (inMeasure.StartTime + inScrollType.TimeWithinMeasure),  static_cast<ScrollMethod>(inScrollType.Method) });
 
-				for (const TJA::ConvertedJPOSScroll& inJPOSScrollChange : inMeasure.JPOSScrollChanges)
-					outCourse.JPOSScrollChanges.Sorted.push_back(JPOSScrollChange{ (inMeasure.StartTime + inJPOSScrollChange.TimeWithinMeasure), inJPOSScrollChange.Move, inJPOSScrollChange.Duration });
+			for (const TJA::ConvertedJPOSScroll& inJPOSScrollChange : inMeasure.JPOSScrollChanges)
+				outCourse.JPOSScrollChanges.Sorted.push_back(JPOSScrollChange{ (inMeasure.StartTime + inJPOSScrollChange.TimeWithinMeasure), inJPOSScrollChange.Move, inJPOSScrollChange.Duration });
 
 
-				for (const TJA::ConvertedBarLineChange& barLineChange : inMeasure.BarLineChanges)
-					outCourse.BarLineChanges.Sorted.push_back(BarLineChange { (inMeasure.StartTime + barLineChange.TimeWithinMeasure), barLineChange.Visibile });
+			for (const TJA::ConvertedBarLineChange& barLineChange : inMeasure.BarLineChanges)
+				outCourse.BarLineChanges.Sorted.push_back(BarLineChange { (inMeasure.StartTime + barLineChange.TimeWithinMeasure), barLineChange.Visibile });
 
-				for (const TJA::ConvertedLyricChange& lyricChange : inMeasure.LyricChanges)
-					outCourse.Lyrics.Sorted.push_back(LyricChange { (inMeasure.StartTime + lyricChange.TimeWithinMeasure), lyricChange.Lyric });
-			}
+			for (const TJA::ConvertedLyricChange& lyricChange : inMeasure.LyricChanges)
+				outCourse.Lyrics.Sorted.push_back(LyricChange { (inMeasure.StartTime + lyricChange.TimeWithinMeasure), lyricChange.Lyric });
+		}
+
+		for (const TJA::ConvertedGoGoRange& inGoGoRange : inCourse.GoGoRanges)
+			outCourse.GoGoRanges.Sorted.push_back(GoGoRange { inGoGoRange.StartTime, (inGoGoRange.EndTime - inGoGoRange.StartTime) });
 
-			for (const TJA::ConvertedGoGoRange& inGoGoRange : inCourse.GoGoRanges)
-				outCourse.GoGoRanges.Sorted.push_back(GoGoRange { inGoGoRange.StartTime, (inGoGoRange.EndTime - inGoGoRange.StartTime) });
+		//outCourse.TempoMap.SetTempoChange(TempoChange());
+		//outCourse.TempoMap = inCourse.GoGoRanges;
 
-			//outCourse.TempoMap.SetTempoChange(TempoChange());
-			//outCourse.TempoMap = inCourse.GoGoRanges;
+		outCourse.ScoreInit = inCourse.CourseMetadata.SCOREINIT;
+		outCourse.ScoreDiff = inCourse.CourseMetadata.SCOREDIFF;
+
+		outCourse.OtherMetadata = inCourse.CourseMetadata.Others;
+
+		outCourse.TempoMap.RebuildAccelerationStructure();
+		outCourse.RecalculateSENotes();
+
+		return inCourse.Measures.empty() ? Time::Zero() : outCourse.TempoMap.BeatToTime(inCourse.Measures.back().StartTime /*+ inCourse.Measures.back().TimeSignature.GetDurationPerBar()*/);
+	}
+
+	b8 CreateChartProjectFromTJA(const TJA::ParsedTJA& inTJA, ChartProject& out, b8 convertCoursesInParallel)
+	{
+		out.ChartDuration = Time::Zero();
+		out.ChartTitle = inTJA.Metadata.TITLE;
+		out.ChartTitleLocalized = inTJA.Metadata.TITLE_localized;
+		out.ChartSubtitle = inTJA.Metadata.SUBTITLE;
+		out.ChartSubtitleLocalized = inTJA.Metadata.SUBTITLE_localized;
+		out.ChartCreator = inTJA.Metadata.MAKER;
+		out.ChartGenre = inTJA.Metadata.GENRE;
+		out.ChartLyricsFileName = inTJA.Metadata.LYRICS;
+		out.SongOffset = inTJA.Metadata.OFFSET;
+		out.SongDemoStartTime = inTJA.Metadata.DEMOSTART;
+		out.SongFileName = inTJA.Metadata.WAVE;
+		out.SongJacket = inTJA.Metadata.PREIMAGE;
+		out.SongVolume = inTJA.Metadata.SONGVOL;
+		out.SoundEffectVolume = inTJA.Metadata.SEVOL;
+		out.BackgroundImageFileName = inTJA.Metadata.BGIMAGE;
+		out.BackgroundMovieFileName = inTJA.Metadata.BGMOVIE;
+		out.MovieOffset = inTJA.Metadata.MOVIEOFFSET;
+		out.OtherMetadata = inTJA.Metadata.Others;
 
-			outCourse.ScoreInit = inCourse.CourseMetadata.SCOREINIT;
-			outCourse.ScoreDiff = inCourse.CourseMetadata.SCOREDIFF;
+		std::vector<const TJA::ParsedCourse*> inCoursesWithChart;
+		for (const TJA::ParsedCourse& inParsedCourse : inTJA.Courses)
+		{
+			if (inParsedCourse.HasChart) // metadata-only TJA section
+				inCoursesWithChart.push_back(&inParsedCourse);
+		}
 
-			outCourse.OtherMetadata = inCourse.CourseMetadata.Others;
+		// NOTE: Output courses are created upfront and each one only ever written to by a single task,
+		//		 with the chart duration reduced in course order afterwards, so the result is identical to converting them serially
+		const size_t courseCount = inCoursesWithChart.size();
+		std::vector<Time> courseDurations(courseCount, Time::Zero());
+		const size_t firstNewCourseIndex = out.Courses.size();
+		for (size_t i = 0; i < courseCount; i++)
+			out.Courses.emplace_back(std::make_unique<ChartCourse>());
 
-			outCourse.TempoMap.RebuildAccelerationStructure();
-			outCourse.RecalculateSENotes();
+		auto convertCourse = [&](size_t i) { courseDurations[i] = ConvertParsedTJACourseToChartCourse(inTJA, *inCoursesWithChart[i], *out.Courses[firstNewCourseIndex + i]); };
 
-			if (!inCourse.Measures.empty())
-				out.ChartDuration = Max(out.ChartDuration, outCourse.TempoMap.BeatToTime(inCourse.Measures.back().StartTime /*+ inCourse.Measures.back().TimeSignature.GetDurationPerBar()*/));
+		const size_t workerCount = convertCoursesInParallel ? Min(courseCount, static_cast<size_t>(Max(std::thread::hardware_concurrency(), 1u))) : 1;
+		if (workerCount <= 1)
+		{
+			for (size_t i = 0; i < courseCount; i++)
+				convertCourse(i);
+		}
+		else
+		{
+			std::atomic<size_t> nextCourseIndex = 0;
+			auto workerFunc = [&]() { for (size_t i; (i = nextCourseIndex.fetch_add(1, std::memory_order_relaxed)) < courseCount;) convertCourse(i); };
+
+			// NOTE: The calling thread works through the courses as well instead of only waiting on the others
+			std::vector<std::future<void>> workerFutures;
+			workerFutures.reserve(workerCount - 1);
+			for (size_t w = 0; w < (workerCount - 1); w++)
+				workerFutures.push_back(std::async(std::launch::async, workerFunc));
+			workerFunc();
+			for (std::future<void>& future : workerFutures)
+				future.get();
 		}
 
+		for (const Time courseDuration : courseDurations)
+			out.ChartDuration = Max(out.ChartDuration, courseDuration);
+
 		return true;
 	}
 
@@ -444,9 +740,75 @@ namespace PeepoDrumKit
 					outConvertedMeasureEnd->GoGoChanges.push_back(TJA::ConvertedGoGoChange{ (endTime - outConvertedMeasureEnd->StartTime), false });
 			}
 
-			TJA::ConvertConvertedMeasuresToParsedCommands(outConvertedMeasures, outCourse.ChartCommands);
+			TJA::ConvertConvertedMeasuresToParsedCommands(outConvertedMeasures, outCourse.ChartCommands, out.Arena);
 		}
 
 		return true;
 	}
+
+	u64 GenerateChartCourseEventListsRevision()
+	{
+		static std::atomic<u64> lastRevision = 0;
+		return lastRevision.fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+
+	void CopyChartProjectForExport(const ChartProject& in, ChartProject& out)
+	{
+		// NOTE: Reuse the existing courses (and with that all of their list allocations) when copying into the same project repeatedly
+		out.Courses.resize(in.Courses.size());
+		for (size_t courseIndex = 0; courseIndex < in.Courses.size(); courseIndex++)
+		{
+			const std::unique_ptr<ChartCourse>& inCourse = in.Courses[courseIndex];
+			if (out.Courses[courseIndex] == nullptr)
+				out.Courses[courseIndex] = std::make_unique<ChartCourse>();
+
+			ChartCourse& outCourse = *out.Courses[courseIndex];
+			outCourse.Type = inCourse->Type;
+			outCourse.Level = inCourse->Level;
+			outCourse.Decimal = inCourse->Decimal;
+			outCourse.Style = inCourse->Style;
+			outCourse.PlayerSide = inCourse->PlayerSide;
+			outCourse.CourseCreator = inCourse->CourseCreator;
+
+			// NOTE: Revisions are unique across all courses, so this also works out for courses that have been added, removed or reordered in the meantime
+			if (outCourse.EventListsRevision != inCourse->EventListsRevision)
+			{
+				outCourse.TempoMap = inCourse->TempoMap;
+				outCourse.Notes_Normal = inCourse->Notes_Normal;
+				outCourse.Notes_Expert = inCourse->Notes_Expert;
+				outCourse.Notes_Master = inCourse->Notes_Master;
+				outCourse.ScrollChanges = inCourse->ScrollChanges;
+				outCourse.BarLineChanges = inCourse->BarLineChanges;
+				outCourse.GoGoRanges = inCourse->GoGoRanges;
+				outCourse.Lyrics = inCourse->Lyrics;
+				outCourse.ScrollTypes = inCourse->ScrollTypes;
+				outCourse.JPOSScrollChanges = inCourse->JPOSScrollChanges;
+				outCourse.EventListsRevision = inCourse->EventListsRevision;
+			}
+			outCourse.ScoreInit = inCourse->ScoreInit;
+			outCourse.ScoreDiff = inCourse->ScoreDiff;
+			outCourse.Life = inCourse->Life;
+			outCourse.Side = inCourse->Side;
+			outCourse.OtherMetadata = inCourse->OtherMetadata;
+		}
+
+		out.ChartDuration = in.ChartDuration;
+		out.ChartTitle = in.ChartTitle;
+		out.ChartTitleLocalized = in.ChartTitleLocalized;
+		out.ChartSubtitle = in.ChartSubtitle;
+		out.ChartSubtitleLocalized = in.ChartSubtitleLocalized;
+		out.ChartCreator = in.ChartCreator;
+		out.ChartGenre = in.ChartGenre;
+		out.ChartLyricsFileName = in.ChartLyricsFileName;
+		out.SongOffset = in.SongOffset;
+		out.SongDemoStartTime = in.SongDemoStartTime;
+		out.SongFileName = in.SongFileName;
+		out.SongJacket = in.SongJacket;
+		out.SongVolume = in.SongVolume;
+		out.SoundEffectVolume = in.SoundEffectVolume;
+		out.BackgroundImageFileName = in.BackgroundImageFileName;
+		out.BackgroundMovieFileName = in.BackgroundMovieFileName;
+		out.MovieOffset = in.MovieOffset;
+		out.OtherMetadata = in.OtherMetadata;
+	}
 }
@@ -4,7 +4,6 @@
 #include "core_beat.h"
 #include "file_format_tja.h"
 #include <unordered_map>
-#include "chart_editor_i18n.h"
 
 namespace PeepoDrumKit
 {
@@ -161,18 +160,6 @@ namespace PeepoDrumKit
 		"DIFFICULTY_TYPE_DAN",
 	};
 
-	static inline std::string GetStyleName(i32 style, i32 playerSide)
-	{
-		if (style == 1)
-			return UI_Str("PLAYER_SIDE_STYLE_SINGLE");
-		char buf[32];
-		std::string res = (style == 2) ? UI_Str("PLAYER_SIDE_STYLE_DOUBLE")
-			: std::string(buf, sprintf_s(buf, UI_Str("PLAYER_SIDE_STYLE_FMT_%d_STYLE"), style));
-		std::string_view strPlaySide (buf, sprintf_s(buf, UI_Str("PLAYER_SIDE_PLAYER_FMT_%d_PLAYER"), playerSide));
-		res += " ("; res += strPlaySide; res += ")";
-		return res;
-	}
-
 	constexpr cstr TowerSideNames[EnumCount<Side>] =
 	{
 		"TOWER_SIDE_NORMAL",
@@ -219,7 +206,7 @@ namespace PeepoDrumKit
 	constexpr std::string_view PluralSuffixDefault = "s"; // unfortunately cannot just pass the string literal for now
 
 	template <typename TEvent>
-	constexpr std::string_view DisplayNameOfChartEvent = std::declval<std::string_view>(); // Forbid usage unless specialized
+	constexpr std::string_view DisplayNameOfChartEvent = std::declval<std::enable_if_t<sizeof(TEvent) != 0, std::string_view>>(); // Forbid usage unless specialized
 	template <typename TEvent>
 	constexpr std::string_view DisplayNameOfLongChartEvent = DisplayNameOfChartEvent<TEvent>;
 	template <typename TEvent>
@@ -361,6 +348,108 @@ namespace PeepoDrumKit
 	constexpr Complex ScrollOrDefault(const ScrollChange* v) { return (v == nullptr) ? Complex(1.0f, 0.0f) : v->ScrollSpeed; }
 	constexpr Tempo TempoOrDefault(const TempoChange* v) { return (v == nullptr) ? FallbackTempo : v->Tempo; }
 
+	// NOTE: Structure-of-arrays of the timings of all notes of a single branch, parallel to the notes list itself.
+	//		 Tail values are equal to the head values for non-long notes and the HBScroll beat tick is only calculated for HBSCROLL / BMSCROLL notes
+	struct NoteTimingTable
+	{
+		std::vector<Time> HeadTimes, TailTimes;
+		std::vector<Tempo> HeadTempos, TailTempos;
+		std::vector<Complex> HeadScrollSpeeds, TailScrollSpeeds;
+		std::vector<ScrollMethod> HeadScrollTypes, TailScrollTypes;
+		std::vector<f64> HeadHBScrollBeatTicks, TailHBScrollBeatTicks;
+
+		// NOTE: Running max of the tail times and running min (from the back) of the head times,
+		//		 so that notes overlapping a time range can be binary searched for despite long notes and time offsets
+		std::vector<Time> MaxTailTimesSoFar, MinHeadTimesFromBack;
+
+		u32 Version = 0;
+
+		inline size_t size() const { return HeadTimes.size(); }
+
+		// NOTE: Index range [first, last) outside of which no note can overlap [minTime, maxTime], the notes inside still have to be checked individually
+		std::pair<size_t, size_t> FindPossiblyOverlappingIndexRange(Time minTime, Time maxTime) const;
+	};
+
+	struct NoteHitSoundEvent
+	{
+		Time Time;
+		NoteType Type;
+	};
+
+	// NOTE: All hit sounds of a single branch (including every individual drumroll / balloon hit) sorted by time, to be scheduled during playback
+	struct NoteHitSoundSchedule
+	{
+		std::vector<NoteHitSoundEvent> Events;
+		Beat DrumrollHitInterval = Beat::Zero();
+		u32 Version = 0;
+
+		// NOTE: Index of the first event not yet visited and the end time of the last visited range, used to continue from where the previous frame left off
+		mutable size_t CursorIndex = 0;
+		mutable Time CursorTime = Time::FromSec(F64Min);
+
+		// NOTE: Visits all events within [startTime, endTime), only binary searching for the start if the range doesn't continue directly from the previous one
+		template <typename Func>
+		void ForEachEventInRange(Time startTime, Time endTime, Func perEventFunc) const
+		{
+			if (endTime < startTime)
+			{
+				CursorTime = Time::FromSec(F64Min);
+				return;
+			}
+
+			if (startTime != CursorTime || CursorIndex > Events.size())
+				CursorIndex = static_cast<size_t>(std::distance(Events.begin(), std::lower_bound(Events.begin(), Events.end(), startTime, [](const NoteHitSoundEvent& e, Time t) { return e.Time < t; })));
+
+			while (CursorIndex < Events.size() && Events[CursorIndex].Time < endTime)
+				perEventFunc(Events[CursorIndex++]);
+			CursorTime = endTime;
+		}
+	};
+
+	// NOTE: Everything needed to position a note head / tail or bar line on the game preview lane, relative to the cursor
+	struct GameLanePoint
+	{
+		Beat Beat;
+		Time Time;
+		Tempo Tempo;
+		Complex ScrollSpeed;
+		ScrollMethod ScrollType;
+		f64 HBScrollBeatTick;
+	};
+
+	struct GameLaneNote { GameLanePoint Head, Tail; };
+	struct GameLaneBar { GameLanePoint Point; i32 BarIndex; };
+
+	// NOTE: Conservative bounds of a fixed size block of consecutive lane items, so that blocks which can't possibly contain anything visible can be skipped entirely.
+	//		 The lane distance is (time * speed) for NMSCROLL and (HBScroll beat tick * speed) for HBSCROLL / BMSCROLL,
+	//		 meaning an item can only ever be visible if it is within (max lane distance / speed) of the cursor
+	struct GameLaneVisibilityBlock
+	{
+		f64 MinTime, MaxTime, MaxInverseTimeSpeed;
+		f64 MinHBScrollBeatTick, MaxHBScrollBeatTick, MaxInverseHBScrollSpeed;
+		// NOTE: Hit notes are drawn around the hit-circle independent of their scroll position
+		Time MinHitTime, MaxHitEndTime;
+		// NOTE: Zero scroll speeds and long notes changing scroll direction can't be bounded
+		b8 IsUnbounded;
+	};
+
+	struct GameLaneNoteCache
+	{
+		std::vector<GameLaneVisibilityBlock> Blocks;
+		u32 Version = 0;
+	};
+
+	struct GameLaneBarCache
+	{
+		std::vector<GameLaneBar> Bars;
+		std::vector<GameLaneVisibilityBlock> Blocks;
+		Beat MaxBeatDuration = Beat::Zero();
+		u32 Version = 0;
+	};
+
+	// NOTE: Unique across all courses, thread-safe as courses are also created by import workers
+	u64 GenerateChartCourseEventListsRevision(); // implemented in chart.cpp
+
 	struct ChartCourse
 	{
 		DifficultyType Type = DifficultyType::Oni;
@@ -395,16 +484,33 @@ namespace PeepoDrumKit
 
 		std::map<std::string, std::string> OtherMetadata;
 
+		// NOTE: Changed by every undo command editing any of the event lists above, so that a copy made for exporting can tell whether its own lists are still up to date
+		u64 EventListsRevision = GenerateChartCourseEventListsRevision();
+
+		// NOTE: Lazily recalculated whenever their version doesn't match the current timings version
+		mutable u32 TimingsVersion = 1;
+		mutable NoteTimingTable TempNoteTimings[EnumCount<BranchType>];
+		mutable NoteHitSoundSchedule TempHitSoundSchedules[EnumCount<BranchType>];
+		mutable GameLaneNoteCache TempGameLaneNotes[EnumCount<BranchType>];
+		mutable GameLaneBarCache TempGameLaneBars;
+
 		inline auto& GetNotes(BranchType branch) { assert(branch < BranchType::Count); return (&Notes_Normal)[EnumToIndex(branch)]; }
 		inline auto& GetNotes(BranchType branch) const { assert(branch < BranchType::Count); return (&Notes_Normal)[EnumToIndex(branch)]; }
 
+		const NoteTimingTable& GetNoteTimings(BranchType branch) const; // implemented in chart.cpp
+		const NoteHitSoundSchedule& GetHitSoundSchedule(BranchType branch, Beat drumrollHitInterval) const; // implemented in chart.cpp
+
+		// NOTE: Called after every edit of the notes or anything affecting their timing, so also invalidates all cached timings
 		void RecalculateSENotes() const
 		{
+			TimingsVersion++;
 			for (BranchType branch = BranchType::Normal; branch < BranchType::Count; IncrementEnum(branch))
 				RecalculateSENotes(branch);
 		}
 
-		void RecalculateSENotes(BranchType branch) const; // implemented in chart_editor_widgets_game.cpp
+		void RecalculateSENotes(BranchType branch) const; // implemented in chart.cpp
+
+		inline void NotifyEventListsModified() { EventListsRevision = GenerateChartCourseEventListsRevision(); }
 	};
 
 	// NOTE: Internal representation of a chart. Can then be imported / exported as .tja (and maybe as the native fumen binary format too eventually?)
@@ -440,7 +546,7 @@ namespace PeepoDrumKit
 	};
 
 	template <auto ChartProject::* Attr>
-	extern constexpr std::string_view DisplayNameOfChartProjectAttr; // defined later
+	constexpr std::string_view DisplayNameOfChartProjectAttr = std::declval<std::enable_if_t<Attr != nullptr, std::string_view>>(); // Forbid usage unless specialized
 
 	template <> constexpr std::string_view DisplayNameOfChartProjectAttr<&ChartProject::ChartDuration> = "Chart Duration";
 	template <> constexpr std::string_view DisplayNameOfChartProjectAttr<&ChartProject::ChartTitle> = "Chart Title";
@@ -472,8 +578,12 @@ namespace PeepoDrumKit
 	void DebugCompareCharts(const ChartProject& chartA, const ChartProject& chartB, DebugCompareChartsOnMessageFunc onMessageFunc, void* userData = nullptr);
 
 	Beat FindCourseMaxUsedBeat(const ChartCourse& course);
-	b8 CreateChartProjectFromTJA(const TJA::ParsedTJA& inTJA, ChartProject& out);
+	// NOTE: Courses are independent of each other and can optionally be converted concurrently, with the output being identical either way
+	b8 CreateChartProjectFromTJA(const TJA::ParsedTJA& inTJA, ChartProject& out, b8 convertCoursesInParallel = false);
 	b8 ConvertChartProjectToTJA(const ChartProject& in, TJA::ParsedTJA& out, b8 includePeepoDrumKitComment = true);
+	// NOTE: Deep copy of everything needed for exporting but none of the lazily recalculated caches, to hand off a snapshot to a worker thread.
+	//		 Copying into the same output project again reuses its previous allocations and only copies the event lists of courses modified since then
+	void CopyChartProjectForExport(const ChartProject& in, ChartProject& out);
 }
 
 namespace PeepoDrumKit
@@ -541,18 +651,6 @@ namespace PeepoDrumKit
 	constexpr cstr GenericListNames[] = { "TempoChanges", "SignatureChanges", "Notes_Normal", "Notes_Expert", "Notes_Master", "ScrollChanges", "BarLineChanges", "GoGoRanges", "Lyrics", "ScrollType", "JPOSScroll", };
 	constexpr cstr GenericMemberNames[] = { "IsSelected", "BarLineVisible", "BalloonPopCount", "ScrollSpeed", "Start", "Duration", "Offset", "NoteType", "Tempo", "TimeSignature", "Lyric", "ScrollType", "JPOSScroll", "JPOSScrollDuration", };
 
-	// Member availability queries
-	template <typename T, GenericMember Member>
-	extern constexpr b8 IsMemberAvailable; // defined later
-
-	template <typename T, GenericMember... Members>
-	constexpr GenericMemberFlags GetAvailableMemberFlags(enum_sequence<GenericMember, Members...>) {
-		return (GenericMemberFlags_None | ... | (IsMemberAvailable<T, Members> ? EnumToFlag(Members) : 0));
-	}
-
-	template <typename T>
-	constexpr GenericMemberFlags AvailableMemberFlags = ForceConsteval<GetAvailableMemberFlags<T>(make_enum_sequence<GenericMember>())>;
-
 	union GenericMemberUnion
 	{
 		b8 B8;
@@ -594,7 +692,7 @@ namespace PeepoDrumKit
 		else if constexpr (Member == GenericMember::I8_ScrollType) return (std::forward<GenericMemberUnionT>(values).I16);
 		else if constexpr (Member == GenericMember::F32_JPOSScroll) return (std::forward<GenericMemberUnionT>(values).CPX);
 		else if constexpr (Member == GenericMember::F32_JPOSScrollDuration) return (std::forward<GenericMemberUnionT>(values).F32);
-		else static_assert(false, "unhandled or invalid GenericMember value");
+		else static_assert(!sizeof(GenericMemberUnionT), "unhandled or invalid GenericMember value");
 	}
 
 	template <GenericMember Member>
@@ -745,6 +843,14 @@ namespace PeepoDrumKit
 	template <typename T, GenericMember Member>
 	constexpr b8 IsMemberAvailable = has_get_v<T, Member> && !std::is_void_v<decltype(get_or_forward<Member>(std::declval<T>()))>;
 
+	template <typename T, GenericMember... Members>
+	constexpr GenericMemberFlags GetAvailableMemberFlags(enum_sequence<GenericMember, Members...>) {
+		return (GenericMemberFlags_None | ... | (IsMemberAvailable<T, Members> ? EnumToFlag(Members) : 0));
+	}
+
+	template <typename T>
+	constexpr GenericMemberFlags AvailableMemberFlags = ForceConsteval<GetAvailableMemberFlags<T>(make_enum_sequence<GenericMember>())>;
+
 	// Apply `action` on `args` resolved by `member` if available, otherwise return `vDefault` on nothing if valid, otherwise return `vError`
 	// If `TRet` is not specified, all of `action`'s possible return values, `vDefault`, and `vError` must have the same type
 	template <typename TRet = keep_deduced_t, typename FAction, typename TDefault, typename TError, typename... TCastedArgs >
@@ -825,7 +931,7 @@ namespace PeepoDrumKit
 	}
 
 	// need to be lambdas to be used as arguments with to-be-deduced parameter types (not needed since C++20)
-	constexpr auto GetGeneric = [&](auto&& typedMember, auto& typedOutValue)
+	constexpr auto GetGeneric = [](auto&& typedMember, auto& typedOutValue)
 	{
 		if constexpr (expect_type_v<decltype(typedMember), std::string> && !expect_type_v<decltype(typedOutValue), std::string>) // for GenericMember::CStr_Lyric
 			typedOutValue = typedMember.data();
@@ -833,7 +939,7 @@ namespace PeepoDrumKit
 			typedOutValue = static_cast<std::remove_reference_t<decltype(typedOutValue)>>(typedMember);
 	};
 
-	constexpr auto SetGeneric = [&](auto& typedMember, auto&& typedInValue)
+	constexpr auto SetGeneric = [](auto& typedMember, auto&& typedInValue)
 	{
 		typedMember = static_cast<std::remove_reference_t<decltype(typedMember)>>(typedInValue);
 	};
@@ -955,7 +1061,7 @@ namespace PeepoDrumKit
 		else if constexpr (List == GenericList::Lyrics) return (std::forward<ChartCourseT>(course).Lyrics);
 		else if constexpr (List == GenericList::ScrollType) return (std::forward<ChartCourseT>(course).ScrollTypes);
 		else if constexpr (List == GenericList::JPOSScroll) return (std::forward<ChartCourseT>(course).JPOSScrollChanges);
-		else static_assert(false, "unhandled or invalid GenericList value");
+		else static_assert(!sizeof(ChartCourseT), "unhandled or invalid GenericList value");
 	}
 
 	template <GenericList List>
@@ -975,7 +1081,7 @@ namespace PeepoDrumKit
 		else if constexpr (List == GenericList::Lyrics) return (std::forward<GenericListStructT>(inValue).NonTrivial.Lyric);
 		else if constexpr (List == GenericList::ScrollType) return (std::forward<GenericListStructT>(inValue).POD.ScrollType);
 		else if constexpr (List == GenericList::JPOSScroll) return (std::forward<GenericListStructT>(inValue).POD.JPOSScroll);
-		else static_assert(false, "unhandled or invalid GenericList value");
+		else static_assert(!sizeof(GenericListStructT), "unhandled or invalid GenericList value");
 	}
 
 	// Access functions for concrete GenericListStruct types
@@ -1093,6 +1199,7 @@ namespace PeepoDrumKit
 	constexpr b8 ListIsItemEndBounded(GenericList list) { return IsNotesList(list) || (list == GenericList::GoGoRanges) || (list == GenericList::JPOSScroll); }
 	constexpr b8 ListHasNoteStaticEffects(GenericList list) { return (list == GenericList::TempoChanges) || (list == GenericList::ScrollChanges) || (list == GenericList::ScrollType); }
 	constexpr b8 ListHasBarlineStaticEffects(GenericList list) { return ListHasNoteStaticEffects(list) || (list == GenericList::BarLineChanges); }
+	constexpr b8 ListAffectsGameLane(GenericList list) { return IsNotesList(list) || ListHasBarlineStaticEffects(list) || (list == GenericList::SignatureChanges); }
 
 	constexpr size_t GetGenericMember_RawByteSize(GenericMember member)
 	{
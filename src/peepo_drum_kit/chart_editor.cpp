@@ -9,6 +9,18 @@ namespace PeepoDrumKit
 {
 	static constexpr std::string_view UntitledChartFileName = "Untitled Chart.tja";
 
+	// NOTE: Points to the most recent autosave file and the chart it belongs to, only exists while there are autosaved changes that haven't been saved manually
+	static constexpr cstr AutosaveRecoveryFileName = "autosave_recovery.txt";
+	static constexpr std::string_view AutosaveFileExtension = ".autosave.tja";
+
+	// NOTE: Decoded songs (already resampled to the output sample rate) together with their waveforms, see Audio::DecodeCacheEntry
+	static constexpr std::string_view SongCacheDirectory = "audio_cache";
+
+	static std::string GetAutosaveFilePath(std::string_view chartFilePath)
+	{
+		return std::string(Path::TrimExtension(!chartFilePath.empty() ? chartFilePath : UntitledChartFileName)).append(AutosaveFileExtension);
+	}
+
 	static constexpr f32 PresetGuiScaleFactors[] = { 0.5, (2.0f / 3.0f), 0.75f, 0.8f, 0.9f, 1.0f, 1.1f, 1.25f, 1.5f, 1.75f, 2.0f, 2.5f, 3.0f, };
 	static constexpr f32 PresetGuiScaleFactorMin = PresetGuiScaleFactors[0];
 	static constexpr f32 PresetGuiScaleFactorMax = PresetGuiScaleFactors[ArrayCount(PresetGuiScaleFactors) - 1];
@@ -48,6 +60,7 @@ namespace PeepoDrumKit
 			course->TempoMap.Tempo.Sorted = { TempoChange(Beat::Zero(), Tempo(160.0f)) };
 			course->TempoMap.Signature.Sorted = { TimeSignatureChange(Beat::Zero(), TimeSignature(4, 4)) };
 			course->TempoMap.RebuildAccelerationStructure();
+			course->NotifyEventListsModified();
 		}
 	}
 
@@ -71,6 +84,15 @@ namespace PeepoDrumKit
 		if (*Settings.Audio.OpenDeviceOnStartup)
 			Audio::Engine.OpenStartStream();
 
+		if (const File::UniqueFileContent recoveryFile = File::ReadAllBytes(AutosaveRecoveryFileName); recoveryFile.Content != nullptr)
+		{
+			const std::string_view recoveryFileContent = recoveryFile.AsString();
+			const size_t lineEndIndex = recoveryFileContent.find('\n');
+			autosaveRecoveryPopup.AutosaveFilePath = recoveryFileContent.substr(0, lineEndIndex);
+			autosaveRecoveryPopup.OriginalChartFilePath = (lineEndIndex != std::string_view::npos) ? recoveryFileContent.substr(lineEndIndex + 1) : "";
+			autosaveRecoveryPopup.OpenOnNextFrame = File::Exists(autosaveRecoveryPopup.AutosaveFilePath);
+		}
+
 #if 0 // DEBUG: TJA bug hunting
 		tjaTestWindow.TabIndexToSelectThisFrame = 2;
 		context.Chart.ChartDuration = Time::FromSec(2.0);
@@ -86,6 +108,13 @@ namespace PeepoDrumKit
 
 	ChartEditor::~ChartEditor()
 	{
+		WaitForAsyncSavingToFinish();
+		if (autosaveChartFuture.valid())
+			autosaveChartFuture.get();
+		if (deleteAutosaveFilesOnceWritten)
+			InternalDeleteAutosaveFiles();
+		CancelAsyncLoadingSongAudioFile();
+		CancelAsyncWritingSongCacheEntry();
 		context.SfxVoicePool.UnloadAllSourcesAndVoices();
 	}
 
@@ -817,14 +846,18 @@ namespace PeepoDrumKit
 							"", scaleMin, scaleMax, GuiScale(vec2(static_cast<f32>(ArrayCount(performance.FrameTimesMS)), plotLinesHeight)));
 						const Rect plotLinesRect = Gui::GetItemRect();
 
-						char overlayTextBuffer[96];
+						char overlayTextBuffer[224];
 						const auto overlayText = std::string_view(overlayTextBuffer, sprintf_s(overlayTextBuffer,
 							"%s%.5g ms\n"
 							"%s%.5g ms\n"
-							"%s%.5g ms",
+							"%s%.5g ms\n"
+							"%s%.3g + %.3g ms\n"
+							"%s%.3g ms",
 							UI_Str("INFO_LATENCY_AVERAGE"), averageFrameTime,
 							UI_Str("INFO_LATENCY_MIN"), minFrameTime,
-							UI_Str("INFO_LATENCY_MAX"), maxFrameTime));
+							UI_Str("INFO_LATENCY_MAX"), maxFrameTime,
+							UI_Str("INFO_LATENCY_AUTOSAVE"), performance.LastAutosaveSnapshotDuration.ToMS(), performance.LastAutosaveSerializeDuration.ToMS(),
+							UI_Str("INFO_LATENCY_WAVEFORM"), timeline.WaveformDrawDuration.ToMS()));
 
 						const vec2 overlayTextSize = Gui::CalcTextSize(overlayText);
 						const Rect overlayTextRect = Rect::FromTLSize(plotLinesRect.GetCenter() - (overlayTextSize * 0.5f) - vec2(0.0f, plotLinesRect.GetHeight() / 4.0f), overlayTextSize);
@@ -844,13 +877,19 @@ namespace PeepoDrumKit
 	void ChartEditor::DrawGui()
 	{
 		InternalUpdateAsyncLoading();
+		InternalUpdateAutosave();
 
 		if (tryToCloseApplicationOnNextFrame)
 		{
 			tryToCloseApplicationOnNextFrame = false;
 			CheckOpenSaveConfirmationPopupThenCall([&]
 			{
-				if (loadSongFuture.valid()) loadSongFuture.get();
+				// NOTE: Stay open if the save that was just issued failed to write its file instead of silently discarding the changes
+				if (!WaitForAsyncSavingToFinish())
+					return;
+				InternalDeleteAutosaveFiles();
+
+				CancelAsyncLoadingSongAudioFile();
 				if (loadJacketFuture.valid()) loadJacketFuture.get();
 				if (importChartFuture.valid()) importChartFuture.get();
 				context.Undo.ClearAll();
@@ -1016,7 +1055,7 @@ namespace PeepoDrumKit
 		if (Gui::Begin(UI_WindowName("TAB_CHART_PROPERTIES"), nullptr, ImGuiWindowFlags_None))
 		{
 			ChartPropertiesWindowIn in = {};
-			in.IsSongAsyncLoading = loadSongFuture.valid();
+			in.IsSongAsyncLoading = (loadSongStream != nullptr);
 			in.IsJacketAsyncLoading = loadJacketFuture.valid();
 			ChartPropertiesWindowOut out = {};
 			propertiesWindow.DrawGui(context, in, out);
@@ -1150,7 +1189,7 @@ namespace PeepoDrumKit
 						// DEBUG: TJA bug hunting
 						if (exportDebugViewData.RoundTripCheck)
 						{
-							std::vector<TJA::Token> tempTokens = TJA::TokenizeLines(TJA::SplitLines(exportDebugViewData.Text));
+							std::vector<TJA::Token> tempTokens; TJA::TokenizeFileContent(exportDebugViewData.Text, tempTokens);
 							TJA::ErrorList tempErrors;
 							TJA::ParsedTJA tempTJA = TJA::ParseTokens(tempTokens, tempErrors);
 							exportDebugViewData.DebugChart = {}; CreateChartProjectFromTJA(tempTJA, exportDebugViewData.DebugChart); exportDebugViewData.DebugLog.clear();
@@ -1271,6 +1310,98 @@ namespace PeepoDrumKit
 			Gui::PopStyleVar(2);
 		}
 
+		// NOTE: Autosave recovery popup
+		{
+			static constexpr cstr autosaveRecoveryPopupID = "INFO_MSGBOX_AUTOSAVE_RECOVERY";
+			if (autosaveRecoveryPopup.OpenOnNextFrame) { Gui::OpenPopup(UI_WindowName(autosaveRecoveryPopupID)); autosaveRecoveryPopup.OpenOnNextFrame = false; }
+
+			const ImGuiViewport* mainViewport = Gui::GetMainViewport();
+			Gui::SetNextWindowPos(Rect::FromTLSize(mainViewport->Pos, mainViewport->Size).GetCenter(), ImGuiCond_Appearing, vec2(0.5f));
+
+			Gui::PushStyleVar(ImGuiStyleVar_ItemSpacing, { GuiScale(4.0f), Gui::GetStyle().ItemSpacing.y });
+			Gui::PushStyleVar(ImGuiStyleVar_WindowPadding, { GuiScale(6.0f), GuiScale(6.0f) });
+			if (Gui::BeginPopupModal(UI_WindowName(autosaveRecoveryPopupID), nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings))
+			{
+				const vec2 buttonSize = GuiScale(vec2(180.0f, 0.0f));
+				Gui::PushFont(FontMain, GuiScaleI32_AtTarget(FontBaseSizes::Medium));
+				{
+					// NOTE: Manual child size calculation required for proper dynamic scaling
+					Gui::BeginChild("TextChild", vec2((buttonSize.x * 2.0f) + Gui::GetStyle().ItemSpacing.x, Gui::GetFontSize() * 4.0f), true, ImGuiWindowFlags_NoBackground);
+					Gui::AlignTextToFramePadding();
+					Gui::TextUnformatted(UI_Str("PROMPT_MSGBOX_AUTOSAVE_RECOVERY"));
+					Gui::TextDisabled("%.*s", FmtStrViewArgs(Path::GetFileName(autosaveRecoveryPopup.AutosaveFilePath)));
+					Gui::EndChild();
+				}
+				Gui::PopFont();
+
+				const b8 clickedRecover = Gui::Button(UI_Str("ACT_MSGBOX_AUTOSAVE_RECOVER"), buttonSize) | (Gui::IsWindowFocused() && Gui::IsAnyPressed(*Settings.Input.Dialog_YesOrOk, false));
+				Gui::SameLine();
+				const b8 clickedDiscard = Gui::Button(UI_Str("ACT_MSGBOX_AUTOSAVE_DISCARD"), buttonSize) | (Gui::IsWindowFocused() && Gui::IsAnyPressed(*Settings.Input.Dialog_No, false));
+
+				if (clickedRecover)
+				{
+					// NOTE: Keep the autosave file around (and owned by this session) until the recovered changes have been saved
+					lastAutosaveFilePath = autosaveRecoveryPopup.AutosaveFilePath;
+					StartAsyncImportingChartFile(autosaveRecoveryPopup.AutosaveFilePath, true);
+					PersistentApp.RecentFiles.Remove(autosaveRecoveryPopup.AutosaveFilePath);
+					Gui::CloseCurrentPopup();
+				}
+				else if (clickedDiscard)
+				{
+					File::Delete(autosaveRecoveryPopup.AutosaveFilePath);
+					File::Delete(AutosaveRecoveryFileName);
+					Gui::CloseCurrentPopup();
+				}
+				Gui::EndPopup();
+			}
+			Gui::PopStyleVar(2);
+		}
+
+		// NOTE: Save failed popup
+		{
+			static constexpr cstr saveFailedPopupID = "INFO_MSGBOX_SAVE_FAILED";
+			if (saveFailedPopup.OpenOnNextFrame) { Gui::OpenPopup(UI_WindowName(saveFailedPopupID)); saveFailedPopup.OpenOnNextFrame = false; }
+
+			const ImGuiViewport* mainViewport = Gui::GetMainViewport();
+			Gui::SetNextWindowPos(Rect::FromTLSize(mainViewport->Pos, mainViewport->Size).GetCenter(), ImGuiCond_Appearing, vec2(0.5f));
+
+			Gui::PushStyleVar(ImGuiStyleVar_ItemSpacing, { GuiScale(4.0f), Gui::GetStyle().ItemSpacing.y });
+			Gui::PushStyleVar(ImGuiStyleVar_WindowPadding, { GuiScale(6.0f), GuiScale(6.0f) });
+			if (Gui::BeginPopupModal(UI_WindowName(saveFailedPopupID), nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings))
+			{
+				const vec2 buttonSize = GuiScale(vec2(120.0f, 0.0f));
+				Gui::PushFont(FontMain, GuiScaleI32_AtTarget(FontBaseSizes::Medium));
+				{
+					// NOTE: Manual child size calculation required for proper dynamic scaling
+					Gui::BeginChild("TextChild", vec2((buttonSize.x * 3.0f) + Gui::GetStyle().ItemSpacing.x, Gui::GetFontSize() * 4.0f), true, ImGuiWindowFlags_NoBackground);
+					Gui::AlignTextToFramePadding();
+					Gui::TextUnformatted(UI_Str("PROMPT_MSGBOX_SAVE_FAILED"));
+					Gui::TextDisabled("%.*s", FmtStrViewArgs(saveFailedPopup.ChartFilePath));
+					Gui::EndChild();
+				}
+				Gui::PopFont();
+
+				const b8 clickedRetry = Gui::Button(UI_Str("ACT_MSGBOX_SAVE_FAILED_RETRY"), buttonSize) | (Gui::IsWindowFocused() && Gui::IsAnyPressed(*Settings.Input.Dialog_YesOrOk, false));
+				Gui::SameLine();
+				const b8 clickedSaveAs = Gui::Button(UI_Str("ACT_FILE_SAVE_AS"), buttonSize);
+				Gui::SameLine();
+				const b8 clickedCancel = Gui::Button(UI_Str("ACT_MSGBOX_CANCEL"), buttonSize) | (Gui::IsWindowFocused() && Gui::IsAnyPressed(*Settings.Input.Dialog_Cancel, false));
+
+				if (clickedRetry || clickedSaveAs || clickedCancel)
+				{
+					// NOTE: Closed first so that a retry that fails yet again can reopen it
+					Gui::CloseCurrentPopup();
+					if (clickedRetry)
+						SaveChart(context, saveFailedPopup.ChartFilePath);
+					else if (clickedSaveAs)
+						OpenChartSaveAsDialog(context);
+					UpdateApplicationWindowTitle(context);
+				}
+				Gui::EndPopup();
+			}
+			Gui::PopStyleVar(2);
+		}
+
 		context.Undo.FlushAndExecuteEndOfFrameCommands();
 	}
 
@@ -1320,7 +1451,7 @@ namespace PeepoDrumKit
 
 	ApplicationHost::CloseResponse ChartEditor::OnWindowCloseRequest()
 	{
-		if (context.Undo.HasPendingChanges)
+		if (context.Undo.HasPendingChanges || saveChartFuture.valid())
 		{
 			tryToCloseApplicationOnNextFrame = true;
 			return ApplicationHost::CloseResponse::SupressExit;
@@ -1346,12 +1477,14 @@ namespace PeepoDrumKit
 
 	void ChartEditor::CreateNewChart(ChartContext& context)
 	{
-		if (loadSongFuture.valid()) loadSongFuture.get();
+		CancelAsyncLoadingSongAudioFile();
 		if (!context.SongSourceFilePath.empty()) StartAsyncLoadingSongAudioFile("");
 		if (loadJacketFuture.valid()) loadJacketFuture.get();
 		if (!context.SongJacketFilePath.empty()) StartAsyncLoadingSongJacketFile("");
 		if (importChartFuture.valid()) importChartFuture.get();
+		autosaveRecoveryPopup.IsRecoveringImport = false;
 		InternalUpdateAsyncLoading();
+		InternalDeleteAutosaveFiles();
 
 		createBackupOfOriginalTJABeforeOverwriteSave = false;
 		context.Chart = {};
@@ -1397,27 +1530,38 @@ namespace PeepoDrumKit
 		assert(!filePath.empty());
 		if (!filePath.empty())
 		{
-			TJA::ParsedTJA tja;
-			ConvertChartProjectToTJA(context.Chart, tja);
-			std::string tjaText;
-			TJA::ConvertParsedToText(tja, tjaText, TJA::Encoding::UTF8);
-
-			// TODO: Proper async file saving by copying in-memory
-			if (createBackupOfOriginalTJABeforeOverwriteSave)
-			{
-				static constexpr b8 overwriteExisting = false;
-				const std::string originalFileBackupPath { std::string(filePath).append(".bak") };
-
-				File::Copy(filePath, originalFileBackupPath, overwriteExisting);
-				createBackupOfOriginalTJABeforeOverwriteSave = false;
-			}
-
-			File::WriteAllBytes(filePath, tjaText);
-
-			context.ChartFilePath = filePath;
+			// NOTE: Only snapshot the chart here, the (comparatively slow) TJA conversion and file writing are then done on a worker thread
+			auto request = std::make_unique<AsyncSaveChartRequest>();
+			request->ChartFilePath = filePath;
+			CopyChartProjectForExport(context.Chart, request->Chart);
+			request->CreateBackupOfOriginalFile = createBackupOfOriginalTJABeforeOverwriteSave;
+			createBackupOfOriginalTJABeforeOverwriteSave = false;
+
+			// NOTE: Reset optimistically and only marked as changed again if the write fails (any edits made in the meantime mark it changed as usual)
+			context.ChartFilePath = request->ChartFilePath;
 			context.Undo.ClearChangesWereMade();
 
 			PersistentApp.RecentFiles.Add(std::string { filePath });
+
+			if (saveChartFuture.valid())
+			{
+				// NOTE: Only saves to the same file can be coalesced, those to any other file (say a "Save As" right after a "Save") still have to be written out
+				auto sameFileRequest = std::find_if(pendingSaveChartRequests.begin(), pendingSaveChartRequests.end(), [&](const auto& pending) { return pending->ChartFilePath == request->ChartFilePath; });
+				if (sameFileRequest != pendingSaveChartRequests.end())
+				{
+					if ((*sameFileRequest)->CreateBackupOfOriginalFile)
+						request->CreateBackupOfOriginalFile = true;
+					*sameFileRequest = std::move(request);
+				}
+				else
+				{
+					pendingSaveChartRequests.push_back(std::move(request));
+				}
+			}
+			else
+			{
+				StartAsyncSavingChartFile(std::move(request));
+			}
 		}
 	}
 
@@ -1453,19 +1597,23 @@ namespace PeepoDrumKit
 		return true;
 	}
 
-	void ChartEditor::StartAsyncImportingChartFile(std::string_view absoluteChartFilePath)
+	void ChartEditor::StartAsyncImportingChartFile(std::string_view absoluteChartFilePath, b8 isRecoveringAutosave)
 	{
 		if (importChartFuture.valid())
 			importChartFuture.get();
 
+		// NOTE: Any previous import has just been discarded so the recovery state must only ever describe the one started here
+		autosaveRecoveryPopup.IsRecoveringImport = isRecoveringAutosave;
+		std::string originalChartFilePath = isRecoveringAutosave ? autosaveRecoveryPopup.OriginalChartFilePath : "";
+
 		PersistentApp.RecentFiles.Add(std::string { absoluteChartFilePath });
-		importChartFuture = std::async(std::launch::async, [tempPathCopy = std::string(absoluteChartFilePath)]() mutable->AsyncImportChartResult
+		importChartFuture = std::async(std::launch::async, [tempPathCopy = std::string(absoluteChartFilePath), isRecoveringAutosave, originalChartFilePath = std::move(originalChartFilePath)]() mutable->AsyncImportChartResult
 		{
 			AsyncImportChartResult result {};
 			result.ChartFilePath = std::move(tempPathCopy);
 
-			auto[fileContent, fileSize] = File::ReadAllBytes(result.ChartFilePath);
-			if (fileContent == nullptr || fileSize == 0)
+			File::MappedView fileView;
+			if (!fileView.Open(result.ChartFilePath) || fileView.Size() == 0)
 			{
 				printf("Failed to read file '%.*s'\n", FmtStrViewArgs(result.ChartFilePath));
 				return result;
@@ -1473,17 +1621,28 @@ namespace PeepoDrumKit
 
 			assert(Path::HasExtension(result.ChartFilePath, TJA::Extension));
 
-			const std::string_view fileContentView = std::string_view(reinterpret_cast<const char*>(fileContent.get()), fileSize);
-			if (UTF8::HasBOM(fileContentView))
-				result.TJA.FileContentUTF8 = UTF8::TrimBOM(fileContentView);
-			else
-				result.TJA.FileContentUTF8 = UTF8::FromShiftJIS(fileContentView);
+			result.TJA.FileContentUTF8 = TJA::ConvertFileContentToUTF8(fileView.AsString());
+			fileView.Close();
 
-			result.TJA.Lines = TJA::SplitLines(result.TJA.FileContentUTF8);
-			result.TJA.Tokens = TJA::TokenizeLines(result.TJA.Lines);
+			TJA::TokenizeFileContent(result.TJA.FileContentUTF8, result.TJA.Tokens);
 			result.TJA.Parsed = ParseTokens(result.TJA.Tokens, result.TJA.ParseErrors);
 
-			if (!CreateChartProjectFromTJA(result.TJA.Parsed, result.Chart))
+			// TODO: Maybe also do date version check (?)
+			// NOTE: An autosave always has the comment, so when recovering it's the original file that will be overwritten once saved that decides
+			//		 (with nothing to back up if the chart was never saved or the file has since been removed)
+			if (!isRecoveringAutosave)
+			{
+				result.CreateBackupOfOriginalFile = !result.TJA.Parsed.HasPeepoDrumKitComment;
+			}
+			else if (File::MappedView originalFileView; !originalChartFilePath.empty() && originalFileView.Open(originalChartFilePath) && originalFileView.Size() > 0)
+			{
+				std::vector<TJA::Token> originalTokens;
+				TJA::TokenizeFileContent(TJA::ConvertFileContentToUTF8(originalFileView.AsString()), originalTokens);
+				TJA::ErrorList originalParseErrors;
+				result.CreateBackupOfOriginalFile = !TJA::ParseTokens(originalTokens, originalParseErrors).HasPeepoDrumKitComment;
+			}
+
+			if (!CreateChartProjectFromTJA(result.TJA.Parsed, result.Chart, true))
 			{
 				printf("Failed to create chart from TJA file '%.*s'\n", FmtStrViewArgs(result.ChartFilePath));
 				return result;
@@ -1503,8 +1662,8 @@ namespace PeepoDrumKit
 				AsyncLoadJacketResult result{};
 				result.JacketFilePath = std::move(tempPathCopy);
 
-				auto [fileContent, fileSize] = File::ReadAllBytes(result.JacketFilePath);
-				if (fileContent == nullptr || fileSize == 0)
+				File::MappedView fileView;
+				if (!fileView.Open(result.JacketFilePath) || fileView.Size() == 0)
 				{
 					printf("Failed to read file '%.*s'\n", FmtStrViewArgs(result.JacketFilePath));
 					return result;
@@ -1514,48 +1673,222 @@ namespace PeepoDrumKit
 			});
 	}
 
+	static void LoadSongStreamFromCacheEntry(AsyncLoadSongStream& stream, const Audio::DecodeCacheEntry& cacheEntry)
+	{
+		// NOTE: Handed over to the timeline as is, leaving it at the default (incrementally generated) waveform should the entry not contain all of them
+		const size_t waveformCount = Min<size_t>(cacheEntry.GetChannelCount(), 2);
+		stream.HasCachedWaveform = (cacheEntry.GetWaveformCount() == waveformCount) &&
+			cacheEntry.CopyWaveform(0, stream.CachedWaveformL) && (waveformCount < 2 || cacheEntry.CopyWaveform(1, stream.CachedWaveformR));
+		if (!stream.HasCachedWaveform)
+		{
+			stream.CachedWaveformL = {};
+			stream.CachedWaveformR = {};
+		}
+
+		Audio::PCMSampleBuffer sampleBuffer {};
+		sampleBuffer.ChannelCount = cacheEntry.GetChannelCount();
+		sampleBuffer.SampleRate = cacheEntry.GetSampleRate();
+		sampleBuffer.FrameCount = cacheEntry.GetFrameCount();
+		sampleBuffer.InterleavedSamples = std::unique_ptr<i16[]>(new i16[sampleBuffer.SampleCount()]);
+
+		// NOTE: Copied out of the mapped file in large blocks and published the same way as when decoding, so that playback can start right away
+		static constexpr i64 copyBlockFrameCount = (Audio::BlockDecoder::BlockFrameCount * 16);
+		const size_t channelCount = sampleBuffer.ChannelCount;
+		const i64 frameCount = sampleBuffer.FrameCount;
+		i16* const samples = sampleBuffer.InterleavedSamples.get();
+		stream.Source = Audio::Engine.LoadStreamingSourceFromBufferMove(Path::GetFileName(stream.SongFilePath), std::move(sampleBuffer));
+		if (stream.Source == Audio::SourceHandle::Invalid)
+			return;
+
+		for (i64 frame = 0; frame < frameCount && !stream.CancelRequested.load(std::memory_order_relaxed);)
+		{
+			const i64 blockFrameCount = Min(copyBlockFrameCount, frameCount - frame);
+			::memcpy(&samples[frame * channelCount], &cacheEntry.GetInterleavedSamples()[frame * channelCount], (blockFrameCount * channelCount) * sizeof(i16));
+			frame += blockFrameCount;
+
+			Audio::Engine.PublishStreamingSourceFrames(stream.Source, frame);
+			if (!stream.FirstBlockPublished.load(std::memory_order_relaxed))
+				stream.FirstBlockPublished.store(true, std::memory_order_release);
+		}
+	}
+
 	void ChartEditor::StartAsyncLoadingSongAudioFile(std::string_view absoluteAudioFilePath)
 	{
-		if (loadSongFuture.valid())
-			loadSongFuture.get();
+		CancelAsyncLoadingSongAudioFile();
 
 		context.SongWaveformFadeAnimationTarget = 0.0f;
 		loadSongStopwatch.Restart();
-		loadSongFuture = std::async(std::launch::async, [tempPathCopy = std::string(absoluteAudioFilePath)]()->AsyncLoadSongResult
+		loadSongStream = std::make_unique<AsyncLoadSongStream>();
+		loadSongStream->SongFilePath = absoluteAudioFilePath;
+		loadSongStream->ResamplerQuality = static_cast<Audio::ResamplerQuality>(Clamp(*Settings.Audio.ResamplerQuality, 0, EnumCountI32<Audio::ResamplerQuality> - 1));
+		const b8 songCacheEnabled = (*Settings.Audio.SongCacheSizeMB > 0);
+		loadSongFuture = std::async(std::launch::async, [stream = loadSongStream.get(), songCacheEnabled]()
 		{
-			AsyncLoadSongResult result {};
-			result.SongFilePath = std::move(tempPathCopy);
-
 			// TODO: Maybe handle this in a different way... but for now loading an empty file path works as an "unload"
-			if (result.SongFilePath.empty())
-				return result;
+			if (stream->SongFilePath.empty())
+				return;
 
-			auto[fileContent, fileSize] = File::ReadAllBytes(result.SongFilePath);
-			if (fileContent == nullptr || fileSize == 0)
+			File::MappedView fileView;
+			if (!fileView.Open(stream->SongFilePath) || fileView.Size() == 0)
 			{
-				printf("Failed to read file '%.*s'\n", FmtStrViewArgs(result.SongFilePath));
-				return result;
+				printf("Failed to read file '%.*s'\n", FmtStrViewArgs(stream->SongFilePath));
+				return;
 			}
 
-			if (Audio::DecodeEntireFile(result.SongFilePath, fileContent.get(), fileSize, result.SampleBuffer) != Audio::DecodeFileResult::FeelsGoodMan)
+			// NOTE: Uncompressed WAV files decode about as fast as their (much larger) cache entry could be read back in, so they aren't worth caching
+			const b8 useSongCache = songCacheEnabled && !Path::HasExtension(stream->SongFilePath, ".wav");
+			const Audio::DecodeCacheKey songCacheKey = useSongCache ? Audio::ComputeDecodeCacheKey(fileView.Data(), fileView.Size()) : Audio::DecodeCacheKey {};
+			if (useSongCache)
 			{
-				printf("Failed to decode audio file '%.*s'\n", FmtStrViewArgs(result.SongFilePath));
-				return result;
+				Audio::DecodeCacheEntry cacheEntry;
+				if (cacheEntry.Open(SongCacheDirectory, songCacheKey, Audio::Engine.OutputSampleRate, stream->ResamplerQuality))
+				{
+					fileView.Close();
+					LoadSongStreamFromCacheEntry(*stream, cacheEntry);
+					return;
+				}
 			}
 
-			// HACK: ...
-			if (result.SampleBuffer.SampleRate != Audio::Engine.OutputSampleRate)
-				Audio::LinearlyResampleBuffer<i16>(result.SampleBuffer.InterleavedSamples, result.SampleBuffer.FrameCount, result.SampleBuffer.SampleRate, result.SampleBuffer.ChannelCount, Audio::Engine.OutputSampleRate);
+			// HACK: Resampled while decoding because the engine doesn't handle mismatched sample rates
+			Audio::BlockDecoder decoder;
+			if (!decoder.Open(stream->SongFilePath, fileView.Data(), fileView.Size(), Audio::Engine.OutputSampleRate, stream->ResamplerQuality))
+			{
+				printf("Failed to decode audio file '%.*s'\n", FmtStrViewArgs(stream->SongFilePath));
+				return;
+			}
 
-			if (result.SampleBuffer.ChannelCount > 0) result.WaveformL.GenerateEntireMipChainFromSampleBuffer(result.SampleBuffer, 0);
-#if !PEEPO_DEBUG // NOTE: Always ignore the second channel in debug builds for performance reasons!
-			if (result.SampleBuffer.ChannelCount > 1) result.WaveformR.GenerateEntireMipChainFromSampleBuffer(result.SampleBuffer, 1);
-#endif
+			Audio::PCMSampleBuffer sampleBuffer {};
+			sampleBuffer.ChannelCount = decoder.GetChannelCount();
+			sampleBuffer.SampleRate = decoder.GetSampleRate();
+			sampleBuffer.FrameCount = decoder.GetFrameCount();
+			sampleBuffer.InterleavedSamples = std::unique_ptr<i16[]>(new i16[sampleBuffer.SampleCount()]);
+
+			// NOTE: Moving the buffer into the source leaves the samples themselves in place, so they can still be written to from here
+			i16* const samples = sampleBuffer.InterleavedSamples.get();
+			stream->Source = Audio::Engine.LoadStreamingSourceFromBufferMove(Path::GetFileName(stream->SongFilePath), std::move(sampleBuffer));
+			if (stream->Source == Audio::SourceHandle::Invalid)
+				return;
+
+			while (!decoder.IsFinished() && !stream->CancelRequested.load(std::memory_order_relaxed))
+			{
+				Audio::Engine.PublishStreamingSourceFrames(stream->Source, decoder.DecodeNextBlock(samples));
+				if (!stream->FirstBlockPublished.load(std::memory_order_relaxed))
+					stream->FirstBlockPublished.store(true, std::memory_order_release);
+			}
+
+			// NOTE: Written by the main thread instead, once the waveform has been generated from all of the samples
+			if (useSongCache && decoder.IsFinished() && !stream->CancelRequested.load(std::memory_order_relaxed))
+			{
+				stream->ShouldWriteSongCacheEntry = true;
+				stream->SongCacheKey = songCacheKey;
+			}
+		});
+	}
+
+	void ChartEditor::CancelAsyncLoadingSongAudioFile()
+	{
+		if (loadSongStream == nullptr)
+			return;
+
+		loadSongStream->CancelRequested = true;
+		if (loadSongFuture.valid())
+			loadSongFuture.get();
+
+		// NOTE: Otherwise left partially decoded inside the context until the next song replaces it
+		if (!loadSongStream->HasBeenHandedOver && loadSongStream->Source != Audio::SourceHandle::Invalid)
+			Audio::Engine.UnloadSource(loadSongStream->Source);
+
+		// NOTE: Same for an already handed over song that was cut short (by either the decoder or copying out of the song cache), because there is no guarantee
+		//		 that anything ever replaces it, such as when the next song then fails to load. So treated as if it had never been loaded in the first place
+		if (loadSongStream->HasBeenHandedOver && context.SongSource == loadSongStream->Source)
+		{
+			const Audio::PCMSampleBuffer* sampleBuffer = Audio::Engine.GetSourceSampleBufferView(context.SongSource);
+			if (sampleBuffer == nullptr || Audio::Engine.GetSourceReadableFrameCount(context.SongSource) < sampleBuffer->FrameCount)
+			{
+				context.SongVoice.SetSource(Audio::SourceHandle::Invalid);
+				if (context.SongSource != Audio::SourceHandle::Invalid)
+					Audio::Engine.UnloadSource(context.SongSource);
+
+				context.SongSource = Audio::SourceHandle::Invalid;
+				context.SongSourceFilePath.clear();
+				context.SongWaveformL = {};
+				context.SongWaveformR = {};
+				context.SongWaveformFadeAnimationTarget = 0.0f;
+				timeline.InvalidateWaveformCaches();
+			}
+		}
+		loadSongStream = nullptr;
+	}
+
+	void ChartEditor::StartAsyncWritingSongCacheEntry(const Audio::DecodeCacheKey& cacheKey, Audio::ResamplerQuality resamplerQuality)
+	{
+		CancelAsyncWritingSongCacheEntry();
+
+		const Audio::PCMSampleBuffer* sampleBuffer = Audio::Engine.GetSourceSampleBufferView(context.SongSource);
+		if (sampleBuffer == nullptr || context.SongWaveformL.IsEmpty())
+			return;
+
+		// NOTE: The samples are no longer written to and stay alive until this has been cancelled, while the waveforms are copied as they belong to the main thread
+		writeSongCacheCancelRequested = false;
+		const u64 songCacheMaxByteSize = static_cast<u64>(ClampBot(*Settings.Audio.SongCacheSizeMB, 0)) * 1024 * 1024;
+		writeSongCacheFuture = std::async(std::launch::async, [sampleBuffer, cacheKey, resamplerQuality, songCacheMaxByteSize, cancelRequested = &writeSongCacheCancelRequested, waveformL = context.SongWaveformL, waveformR = context.SongWaveformR]() mutable
+		{
+			const Audio::WaveformMipChain waveforms[2] = { std::move(waveformL), std::move(waveformR) };
+			const size_t waveformCount = Min<size_t>(sampleBuffer->ChannelCount, 2);
+
+			if (Audio::WriteDecodeCacheEntry(SongCacheDirectory, cacheKey, *sampleBuffer, resamplerQuality, waveforms, waveformCount, cancelRequested))
+				Audio::EvictDecodeCacheEntries(SongCacheDirectory, songCacheMaxByteSize);
+			else if (!cancelRequested->load(std::memory_order_relaxed))
+				printf("Failed to write song cache entry to '%.*s'\n", FmtStrViewArgs(SongCacheDirectory));
+		});
+	}
+
+	void ChartEditor::CancelAsyncWritingSongCacheEntry()
+	{
+		// NOTE: Only ever has to wait for the block currently being written
+		writeSongCacheCancelRequested = true;
+		if (writeSongCacheFuture.valid())
+			writeSongCacheFuture.get();
+	}
+
+	void ChartEditor::StartAsyncSavingChartFile(std::unique_ptr<AsyncSaveChartRequest> request)
+	{
+		assert(request != nullptr && !saveChartFuture.valid());
+		saveChartFuture = std::async(std::launch::async, [request = std::move(request)]() -> AsyncSaveChartResult
+		{
+			AsyncSaveChartResult result {};
+			result.ChartFilePath = std::move(request->ChartFilePath);
+
+			TJA::ParsedTJA tja;
+			ConvertChartProjectToTJA(request->Chart, tja);
+
+			if (request->CreateBackupOfOriginalFile)
+			{
+				static constexpr b8 overwriteExisting = false;
+				const std::string originalFileBackupPath { std::string(result.ChartFilePath).append(".bak") };
+
+				File::Copy(result.ChartFilePath, originalFileBackupPath, overwriteExisting);
+			}
+
+			result.Succeeded = TJA::WriteParsedToTextFile(tja, result.ChartFilePath, TJA::Encoding::UTF8);
+			if (!result.Succeeded)
+				printf("Failed to write file '%.*s'\n", FmtStrViewArgs(result.ChartFilePath));
 
 			return result;
 		});
 	}
 
+	b8 ChartEditor::WaitForAsyncSavingToFinish()
+	{
+		b8 allSavesSucceeded = true;
+		while (saveChartFuture.valid())
+		{
+			saveChartFuture.wait();
+			allSavesSucceeded &= InternalUpdateAsyncSaving();
+		}
+		return allSavesSucceeded;
+	}
+
 	void ChartEditor::SetAndStartLoadingChartSongFileName(std::string_view relativeOrAbsoluteAudioFilePath, Undo::UndoHistory& undo)
 	{
 		if (!relativeOrAbsoluteAudioFilePath.empty() && !Path::IsRelative(relativeOrAbsoluteAudioFilePath))
@@ -1657,6 +1990,7 @@ namespace PeepoDrumKit
 	{
 		context.Gfx.UpdateAsyncLoading();
 		context.SfxVoicePool.UpdateAsyncLoading();
+		InternalUpdateAsyncSaving();
 
 		if (importChartFuture.valid() && importChartFuture._Is_ready())
 		{
@@ -1664,8 +1998,7 @@ namespace PeepoDrumKit
 
 			AsyncImportChartResult loadResult = importChartFuture.get();
 
-			// TODO: Maybe also do date version check (?)
-			createBackupOfOriginalTJABeforeOverwriteSave = !loadResult.TJA.Parsed.HasPeepoDrumKitComment;
+			createBackupOfOriginalTJABeforeOverwriteSave = loadResult.CreateBackupOfOriginalFile;
 
 			context.Chart = std::move(loadResult.Chart);
 			context.ChartFilePath = std::move(loadResult.ChartFilePath);
@@ -1683,35 +2016,91 @@ namespace PeepoDrumKit
 				context.SetCursorTime(context.GetCursorTime() + (previousChartSongOffset - context.Chart.SongOffset));
 
 			context.Undo.ClearAll();
+
+			if (autosaveRecoveryPopup.IsRecoveringImport)
+			{
+				// NOTE: Continue from where the last session left off, with the recovered changes still marked as unsaved
+				context.ChartFilePath = std::move(autosaveRecoveryPopup.OriginalChartFilePath);
+				context.Undo.NotifyChangesWereMade();
+				autosaveRecoveryPopup.IsRecoveringImport = false;
+			}
+			else
+			{
+				InternalDeleteAutosaveFiles();
+			}
 		}
 
 		// NOTE: Just in case there is something wrong with the animation, that could otherwise prevent the song from finishing to load
 		static constexpr Time maxWaveformFadeOutDelaySafetyLimit = Time::FromSec(0.5);
 		const b8 waveformHasFadedOut = (context.SongWaveformFadeAnimationCurrent <= 0.01f || loadSongStopwatch.GetElapsed() >= maxWaveformFadeOutDelaySafetyLimit);
 
-		if (loadSongFuture.valid() && loadSongFuture._Is_ready() && waveformHasFadedOut)
+		if (loadSongStream != nullptr)
 		{
-			loadSongStopwatch.Stop();
-			AsyncLoadSongResult loadResult = loadSongFuture.get();
-			context.SongSourceFilePath = std::move(loadResult.SongFilePath);
-			context.SongWaveformL = std::move(loadResult.WaveformL);
-			context.SongWaveformR = std::move(loadResult.WaveformR);
-			context.SongWaveformFadeAnimationTarget = context.SongWaveformL.IsEmpty() ? 0.0f : 1.0f;
+			// NOTE: Waited on as soon as it's done so that the published frame count read below is guaranteed to be final
+			const b8 loadHasFinished = !loadSongFuture.valid() || loadSongFuture._Is_ready();
+			if (loadSongFuture.valid() && loadHasFinished)
+				loadSongFuture.get();
+
+			if (!loadSongStream->HasBeenHandedOver && waveformHasFadedOut && (loadHasFinished || loadSongStream->FirstBlockPublished.load(std::memory_order_acquire)))
+			{
+				loadSongStopwatch.Stop();
+				loadSongStream->HasBeenHandedOver = true;
+				context.SongSourceFilePath = loadSongStream->SongFilePath;
+
+				CancelAsyncWritingSongCacheEntry();
+				if (context.SongSource != Audio::SourceHandle::Invalid)
+					Audio::Engine.UnloadSource(context.SongSource);
+
+				context.SongSource = loadSongStream->Source;
+				context.SongVoice.SetSource(context.SongSource);
+				context.SongWaveformL = {};
+				context.SongWaveformR = {};
+				timeline.InvalidateWaveformCaches();
+
+				// NOTE: Fading back in right away with the not yet decoded part of the waveform simply staying flat until it has been generated
+				if (const Audio::PCMSampleBuffer* sampleBuffer = Audio::Engine.GetSourceSampleBufferView(context.SongSource); sampleBuffer != nullptr)
+				{
+					// NOTE: With only the coarse mips of a cached waveform available upfront, the finer ones are then generated the same way as when decoding
+					if (loadSongStream->HasCachedWaveform)
+					{
+						context.SongWaveformL = std::move(loadSongStream->CachedWaveformL);
+						context.SongWaveformR = std::move(loadSongStream->CachedWaveformR);
+					}
+					else
+					{
+						if (sampleBuffer->ChannelCount > 0) context.SongWaveformL.BeginIncrementalMipChainGeneration(sampleBuffer->FrameCount, sampleBuffer->SampleRate);
+						if (sampleBuffer->ChannelCount > 1) context.SongWaveformR.BeginIncrementalMipChainGeneration(sampleBuffer->FrameCount, sampleBuffer->SampleRate);
+					}
 
-			// TODO: Maybe handle this differently...
-			if (context.Chart.ChartTitle.empty() && !context.SongSourceFilePath.empty())
-				context.Chart.ChartTitle = Path::GetFileName(context.SongSourceFilePath, false);
+					if (context.Chart.ChartDuration.Seconds <= 0.0 && sampleBuffer->SampleRate > 0)
+						context.Chart.ChartDuration = Audio::FramesToTime(sampleBuffer->FrameCount, sampleBuffer->SampleRate);
+				}
+				context.SongWaveformFadeAnimationTarget = context.SongWaveformL.IsEmpty() ? 0.0f : 1.0f;
 
-			if (context.Chart.ChartDuration.Seconds <= 0.0 && loadResult.SampleBuffer.SampleRate > 0)
-				context.Chart.ChartDuration = Audio::FramesToTime(loadResult.SampleBuffer.FrameCount, loadResult.SampleBuffer.SampleRate);
+				// TODO: Maybe handle this differently...
+				if (context.Chart.ChartTitle.empty() && !context.SongSourceFilePath.empty())
+					context.Chart.ChartTitle = Path::GetFileName(context.SongSourceFilePath, false);
 
-			if (context.SongSource != Audio::SourceHandle::Invalid)
-				Audio::Engine.UnloadSource(context.SongSource);
+				Audio::Engine.EnsureStreamRunning();
+			}
 
-			context.SongSource = Audio::Engine.LoadSourceFromBufferMove(Path::GetFileName(context.SongSourceFilePath), std::move(loadResult.SampleBuffer));
-			context.SongVoice.SetSource(context.SongSource);
+			if (loadSongStream->HasBeenHandedOver)
+			{
+				if (const Audio::PCMSampleBuffer* sampleBuffer = Audio::Engine.GetSourceSampleBufferView(context.SongSource); sampleBuffer != nullptr)
+				{
+					// NOTE: Both channels in a single pass with large chunks of newly decoded frames (such as from a fast decoder or a late handover) split across all cores
+					const i64 readableFrameCount = Audio::Engine.GetSourceReadableFrameCount(context.SongSource);
+					if (!context.SongWaveformL.IsEmpty())
+						Audio::WaveformMipChain::ContinueIncrementalStereoMipChainGeneration(context.SongWaveformL, &context.SongWaveformR, *sampleBuffer, readableFrameCount);
+				}
 
-			Audio::Engine.EnsureStreamRunning();
+				if (loadHasFinished)
+				{
+					if (loadSongStream->ShouldWriteSongCacheEntry)
+						StartAsyncWritingSongCacheEntry(loadSongStream->SongCacheKey, loadSongStream->ResamplerQuality);
+					loadSongStream = nullptr;
+				}
+			}
 		}
 
 		if (loadJacketFuture.valid() && loadJacketFuture._Is_ready())
@@ -1721,4 +2110,122 @@ namespace PeepoDrumKit
 			context.SongJacketFilePath = std::move(loadResult.JacketFilePath);
 		}
 	}
+
+	b8 ChartEditor::InternalUpdateAsyncSaving()
+	{
+		if (!saveChartFuture.valid() || !saveChartFuture._Is_ready())
+			return true;
+
+		const AsyncSaveChartResult saveResult = saveChartFuture.get();
+
+		// NOTE: A pending request to the same file always contains the more recent snapshot so its own result is the one that decides the final state
+		const b8 sameFileRequestPending = std::any_of(pendingSaveChartRequests.begin(), pendingSaveChartRequests.end(), [&](const auto& pending) { return pending->ChartFilePath == saveResult.ChartFilePath; });
+		if (!saveResult.Succeeded && !sameFileRequestPending)
+		{
+			if (saveResult.ChartFilePath == context.ChartFilePath)
+				context.Undo.NotifyChangesWereMade();
+
+			saveFailedPopup.OpenOnNextFrame = true;
+			saveFailedPopup.ChartFilePath = saveResult.ChartFilePath;
+		}
+
+		if (saveResult.Succeeded && pendingSaveChartRequests.empty() && !context.Undo.HasPendingChanges)
+			InternalDeleteAutosaveFiles();
+
+		if (!pendingSaveChartRequests.empty())
+		{
+			std::unique_ptr<AsyncSaveChartRequest> nextRequest = std::move(pendingSaveChartRequests.front());
+			pendingSaveChartRequests.erase(pendingSaveChartRequests.begin());
+			StartAsyncSavingChartFile(std::move(nextRequest));
+		}
+
+		return saveResult.Succeeded;
+	}
+
+	void ChartEditor::InternalUpdateAutosave()
+	{
+		if (autosaveChartFuture.valid())
+		{
+			if (!autosaveChartFuture._Is_ready())
+				return;
+
+			AsyncAutosaveChartResult autosaveResult = autosaveChartFuture.get();
+			autosaveSnapshot = std::move(autosaveResult.Snapshot);
+			performance.LastAutosaveSerializeDuration = autosaveResult.SerializeDuration;
+
+			if (deleteAutosaveFilesOnceWritten)
+				InternalDeleteAutosaveFiles();
+		}
+
+		const i32 autosaveIntervalSec = *Settings.General.AutosaveIntervalSec;
+		if (autosaveIntervalSec <= 0 || autosaveIntervalStopwatch.GetElapsed() < Time::FromSec(autosaveIntervalSec))
+			return;
+		autosaveIntervalStopwatch.Restart();
+
+		// NOTE: Undoing and redoing doesn't count towards the number of changes made but does still move commands between the two stacks
+		const b8 changesWereMadeSinceLastAutosave =
+			(context.Undo.NumberOfChangesMade != lastAutosaveNumberOfChangesMade) ||
+			(context.Undo.UndoStack.size() != lastAutosaveUndoStackSize) ||
+			(context.Undo.RedoStack.size() != lastAutosaveRedoStackSize);
+		if (!context.Undo.HasPendingChanges || !changesWereMadeSinceLastAutosave || importChartFuture.valid())
+			return;
+
+		lastAutosaveNumberOfChangesMade = context.Undo.NumberOfChangesMade;
+		lastAutosaveUndoStackSize = context.Undo.UndoStack.size();
+		lastAutosaveRedoStackSize = context.Undo.RedoStack.size();
+
+		std::string autosaveFilePath = GetAutosaveFilePath(context.ChartFilePath);
+		if (!lastAutosaveFilePath.empty() && lastAutosaveFilePath != autosaveFilePath)
+			File::Delete(lastAutosaveFilePath);
+		lastAutosaveFilePath = autosaveFilePath;
+
+		const CPUStopwatch snapshotStopwatch = CPUStopwatch::StartNew();
+		CopyChartProjectForExport(context.Chart, *autosaveSnapshot);
+		performance.LastAutosaveSnapshotDuration = snapshotStopwatch.GetElapsed();
+
+		autosaveChartFuture = std::async(std::launch::async, [snapshot = std::move(autosaveSnapshot), autosaveFilePath = std::move(autosaveFilePath), chartFilePath = context.ChartFilePath]() mutable -> AsyncAutosaveChartResult
+		{
+			const CPUStopwatch serializeStopwatch = CPUStopwatch::StartNew();
+			AsyncAutosaveChartResult result {};
+			result.AutosaveFilePath = std::move(autosaveFilePath);
+
+			TJA::ParsedTJA tja;
+			ConvertChartProjectToTJA(*snapshot, tja);
+
+			// NOTE: Only point to the autosave file after it has been fully written
+			const std::string recoveryFileContent = std::string(result.AutosaveFilePath).append("\n").append(chartFilePath);
+			result.Succeeded = TJA::WriteParsedToTextFile(tja, result.AutosaveFilePath, TJA::Encoding::UTF8) && File::WriteAllBytesAtomic(AutosaveRecoveryFileName, recoveryFileContent);
+			if (!result.Succeeded)
+				printf("Failed to write file '%.*s'\n", FmtStrViewArgs(result.AutosaveFilePath));
+
+			result.Snapshot = std::move(snapshot);
+			result.SerializeDuration = serializeStopwatch.GetElapsed();
+			return result;
+		});
+	}
+
+	void ChartEditor::InternalDeleteAutosaveFiles()
+	{
+		if (autosaveChartFuture.valid() && !autosaveChartFuture._Is_ready())
+		{
+			deleteAutosaveFilesOnceWritten = true;
+		}
+		else
+		{
+			if (autosaveChartFuture.valid())
+				autosaveSnapshot = autosaveChartFuture.get().Snapshot;
+
+			// NOTE: Only ever delete the recovery file together with an autosave file from this session, so an unanswered recovery popup won't lose it
+			if (!lastAutosaveFilePath.empty())
+			{
+				File::Delete(lastAutosaveFilePath);
+				File::Delete(AutosaveRecoveryFileName);
+				lastAutosaveFilePath.clear();
+			}
+			deleteAutosaveFilesOnceWritten = false;
+		}
+
+		lastAutosaveNumberOfChangesMade = -1;
+		autosaveIntervalStopwatch.Restart();
+	}
 }
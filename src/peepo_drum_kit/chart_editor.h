@@ -8,6 +8,8 @@
 #include "chart_editor_timeline.h"
 #include "imgui/imgui_include.h"
 #include "audio/audio_engine.h"
+#include "audio/audio_decode_cache.h"
+#include <atomic>
 
 #include "test_gui_audio.h"
 #include "test_gui_tja.h"
@@ -18,22 +20,36 @@ namespace PeepoDrumKit
 	{
 		std::string ChartFilePath;
 		ChartProject Chart;
+		b8 CreateBackupOfOriginalFile;
 
 		struct TJATempData
 		{
 			std::string FileContentUTF8;
-			std::vector<std::string_view> Lines;
 			std::vector<TJA::Token> Tokens;
 			TJA::ParsedTJA Parsed;
 			TJA::ErrorList ParseErrors;
 		} TJA;
 	};
 
-	struct AsyncLoadSongResult
+	// NOTE: Shared with the song loading worker, which decodes the song block by block straight into a streaming audio engine source.
+	//		 The source is handed over to the context as soon as its first block has been published and is then filled in (along with the waveform) over the next frames
+	struct AsyncLoadSongStream
 	{
 		std::string SongFilePath;
-		Audio::PCMSampleBuffer SampleBuffer;
-		Audio::WaveformMipChain WaveformL, WaveformR;
+		// NOTE: Written before starting the worker, so that the song cache entry is always written for the same quality the song was decoded with
+		Audio::ResamplerQuality ResamplerQuality = Audio::DefaultResamplerQuality;
+		// NOTE: Written by the worker before publishing the first block
+		Audio::SourceHandle Source = Audio::SourceHandle::Invalid;
+		// NOTE: Also written before publishing the first block, only when loaded from the song cache with the coarse waveform mips already generated
+		b8 HasCachedWaveform = false;
+		Audio::WaveformMipChain CachedWaveformL, CachedWaveformR;
+		std::atomic<b8> FirstBlockPublished = false;
+		std::atomic<b8> CancelRequested = false;
+		// NOTE: Written by the worker before returning, only set once the song has been decoded in its entirety
+		b8 ShouldWriteSongCacheEntry = false;
+		Audio::DecodeCacheKey SongCacheKey = {};
+		// NOTE: Only accessed by the main thread
+		b8 HasBeenHandedOver = false;
 	};
 
 	struct AsyncLoadJacketResult
@@ -41,6 +57,27 @@ namespace PeepoDrumKit
 		std::string JacketFilePath;
 	};
 
+	struct AsyncSaveChartRequest
+	{
+		std::string ChartFilePath;
+		ChartProject Chart;
+		b8 CreateBackupOfOriginalFile;
+	};
+
+	struct AsyncSaveChartResult
+	{
+		std::string ChartFilePath;
+		b8 Succeeded;
+	};
+
+	struct AsyncAutosaveChartResult
+	{
+		std::unique_ptr<ChartProject> Snapshot;
+		std::string AutosaveFilePath;
+		Time SerializeDuration;
+		b8 Succeeded;
+	};
+
 	struct ChartEditor
 	{
 	public:
@@ -62,9 +99,16 @@ namespace PeepoDrumKit
 		b8 OpenChartSaveAsDialog(ChartContext& context);
 		b8 TrySaveChartOrOpenSaveAsDialog(ChartContext& context);
 
-		void StartAsyncImportingChartFile(std::string_view absoluteChartFilePath);
+		void StartAsyncImportingChartFile(std::string_view absoluteChartFilePath, b8 isRecoveringAutosave = false);
 		void StartAsyncLoadingSongAudioFile(std::string_view absoluteAudioFilePath);
+		void CancelAsyncLoadingSongAudioFile();
+		// NOTE: Writes the fully loaded context song (and its waveform) to the song cache, which has to be cancelled before the song is unloaded
+		void StartAsyncWritingSongCacheEntry(const Audio::DecodeCacheKey& cacheKey, Audio::ResamplerQuality resamplerQuality);
+		void CancelAsyncWritingSongCacheEntry();
 		void StartAsyncLoadingSongJacketFile(std::string_view absoluteJacketFilePath);
+		void StartAsyncSavingChartFile(std::unique_ptr<AsyncSaveChartRequest> request);
+		// NOTE: Returns false if any of the saves waited on failed to write its file
+		b8 WaitForAsyncSavingToFinish();
 		void SetAndStartLoadingChartSongFileName(std::string_view relativeOrAbsoluteAudioFilePath, Undo::UndoHistory& undo);
 		void SetAndStartLoadingSongJacketFileName(std::string_view relativeOrAbsoluteAudioFilePath, Undo::UndoHistory& undo);
 
@@ -74,6 +118,10 @@ namespace PeepoDrumKit
 
 		void CheckOpenSaveConfirmationPopupThenCall(std::function<void()> onSuccess);
 		void InternalUpdateAsyncLoading();
+		// NOTE: Returns false if a save has just finished but failed to write its file
+		b8 InternalUpdateAsyncSaving();
+		void InternalUpdateAutosave();
+		void InternalDeleteAutosaveFiles();
 
 	private:
 		ChartContext context = {};
@@ -81,8 +129,27 @@ namespace PeepoDrumKit
 		ChartGamePreview gamePreview = {};
 
 		std::future<AsyncImportChartResult> importChartFuture {};
-		std::future<AsyncLoadSongResult> loadSongFuture {};
+		std::future<void> loadSongFuture {};
+		// NOTE: Outlives the worker, only released again once its future has been waited on
+		std::unique_ptr<AsyncLoadSongStream> loadSongStream {};
+		// NOTE: Separate from the loading worker so that neither cancelling a load nor starting the next one ever has to wait for an entire cache write
+		std::future<void> writeSongCacheFuture {};
+		std::atomic<b8> writeSongCacheCancelRequested = false;
 		std::future<AsyncLoadJacketResult> loadJacketFuture {};
+		std::future<AsyncSaveChartResult> saveChartFuture {};
+		// NOTE: Saves issued while another one is still in flight are queued up in order, with those to the same file coalesced
+		//		 so that only the most recent snapshot of each file is written out
+		std::vector<std::unique_ptr<AsyncSaveChartRequest>> pendingSaveChartRequests {};
+		std::future<AsyncAutosaveChartResult> autosaveChartFuture {};
+		// NOTE: Handed to the autosave worker while in flight and then returned, so that each snapshot mostly copies into existing allocations
+		std::unique_ptr<ChartProject> autosaveSnapshot = std::make_unique<ChartProject>();
+		CPUStopwatch autosaveIntervalStopwatch = CPUStopwatch::StartNew();
+		std::string lastAutosaveFilePath;
+		// NOTE: Set instead of blocking on an autosave that is still being written, which would otherwise recreate the files right after
+		b8 deleteAutosaveFilesOnceWritten = false;
+		i32 lastAutosaveNumberOfChangesMade = -1;
+		size_t lastAutosaveUndoStackSize = 0;
+		size_t lastAutosaveRedoStackSize = 0;
 		CPUStopwatch loadSongStopwatch = {};
 		b8 createBackupOfOriginalTJABeforeOverwriteSave = false;
 		b8 wasAudioEngineRunningIdleOnFocusLost = false;
@@ -121,12 +188,28 @@ namespace PeepoDrumKit
 			std::function<void()> OnSuccessFunction;
 		} saveConfirmationPopup = {};
 
+		struct AutosaveRecoveryPopupData
+		{
+			b8 OpenOnNextFrame;
+			b8 IsRecoveringImport;
+			std::string AutosaveFilePath;
+			std::string OriginalChartFilePath;
+		} autosaveRecoveryPopup = {};
+
+		struct SaveFailedPopupData
+		{
+			b8 OpenOnNextFrame;
+			std::string ChartFilePath;
+		} saveFailedPopup = {};
+
 		struct PerformanceData
 		{
 			b8 ShowOverlay;
 			f32 FrameTimesMS[256];
 			size_t FrameTimeIndex;
 			size_t FrameTimeCount;
+			Time LastAutosaveSnapshotDuration;
+			Time LastAutosaveSerializeDuration;
 		} performance = {};
 	};
 }
@@ -142,6 +142,7 @@ namespace PeepoDrumKit
 		inline void SetCursorTime(Time newTime)
 		{
 			SongVoice.SetPosition(newTime - Chart.SongOffset);
+			SfxVoicePool.PauseAllFutureVoices();
 			CursorNonSmoothTimeThisFrame = CursorNonSmoothTimeLastFrame = newTime;
 			CursorBeatWhilePaused = ChartSelectedCourse->TempoMap.TimeToBeat(newTime);
 			CursorTimeOnPlaybackStart = newTime;
@@ -151,6 +152,7 @@ namespace PeepoDrumKit
 		{
 			const Time newTime = ChartSelectedCourse->TempoMap.BeatToTime(newBeat);
 			SongVoice.SetPosition(newTime - Chart.SongOffset);
+			SfxVoicePool.PauseAllFutureVoices();
 			CursorNonSmoothTimeThisFrame = CursorNonSmoothTimeLastFrame = newTime;
 			CursorBeatWhilePaused = newBeat;
 			CursorTimeOnPlaybackStart = newTime;
@@ -167,6 +167,18 @@ X("PROMPT_MSGBOX_UNSAVED_SAVE_CHANGES",				"Save changes to the current file?")
 X("ACT_MSGBOX_UNSAVED_SAVE_CHANGES",				"Save Changes") \
 X("ACT_MSGBOX_UNSAVED_DISCARD_CHANGES",				"Discard Changes") \
 X("ACT_MSGBOX_CANCEL",								"Cancel") \
+/* autosave recovery message box */ \
+X("INFO_MSGBOX_AUTOSAVE_RECOVERY",					"Peepo Drum Kit - Autosave Recovery") \
+X("PROMPT_MSGBOX_AUTOSAVE_RECOVERY",				"Recover unsaved changes from the last session?") \
+X("ACT_MSGBOX_AUTOSAVE_RECOVER",					"Recover") \
+X("ACT_MSGBOX_AUTOSAVE_DISCARD",					"Discard") \
+/* save failed message box */ \
+X("INFO_MSGBOX_SAVE_FAILED",						"Peepo Drum Kit - Save Failed") \
+X("PROMPT_MSGBOX_SAVE_FAILED",						"Failed to write the chart file, your changes have not been saved.") \
+X("ACT_MSGBOX_SAVE_FAILED_RETRY",					"Retry") \
+/* latency menu (contd.) */ \
+X("INFO_LATENCY_AUTOSAVE",							"Autosave: ") \
+X("INFO_LATENCY_WAVEFORM",							"Waveform: ") \
 /* chart events tab / timeline tab */ \
 X("DETAILS_CHART_EVENT_EVENTS",						"Events") \
 X("EVENT_TEMPO",									"Tempo") \
@@ -298,6 +310,10 @@ X("NOTE_TYPE_ADLIB",								"Adlib") \
 X("NOTE_TYPE_FUSEROLL",								"Fuseroll") \
 /* language tab (contd) */ \
 X("ACT_LANGUAGE_LOAD_FULL_CJKV_GLYPHS",				"Load Full CJKV Glyphs (slow)") \
+/* settings window */ \
+X("AUDIO_RESAMPLER_QUALITY_LOW",					"Low (Fastest)") \
+X("AUDIO_RESAMPLER_QUALITY_MEDIUM",					"Medium") \
+X("AUDIO_RESAMPLER_QUALITY_HIGH",					"High (Slowest)") \
 /* empty last line */
 
 
@@ -410,3 +426,18 @@ namespace PeepoDrumKit::i18n
 		return buffer;
 	}
 }
+
+namespace PeepoDrumKit
+{
+	static inline std::string GetStyleName(i32 style, i32 playerSide)
+	{
+		if (style == 1)
+			return UI_Str("PLAYER_SIDE_STYLE_SINGLE");
+		char buf[32];
+		std::string res = (style == 2) ? UI_Str("PLAYER_SIDE_STYLE_DOUBLE")
+			: std::string(buf, sprintf_s(buf, UI_Str("PLAYER_SIDE_STYLE_FMT_%d_STYLE"), style));
+		std::string_view strPlaySide (buf, sprintf_s(buf, UI_Str("PLAYER_SIDE_PLAYER_FMT_%d_PLAYER"), playerSide));
+		res += " ("; res += strPlaySide; res += ")";
+		return res;
+	}
+}
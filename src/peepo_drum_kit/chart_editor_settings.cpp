@@ -470,12 +470,15 @@ namespace PeepoDrumKit
 			X(General.TransformScale_KeepTimePosition, "transform_scale_keep_time_position");
 			X(General.TransformScale_KeepTimeSignature, "transform_scale_keep_time_signature");
 			X(General.TransformScale_KeepItemDuration, "transform_scale_keep_item_duration");
+			X(General.AutosaveIntervalSec, "autosave_interval_sec");
 
 			SECTION("audio");
 			X(Audio.OpenDeviceOnStartup, "open_device_on_startup");
 			X(Audio.CloseDeviceOnIdleFocusLoss, "close_device_on_idle_focus_loss");
 			X(Audio.RequestExclusiveDeviceAccess, "request_exclusive_device_access");
 			X(Audio.BufferFrameSize, "buffer_frame_size");
+			X(Audio.SongCacheSizeMB, "song_cache_size_mb");
+			X(Audio.ResamplerQuality, "resampler_quality");
 
 			SECTION("animation");
 			X(Animation.EnableGuiScaleAnimation, "enable_gui_scale_animation");
@@ -3,6 +3,7 @@
 #include "core_beat.h"
 #include "core_string.h"
 #include "imgui/imgui_include.h"
+#include "audio/audio_resampler.h"
 
 namespace PeepoDrumKit
 {
@@ -150,6 +151,7 @@ namespace PeepoDrumKit
 			WithDefault<b8> TransformScale_KeepTimePosition = false;
 			WithDefault<b8> TransformScale_KeepTimeSignature = false;
 			WithDefault<b8> TransformScale_KeepItemDuration = false;
+			WithDefault<i32> AutosaveIntervalSec = 60;
 			// TODO: ...
 			static inline WithDefault<vec2> GameViewportAspectRatioMin = vec2(0.0f, 0.0f);
 			static inline WithDefault<vec2> GameViewportAspectRatioMax = vec2(0.0f, 0.0f);
@@ -161,6 +163,9 @@ namespace PeepoDrumKit
 			WithDefault<b8> CloseDeviceOnIdleFocusLoss = false;
 			WithDefault<b8> RequestExclusiveDeviceAccess = false;
 			WithDefault<i32> BufferFrameSize = 0;
+			WithDefault<i32> SongCacheSizeMB = 2048;
+			// NOTE: Index of an Audio::ResamplerQuality, only applied to songs loaded afterwards
+			WithDefault<i32> ResamplerQuality = static_cast<i32>(Audio::DefaultResamplerQuality);
 		} Audio;
 
 		struct AnimationData
@@ -1,4 +1,5 @@
 ﻿#include "chart_editor_settings_gui.h"
+#include "chart_editor_i18n.h"
 
 namespace PeepoDrumKit
 {
@@ -140,7 +141,7 @@ namespace PeepoDrumKit
 			Default,
 			B8_ChartSongSpaceComboBox, B8_ExclusiveAudioComboBox, I32_BarDivisionComboBox,
 			F32_TimelineScrollSensitivity, F32_ExponentialSpeed,
-			I32_AudioBufferFrameSize,
+			I32_AudioBufferFrameSize, I32_ResamplerQualityComboBox,
 		};
 
 		struct SettingsEntry
@@ -242,6 +243,24 @@ namespace PeepoDrumKit
 						if (changesWereMade)
 							inOutI32->Value = std::clamp(inOutI32->Value, 0, i32{ Audio::Engine.MaxBufferFrameCount });
 					}
+					else if (in.Widget == WidgetType::I32_ResamplerQualityComboBox)
+					{
+						const cstr qualityNames[] = { UI_Str("AUDIO_RESAMPLER_QUALITY_LOW"), UI_Str("AUDIO_RESAMPLER_QUALITY_MEDIUM"), UI_Str("AUDIO_RESAMPLER_QUALITY_HIGH"), };
+						static_assert(ArrayCount(qualityNames) == EnumCount<Audio::ResamplerQuality>);
+
+						const i32 currentIndex = Clamp(inOutI32->Value, 0, EnumCountI32<Audio::ResamplerQuality> - 1);
+						if (Gui::BeginCombo("##", qualityNames[currentIndex], ImGuiComboFlags_None))
+						{
+							for (i32 i = 0; i < EnumCountI32<Audio::ResamplerQuality>; i++)
+							{
+								const b8 isSelected = (i == currentIndex);
+								if (Gui::Selectable(qualityNames[i], isSelected)) { inOutI32->Value = i; changesWereMade = true; }
+								if (isSelected) { Gui::SetItemDefaultFocus(); }
+								if (i == inOutI32->Default) { Gui::SameLine(); GuiRightAlignedTextDisabled("(Default)"); }
+							}
+							Gui::EndCombo();
+						}
+					}
 					else
 					{
 						changesWereMade |= Gui::InputInt("##", &inOutI32->Value, 1, 10);
@@ -727,6 +746,11 @@ namespace PeepoDrumKit
 							"The timeline distance moved per mouse wheel scroll tick while holding down shift.",
 							SettingsGui::WidgetType::F32_TimelineScrollSensitivity),
 
+						SettingsGui::SettingsEntry(
+							settings.General.AutosaveIntervalSec,
+							"General: Autosave Interval (Seconds)",
+							"How often unsaved changes are written to a separate \".autosave.tja\" file next to the chart, to be recovered after a crash. Zero disables autosaving."),
+
 						SettingsGui::SettingsEntry(settings.Animation.EnableGuiScaleAnimation,
 							"Animation: Smooth UI Zoom",
 							"Smoothly animate between UI zoom levels."),
@@ -903,6 +927,19 @@ namespace PeepoDrumKit
 							"Prevent audio distortion by requesting sufficient buffer size (adding audio latency).\n"
 							"The minimum resulting size is the minimum possible size reported by the device.",
 							SettingsGui::WidgetType::I32_AudioBufferFrameSize),
+
+						SettingsGui::SettingsEntry(
+							settings.Audio.SongCacheSizeMB,
+							"Song Cache Size (MB)",
+							"Decoded songs and their waveforms are kept inside a local \"audio_cache\" directory so that they load much faster the next time.\n"
+							"The least recently used ones are deleted once over this size. Zero disables the cache."),
+
+						SettingsGui::SettingsEntry(
+							settings.Audio.ResamplerQuality,
+							"Resampler Quality",
+							"Filter quality used when songs have to be converted to the sample rate of the audio device.\n"
+							"Higher quality takes longer to decode. Only applies to songs loaded afterwards.",
+							SettingsGui::WidgetType::I32_ResamplerQualityComboBox),
 					};
 
 					changesWereMade |= SettingsGui::DrawEntriesListTableGui(settingsEntriesAudio, ArrayCount(settingsEntriesAudio), nullptr, lastActiveGroup);
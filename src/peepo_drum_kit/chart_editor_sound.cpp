@@ -15,14 +15,14 @@ namespace PeepoDrumKit
 				const std::string_view inFilePath = SoundEffectTypeFilePaths[i];
 				auto& resultBuffer = result.SampleBuffers[i];
 
-				auto[fileContent, fileSize] = File::ReadAllBytes(inFilePath);
-				if (fileContent == nullptr || fileSize == 0)
+				File::MappedView fileView;
+				if (!fileView.Open(inFilePath) || fileView.Size() == 0)
 				{
 					printf("Failed to read file '%.*s'\n", FmtStrViewArgs(inFilePath));
 					continue;
 				}
 
-				if (Audio::DecodeEntireFile(inFilePath, fileContent.get(), fileSize, resultBuffer) != Audio::DecodeFileResult::FeelsGoodMan)
+				if (Audio::DecodeEntireFile(inFilePath, fileView.Data(), fileView.Size(), resultBuffer) != Audio::DecodeFileResult::FeelsGoodMan)
 				{
 					printf("Failed to decode audio file '%.*s'\n", FmtStrViewArgs(inFilePath));
 					continue;
@@ -30,7 +30,7 @@ namespace PeepoDrumKit
 
 				// HACK: ...
 				if (resultBuffer.SampleRate != Audio::Engine.OutputSampleRate)
-					Audio::LinearlyResampleBuffer<i16>(resultBuffer.InterleavedSamples, resultBuffer.FrameCount, resultBuffer.SampleRate, resultBuffer.ChannelCount, Audio::Engine.OutputSampleRate);
+					Audio::ResampleBuffer(resultBuffer.InterleavedSamples, resultBuffer.FrameCount, resultBuffer.SampleRate, resultBuffer.ChannelCount, Audio::Engine.OutputSampleRate);
 			}
 			return result;
 		});
@@ -96,8 +96,19 @@ namespace PeepoDrumKit
 		}
 	}
 
+	void SoundEffectsVoicePool::ScheduleSound(SoundEffectType type, Audio::Voice clockVoice, Time clockVoicePosition, f32 pan)
+	{
+		Audio::Engine.EnsureStreamRunning();
+		const b8 isMetronome = (type >= SoundEffectType::MetronomeBar);
+		const SoundGroup soundGroup = isMetronome ? SoundGroup::Metronome : SoundGroup::SoundEffects;
+		const b8 audible = (GetSoundGroupVolume(soundGroup) != 0) && (GetSoundGroupVolume(SoundGroup::Master) != 0);
+		if (audible)
+			Audio::Engine.ScheduleOneShotSound(TryGetSourceForType(type), clockVoice, clockVoicePosition, 1.0f, pan, EnumToIndex(soundGroup));
+	}
+
 	void SoundEffectsVoicePool::PauseAllFutureVoices()
 	{
+		Audio::Engine.ClearScheduledOneShotSounds();
 		for (auto& voice : VoicePool)
 		{
 			if (voice.GetIsPlaying() && voice.GetPosition() < Time::Zero())
@@ -45,6 +45,7 @@ namespace PeepoDrumKit
 		void UnloadAllSourcesAndVoices();
 
 		void PlaySound(SoundEffectType type, Time startTime = Time::Zero(), std::optional<Time> externalClock = {}, f32 pan = 0);
+		void ScheduleSound(SoundEffectType type, Audio::Voice clockVoice, Time clockVoicePosition, f32 pan = 0);
 		void PauseAllFutureVoices();
 		Audio::SourceHandle TryGetSourceForType(SoundEffectType type) const;
 
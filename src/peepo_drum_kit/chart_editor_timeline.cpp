@@ -335,6 +335,16 @@ namespace PeepoDrumKit
 			context.SfxVoicePool.PlaySound(SoundEffectType::TaikoKa, startTime, externalClock, pan);
 	}
 
+	// NOTE: Started by the audio render callback at the exact sample the song voice reaches the note time
+	static void ScheduleSoundEffectTypeForNoteType(ChartContext& context, NoteType noteType, Time noteTime, f32 pan = 0)
+	{
+		const Time songVoicePosition = (noteTime - context.Chart.SongOffset);
+		if (!IsKaNote(noteType))
+			context.SfxVoicePool.ScheduleSound(SoundEffectType::TaikoDon, context.SongVoice, songVoicePosition, pan);
+		if (IsKaNote(noteType) || IsKaDonNote(noteType))
+			context.SfxVoicePool.ScheduleSound(SoundEffectType::TaikoKa, context.SongVoice, songVoicePosition, pan);
+	}
+
 	static b8 IsTimelineCursorVisibleOnScreen(const TimelineCamera& camera, const TimelineRegions& regions, const Time cursorTime, const f32 edgePixelThreshold = 0.0f)
 	{
 		assert(edgePixelThreshold >= 0.0f);
@@ -535,18 +545,152 @@ namespace PeepoDrumKit
 		DrawTimelineRectBaseWithStartEndTriangles(drawList, DrawTimelineRectBaseParam{ tl, br, 1.0f, 1.0f, selected ? TimelineJPOSScrollBackgroundColorBorderSelected : TimelineJPOSScrollBackgroundColorBorder, TimelineJPOSScrollBackgroundColorOuter, TimelineJPOSScrollBackgroundColorInner, selected });
 	}
 
-	static void DrawTimelineContentWaveform(const ChartTimeline& timeline, ImDrawList* drawList, Time chartSongOffset, const Audio::WaveformMipChain& waveformL, const Audio::WaveformMipChain& waveformR, f32 waveformAnimation)
+	Time TimelineWaveformChunkCache::QuantizeTimePerPixel(Time timePerPixel)
+	{
+		if (timePerPixel.Seconds <= 0.0)
+			return timePerPixel;
+		return Time::FromSec(::exp2(::round(::log2(timePerPixel.Seconds) * 64.0) / 64.0));
+	}
+
+	void TimelineWaveformChunkCache::ComputeChunk(const Audio::WaveformMipChain& waveform, const Audio::WaveformMip& mip, Time timePerPixel, i64 chunkIndex, CustomDraw::WaveformChunk& outChunk, const Audio::PCMSampleBuffer* sourceBuffer, u32 sourceChannelIndex)
+	{
+		// NOTE: Otherwise each base mip bucket would be stretched across multiple pixels
+		const b8 readSourceSamples = (sourceBuffer != nullptr && &mip == &waveform.AllMips[0] && timePerPixel < mip.TimePerSample) &&
+			(sourceBuffer->InterleavedSamples != nullptr && sourceChannelIndex < sourceBuffer->ChannelCount && sourceBuffer->FrameCount == waveform.SourceFrameCount);
+
+		const i64 firstPixel = (chunkIndex * CustomDraw::WaveformPixelsPerChunk);
+		for (i32 chunkPixel = 0; chunkPixel < CustomDraw::WaveformPixelsPerChunk; chunkPixel++)
+		{
+			const Time timeAtPixel = timePerPixel * static_cast<f64>(firstPixel + chunkPixel);
+			const b8 outOfBounds = (timeAtPixel < Time::Zero() || (timeAtPixel > waveform.Duration));
+			if (outOfBounds)
+				outChunk.PerPixelAmplitude[chunkPixel] = OutOfBoundsAmplitude;
+			else if (readSourceSamples)
+				outChunk.PerPixelAmplitude[chunkPixel] = waveform.GetSourceAmplitudeAt(*sourceBuffer, sourceChannelIndex, timeAtPixel, timePerPixel);
+			else
+				outChunk.PerPixelAmplitude[chunkPixel] = waveform.GetAmplitudeAt(mip, timeAtPixel, timePerPixel);
+		}
+	}
+
+	void TimelineWaveformChunkCache::Invalidate()
+	{
+		Waveform = nullptr;
+		Mip = nullptr;
+		SourceBuffer = nullptr;
+		SourceChannelIndex = 0;
+		TimePerPixel = {};
+		Chunks.clear();
+	}
+
+	void TimelineWaveformChunkCache::BeginFrame(const Audio::WaveformMipChain& waveform, Time quantizedTimePerPixel, const Audio::PCMSampleBuffer* sourceBuffer, u32 sourceChannelIndex)
+	{
+		const Audio::WaveformMip* mip = &waveform.FindClosestMip(quantizedTimePerPixel);
+		if (Waveform != &waveform || Mip != mip || SourceBuffer != sourceBuffer || SourceChannelIndex != sourceChannelIndex || TimePerPixel != quantizedTimePerPixel)
+		{
+			Chunks.clear();
+			Waveform = &waveform;
+			Mip = mip;
+			SourceBuffer = sourceBuffer;
+			SourceChannelIndex = sourceChannelIndex;
+			TimePerPixel = quantizedTimePerPixel;
+		}
+		FrameIndex++;
+		ChunksComputedThisFrame = 0;
+	}
+
+	const CustomDraw::WaveformChunk& TimelineWaveformChunkCache::GetChunk(i64 chunkIndex)
+	{
+		assert(Waveform != nullptr && Mip != nullptr);
+		const size_t generatedBucketCount = Mip->GeneratedBucketCount;
+
+		CachedChunk* chunk = nullptr;
+		for (CachedChunk& it : Chunks)
+		{
+			if (it.ChunkIndex == chunkIndex) { chunk = &it; break; }
+		}
+
+		if (chunk != nullptr)
+		{
+			// NOTE: Still up to date if all buckets read by the last pixel had already been generated (or nothing new has been generated since).
+		//		 Source samples are only read from up to the generated base mip buckets, so the same applies to those
+			const f64 chunkEndBucket = Ceil(GetChunkStartTime(chunkIndex + 1, TimePerPixel).Seconds * Mip->SamplesPerSecond);
+			const size_t requiredBucketCount = static_cast<size_t>(Clamp(chunkEndBucket, 0.0, static_cast<f64>(Mip->BucketCount)));
+			if (chunk->MipGeneratedBucketCount == generatedBucketCount || chunk->MipGeneratedBucketCount >= requiredBucketCount)
+			{
+				chunk->LastUsedFrame = FrameIndex;
+				return chunk->Amplitudes;
+			}
+		}
+		else if (Chunks.size() < MaxCachedChunks)
+		{
+			chunk = &Chunks.emplace_back();
+		}
+		else
+		{
+			// NOTE: Evicting the least recently used chunk, unless all of them are visible this frame in which case there simply is no upper limit
+			chunk = &Chunks[0];
+			for (CachedChunk& it : Chunks)
+			{
+				if (it.LastUsedFrame < chunk->LastUsedFrame)
+					chunk = &it;
+			}
+			if (chunk->LastUsedFrame == FrameIndex)
+				chunk = &Chunks.emplace_back();
+		}
+
+		chunk->ChunkIndex = chunkIndex;
+		chunk->LastUsedFrame = FrameIndex;
+		chunk->MipGeneratedBucketCount = generatedBucketCount;
+		ComputeChunk(*Waveform, *Mip, TimePerPixel, chunkIndex, chunk->Amplitudes, SourceBuffer, SourceChannelIndex);
+		ChunksComputedThisFrame++;
+		return chunk->Amplitudes;
+	}
+
+	// NOTE: Shared by the content and scrollbar waveforms, with the caller providing the local space x position of a song time
+	template <typename SongTimeToLocalSpaceXFunc>
+	static void DrawCachedWaveformChunks(ImDrawList* drawList, TimelineWaveformChunkCache& cache, const Audio::WaveformMipChain& waveform, const Audio::PCMSampleBuffer* sourceBuffer, u32 sourceChannelIndex,
+		Time timePerPixel, Time visibleSongTimeStart, Time visibleSongTimeEnd, vec2 screenSpaceOrigin, f32 height, u32 color, f32 amplitudeScale, f32 minAmplitude, SongTimeToLocalSpaceXFunc songTimeToLocalSpaceX)
+	{
+		const Time chunkTimePerPixel = TimelineWaveformChunkCache::QuantizeTimePerPixel(timePerPixel);
+		if (chunkTimePerPixel.Seconds <= 0.0)
+			return;
+
+		cache.BeginFrame(waveform, chunkTimePerPixel, sourceBuffer, sourceChannelIndex);
+
+		// NOTE: Chunks entirely outside the song would only contain out of bounds pixels anyway
+		const i64 firstChunkIndex = Max(TimelineWaveformChunkCache::GetChunkIndexAtTime(visibleSongTimeStart, chunkTimePerPixel), static_cast<i64>(0));
+		const i64 lastChunkIndex = Min(TimelineWaveformChunkCache::GetChunkIndexAtTime(visibleSongTimeEnd, chunkTimePerPixel), TimelineWaveformChunkCache::GetChunkIndexAtTime(waveform.Duration, chunkTimePerPixel));
+
+		for (i64 chunkIndex = firstChunkIndex; chunkIndex <= lastChunkIndex; chunkIndex++)
+		{
+			const CustomDraw::WaveformChunk& cachedChunk = cache.GetChunk(chunkIndex);
+
+			CustomDraw::WaveformChunk chunk;
+			for (i32 chunkPixel = 0; chunkPixel < CustomDraw::WaveformPixelsPerChunk; chunkPixel++)
+			{
+				const f32 amplitude = cachedChunk.PerPixelAmplitude[chunkPixel];
+				chunk.PerPixelAmplitude[chunkPixel] = (amplitude == TimelineWaveformChunkCache::OutOfBoundsAmplitude) ? 0.0f : (amplitudeScale * ClampBot(amplitude, minAmplitude));
+			}
+
+			// NOTE: Stretched by the difference between the quantized and the actual time per pixel
+			const f32 chunkStartX = songTimeToLocalSpaceX(TimelineWaveformChunkCache::GetChunkStartTime(chunkIndex + 0, chunkTimePerPixel));
+			const f32 chunkEndX = songTimeToLocalSpaceX(TimelineWaveformChunkCache::GetChunkStartTime(chunkIndex + 1, chunkTimePerPixel));
+			const Rect chunkRect = Rect::FromTLSize(screenSpaceOrigin + vec2(chunkStartX, 0.5f), vec2(chunkEndX - chunkStartX, height));
+			CustomDraw::DrawWaveformChunk(drawList, chunkRect, color, chunk);
+		}
+	}
+
+	static void DrawTimelineContentWaveform(const ChartTimeline& timeline, ImDrawList* drawList, Time chartSongOffset, const Audio::WaveformMipChain& waveformL, const Audio::WaveformMipChain& waveformR, const Audio::PCMSampleBuffer* songSampleBuffer, f32 waveformAnimation, TimelineWaveformChunkCache (&caches)[2])
 	{
 		const f32 waveformAnimationScale = Clamp(waveformAnimation, 0.0f, 1.0f);
 		const f32 waveformAnimationAlpha = (waveformAnimationScale * waveformAnimationScale);
 		const u32 waveformColor = Gui::ColorU32WithAlpha(TimelineWaveformBaseColor, waveformAnimationAlpha * 0.215f * (waveformR.IsEmpty() ? 2.0f : 1.0f));
 
-		const Time waveformTimePerPixel = timeline.Camera.LocalSpaceXToTime(1.0f) - timeline.Camera.LocalSpaceXToTime(0.0f);
-		const Time waveformDuration = waveformL.Duration;
+		const Time waveformTimePerPixel = timeline.Camera.TimePerScreenPixel();
+		const Time visibleSongTimeStart = timeline.Camera.LocalSpaceXToTime(0.0f) - chartSongOffset;
+		const Time visibleSongTimeEnd = timeline.Camera.LocalSpaceXToTime(timeline.Regions.Content.GetWidth()) - chartSongOffset;
 
-		const Rect contentRect = timeline.Regions.Content;
 		const f32 rowsHeight = GetTotalTimelineRowsHeight(timeline);
-
 		const f32 minAmplitude = (2.0f / rowsHeight);
 		for (size_t waveformIndex = 0; waveformIndex < 2; waveformIndex++)
 		{
@@ -554,23 +698,9 @@ namespace PeepoDrumKit
 			if (waveform.IsEmpty())
 				continue;
 
-			const auto& waveformMip = waveform.FindClosestMip(waveformTimePerPixel);
-			for (i32 visiblePixel = 0; visiblePixel < contentRect.GetWidth(); /*visiblePixel++*/)
-			{
-				CustomDraw::WaveformChunk chunk;
-				const Rect chunkRect = Rect::FromTLSize(timeline.LocalToScreenSpace(vec2(static_cast<f32>(visiblePixel), 0.5f)), vec2(static_cast<f32>(CustomDraw::WaveformPixelsPerChunk), rowsHeight));
-
-				for (i32 chunkPixel = 0; chunkPixel < CustomDraw::WaveformPixelsPerChunk; chunkPixel++)
-				{
-					const Time timeAtPixel = timeline.Camera.LocalSpaceXToTime(static_cast<f32>(visiblePixel)) - chartSongOffset;
-					const b8 outOfBounds = (timeAtPixel < Time::Zero() || (timeAtPixel > waveformDuration));
-
-					chunk.PerPixelAmplitude[chunkPixel] = outOfBounds ? 0.0f : (waveformAnimationScale * ClampBot(waveform.GetAmplitudeAt(waveformMip, timeAtPixel, waveformTimePerPixel), minAmplitude));
-					visiblePixel++;
-				}
-
-				CustomDraw::DrawWaveformChunk(drawList, chunkRect, waveformColor, chunk);
-			}
+			DrawCachedWaveformChunks(drawList, caches[waveformIndex], waveform, songSampleBuffer, static_cast<u32>(waveformIndex), waveformTimePerPixel, visibleSongTimeStart, visibleSongTimeEnd,
+				timeline.LocalToScreenSpace(vec2(0.0f)), rowsHeight, waveformColor, waveformAnimationScale, minAmplitude,
+				[&](Time songTime) { return timeline.Camera.TimeToLocalSpaceX(songTime + chartSongOffset); });
 		}
 	}
 
@@ -602,10 +732,16 @@ namespace PeepoDrumKit
 			// TODO: It looks like there'll also have to be one scroll speed lane per branch type
 			//		 which means the scroll speed change line should probably extend all to the way down to its corresponding note lane (?)
 
-			for (const Note& it : list)
+			static constexpr BranchType branchForThisRow = TimelineRowToBranchType(RowType);
+			const NoteTimingTable& timings = context.ChartSelectedCourse->GetNoteTimings(branchForThisRow);
+			assert(timings.size() == list.size());
+
+			const auto[firstIndex, lastIndex] = timings.FindPossiblyOverlappingIndexRange(visibleTime.Min, visibleTime.Max);
+			for (size_t i = firstIndex; i < lastIndex; i++)
 			{
-				const Time startTime = context.BeatToTime(it.GetStart()) + it.TimeOffset;
-				const Time endTime = (it.BeatDuration > Beat::Zero()) ? context.BeatToTime(it.GetEnd()) + it.TimeOffset : startTime;
+				const Note& it = list[i];
+				const Time startTime = timings.HeadTimes[i];
+				const Time endTime = timings.TailTimes[i];
 				if (endTime < visibleTime.Min || startTime > visibleTime.Max)
 					continue;
 
@@ -639,7 +775,6 @@ namespace PeepoDrumKit
 				}
 			}
 
-			static constexpr BranchType branchForThisRow = TimelineRowToBranchType(RowType);
 			if (!timeline.TempDeletedNoteAnimationsBuffer.empty())
 			{
 				for (const auto& data : timeline.TempDeletedNoteAnimationsBuffer)
@@ -818,7 +953,7 @@ namespace PeepoDrumKit
 		return Clamp(TimeToScrollbarLocalSpaceX(time, regions, chartDuration), 1.0f, regions.ContentScrollbarX.GetWidth() - 2.0f);
 	}
 
-	static void DrawTimelineScrollbarXWaveform(const ChartTimeline& timeline, ImDrawList* drawList, Time chartSongOffset, Time chartDuration, const Audio::WaveformMipChain& waveformL, const Audio::WaveformMipChain& waveformR, f32 waveformAnimation)
+	static void DrawTimelineScrollbarXWaveform(const ChartTimeline& timeline, ImDrawList* drawList, Time chartSongOffset, Time chartDuration, const Audio::WaveformMipChain& waveformL, const Audio::WaveformMipChain& waveformR, f32 waveformAnimation, TimelineWaveformChunkCache (&caches)[2])
 	{
 		assert(!waveformL.IsEmpty());
 		const f32 waveformAnimationScale = Clamp(waveformAnimation, 0.0f, 1.0f);
@@ -826,11 +961,10 @@ namespace PeepoDrumKit
 		const u32 waveformColor = Gui::ColorU32WithAlpha(TimelineWaveformBaseColor, waveformAnimationAlpha * 0.5f * (waveformR.IsEmpty() ? 2.0f : 1.0f));
 
 		const Time waveformTimePerPixel = Time::FromSec(chartDuration.ToSec() / ClampBot(timeline.Regions.ContentScrollbarX.GetWidth(), 1.0f));
-		const Time waveformDuration = waveformL.Duration;
-
-		const Rect scrollbarRect = timeline.Regions.ContentScrollbarX;
-		const f32 scrollbarHeight = scrollbarRect.GetHeight();
+		const Time visibleSongTimeStart = Time::Zero() - chartSongOffset;
+		const Time visibleSongTimeEnd = chartDuration - chartSongOffset;
 
+		const f32 scrollbarHeight = timeline.Regions.ContentScrollbarX.GetHeight();
 		const f32 minAmplitude = (2.0f / scrollbarHeight);
 		for (size_t waveformIndex = 0; waveformIndex < 2; waveformIndex++)
 		{
@@ -838,23 +972,9 @@ namespace PeepoDrumKit
 			if (waveform.IsEmpty())
 				continue;
 
-			const auto& waveformMip = waveform.FindClosestMip(waveformTimePerPixel);
-			for (i32 visiblePixel = 0; visiblePixel < scrollbarRect.GetWidth(); /*visiblePixel++*/)
-			{
-				CustomDraw::WaveformChunk chunk;
-				const Rect chunkRect = Rect::FromTLSize(timeline.LocalToScreenSpace_ScrollbarX(vec2(static_cast<f32>(visiblePixel), 0.5f)), vec2(static_cast<f32>(CustomDraw::WaveformPixelsPerChunk), scrollbarHeight));
-
-				for (i32 chunkPixel = 0; chunkPixel < CustomDraw::WaveformPixelsPerChunk; chunkPixel++)
-				{
-					const Time timeAtPixel = (waveformTimePerPixel * static_cast<f64>(visiblePixel)) - chartSongOffset;
-					const b8 outOfBounds = (timeAtPixel < Time::Zero() || (timeAtPixel > waveformDuration));
-
-					chunk.PerPixelAmplitude[chunkPixel] = outOfBounds ? 0.0f : (waveformAnimationScale * ClampBot(waveform.GetAmplitudeAt(waveformMip, timeAtPixel, waveformTimePerPixel), minAmplitude));
-					visiblePixel++;
-				}
-
-				CustomDraw::DrawWaveformChunk(drawList, chunkRect, waveformColor, chunk);
-			}
+			DrawCachedWaveformChunks(drawList, caches[waveformIndex], waveform, nullptr, 0, waveformTimePerPixel, visibleSongTimeStart, visibleSongTimeEnd,
+				timeline.LocalToScreenSpace_ScrollbarX(vec2(0.0f)), scrollbarHeight, waveformColor, waveformAnimationScale, minAmplitude,
+				[&](Time songTime) { return TimeToScrollbarLocalSpaceX(songTime + chartSongOffset, timeline.Regions, chartDuration); });
 		}
 	}
 
@@ -864,14 +984,17 @@ namespace PeepoDrumKit
 		const f32 localNoteCenterY = timeline.Regions.ContentScrollbarX.GetHeight() * /*0.5f*//*0.75f*/0.25f;
 
 		// TODO: Also draw other timeline items... tempo / signature changes, gogo-time etc. (?)
-		for (const Note& note : course.GetNotes(branch))
+		const SortedNotesList& notes = course.GetNotes(branch);
+		const NoteTimingTable& timings = course.GetNoteTimings(branch);
+		for (size_t i = 0; i < notes.size(); i++)
 		{
-			const f32 localHeadX = TimeToScrollbarLocalSpaceX(course.TempoMap.BeatToTime(note.GetStart()) + note.TimeOffset, timeline.Regions, chartDuration);
+			const Note& note = notes[i];
+			const f32 localHeadX = TimeToScrollbarLocalSpaceX(timings.HeadTimes[i], timeline.Regions, chartDuration);
 			Rect screenNoteRect = Rect::FromCenterSize(timeline.LocalToScreenSpace_ScrollbarX(vec2(localHeadX, localNoteCenterY)), localNoteRectSize);
 
 			if (note.BeatDuration > Beat::Zero())
 			{
-				const f32 localTailX = TimeToScrollbarLocalSpaceX(course.TempoMap.BeatToTime(note.GetEnd()) + note.TimeOffset, timeline.Regions, chartDuration);
+				const f32 localTailX = TimeToScrollbarLocalSpaceX(timings.TailTimes[i], timeline.Regions, chartDuration);
 				screenNoteRect.BR.x += (localTailX - localHeadX);
 			}
 
@@ -880,62 +1003,22 @@ namespace PeepoDrumKit
 		}
 	}
 
-	static void UpdateTimelinePlaybackAndMetronomneSounds(ChartContext& context, b8 playbackSoundsEnabled, ChartTimeline::MetronomeData& metronome)
+	static void UpdateTimelinePlaybackHitSounds(ChartContext& context, b8 playbackSoundsEnabled, ChartTimeline::PlaybackSoundsData& playbackSounds)
 	{
-		static constexpr Time frameTimeThresholdAtWhichPlayingSoundsMakesNoSense = Time::FromMS(250.0);
-		static constexpr Time playbackSoundFutureOffset = Time::FromSec(1.0 / 25.0);
-
-		Time& nonSmoothCursorThisFrame = context.CursorNonSmoothTimeThisFrame;
-		Time& nonSmoothCursorLastFrame = context.CursorNonSmoothTimeLastFrame;
-
-		nonSmoothCursorLastFrame = nonSmoothCursorThisFrame;
-		nonSmoothCursorThisFrame = (context.SongVoice.GetPosition() + context.Chart.SongOffset);
+		// NOTE: In real time, covering even a long stalled frame. Sounds that still end up being late are then dropped by the render callback
+		static constexpr Time hitSoundScheduleAheadTime = Time::FromMS(500.0);
 
-		const Time elapsedCursorTimeSinceLastUpdate = (nonSmoothCursorLastFrame - nonSmoothCursorThisFrame);
-		if (elapsedCursorTimeSinceLastUpdate >= frameTimeThresholdAtWhichPlayingSoundsMakesNoSense)
+		if (!playbackSoundsEnabled)
+		{
+			if (playbackSounds.HasScheduled)
+				Audio::Engine.ClearScheduledOneShotSounds();
+			playbackSounds.HasScheduled = false;
 			return;
+		}
 
-		const Time futureOffset = (playbackSoundFutureOffset * Min(context.SongVoice.GetPlaybackSpeed(), 1.0f));
-
-		if (playbackSoundsEnabled)
+		const Beat drumrollHitInterval = GetGridBeatSnap(*Settings.General.DrumrollAutoHitBarDivision);
+		auto forEachComparedLane = [&](auto perLaneFunc)
 		{
-			auto checkAndPlayNoteSound = [&](Time noteTime, NoteType noteType, f32 pan)
-			{
-				const Time offsetNoteTime = noteTime - futureOffset;
-				if (offsetNoteTime >= nonSmoothCursorLastFrame && offsetNoteTime < nonSmoothCursorThisFrame)
-				{
-					// NOTE: Don't wanna cause any audio cutoffs. If this happens the future threshold is either set too low for the current frame time
-					//		 or playback was started on top of an existing note
-					const Time startTime = Min((nonSmoothCursorThisFrame - noteTime), Time::Zero());
-					const Time externalClock = noteTime;
-
-					PlaySoundEffectTypeForNoteType(context, noteType, startTime, externalClock, pan);
-				}
-			};
-
-			auto handleNotePlayback = [&](const ChartCourse* course, BranchType branch, const Note& note, i32 nLanes, i32 iLane)
-			{
-				f32 pan = (nLanes <= 1) ? 0 : 2.0 * iLane / (nLanes - 1) - 1;
-				if (note.BeatDuration > Beat::Zero())
-				{
-					if (IsBalloonNote(note.Type))
-					{
-						for (i32 iPop = 0; iPop < note.BalloonPopCount; ++iPop)
-							checkAndPlayNoteSound(course->TempoMap.BeatToTime(ConvertRange(0, i32{ note.BalloonPopCount }, note.BeatTime, note.GetEnd(), iPop)) + note.TimeOffset, note.Type, pan);
-					}
-					else
-					{
-						const Beat drummrollBeatInterval = GetGridBeatSnap(*Settings.General.DrumrollAutoHitBarDivision);
-						for (Beat subBeat = Beat::Zero(); subBeat <= note.BeatDuration; subBeat += drummrollBeatInterval)
-							checkAndPlayNoteSound(course->TempoMap.BeatToTime(note.BeatTime + subBeat) + note.TimeOffset, note.Type, pan);
-					}
-				}
-				else
-				{
-					checkAndPlayNoteSound(course->TempoMap.BeatToTime(note.BeatTime) + note.TimeOffset, note.Type, pan);
-				}
-			};
-
 			const i32 nLanes = size(context.ChartsCompared);
 			i32 iLane = -1;
 			for (auto it = cbegin(context.Chart.Courses); it != cend(context.Chart.Courses); ++it) {
@@ -943,14 +1026,90 @@ namespace PeepoDrumKit
 				auto branch = BranchType::Normal;
 				if (!context.IsChartCompared(course, branch))
 					continue;
-				const b8 isFocusedLane = (context.CompareMode && course == context.ChartSelectedCourse && branch == context.ChartSelectedBranch);
 				++iLane;
 
-				for (const Note& note : course->GetNotes(branch))
-					handleNotePlayback(course, branch, note, nLanes, iLane);
+				const f32 pan = (nLanes <= 1) ? 0 : 2.0 * iLane / (nLanes - 1) - 1;
+				perLaneFunc(course, course->GetHitSoundSchedule(branch, drumrollHitInterval), pan);
 			}
+		};
+
+		// NOTE: Pausing and seeking discard all scheduled sounds (through the engine), while editing the chart or changing which lanes are compared
+		//		 only shows up as a different set of (versioned) hit sound schedules
+		b8 scheduleChanged = !playbackSounds.HasScheduled ||
+			(playbackSounds.EngineScheduleGeneration != Audio::Engine.GetScheduledOneShotSoundGeneration()) ||
+			(playbackSounds.SongOffset != context.Chart.SongOffset) ||
+			(playbackSounds.DrumrollHitInterval != drumrollHitInterval);
+
+		size_t laneCount = 0;
+		forEachComparedLane([&](const ChartCourse* course, const NoteHitSoundSchedule& schedule, f32 pan)
+		{
+			const ChartTimeline::PlaybackSoundsData::ScheduledLane lane = { course, schedule.Version };
+			if (laneCount >= playbackSounds.Lanes.size())
+			{
+				playbackSounds.Lanes.push_back(lane);
+				scheduleChanged = true;
+			}
+			else if (playbackSounds.Lanes[laneCount].Course != lane.Course || playbackSounds.Lanes[laneCount].ScheduleVersion != lane.ScheduleVersion)
+			{
+				playbackSounds.Lanes[laneCount] = lane;
+				scheduleChanged = true;
+			}
+			laneCount++;
+		});
+		if (laneCount != playbackSounds.Lanes.size())
+		{
+			playbackSounds.Lanes.resize(laneCount);
+			scheduleChanged = true;
 		}
 
+		const Time cursorTime = context.CursorNonSmoothTimeThisFrame;
+		if (scheduleChanged)
+		{
+			Audio::Engine.ClearScheduledOneShotSounds();
+			playbackSounds.HasScheduled = true;
+			playbackSounds.EngineScheduleGeneration = Audio::Engine.GetScheduledOneShotSoundGeneration();
+			playbackSounds.ScheduledUntilTime = cursorTime;
+			playbackSounds.SongOffset = context.Chart.SongOffset;
+			playbackSounds.DrumrollHitInterval = drumrollHitInterval;
+		}
+
+		// NOTE: Continuing from where the previous update left off, unless the cursor has already moved past it (after a frame stalled for longer than the look ahead)
+		const Time scheduleStartTime = Max(playbackSounds.ScheduledUntilTime, cursorTime);
+		const Time scheduleEndTime = cursorTime + (hitSoundScheduleAheadTime * context.SongVoice.GetPlaybackSpeed());
+		if (scheduleEndTime <= scheduleStartTime)
+			return;
+
+		forEachComparedLane([&](const ChartCourse* course, const NoteHitSoundSchedule& schedule, f32 pan)
+		{
+			// NOTE: Only visits the hit sounds (including all drumroll / balloon sub hits) that haven't been scheduled yet
+			schedule.ForEachEventInRange(scheduleStartTime, scheduleEndTime, [&](const NoteHitSoundEvent& hit)
+			{
+				ScheduleSoundEffectTypeForNoteType(context, hit.Type, hit.Time, pan);
+			});
+		});
+		playbackSounds.ScheduledUntilTime = scheduleEndTime;
+	}
+
+	static void UpdateTimelinePlaybackAndMetronomneSounds(ChartContext& context, b8 playbackSoundsEnabled, ChartTimeline::PlaybackSoundsData& playbackSounds, ChartTimeline::MetronomeData& metronome)
+	{
+		static constexpr Time frameTimeThresholdAtWhichPlayingSoundsMakesNoSense = Time::FromMS(250.0);
+		static constexpr Time playbackSoundFutureOffset = Time::FromSec(1.0 / 25.0);
+
+		Time& nonSmoothCursorThisFrame = context.CursorNonSmoothTimeThisFrame;
+		Time& nonSmoothCursorLastFrame = context.CursorNonSmoothTimeLastFrame;
+
+		nonSmoothCursorLastFrame = nonSmoothCursorThisFrame;
+		nonSmoothCursorThisFrame = (context.SongVoice.GetPosition() + context.Chart.SongOffset);
+
+		// NOTE: Independent of the frame rate, unlike the metronome below which is still started directly
+		UpdateTimelinePlaybackHitSounds(context, playbackSoundsEnabled, playbackSounds);
+
+		const Time elapsedCursorTimeSinceLastUpdate = (nonSmoothCursorLastFrame - nonSmoothCursorThisFrame);
+		if (elapsedCursorTimeSinceLastUpdate >= frameTimeThresholdAtWhichPlayingSoundsMakesNoSense)
+			return;
+
+		const Time futureOffset = (playbackSoundFutureOffset * Min(context.SongVoice.GetPlaybackSpeed(), 1.0f));
+
 		if (metronome.IsEnabled)
 		{
 			if (nonSmoothCursorLastFrame != metronome.LastProvidedNonSmoothCursorTime)
@@ -998,8 +1157,15 @@ namespace PeepoDrumKit
 		}
 	}
 
+	void ChartTimeline::InvalidateWaveformCaches()
+	{
+		for (TimelineWaveformChunkCache& cache : ContentWaveformCache) cache.Invalidate();
+		for (TimelineWaveformChunkCache& cache : ScrollbarWaveformCache) cache.Invalidate();
+	}
+
 	void ChartTimeline::DrawGui(ChartContext& context)
 	{
+		WaveformDrawDuration = Time::Zero();
 		UpdateInputAtStartOfFrame(context);
 		UpdateAllAnimationsAfterUserInput(context);
 
@@ -1124,7 +1290,11 @@ namespace PeepoDrumKit
 					const b8 isPlayback = context.GetIsPlayback();
 
 					if (!context.SongWaveformL.IsEmpty())
-						DrawTimelineScrollbarXWaveform(*this, Gui::GetWindowDrawList(), context.Chart.SongOffset, chartDuration, context.SongWaveformL, context.SongWaveformR, context.SongWaveformFadeAnimationCurrent);
+					{
+						CPUStopwatch waveformStopwatch = CPUStopwatch::StartNew();
+						DrawTimelineScrollbarXWaveform(*this, Gui::GetWindowDrawList(), context.Chart.SongOffset, chartDuration, context.SongWaveformL, context.SongWaveformR, context.SongWaveformFadeAnimationCurrent, ScrollbarWaveformCache);
+						WaveformDrawDuration += waveformStopwatch.Stop();
+					}
 
 					DrawTimelineScrollbarXMinimap(*this, Gui::GetWindowDrawList(), *context.ChartSelectedCourse, context.ChartSelectedBranch, chartDuration);
 
@@ -3001,9 +3171,9 @@ namespace PeepoDrumKit
 				context.SfxVoicePool.PlaySound(SoundEffectType::MetronomeBeat);
 		}
 
-		// NOTE: Playback preview sounds / metronome
-		if (context.GetIsPlayback() && (PlaybackSoundsEnabled || Metronome.IsEnabled))
-			UpdateTimelinePlaybackAndMetronomneSounds(context, PlaybackSoundsEnabled, Metronome);
+		// NOTE: Playback preview sounds / metronome, also while both are disabled so that any hit sounds that have already been scheduled can be discarded
+		if (context.GetIsPlayback())
+			UpdateTimelinePlaybackAndMetronomneSounds(context, PlaybackSoundsEnabled, PlaybackSounds, Metronome);
 
 		// NOTE: Mouse selection box
 		{
@@ -3330,7 +3500,11 @@ namespace PeepoDrumKit
 
 		// NOTE: Background waveform
 		if (TimelineWaveformDrawOrder == WaveformDrawOrder::Background && !context.SongWaveformL.IsEmpty())
-			DrawTimelineContentWaveform(*this, DrawListContent, context.Chart.SongOffset, context.SongWaveformL, context.SongWaveformR, context.SongWaveformFadeAnimationCurrent);
+		{
+			CPUStopwatch waveformStopwatch = CPUStopwatch::StartNew();
+			DrawTimelineContentWaveform(*this, DrawListContent, context.Chart.SongOffset, context.SongWaveformL, context.SongWaveformR, Audio::Engine.GetSourceSampleBufferView(context.SongSource), context.SongWaveformFadeAnimationCurrent, ContentWaveformCache);
+			WaveformDrawDuration += waveformStopwatch.Stop();
+		}
 
 		// NOTE: Row labels, lines and items
 		{
@@ -3388,7 +3562,11 @@ namespace PeepoDrumKit
 
 		// NOTE: Background waveform overlay
 		if (TimelineWaveformDrawOrder == WaveformDrawOrder::Foreground && !context.SongWaveformL.IsEmpty())
-			DrawTimelineContentWaveform(*this, DrawListContent, context.Chart.SongOffset, context.SongWaveformL, context.SongWaveformR, context.SongWaveformFadeAnimationCurrent);
+		{
+			CPUStopwatch waveformStopwatch = CPUStopwatch::StartNew();
+			DrawTimelineContentWaveform(*this, DrawListContent, context.Chart.SongOffset, context.SongWaveformL, context.SongWaveformR, Audio::Engine.GetSourceSampleBufferView(context.SongSource), context.SongWaveformFadeAnimationCurrent, ContentWaveformCache);
+			WaveformDrawDuration += waveformStopwatch.Stop();
+		}
 
 		// NOTE: Cursor foreground
 		{
@@ -193,6 +193,48 @@ namespace PeepoDrumKit
 		inline TransformActionParam& SetTimeRatio(const ivec2& ratio) { return SetTimeRatio(ratio[0], ratio[1]); }
 	};
 
+	// NOTE: Per pixel waveform amplitudes of fixed size chunks, aligned to a pixel grid starting at the song start and using a quantized time per pixel.
+	//		 Scrolling therefore only ever needs to compute the newly exposed chunks, while zooming to a different quantum or reloading the song invalidates everything.
+	//		 Chunks computed while the song was still being decoded are recomputed once more of the mip they were sampled from has been generated
+	struct TimelineWaveformChunkCache
+	{
+		static constexpr size_t MaxCachedChunks = 48;
+		// NOTE: Stored in place of the amplitude of pixels outside the song, to differentiate them from silence
+		static constexpr f32 OutOfBoundsAmplitude = -1.0f;
+
+		struct CachedChunk
+		{
+			i64 ChunkIndex;
+			u64 LastUsedFrame;
+			size_t MipGeneratedBucketCount;
+			CustomDraw::WaveformChunk Amplitudes;
+		};
+
+		const Audio::WaveformMipChain* Waveform = nullptr;
+		const Audio::WaveformMip* Mip = nullptr;
+		// NOTE: Optional, read from directly when zoomed in further than the base mip
+		const Audio::PCMSampleBuffer* SourceBuffer = nullptr;
+		u32 SourceChannelIndex = 0;
+		Time TimePerPixel = {};
+		u64 FrameIndex = 0;
+		i32 ChunksComputedThisFrame = 0;
+		std::vector<CachedChunk> Chunks;
+
+		// NOTE: In 1/64th octave steps, which is small enough for the stretched chunks to be indistinguishable from exact ones
+		static Time QuantizeTimePerPixel(Time timePerPixel);
+		static Time GetChunkStartTime(i64 chunkIndex, Time timePerPixel) { return timePerPixel * static_cast<f64>(chunkIndex * CustomDraw::WaveformPixelsPerChunk); }
+		static i64 GetChunkIndexAtTime(Time songTime, Time timePerPixel) { return static_cast<i64>(Floor(songTime.Seconds / (timePerPixel.Seconds * CustomDraw::WaveformPixelsPerChunk))); }
+
+		// NOTE: The uncached path, with the pixel at index i covering the song time range [i * timePerPixel, (i + 1) * timePerPixel).
+		//		 Reads the samples of the source buffer (if any) the waveform has been generated from when zoomed in further than its base mip
+		static void ComputeChunk(const Audio::WaveformMipChain& waveform, const Audio::WaveformMip& mip, Time timePerPixel, i64 chunkIndex, CustomDraw::WaveformChunk& outChunk, const Audio::PCMSampleBuffer* sourceBuffer = nullptr, u32 sourceChannelIndex = 0);
+
+		void Invalidate();
+		// NOTE: Must be called once per frame before getting any chunks, invalidating the cache if the waveform, its source buffer or the quantized time per pixel has changed
+		void BeginFrame(const Audio::WaveformMipChain& waveform, Time quantizedTimePerPixel, const Audio::PCMSampleBuffer* sourceBuffer = nullptr, u32 sourceChannelIndex = 0);
+		const CustomDraw::WaveformChunk& GetChunk(i64 chunkIndex);
+	};
+
 	struct ChartTimeline
 	{
 		TimelineCamera Camera = []() { TimelineCamera out {}; out.PositionCurrent.x = out.PositionTarget.x = TimelineCameraBaseScrollX; return out; }();
@@ -272,6 +314,20 @@ namespace PeepoDrumKit
 		f32 GridSnapLineAnimationCurrent = 1.0f;
 
 		b8 PlaybackSoundsEnabled = true;
+		// NOTE: Hit sounds are scheduled well ahead of the song voice and then started by the render callback at their exact sample,
+		//		 so that neither a low nor an uneven frame rate can delay or skip them. Anything that changes which sounds have to be played
+		//		 discards those already scheduled, starting over from the cursor
+		struct PlaybackSoundsData
+		{
+			struct ScheduledLane { const ChartCourse* Course; u32 ScheduleVersion; };
+			std::vector<ScheduledLane> Lanes;
+			b8 HasScheduled = false;
+			u32 EngineScheduleGeneration = 0;
+			Time ScheduledUntilTime = {};
+			Time SongOffset = {};
+			Beat DrumrollHitInterval = {};
+		} PlaybackSounds = {};
+
 		struct MetronomeData
 		{
 			b8 IsEnabled = false;
@@ -287,6 +343,12 @@ namespace PeepoDrumKit
 		struct TempDrawSelectionBox { Rect ScreenSpaceRect; u32 FillColor, BorderColor; };
 		std::vector<TempDrawSelectionBox> TempSelectionBoxesDrawBuffer;
 
+		// NOTE: Left and right channel each
+		TimelineWaveformChunkCache ContentWaveformCache[2];
+		TimelineWaveformChunkCache ScrollbarWaveformCache[2];
+		// NOTE: Accumulated across the scrollbar and content waveforms and reset at the start of each frame
+		Time WaveformDrawDuration = {};
+
 	public:
 		inline b8 HasKeyboardFocus() const { return IsAnyChildWindowFocused; }
 
@@ -315,6 +377,7 @@ namespace PeepoDrumKit
 		}
 
 		void DrawGui(ChartContext& context);
+		void InvalidateWaveformCaches();
 
 		void StartEndRangeSelectionAtCursor(ChartContext& context);
 		void PlayNoteSoundAndHitAnimationsAtBeat(ChartContext& context, Beat cursorBeat);
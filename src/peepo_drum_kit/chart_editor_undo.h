@@ -80,11 +80,14 @@ namespace PeepoDrumKit
 		constexpr std::string_view ActionPrefixUpdate = "Update ";
 		constexpr std::string_view ActionPrefixUpdateAll = "Update All ";
 
+		// NOTE: The first modified beat is only used to limit rebuilding the tempo map acceleration structure (which time signatures don't affect)
 		template <typename TEvent>
-		static void RefreshChart(ChartCourse* Course, ChartCourseListType<TEvent>* Map)
+		static void RefreshChart(ChartCourse* Course, ChartCourseListType<TEvent>* Map, Beat firstModifiedBeat = Beat::Zero())
 		{
-			if constexpr (TempoMapMemberPointer<TEvent> != nullptr) { Map->RebuildAccelerationStructure(); Course->RecalculateSENotes(); }
-			else if constexpr (expect_type_v<TEvent, Note>) { Course->RecalculateSENotes(); }
+			Course->NotifyEventListsModified();
+			if constexpr (expect_type_v<TEvent, TempoChange>) { Map->RebuildAccelerationStructureFromBeat(firstModifiedBeat); Course->RecalculateSENotes(); }
+			else if constexpr (TempoMapMemberPointer<TEvent> != nullptr) { Course->RecalculateSENotes(); }
+			else if constexpr (expect_type_v<TEvent, Note> || expect_type_v<TEvent, ScrollChange> || expect_type_v<TEvent, ScrollType> || expect_type_v<TEvent, BarLineChange>) { Course->RecalculateSENotes(); }
 		}
 
 		template <typename TEvent>
@@ -100,12 +103,12 @@ namespace PeepoDrumKit
 					GetEventList<EventList>(*Map).InsertOrUpdate(ReplacedValue.value());
 				else
 					GetEventList<EventList>(*Map).RemoveAtBeat(GetBeat(NewValue));
-				RefreshChart<TEvent>(Course, Map);
+				RefreshChart<TEvent>(Course, Map, GetBeat(NewValue));
 			}
 			void Redo() override
 			{
 				GetEventList<EventList>(*Map).InsertOrFunc(NewValue, [&](TEvent& v, ...) { ReplacedValue = std::move(v); v = NewValue; }); // safe replace
-				RefreshChart<TEvent>(Course, Map);
+				RefreshChart<TEvent>(Course, Map, GetBeat(NewValue));
 			}
 
 			Undo::MergeResult TryMerge(Command& commandToMerge) override { return Undo::MergeResult::Failed; }
@@ -126,24 +129,23 @@ namespace PeepoDrumKit
 			constexpr static auto EventList = TempoMapMemberPointer<TEvent>;
 			AddMultipleChartEventsBase(ChartCourse* course, ChartCourseListType* map, std::vector<TEvent> newValues) : Course(course), Map(map)
 			{
+				// NOTE: Stable so that the last of multiple new events at the same beat still wins
+				std::stable_sort(newValues.begin(), newValues.end(), [](const TEvent& a, const TEvent& b) { return GetBeat(a) < GetBeat(b); });
 				for (const auto& event : newValues)
 					NewEvents.InsertOrUpdate(event); // merge new events
 			}
 
 			void Undo() override
 			{
-				for (const auto& event : NewEvents)
-					GetEventList<EventList>(*Map).RemoveAtBeat(GetBeat(event));
-				for (const auto& event : ReplacedEvents)
-					GetEventList<EventList>(*Map).InsertOrUpdate(event);
-				RefreshChart<TEvent>(Course, Map);
+				GetEventList<EventList>(*Map).RemoveSortedRangeAtBeats(NewEvents.data(), NewEvents.size());
+				GetEventList<EventList>(*Map).InsertSortedRange(ReplacedEvents.data(), ReplacedEvents.size());
+				RefreshChart<TEvent>(Course, Map, NewEvents.empty() ? Beat::Zero() : GetBeat(NewEvents[0]));
 			}
 			void Redo() override
 			{
 				ReplacedEvents.clear();
-				for (const auto& event : NewEvents)
-					GetEventList<EventList>(*Map).InsertOrFunc(event, [&](TEvent& v, ...) { ReplacedEvents.push_back(std::move(v)); v = event; }); // safe replace
-				RefreshChart<TEvent>(Course, Map);
+				GetEventList<EventList>(*Map).InsertSortedRangeOrFunc(NewEvents.data(), NewEvents.size(), [&](TEvent& v, const TEvent& event) { ReplacedEvents.push_back(std::move(v)); v = event; }); // safe replace
+				RefreshChart<TEvent>(Course, Map, NewEvents.empty() ? Beat::Zero() : GetBeat(NewEvents[0]));
 			}
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override { return Undo::MergeResult::Failed; }
@@ -165,8 +167,8 @@ namespace PeepoDrumKit
 			RemoveSingleChartEventBase(ChartCourse* course, ChartCourseListType* map, TEvent oldValue) : Course(course), Map(map), OldValue(oldValue) { }
 			RemoveSingleChartEventBase(ChartCourse* course, ChartCourseListType* map, Beat beat) : Course(course), Map(map), OldValue(*GetEventList<EventList>(*Map).TryFindExactAtBeat(beat)) { assert(GetBeat(OldValue) == beat); }
 
-			void Undo() override { GetEventList<EventList>(*Map).InsertOrUpdate(OldValue); RefreshChart<TEvent>(Course, Map); }
-			void Redo() override { GetEventList<EventList>(*Map).RemoveAtBeat(GetBeat(OldValue)); RefreshChart<TEvent>(Course, Map); }
+			void Undo() override { GetEventList<EventList>(*Map).InsertOrUpdate(OldValue); RefreshChart<TEvent>(Course, Map, GetBeat(OldValue)); }
+			void Redo() override { GetEventList<EventList>(*Map).RemoveAtBeat(GetBeat(OldValue)); RefreshChart<TEvent>(Course, Map, GetBeat(OldValue)); }
 
 			Undo::MergeResult TryMerge(Command& commandToMerge) override { return Undo::MergeResult::Failed; }
 			Undo::CommandInfo GetInfo() const override { return { ConstevalStrJoined<ActionPrefixRemove, DisplayNameOfChartEvent<TEvent>> }; }
@@ -183,18 +185,26 @@ namespace PeepoDrumKit
 		{
 			using ChartCourseListType = ChartCourseListType<TEvent>;
 			constexpr static auto EventList = TempoMapMemberPointer<TEvent>;
-			RemoveMultipleChartEventsBase(ChartCourse* course, ChartCourseListType* map, std::vector<TEvent> oldValues) : Course(course), Map(map), OldValues(std::move(oldValues)) { }
+			RemoveMultipleChartEventsBase(ChartCourse* course, ChartCourseListType* map, std::vector<TEvent> oldValues) : Course(course), Map(map), OldValues(std::move(oldValues))
+			{
+				// NOTE: Kept sorted by beat for the bulk insert / remove
+				std::stable_sort(OldValues.begin(), OldValues.end(), [](const TEvent& a, const TEvent& b) { return GetBeat(a) < GetBeat(b); });
+			}
 
 			void Undo() override
 			{
-				for (const auto& event : OldValues)
-					GetEventList<EventList>(*Map).InsertOrUpdate(event);
-				RefreshChart<TEvent>(Course, Map);
+				GetEventList<EventList>(*Map).InsertSortedRange(OldValues.data(), OldValues.size());
+				RefreshChart<TEvent>(Course, Map, OldValues.empty() ? Beat::Zero() : GetBeat(OldValues[0]));
 			}
 			void Redo() override
 			{
-				for (const TEvent& event : OldValues) GetEventList<EventList>(*Map).RemoveAtBeat(GetBeat(event));
-				RefreshChart<TEvent>(Course, Map);
+				GetEventList<EventList>(*Map).RemoveSortedRangeAtBeats(OldValues.data(), OldValues.size());
+				RefreshChart<TEvent>(Course, Map, OldValues.empty() ? Beat::Zero() : GetBeat(OldValues[0]));
+			}
+
+			void AddOldValueKeepSorted(TEvent oldValue)
+			{
+				OldValues.insert(std::upper_bound(OldValues.begin(), OldValues.end(), oldValue, [](const TEvent& a, const TEvent& b) { return GetBeat(a) < GetBeat(b); }), std::move(oldValue));
 			}
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override { return Undo::MergeResult::Failed; }
@@ -223,7 +233,7 @@ namespace PeepoDrumKit
 			void Redo() override
 			{
 				EventsToRemove.Redo();
-				GetEventList<EventList>(*Map).InsertOrFunc(NewValue, [&](TEvent& v, ...) { EventsToRemove.OldValues.push_back(std::move(v)); v = NewValue; }); // safe replace
+				GetEventList<EventList>(*Map).InsertOrFunc(NewValue, [&](TEvent& v, ...) { EventsToRemove.AddOldValueKeepSorted(std::move(v)); v = NewValue; }); // safe replace
 				RefreshChart<TEvent>(Course, Map);
 			}
 
@@ -245,8 +255,8 @@ namespace PeepoDrumKit
 			constexpr static auto EventList = TempoMapMemberPointer<TEvent>;
 			UpdateSingleChartEventBase(ChartCourse* course, ChartCourseListType* map, TEvent newValue) : Course(course), Map(map), NewValue(newValue), OldValue(*GetEventList<EventList>(*Map).TryFindExactAtBeat(GetBeat(newValue))) { assert(GetBeat(newValue) == GetBeat(OldValue)); }
 
-			void Undo() override { GetEventList<EventList>(*Map).InsertOrUpdate(OldValue); RefreshChart<TEvent>(Course, Map); }
-			void Redo() override { GetEventList<EventList>(*Map).InsertOrUpdate(NewValue); RefreshChart<TEvent>(Course, Map); }
+			void Undo() override { GetEventList<EventList>(*Map).InsertOrUpdate(OldValue); RefreshChart<TEvent>(Course, Map, GetBeat(OldValue)); }
+			void Redo() override { GetEventList<EventList>(*Map).InsertOrUpdate(NewValue); RefreshChart<TEvent>(Course, Map, GetBeat(NewValue)); }
 
 			Undo::MergeResult TryMerge(Command& commandToMerge) override
 			{
@@ -559,9 +569,11 @@ namespace PeepoDrumKit
 					NewData[static_cast<size_t>(data.List)].InsertOrUpdate(data); // merge new data
 					if (data.List == GenericList::TempoChanges)
 						UpdateTempoMap = true;
-					else if (IsNotesList(data.List))
+					else if (ListAffectsGameLane(data.List))
 						UpdateNotes = true;
 				}
+				if (UpdateTempoMap)
+					FirstModifiedTempoBeat = GetBeat(NewData[static_cast<size_t>(GenericList::TempoChanges)][0]);
 			}
 
 			void Undo() override
@@ -572,8 +584,9 @@ namespace PeepoDrumKit
 				}
 				for (const auto& data : ReplacedData)
 					TryAddOrReplaceGenericStruct(*Course, data.List, data.Value);
+				Course->NotifyEventListsModified();
 				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
+					Course->TempoMap.RebuildAccelerationStructureFromBeat(FirstModifiedTempoBeat);
 				if (UpdateTempoMap || UpdateNotes)
 					Course->RecalculateSENotes();
 			}
@@ -585,8 +598,9 @@ namespace PeepoDrumKit
 					for (const auto& data : list)
 						TryAddOrFuncGenericStruct(*Course, data.List, data.Value, [&](auto& v, auto&& vNew) { ReplacedData.emplace_back(data.List, std::move(v)); v = vNew; }); // safe replace
 				}
+				Course->NotifyEventListsModified();
 				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
+					Course->TempoMap.RebuildAccelerationStructureFromBeat(FirstModifiedTempoBeat);
 				if (UpdateTempoMap || UpdateNotes)
 					Course->RecalculateSENotes();
 			}
@@ -597,7 +611,8 @@ namespace PeepoDrumKit
 			ChartCourse* Course;
 			BeatSortedList<GenericListStructWithType> NewData[EnumCount<GenericList>];
 			std::vector<GenericListStructWithType> ReplacedData;
-			b8 UpdateTempoMap, UpdateNotes;
+			b8 UpdateTempoMap, UpdateNotes = false;
+			Beat FirstModifiedTempoBeat = Beat::Zero();
 		};
 
 		struct RemoveMultipleGenericItems : Undo::Command
@@ -607,8 +622,11 @@ namespace PeepoDrumKit
 				for (const auto& data : OldData)
 				{
 					if (data.List == GenericList::TempoChanges)
+					{
+						FirstModifiedTempoBeat = UpdateTempoMap ? Min(FirstModifiedTempoBeat, GetBeat(data)) : GetBeat(data);
 						UpdateTempoMap = true;
-					else if (IsNotesList(data.List))
+					}
+					else if (ListAffectsGameLane(data.List))
 						UpdateNotes = true;
 				}
 			}
@@ -617,8 +635,9 @@ namespace PeepoDrumKit
 			{
 				for (const auto& data : OldData)
 					TryAddOrReplaceGenericStruct(*Course, data.List, data.Value);
+				Course->NotifyEventListsModified();
 				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
+					Course->TempoMap.RebuildAccelerationStructureFromBeat(FirstModifiedTempoBeat);
 				if (UpdateTempoMap || UpdateNotes)
 					Course->RecalculateSENotes();
 			}
@@ -627,8 +646,9 @@ namespace PeepoDrumKit
 			{
 				for (const auto& data : OldData)
 					TryRemoveGenericStruct(*Course, data.List, data.Value);
+				Course->NotifyEventListsModified();
 				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
+					Course->TempoMap.RebuildAccelerationStructureFromBeat(FirstModifiedTempoBeat);
 				if (UpdateTempoMap || UpdateNotes)
 					Course->RecalculateSENotes();
 			}
@@ -638,7 +658,8 @@ namespace PeepoDrumKit
 
 			ChartCourse* Course;
 			std::vector<GenericListStructWithType> OldData;
-			b8 UpdateTempoMap, UpdateNotes;
+			b8 UpdateTempoMap, UpdateNotes = false;
+			Beat FirstModifiedTempoBeat = Beat::Zero();
 		};
 
 		struct AddMultipleGenericItems_Paste : AddMultipleGenericItems
@@ -683,8 +704,16 @@ namespace PeepoDrumKit
 					const b8 success = TryGet(*Course, data.List, data.Index, data.Member, data.OldValue);
 					assert(success);
 					if (data.List == GenericList::TempoChanges)
+					{
+						// NOTE: Include both the old and new beat of moved tempo changes
+						Beat modifiedBeat = Beat::Zero();
+						TryGet<GenericMember::Beat_Start>(*Course, data.List, data.Index, modifiedBeat);
+						if (data.Member == GenericMember::Beat_Start)
+							modifiedBeat = Min(modifiedBeat, data.NewValue.Beat);
+						FirstModifiedTempoBeat = UpdateTempoMap ? Min(FirstModifiedTempoBeat, modifiedBeat) : modifiedBeat;
 						UpdateTempoMap = true;
-					else if (IsNotesList(data.List))
+					}
+					else if (ListAffectsGameLane(data.List))
 						UpdateNotes = true;
 				}
 			}
@@ -693,8 +722,9 @@ namespace PeepoDrumKit
 			{
 				for (const auto& newData : NewData)
 					TrySet(*Course, newData.List, newData.Index, newData.Member, newData.OldValue);
+				Course->NotifyEventListsModified();
 				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
+					Course->TempoMap.RebuildAccelerationStructureFromBeat(FirstModifiedTempoBeat);
 				if (UpdateTempoMap || UpdateNotes)
 					Course->RecalculateSENotes();
 			}
@@ -703,8 +733,9 @@ namespace PeepoDrumKit
 			{
 				for (const auto& newData : NewData)
 					TrySet(*Course, newData.List, newData.Index, newData.Member, newData.NewValue);
+				Course->NotifyEventListsModified();
 				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
+					Course->TempoMap.RebuildAccelerationStructureFromBeat(FirstModifiedTempoBeat);
 				if (UpdateTempoMap || UpdateNotes)
 					Course->RecalculateSENotes();
 			}
@@ -728,6 +759,7 @@ namespace PeepoDrumKit
 
 				for (size_t i = 0; i < NewData.size(); i++)
 					NewData[i].NewValue = other->NewData[i].NewValue;
+				FirstModifiedTempoBeat = Min(FirstModifiedTempoBeat, other->FirstModifiedTempoBeat);
 
 				return Undo::MergeResult::ValueUpdated;
 			}
@@ -736,7 +768,8 @@ namespace PeepoDrumKit
 
 			ChartCourse* Course;
 			std::vector<Data> NewData;
-			b8 UpdateTempoMap, UpdateNotes;
+			b8 UpdateTempoMap, UpdateNotes = false;
+			Beat FirstModifiedTempoBeat = Beat::Zero();
 		};
 
 		struct ChangeMultipleGenericProperties_MoveItems : ChangeMultipleGenericProperties
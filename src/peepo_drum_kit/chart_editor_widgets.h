@@ -163,12 +163,12 @@ namespace PeepoDrumKit
 
 			f32 x = 0;
 			f32 y = 0;
-			Time jposTimeStamp = accelerationStructure.ConvertBeatToTimeUsingLookupTableIndexing(jposScrollChanges[0].BeatTime);
+			Time jposTimeStamp = accelerationStructure.ConvertBeatToTimeUsingSegmentBinarySearch(jposScrollChanges[0].BeatTime);
 			Time nextJposTimeStamp;
 			for (size_t i = 0; i < jposScrollChanges.size() && timeStamp >= jposTimeStamp; i++) {
 				JPOSScrollChange jposChange = jposScrollChanges[i];
 				nextJposTimeStamp = !(i + 1 < jposScrollChanges.size()) ? Time::FromSec(F32Max)
-					: accelerationStructure.ConvertBeatToTimeUsingLookupTableIndexing(jposScrollChanges[i + 1].BeatTime);
+					: accelerationStructure.ConvertBeatToTimeUsingSegmentBinarySearch(jposScrollChanges[i + 1].BeatTime);
 
 				Complex jposMove = jposChange.Move;
 				Time jposDuration = Time::FromSec(jposChange.Duration);
@@ -214,6 +214,17 @@ namespace PeepoDrumKit
 			);
 		}
 
+		// NOTE: Same as above but using the precalculated HBScroll beat tick of the lane point
+		vec2 GetNoteCoordinatesLane(vec2 originLane, Time cursorTime, f64 cursorHBScrollBeatTick, const GameLanePoint& point) const
+		{
+			Complex readaptedScrollSpeed = (point.ScrollType == ScrollMethod::BMSCROLL) ? Complex(1.f, 0.f) : point.ScrollSpeed;
+
+			return vec2(
+				originLane.x + TimeToLaneSpace(cursorTime, cursorHBScrollBeatTick, point.Time, point.HBScrollBeatTick, point.Tempo, readaptedScrollSpeed.GetRealPart(), point.ScrollType),
+				originLane.y + TimeToLaneSpace(cursorTime, cursorHBScrollBeatTick, point.Time, point.HBScrollBeatTick, point.Tempo, readaptedScrollSpeed.GetImaginaryPart(), point.ScrollType)
+			);
+		}
+
 		vec2 GetHitCircleCoordinatesScreen(const SortedJPOSScrollChangesList& jposScrollChanges, Time timeStamp, const TempoMapAccelerationStructure& accelerationStructure)
 		{
 			return LaneToScreenSpace(GetHitCircleCoordinatesLane(jposScrollChanges, timeStamp, accelerationStructure));
@@ -230,12 +241,26 @@ namespace PeepoDrumKit
 			ScrollMethod scrollType, 
 			const TempoMapAccelerationStructure& accelerationStructure
 		) const
+		{
+			const b8 usesHBScrollBeatTick = (scrollType == ScrollMethod::HBSCROLL || scrollType == ScrollMethod::BMSCROLL);
+			const f64 noteHBScrollBeatTick = usesHBScrollBeatTick ? accelerationStructure.ConvertBeatAndTimeToHBScrollBeatTickUsingSegmentBinarySearch(noteBeat, noteTime) : 0.0;
+			return TimeToLaneSpace(cursorTime, cursorHBScrollBeatTick, noteTime, noteHBScrollBeatTick, tempo, scrollSpeed, scrollType);
+		}
+
+		constexpr f32 TimeToLaneSpace(
+			Time cursorTime,
+			f64 cursorHBScrollBeatTick,
+			Time noteTime,
+			f64 noteHBScrollBeatTick,
+			Tempo tempo,
+			f32 scrollSpeed,
+			ScrollMethod scrollType
+		) const
 		{
 			switch (scrollType) {
 				case (ScrollMethod::HBSCROLL):
 				case (ScrollMethod::BMSCROLL):
 				{
-					f64 noteHBScrollBeatTick = accelerationStructure.ConvertBeatAndTimeToHBScrollBeatTickUsingLookupTableIndexing(noteBeat, noteTime);
 					return scrollSpeed * ((noteHBScrollBeatTick - cursorHBScrollBeatTick) / Beat::TicksPerBeat) * GameWorldSpaceDistancePerLaneBeat;
 				}
 				case (ScrollMethod::NMSCROLL):
@@ -251,6 +276,8 @@ namespace PeepoDrumKit
 
 		constexpr b8 IsPointVisibleOnLane(f32 laneX, f32 threshold = 280.0f) const { return (laneX >= -threshold) && (laneX <= (LaneWidth() + threshold)); }
 		constexpr b8 IsRangeVisibleOnLane(f32 laneHeadX, f32 laneTailX, f32 threshold = 280.0f) const { return (laneTailX >= -threshold) && (laneHeadX <= (LaneWidth() + threshold)); }
+		// NOTE: Max distance from the lane origin at which an item can still pass the above visibility checks
+		f32 GetMaxVisibleLaneDistance(f32 originLaneX, f32 threshold = 280.0f) const { return Max(Absolute(-threshold - originLaneX), Absolute((LaneWidth() + threshold) - originLaneX)); }
 	};
 
 	struct ChartGamePreview
@@ -263,6 +290,19 @@ namespace PeepoDrumKit
 		void DrawGui(ChartContext& context, Time animatedCursorTime);
 	};
 
+	// NOTE: Headless check of the game preview visibility blocks, comparing the notes and bar lines visible at each sampled cursor time
+	//		 (on the normal branch) against walking through all of them, for the TJA test window
+	struct GameLaneVisibilityComparisonResult
+	{
+		size_t CursorCount;
+		size_t VisibleNoteCount, VisibleBarCount;
+		size_t WindowedNoteCount, WindowedBarCount;
+		size_t MismatchCount;
+		Time FullWalkDuration, WindowedDuration;
+	};
+
+	GameLaneVisibilityComparisonResult DebugCompareGameLaneVisibilityAgainstFullWalk(const ChartCourse& course, Time chartDuration, size_t cursorCount, DebugCompareChartsOnMessageFunc onMessageFunc, void* userData = nullptr);
+
 	// Other GUI helpers
 	b8 GuiInputFraction(cstr label, ivec2* inOutValue, std::optional<ivec2> valueRange,
 		i32 step = 0, i32 stepFast = 0,
@@ -388,165 +388,281 @@ namespace PeepoDrumKit
 		});
 	}
 
-	struct ForEachNoteLaneData
+	static constexpr size_t GameLaneItemsPerVisibilityBlock = 32;
+	static constexpr GameLaneVisibilityBlock EmptyGameLaneVisibilityBlock = { F64Max, -F64Max, 0.0, F64Max, -F64Max, 0.0, Time::FromSec(F64Max), Time::FromSec(-F64Max), false };
+
+	static constexpr b8 UsesHBScrollBeatTick(ScrollMethod scrollType) { return (scrollType == ScrollMethod::HBSCROLL) || (scrollType == ScrollMethod::BMSCROLL); }
+
+	static GameLanePoint ToGameLanePoint(const SortedTempoMap& tempoMap, Beat beat, Time time, Tempo tempo, Complex scrollSpeed, ScrollMethod scrollType)
 	{
-		const Note* OriginalNote;
-		Beat Beat;
-		Time Time;
-		Tempo Tempo;
-		Complex ScrollSpeed;
-		ScrollMethod ScrollType;
-		struct {
-			struct Beat Beat;
-			struct Time Time;
-			struct Tempo Tempo;
-			Complex ScrollSpeed;
-			ScrollMethod ScrollType;
-		} Tail;
-	};
+		return GameLanePoint { beat, time, tempo, scrollSpeed, scrollType, UsesHBScrollBeatTick(scrollType) ? tempoMap.BeatAndTimeToHBScrollBeatTick(beat, time) : 0.0 };
+	}
 
-	template <typename Func>
-	static void ForEachNoteOnNoteLane(const ChartCourse& course, BranchType branch, Func perNoteFunc)
+	// NOTE: Signed lane space distance per second (NMSCROLL) or per HBScroll beat tick (HBSCROLL / BMSCROLL) along the x axis, see GameCamera::TimeToLaneSpace()
+	static f64 GetGameLanePointSpeed(const GameLanePoint& point)
 	{
-		BeatSortedForwardIterator<TempoChange> tempoChangeIt {};
-		BeatSortedForwardIterator<ScrollChange> scrollChangeIt {};
-		BeatSortedForwardIterator<ScrollType> scrollTypeIt {};
-		BeatSortedForwardIterator<JPOSScrollChange> JPOSscrollChangeIt {};
+		if (!UsesHBScrollBeatTick(point.ScrollType))
+			return ((point.Tempo.BPM * point.ScrollSpeed.GetRealPart()) / 60.0) * GameWorldSpaceDistancePerLaneBeat;
+
+		const f64 scrollSpeed = (point.ScrollType == ScrollMethod::BMSCROLL) ? 1.0 : point.ScrollSpeed.GetRealPart();
+		return (scrollSpeed / Beat::TicksPerBeat) * GameWorldSpaceDistancePerLaneBeat;
+	}
 
-		for (const Note& note : course.GetNotes(branch))
+	static void AddToGameLaneVisibilityBlock(GameLaneVisibilityBlock& block, const GameLanePoint& head, const GameLanePoint& tail)
+	{
+		// NOTE: As long as both ends move in the same direction, the whole range can only be visible if either end is close enough or the cursor is in between
+		const f64 headSpeed = GetGameLanePointSpeed(head), tailSpeed = GetGameLanePointSpeed(tail);
+		if (headSpeed == 0.0 || tailSpeed == 0.0 || (headSpeed < 0.0) != (tailSpeed < 0.0) || UsesHBScrollBeatTick(head.ScrollType) != UsesHBScrollBeatTick(tail.ScrollType))
 		{
-			const Beat beat = note.BeatTime;
-			const Time head = (course.TempoMap.BeatToTime(beat) + note.TimeOffset);
-			const Beat beatTail = (note.BeatDuration > Beat::Zero()) ? (beat + note.BeatDuration) : beat;
-			const Time tail = (note.BeatDuration > Beat::Zero()) ? (course.TempoMap.BeatToTime(beatTail) + note.TimeOffset) : head;
-			perNoteFunc(ForEachNoteLaneData { &note, beat, head,
-				TempoOrDefault(tempoChangeIt.Next(course.TempoMap.Tempo.Sorted, beat)),
-				ScrollOrDefault(scrollChangeIt.Next(course.ScrollChanges.Sorted, beat)),
-				ScrollTypeOrDefault(scrollTypeIt.Next(course.ScrollTypes.Sorted, beat)),
-				{
-					beatTail, tail,
-					TempoOrDefault(tempoChangeIt.Next(course.TempoMap.Tempo.Sorted, beatTail)),
-					ScrollOrDefault(scrollChangeIt.Next(course.ScrollChanges.Sorted, beatTail)),
-					ScrollTypeOrDefault(scrollTypeIt.Next(course.ScrollTypes.Sorted, beatTail)),
-				},
-			});
+			block.IsUnbounded = true;
+			return;
+		}
+
+		const f64 inverseSpeed = Max(1.0 / Absolute(headSpeed), 1.0 / Absolute(tailSpeed));
+		if (UsesHBScrollBeatTick(head.ScrollType))
+		{
+			block.MinHBScrollBeatTick = Min(block.MinHBScrollBeatTick, Min(head.HBScrollBeatTick, tail.HBScrollBeatTick));
+			block.MaxHBScrollBeatTick = Max(block.MaxHBScrollBeatTick, Max(head.HBScrollBeatTick, tail.HBScrollBeatTick));
+			block.MaxInverseHBScrollSpeed = Max(block.MaxInverseHBScrollSpeed, inverseSpeed);
 		}
+		else
+		{
+			block.MinTime = Min(block.MinTime, Min(head.Time.Seconds, tail.Time.Seconds));
+			block.MaxTime = Max(block.MaxTime, Max(head.Time.Seconds, tail.Time.Seconds));
+			block.MaxInverseTimeSpeed = Max(block.MaxInverseTimeSpeed, inverseSpeed);
+		}
+	}
+
+	// NOTE: Time range during which a note is drawn at (or flying away from) the hit-circle instead of at its scroll position
+	static void AddToGameLaneVisibilityBlockHitTimeRange(GameLaneVisibilityBlock& block, const Note& note, const GameLaneNote& laneNote)
+	{
+		const Time hitEndTime =
+			IsRegularNote(note.Type) ? (laneNote.Head.Time + GetTotalGameNoteHitAnimationDuration(note.Type)) :
+			IsBalloonNote(note.Type) ? laneNote.Tail.Time :
+			(laneNote.Tail.Time + GameNoteHitAnimationDuration);
+
+		block.MinHitTime = Min(block.MinHitTime, laneNote.Head.Time);
+		block.MaxHitEndTime = Max(block.MaxHitEndTime, hitEndTime);
 	}
 
-	void ChartCourse::RecalculateSENotes(BranchType branch) const
+	static b8 IsGameLaneVisibilityBlockPossiblyVisible(const GameLaneVisibilityBlock& block, Time cursorTime, f64 cursorHBScrollBeatTick, f64 maxLaneDistance)
 	{
-		enum class SEFormType { Long, Short, Alternate, Final };
+		if (block.IsUnbounded)
+			return true;
+		if (cursorTime >= block.MinHitTime && cursorTime <= block.MaxHitEndTime)
+			return true;
+
+		const f64 timeDistance = (maxLaneDistance * block.MaxInverseTimeSpeed);
+		if (cursorTime.Seconds >= (block.MinTime - timeDistance) && cursorTime.Seconds <= (block.MaxTime + timeDistance))
+			return true;
 
-		// prev, curr, next, n(ext)2nd
-		ForEachNoteLaneData noteDataRingBuffer[4] = {};
-		i32 noteDataRingOffset = 0;
-		auto getNoteData = [&](i32 idx) -> decltype(auto) { return noteDataRingBuffer[(noteDataRingOffset + idx) & 3]; };
+		const f64 tickDistance = (maxLaneDistance * block.MaxInverseHBScrollSpeed);
+		return (cursorHBScrollBeatTick >= (block.MinHBScrollBeatTick - tickDistance) && cursorHBScrollBeatTick <= (block.MaxHBScrollBeatTick + tickDistance));
+	}
+
+	template <typename Func>
+	static void ForEachPossiblyVisibleGameLaneItemIndex(const std::vector<GameLaneVisibilityBlock>& blocks, size_t itemCount, Time cursorTime, f64 cursorHBScrollBeatTick, f32 maxLaneDistance, Func perItemIndexFunc)
+	{
+		// NOTE: Slightly padded to account for the lower precision of the actual lane positioning
+		const f64 paddedLaneDistance = (static_cast<f64>(maxLaneDistance) * 1.001) + 1.0;
 
-		// distance when curr is on the judgement mark
-		// other is NMScroll: visual beat distance = sec_time * visual_beat_per_second_other
-		// other is HBScroll: visual beat distance = scroll_other * beat_distance
-		auto getVisualBeat = [&](const auto& curr, const auto& other, f32 scrollOther, f32 vbpsOther, Time timeDistance)
+		for (size_t blockIndex = 0; blockIndex < blocks.size(); blockIndex++)
 		{
-			return (other.OriginalNote == nullptr) ? F32Max
-				: (other.ScrollType == ScrollMethod::NMSCROLL) ? vbpsOther * timeDistance.Seconds
-				: (other.ScrollType == ScrollMethod::HBSCROLL) ? scrollOther * abs(curr.Beat - other.Beat).Ticks / Beat::TicksPerBeat
-				: /* (prev.ScrollType == ScrollMethod::BMSCROLL) ? */ abs(curr.Beat - other.Beat).Ticks / Beat::TicksPerBeat;
+			if (!IsGameLaneVisibilityBlockPossiblyVisible(blocks[blockIndex], cursorTime, cursorHBScrollBeatTick, paddedLaneDistance))
+				continue;
+
+			const size_t endIndex = Min((blockIndex + 1) * GameLaneItemsPerVisibilityBlock, itemCount);
+			for (size_t itemIndex = blockIndex * GameLaneItemsPerVisibilityBlock; itemIndex < endIndex; itemIndex++)
+				perItemIndexFunc(itemIndex);
+		}
+	}
+
+	static GameLaneNote GetGameLaneNote(const Note& note, const NoteTimingTable& timings, size_t i)
+	{
+		const Beat beatTail = (note.BeatDuration > Beat::Zero()) ? (note.BeatTime + note.BeatDuration) : note.BeatTime;
+		return GameLaneNote {
+			GameLanePoint { note.BeatTime, timings.HeadTimes[i], timings.HeadTempos[i], timings.HeadScrollSpeeds[i], timings.HeadScrollTypes[i], timings.HeadHBScrollBeatTicks[i] },
+			GameLanePoint { beatTail, timings.TailTimes[i], timings.TailTempos[i], timings.TailScrollSpeeds[i], timings.TailScrollTypes[i], timings.TailHBScrollBeatTicks[i] },
 		};
+	}
 
-		auto getNoteDistance = [&]()
+	static void RecalculateGameLaneNoteVisibilityBlocks(const SortedNotesList& notes, const NoteTimingTable& timings, GameLaneNoteCache& laneCache)
+	{
+		assert(notes.size() == timings.size());
+		laneCache.Blocks.clear();
+		for (size_t i = 0; i < notes.size(); i++)
 		{
-			const auto& prev = getNoteData(0);
-			const auto& curr = getNoteData(1);
-			const auto& next = getNoteData(2);
-			const auto& n2nd = getNoteData(3);
-			const f32 scrollPrev = abs(prev.ScrollSpeed.cpx);
-			const f32 scrollNextCapped = std::min(1.0f, abs(next.ScrollSpeed.cpx));
-			// visual beat per second
-			const f32 vbpsPrev = scrollPrev * prev.Tempo.BPM / 60;
-			const f32 vbpsNextCapped = scrollNextCapped * next.Tempo.BPM / 60;
-			// time distance
-			const Time tdToPrev = (prev.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (curr.Time - prev.Time);
-			const Time tdToNext = (next.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (next.Time - curr.Time);
-			const Time tdToN2nd = (n2nd.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (n2nd.Time - next.Time);
-			const f32 vbdToPrev = getVisualBeat(curr, prev, scrollPrev, vbpsPrev, tdToPrev);
-			const f32 vbdToNextCapped = getVisualBeat(curr, next, scrollNextCapped, vbpsNextCapped, tdToNext);
-			return std::tuple{ tdToPrev, vbdToPrev, tdToNext, vbdToNextCapped, tdToN2nd };
-		};
+			if ((i % GameLaneItemsPerVisibilityBlock) == 0)
+				laneCache.Blocks.push_back(EmptyGameLaneVisibilityBlock);
 
-		const SortedNotesList& notes = GetNotes(branch);
-		std::vector<const Note*> alterChain;
-		b8 isAlterChain = true;
-		Time timeIntervalAlter = Time::Zero();
-		Time timeStartAlter = Time::Zero();
+			const GameLaneNote laneNote = GetGameLaneNote(notes[i], timings, i);
+			AddToGameLaneVisibilityBlock(laneCache.Blocks.back(), laneNote.Head, laneNote.Tail);
+			AddToGameLaneVisibilityBlockHitTimeRange(laneCache.Blocks.back(), notes[i], laneNote);
+		}
+		laneCache.Version = timings.Version;
+	}
 
-		auto assignSingleNote = [&]()
+	static void RecalculateGameLaneBars(const ChartCourse& course, BranchType branch, Beat maxBeatDuration)
+	{
+		GameLaneBarCache& barCache = course.TempGameLaneBars;
+		barCache.Bars.clear();
+		barCache.Blocks.clear();
+		ForEachBarOnNoteLane(course, branch, maxBeatDuration, [&](const ForEachBarLaneData& it)
 		{
-			auto& curr = getNoteData(1);
-			const Note& it = *getNoteData(1).OriginalNote;
-			auto [tdToPrev, vbdToPrev, tdToNext, vbdToNextCapped, tdToN2nd] = getNoteDistance();
-			const Time timeEpsilon = Time::FromMS(1e-3);
-			const b8 denseToSparse = (tdToNext >= tdToPrev + timeEpsilon);
-			const b8 sparseToDense = (tdToN2nd <= tdToNext - timeEpsilon);
-			const f32 beatsEpsilon = 4 / 192.0;
-			const b8 isLongAvoided = (vbdToPrev <= 4 / 16.0 - beatsEpsilon
-				|| vbdToNextCapped <= 4 / 12.0 - beatsEpsilon); // avoid text from overlapping or extending under next note
-			const b8 isPrePause = (vbdToNextCapped >= 4 / 8.0 + beatsEpsilon);
-			auto se = (!isLongAvoided && (denseToSparse || sparseToDense || isPrePause)) ? SEFormType::Long : SEFormType::Short;
-			if (isAlterChain) {
-				if (it.Type == NoteType::Don && alterChain.empty()) {
-					timeIntervalAlter = tdToNext;
-					timeStartAlter = curr.Time;
-					alterChain.push_back(&it);
-				} else if (it.Type == NoteType::Don && abs(tdToPrev - timeIntervalAlter) < timeEpsilon && abs(timeStartAlter - curr.Time) < Time::FromSec(0.5) + timeEpsilon) {
-					alterChain.push_back(&it);
-				} else {
-					isAlterChain = false;
-					alterChain.clear();
-				}
-			}
-			if (denseToSparse || sparseToDense) {
-				if (denseToSparse && isAlterChain && !isLongAvoided && size(alterChain) % 2 != 0 && abs(timeStartAlter - curr.Time) < Time::FromSec(0.5) + timeEpsilon) {
-					for (i32 ia = 0; ia < size(alterChain); ++ia) {
-						if (ia % 2 == 1)
-							alterChain[ia]->TempSEType = NoteSEType::Ko;
-					}
-				}
-				alterChain.clear();
-				isAlterChain = sparseToDense;
-			}
+			if ((barCache.Bars.size() % GameLaneItemsPerVisibilityBlock) == 0)
+				barCache.Blocks.push_back(EmptyGameLaneVisibilityBlock);
 
-			switch (it.Type)
-			{
-			case NoteType::Don: { it.TempSEType = (se == SEFormType::Long) ? NoteSEType::Don : NoteSEType::Do; } break;
-			case NoteType::DonBig: { it.TempSEType = NoteSEType::DonBig; } break;
-			case NoteType::DonBigHand: { it.TempSEType = NoteSEType::DonHand; } break;
-			case NoteType::Ka: { it.TempSEType = (se == SEFormType::Long) ? NoteSEType::Katsu : NoteSEType::Ka; } break;
-			case NoteType::KaBig: { it.TempSEType = NoteSEType::KatsuBig; } break;
-			case NoteType::KaBigHand: { it.TempSEType = NoteSEType::KatsuHand; } break;
-			case NoteType::Drumroll: { it.TempSEType = NoteSEType::Drumroll; } break;
-			case NoteType::DrumrollBig: { it.TempSEType = NoteSEType::DrumrollBig; } break;
-			case NoteType::Balloon: { it.TempSEType = NoteSEType::Balloon; } break;
-			case NoteType::BalloonSpecial: { it.TempSEType = NoteSEType::BalloonSpecial; } break;
-			default: { it.TempSEType = NoteSEType::Count; } break;
-			}
-		};
+			const GameLaneBar& bar = barCache.Bars.emplace_back(GameLaneBar { ToGameLanePoint(course.TempoMap, it.Beat, it.Time, it.Tempo, it.ScrollSpeed, it.ScrollType), it.BarIndex });
+			AddToGameLaneVisibilityBlock(barCache.Blocks.back(), bar.Point, bar.Point);
+		});
+		barCache.MaxBeatDuration = maxBeatDuration;
+		barCache.Version = course.TimingsVersion;
+	}
+
+	// NOTE: Only iterates over the blocks of notes which can possibly be visible, the final visibility check is still up to the caller
+	template <typename Func>
+	static void ForEachPossiblyVisibleNoteOnNoteLane(const ChartCourse& course, BranchType branch, Time cursorTime, f64 cursorHBScrollBeatTick, f32 maxLaneDistance, Func perNoteFunc)
+	{
+		const SortedNotesList& notes = course.GetNotes(branch);
+		const NoteTimingTable& timings = course.GetNoteTimings(branch);
+		GameLaneNoteCache& laneCache = course.TempGameLaneNotes[EnumToIndex(branch)];
+		if (laneCache.Version != timings.Version || laneCache.Blocks.size() != ((notes.size() + GameLaneItemsPerVisibilityBlock - 1) / GameLaneItemsPerVisibilityBlock))
+			RecalculateGameLaneNoteVisibilityBlocks(notes, timings, laneCache);
 
-		// fetch 2nd next note, update current note
-		i32 lastFilled = 0;
-		ForEachNoteOnNoteLane(*this, branch, [&](const ForEachNoteLaneData& dataIt)
+		ForEachPossiblyVisibleGameLaneItemIndex(laneCache.Blocks, notes.size(), cursorTime, cursorHBScrollBeatTick, maxLaneDistance, [&](size_t i)
 		{
-			if (getNoteData(1).OriginalNote != nullptr)
-				assignSingleNote();
-			noteDataRingOffset = (noteDataRingOffset + 1) & 3;
-			getNoteData(3) = dataIt;
-			lastFilled = 3;
+			perNoteFunc(notes[i], GetGameLaneNote(notes[i], timings, i));
 		});
-		for (; lastFilled >= 1; --lastFilled) {
-			if (getNoteData(1).OriginalNote != nullptr)
-				assignSingleNote();
-			noteDataRingOffset = (noteDataRingOffset + 1) & 3;
-			getNoteData(3).OriginalNote = nullptr;
+	}
+
+	template <typename Func>
+	static void ForEachPossiblyVisibleBarOnNoteLane(const ChartCourse& course, BranchType branch, Beat maxBeatDuration, Time cursorTime, f64 cursorHBScrollBeatTick, f32 maxLaneDistance, Func perBarFunc)
+	{
+		const GameLaneBarCache& barCache = course.TempGameLaneBars;
+		if (barCache.Version != course.TimingsVersion || barCache.MaxBeatDuration != maxBeatDuration)
+			RecalculateGameLaneBars(course, branch, maxBeatDuration);
+
+		ForEachPossiblyVisibleGameLaneItemIndex(barCache.Blocks, barCache.Bars.size(), cursorTime, cursorHBScrollBeatTick, maxLaneDistance, [&](size_t i)
+		{
+			perBarFunc(barCache.Bars[i]);
+		});
+	}
+
+	// NOTE: Final per note visibility check for the notes passed on by the visibility blocks, also moving notes currently being hit to the hit-circle
+	static b8 IsGameLaneNoteVisible(const GameCamera& camera, vec2 hitCirclePosLane, Time cursorTime, f64 cursorHBScrollBeatTick, const Note& note, const GameLaneNote& it, vec2& outLaneHead, vec2& outLaneTail)
+	{
+		vec2 laneHead = camera.GetNoteCoordinatesLane(hitCirclePosLane, cursorTime, cursorHBScrollBeatTick, it.Head);
+		vec2 laneTail = camera.GetNoteCoordinatesLane(hitCirclePosLane, cursorTime, cursorHBScrollBeatTick, it.Tail);
+
+		b8 isVisible = true;
+
+		const Time timeSinceHeadHit = TimeSinceNoteHit(it.Head.Time, cursorTime);
+		const Time timeSinceTailHit = TimeSinceNoteHit(it.Tail.Time, cursorTime);
+		if (IsRegularNote(note.Type)) {
+			if (timeSinceHeadHit >= Time::Zero())
+				laneHead = laneTail = hitCirclePosLane; // temporary value, override when drawn
+			else
+				isVisible = camera.IsPointVisibleOnLane(laneHead.x);
+			if (timeSinceHeadHit > GetTotalGameNoteHitAnimationDuration(note.Type))
+				isVisible = false;
+		}
+		else if (IsBalloonNote(note.Type)) {
+			if (timeSinceTailHit >= Time::Zero()) {
+				laneHead = laneTail;
+				isVisible = false;
+			}
+			else if (timeSinceHeadHit >= Time::Zero())
+				laneHead = hitCirclePosLane;
+			else
+				isVisible = camera.IsRangeVisibleOnLane(Min(laneHead.x, laneTail.x), Max(laneHead.x, laneTail.x));
+		}
+		else { // is bar roll note
+			// flying notes in screen?
+			isVisible = ((timeSinceHeadHit >= Time::Zero() && timeSinceTailHit <= GameNoteHitAnimationDuration)
+				// roll body in screen?
+				|| camera.IsRangeVisibleOnLane(Min(laneHead.x, laneTail.x), Max(laneHead.x, laneTail.x)));
 		}
+
+		outLaneHead = laneHead;
+		outLaneTail = laneTail;
+		return isVisible;
+	}
+
+	GameLaneVisibilityComparisonResult DebugCompareGameLaneVisibilityAgainstFullWalk(const ChartCourse& course, Time chartDuration, size_t cursorCount, DebugCompareChartsOnMessageFunc onMessageFunc, void* userData)
+	{
+		static constexpr size_t maxMismatchMessageCount = 32;
+		static constexpr BranchType branch = BranchType::Normal;
+		const SortedNotesList& notes = course.GetNotes(branch);
+		const NoteTimingTable& timings = course.GetNoteTimings(branch);
+		const Beat chartBeatDuration = course.TempoMap.TimeToBeat(chartDuration);
+
+		GameLaneVisibilityComparisonResult result = {};
+		std::vector<size_t> fullWalkNoteIndices, windowedNoteIndices;
+		std::vector<i32> fullWalkBarIndices, windowedBarIndices;
+		char message[128];
+
+		// NOTE: Both the standard and an ultra wide lane, each at every sampled cursor time from slightly before the start to slightly past the end of the chart
+		for (const f32 laneWidth : { GameLaneStandardWidth, GameLaneStandardWidth * 2.0f })
+		{
+			GameCamera camera = {};
+			camera.LaneRect = Rect::FromTLSize(vec2(GameLanePaddingL, GameLanePaddingTop), vec2(laneWidth, GameLaneSlice.TotalHeight()));
+
+			// NOTE: Making sure the lazily recalculated visibility blocks aren't included in the timings below
+			ForEachPossiblyVisibleNoteOnNoteLane(course, branch, Time::Zero(), 0.0, 0.0f, [&](const Note&, const GameLaneNote&) {});
+			ForEachPossiblyVisibleBarOnNoteLane(course, branch, chartBeatDuration, Time::Zero(), 0.0, 0.0f, [&](const GameLaneBar&) {});
+
+			for (size_t cursorIndex = 0; cursorIndex < cursorCount; cursorIndex++)
+			{
+				const Time cursorTime = Time::FromSec(ConvertRange(0.0, static_cast<f64>(Max<size_t>(cursorCount, 2) - 1), -2.0, chartDuration.Seconds + 2.0, static_cast<f64>(cursorIndex)));
+				const Beat cursorBeatTrunc = course.TempoMap.TimeToBeat(cursorTime, true);
+				const f64 cursorHBScrollBeatTick = course.TempoMap.BeatAndTimeToHBScrollBeatTick(cursorBeatTrunc, cursorTime);
+				const vec2 hitCirclePosLane = camera.GetHitCircleCoordinatesLane(course.JPOSScrollChanges, cursorTime, course.TempoMap.AccelerationStructure);
+				const f32 maxVisibleLaneDistance = camera.GetMaxVisibleLaneDistance(hitCirclePosLane.x);
+				const auto isBarVisible = [&](const GameLanePoint& point) { return camera.IsPointVisibleOnLane(camera.GetNoteCoordinatesLane(hitCirclePosLane, cursorTime, cursorHBScrollBeatTick, point).x); };
+				vec2 laneHead, laneTail;
+
+				fullWalkNoteIndices.clear();
+				fullWalkBarIndices.clear();
+				CPUStopwatch stopwatch = CPUStopwatch::StartNew();
+				for (size_t i = 0; i < notes.size(); i++)
+				{
+					if (IsGameLaneNoteVisible(camera, hitCirclePosLane, cursorTime, cursorHBScrollBeatTick, notes[i], GetGameLaneNote(notes[i], timings, i), laneHead, laneTail))
+						fullWalkNoteIndices.push_back(i);
+				}
+				ForEachBarOnNoteLane(course, branch, chartBeatDuration, [&](const ForEachBarLaneData& it)
+				{
+					if (isBarVisible(ToGameLanePoint(course.TempoMap, it.Beat, it.Time, it.Tempo, it.ScrollSpeed, it.ScrollType)))
+						fullWalkBarIndices.push_back(it.BarIndex);
+				});
+				result.FullWalkDuration += stopwatch.Restart();
+
+				windowedNoteIndices.clear();
+				windowedBarIndices.clear();
+				ForEachPossiblyVisibleNoteOnNoteLane(course, branch, cursorTime, cursorHBScrollBeatTick, maxVisibleLaneDistance, [&](const Note& note, const GameLaneNote& it)
+				{
+					result.WindowedNoteCount++;
+					if (IsGameLaneNoteVisible(camera, hitCirclePosLane, cursorTime, cursorHBScrollBeatTick, note, it, laneHead, laneTail))
+						windowedNoteIndices.push_back(ArrayItToIndex(&note, &notes[0]));
+				});
+				ForEachPossiblyVisibleBarOnNoteLane(course, branch, chartBeatDuration, cursorTime, cursorHBScrollBeatTick, maxVisibleLaneDistance, [&](const GameLaneBar& it)
+				{
+					result.WindowedBarCount++;
+					if (isBarVisible(it.Point))
+						windowedBarIndices.push_back(it.BarIndex);
+				});
+				result.WindowedDuration += stopwatch.Stop();
+
+				result.CursorCount++;
+				result.VisibleNoteCount += fullWalkNoteIndices.size();
+				result.VisibleBarCount += fullWalkBarIndices.size();
+				if (fullWalkNoteIndices != windowedNoteIndices && result.MismatchCount++ < maxMismatchMessageCount)
+					onMessageFunc(std::string_view(message, sprintf_s(message, "Visible notes mismatch at %.3f sec: %zu (full walk: %zu)", cursorTime.Seconds, windowedNoteIndices.size(), fullWalkNoteIndices.size())), userData);
+				if (fullWalkBarIndices != windowedBarIndices && result.MismatchCount++ < maxMismatchMessageCount)
+					onMessageFunc(std::string_view(message, sprintf_s(message, "Visible bar lines mismatch at %.3f sec: %zu (full walk: %zu)", cursorTime.Seconds, windowedBarIndices.size(), fullWalkBarIndices.size())), userData);
+			}
+		}
+
+		return result;
 	}
 
 	void ChartGamePreview::DrawGui(ChartContext& context, Time animatedCursorTime)
@@ -711,16 +827,18 @@ namespace PeepoDrumKit
 				drawList->AddText(posTxtJPos, 0xFFFFFFFF, str.c_str(), str.c_str() + str.length());
 			}
 
+			const f32 maxVisibleLaneDistance = Camera.GetMaxVisibleLaneDistance(hitCirclePosLane.x);
+
 			drawList->ChannelsSetCurrent(2);
-			ForEachBarOnNoteLane(*course, branch, chartBeatDuration, [&](const ForEachBarLaneData& it)
+			ForEachPossiblyVisibleBarOnNoteLane(*course, branch, chartBeatDuration, cursorTimeOrAnimated, cursorHBScrollBeatOrAnimated, maxVisibleLaneDistance, [&](const GameLaneBar& it)
 			{
-				const vec2 lane = Camera.GetNoteCoordinatesLane(hitCirclePosLane, cursorTimeOrAnimated, cursorHBScrollBeatOrAnimated, it.Time, it.Beat, it.Tempo, it.ScrollSpeed, it.ScrollType, tempoChanges, jposScrollChanges);
+				const vec2 lane = Camera.GetNoteCoordinatesLane(hitCirclePosLane, cursorTimeOrAnimated, cursorHBScrollBeatOrAnimated, it.Point);
 				const f32 laneX = lane.x, laneY = lane.y;
 
 				if (Camera.IsPointVisibleOnLane(laneX))
 				{
-					const vec2 tl = Camera.LaneToWorldSpace(laneX, laneY) - Rotate(vec2(0.0f, GameLaneSlice.Content * 0.5f), GetNoteFaceRotationMirror(it.Tempo, it.ScrollSpeed, NoteType::Count).first);
-					const vec2 br = Camera.LaneToWorldSpace(laneX, laneY) + Rotate(vec2(0.0f, GameLaneSlice.Content * 0.5f), GetNoteFaceRotationMirror(it.Tempo, it.ScrollSpeed, NoteType::Count).first);
+					const vec2 tl = Camera.LaneToWorldSpace(laneX, laneY) - Rotate(vec2(0.0f, GameLaneSlice.Content * 0.5f), GetNoteFaceRotationMirror(it.Point.Tempo, it.Point.ScrollSpeed, NoteType::Count).first);
+					const vec2 br = Camera.LaneToWorldSpace(laneX, laneY) + Rotate(vec2(0.0f, GameLaneSlice.Content * 0.5f), GetNoteFaceRotationMirror(it.Point.Tempo, it.Point.ScrollSpeed, NoteType::Count).first);
 					drawList->AddLine(Camera.WorldToScreenSpace(tl), Camera.WorldToScreenSpace(br), GameLaneBarLineColor, Camera.WorldToScreenScale(GameLaneBarLineThickness));
 
 					char barLineStr[32];
@@ -750,37 +868,11 @@ namespace PeepoDrumKit
 #endif
 
 			drawList->ChannelsSetCurrent(3);
-			ForEachNoteOnNoteLane(*course, branch, [&](const ForEachNoteLaneData& it)
+			ForEachPossiblyVisibleNoteOnNoteLane(*course, branch, cursorTimeOrAnimated, cursorHBScrollBeatOrAnimated, maxVisibleLaneDistance, [&](const Note& note, const GameLaneNote& it)
 			{
-				vec2 laneHead = Camera.GetNoteCoordinatesLane(hitCirclePosLane, cursorTimeOrAnimated, cursorHBScrollBeatOrAnimated, it.Time, it.Beat, it.Tempo, it.ScrollSpeed, it.ScrollType, tempoChanges, jposScrollChanges);
-				vec2 laneTail = Camera.GetNoteCoordinatesLane(hitCirclePosLane, cursorTimeOrAnimated, cursorHBScrollBeatOrAnimated, it.Tail.Time, it.Tail.Beat, it.Tail.Tempo, it.Tail.ScrollSpeed, it.Tail.ScrollType, tempoChanges, jposScrollChanges);
-
-				b8 isVisible = true;
-
-				const Time timeSinceHeadHit = TimeSinceNoteHit(it.Time, cursorTimeOrAnimated);
-				const Time timeSinceTailHit = TimeSinceNoteHit(it.Tail.Time, cursorTimeOrAnimated);
-				if (IsRegularNote(it.OriginalNote->Type)) {
-					if (timeSinceHeadHit >= Time::Zero())
-						laneHead = laneTail = hitCirclePosLane; // temporary value, override when drawn
-					if (timeSinceHeadHit > GetTotalGameNoteHitAnimationDuration(it.OriginalNote->Type))
-						isVisible = false;
-				}
-				else if (IsBalloonNote(it.OriginalNote->Type)) {
-					if (timeSinceTailHit >= Time::Zero()) {
-						laneHead = laneTail;
-						isVisible = false;
-					}
-					else if (timeSinceHeadHit >= Time::Zero())
-						laneHead = hitCirclePosLane;
-				}
-				else { // is bar roll note
-					// flying notes in screen?
-					isVisible = ((timeSinceHeadHit >= Time::Zero() && timeSinceTailHit <= GameNoteHitAnimationDuration)
-						// roll body in screen?
-						|| Camera.IsRangeVisibleOnLane(Min(laneHead.x, laneTail.x), Max(laneHead.x, laneTail.x)));
-				}
-				if (isVisible)
-					ReverseNoteDrawBuffer.push_back(DeferredNoteDrawData{ laneHead.x, laneTail.x, laneHead.y, laneTail.y, it.Tempo, it.ScrollSpeed, it.OriginalNote, it.Time, it.Tail.Time });
+				vec2 laneHead, laneTail;
+				if (IsGameLaneNoteVisible(Camera, hitCirclePosLane, cursorTimeOrAnimated, cursorHBScrollBeatOrAnimated, note, it, laneHead, laneTail))
+					ReverseNoteDrawBuffer.push_back(DeferredNoteDrawData{ laneHead.x, laneTail.x, laneHead.y, laneTail.y, it.Head.Tempo, it.Head.ScrollSpeed, &note, it.Head.Time, it.Tail.Time });
 			});
 
 			const Beat drummrollHitInterval = GetGridBeatSnap(*Settings.General.DrumrollAutoHitBarDivision);
@@ -1,5 +1,11 @@
 #include "test_gui_audio.h"
+#include "audio/audio_file_formats.h"
+#include "audio/audio_waveform.h"
+#include "audio/audio_decode_cache.h"
+#include "chart_editor_timeline.h"
+#include "core_io.h"
 #include "imgui/imgui_include.h"
+#include <thread>
 
 namespace PeepoDrumKit
 {
@@ -18,6 +24,12 @@ namespace PeepoDrumKit
 			beginEndTabItem("Audio Engine", [this] { AudioEngineTabContent(); });
 			beginEndTabItem("Active Voices", [this] { ActiveVoicesTabContent(); });
 			beginEndTabItem("Loaded Sources", [this] { LoadedSourcesTabContent(); });
+			beginEndTabItem("Mix Kernels", [this] { MixKernelsTabContent(); });
+			beginEndTabItem("Song Loading", [this] { SongLoadingTabContent(); });
+			beginEndTabItem("Waveform", [this] { WaveformTabContent(); });
+			beginEndTabItem("Resampler", [this] { ResamplerTabContent(); });
+			beginEndTabItem("Stress Test", [this] { StressTestTabContent(); });
+			beginEndTabItem("Scheduled Sounds", [this] { ScheduledSoundsTabContent(); });
 			Gui::EndTabBar();
 		}
 		Gui::PopStyleColor(2);
@@ -275,6 +287,944 @@ namespace PeepoDrumKit
 		}
 	}
 
+	static constexpr cstr MixKernelFunctionNames[] =
+	{
+		"Mix I16 (Frame Gains)",
+		"Mix I16 (Constant Gain)",
+		"Mix F32 into I16 (Clamped)",
+		"Mix F32 into F32",
+		"Duplicate Mono to Stereo",
+		"Combine Quad to Stereo",
+	};
+
+	void AudioTestWindow::MixKernelsTabContent()
+	{
+		if (Gui::Button("Run Benchmark", vec2(Gui::GetContentRegionAvail().x, 0.0f)))
+			RunMixKernelBenchmark();
+
+		Gui::Property::Table(ImGuiTableFlags_BordersInner | ImGuiTableFlags_ScrollY, [&]
+		{
+			Gui::Property::PropertyTextValueFunc("Selected Kernel Set", [&]
+			{
+				Gui::TextUnformatted(Audio::MixKernelSetNames[EnumToIndex(Audio::GetBestSupportedMixKernelSet())]);
+			});
+
+			for (size_t setIndex = 0; setIndex < EnumCount<Audio::MixKernelSet>; setIndex++)
+			{
+				const MixKernelBenchmarkResult& result = mixKernelBenchmarkResults[setIndex];
+				Gui::PushID(static_cast<int>(setIndex));
+				Gui::Property::PropertyTreeNodeValueFunc(Audio::MixKernelSetNames[setIndex], ImGuiTreeNodeFlags_DefaultOpen, [&]
+				{
+					for (size_t funcIndex = 0; funcIndex < ArrayCount(MixKernelFunctionNames); funcIndex++)
+					{
+						Gui::Property::PropertyTextValueFunc(MixKernelFunctionNames[funcIndex], [&]
+						{
+							if (!Audio::IsMixKernelSetSupported(static_cast<Audio::MixKernelSet>(setIndex)))
+								Gui::TextDisabled("(Unsupported)");
+							else if (!mixKernelBenchmarkHasRun)
+								Gui::TextDisabled("(Not run)");
+							else
+								Gui::TextColored((result.MaxDeviationFromScalar[funcIndex] == 0.0) ? Gui::GetStyleColorVec4(ImGuiCol_Text) : ImVec4(1.0f, 0.3f, 0.3f, 1.0f),
+									"%.3f ns/frame (max deviation: %g)", result.NanosecondsPerFrame[funcIndex], result.MaxDeviationFromScalar[funcIndex]);
+						});
+					}
+				});
+				Gui::PopID();
+			}
+		});
+	}
+
+	void AudioTestWindow::RunMixKernelBenchmark()
+	{
+		// NOTE: Odd frame count on purpose so that the scalar remainder loops are exercised as well
+		static constexpr size_t frameCount = Audio::AudioEngine::MaxBufferFrameCount - 3;
+		static constexpr i32 iterations = 16;
+
+		u32 randomState = 0x1234567;
+		auto nextRandom = [&]() { randomState = (randomState * 1664525u) + 1013904223u; return randomState; };
+
+		std::vector<i16> inI16(frameCount * 4);
+		std::vector<f32> inF32(frameCount * 2), frameGains(frameCount);
+		for (i16& v : inI16) v = static_cast<i16>(nextRandom() >> 16);
+		for (f32& v : inF32) v = (static_cast<f32>(nextRandom() >> 8) / static_cast<f32>(1 << 24) - 0.5f) * 4.0f * I16Max;
+		for (f32& v : frameGains) v = static_cast<f32>(nextRandom() >> 8) / static_cast<f32>(1 << 24);
+
+		std::vector<f32> outF32(frameCount * 2), scalarOutF32[4];
+		std::vector<i16> outI16(frameCount * 2), scalarOutI16[6];
+
+		auto runKernel = [&](const Audio::MixKernels& kernels, size_t funcIndex)
+		{
+			std::fill(outF32.begin(), outF32.end(), 1.0f);
+			std::fill(outI16.begin(), outI16.end(), static_cast<i16>(1));
+			switch (funcIndex)
+			{
+			case 0: kernels.MixStereoI16WithFrameGains(outF32.data(), inI16.data(), frameGains.data(), frameCount, 0.7f, 0.3f); break;
+			case 1: kernels.MixStereoI16WithConstantGain(outF32.data(), inI16.data(), frameCount, 0.7f, 0.3f); break;
+			case 2: kernels.MixStereoF32IntoI16Clamped(outI16.data(), inF32.data(), frameGains.data(), frameCount, 0.9f, 0.8f); break;
+			case 3: kernels.MixStereoF32IntoF32(outF32.data(), inF32.data(), frameGains.data(), frameCount, 0.9f, 0.8f); break;
+			case 4: kernels.DuplicateMonoToStereoI16(outI16.data(), inI16.data(), frameCount); break;
+			case 5: kernels.CombineQuadToStereoI16(outI16.data(), inI16.data(), frameCount); break;
+			}
+		};
+		auto outputIsF32 = [](size_t funcIndex) { return (funcIndex == 0 || funcIndex == 1 || funcIndex == 3); };
+
+		const Audio::MixKernels& scalarKernels = Audio::GetMixKernels(Audio::MixKernelSet::Scalar);
+		for (size_t funcIndex = 0; funcIndex < ArrayCount(MixKernelFunctionNames); funcIndex++)
+		{
+			runKernel(scalarKernels, funcIndex);
+			if (outputIsF32(funcIndex)) scalarOutF32[funcIndex] = outF32; else scalarOutI16[funcIndex] = outI16;
+		}
+
+		for (size_t setIndex = 0; setIndex < EnumCount<Audio::MixKernelSet>; setIndex++)
+		{
+			MixKernelBenchmarkResult& result = mixKernelBenchmarkResults[setIndex];
+			result = {};
+			result.Supported = Audio::IsMixKernelSetSupported(static_cast<Audio::MixKernelSet>(setIndex));
+			if (!result.Supported)
+				continue;
+
+			const Audio::MixKernels& kernels = Audio::GetMixKernels(static_cast<Audio::MixKernelSet>(setIndex));
+			for (size_t funcIndex = 0; funcIndex < ArrayCount(MixKernelFunctionNames); funcIndex++)
+			{
+				Time totalDuration = Time::Zero();
+				for (i32 i = 0; i < iterations; i++)
+				{
+					CPUStopwatch stopwatch = CPUStopwatch::StartNew();
+					runKernel(kernels, funcIndex);
+					totalDuration += stopwatch.Stop();
+				}
+				result.NanosecondsPerFrame[funcIndex] = (totalDuration.ToSec() * 1000000000.0) / static_cast<f64>(iterations * frameCount);
+
+				for (size_t i = 0; i < (frameCount * 2); i++)
+				{
+					const f64 deviation = outputIsF32(funcIndex) ? Absolute(static_cast<f64>(outF32[i]) - scalarOutF32[funcIndex][i]) : Absolute(static_cast<f64>(outI16[i]) - scalarOutI16[funcIndex][i]);
+					result.MaxDeviationFromScalar[funcIndex] = Max(result.MaxDeviationFromScalar[funcIndex], deviation);
+				}
+			}
+		}
+		mixKernelBenchmarkHasRun = true;
+	}
+
+	void AudioTestWindow::SongLoadingTabContent()
+	{
+		Gui::SetNextItemWidth(Gui::GetContentRegionAvail().x);
+		Gui::PathInputTextWithHint("##SongLoadingFilePath", "Audio File", &songLoadingBenchmark.FilePath);
+		if (Gui::Button("Run Benchmark", vec2(Gui::GetContentRegionAvail().x, 0.0f)) && !songLoadingBenchmark.FilePath.empty())
+			RunSongLoadingBenchmark();
+
+		const SongLoadingBenchmarkResult& result = songLoadingBenchmark;
+		Gui::Property::Table(ImGuiTableFlags_BordersInner | ImGuiTableFlags_ScrollY, [&]
+		{
+			if (!result.HasRun || result.FailedToLoad)
+			{
+				Gui::Property::PropertyTextValueFunc("Result", [&] { Gui::TextDisabled(!result.HasRun ? "(Not run)" : "(Failed to load file)"); });
+				return;
+			}
+
+			Gui::Property::PropertyTextValueFunc("Source Format", [&] { Gui::Text("%u channel(s), %u Hz", result.ChannelCount, result.SourceSampleRate); });
+			Gui::Property::PropertyTextValueFunc("Output Frames", [&] { Gui::Text("%lld (%lld blocks)", static_cast<long long>(result.FrameCount), static_cast<long long>(result.BlockCount)); });
+			Gui::Property::PropertyTextValueFunc("Entire: First Audio / Waveform", [&] { Gui::Text("%.3f ms", result.EntireDuration.ToMS()); });
+			Gui::Property::PropertyTextValueFunc("Streaming: First Audio", [&] { Gui::Text("%.3f ms", result.StreamingTimeToFirstAudio.ToMS()); });
+			Gui::Property::PropertyTextValueFunc("Streaming: First Waveform", [&] { Gui::Text("%.3f ms", result.StreamingTimeToFirstWaveform.ToMS()); });
+			Gui::Property::PropertyTextValueFunc("Streaming: Complete Waveform", [&] { Gui::Text("%.3f ms", result.StreamingDuration.ToMS()); });
+			Gui::Property::PropertyTextValueFunc("Identical Output", [&]
+			{
+				const b8 identical = (result.SamplesMatch && result.WaveformMatches);
+				Gui::TextColored(identical ? Gui::GetStyleColorVec4(ImGuiCol_Text) : ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Samples: %s, Waveform: %s", result.SamplesMatch ? "Yes" : "No", result.WaveformMatches ? "Yes" : "No");
+			});
+			Gui::Property::PropertyTextValueFunc("Song Cache: Key", [&] { Gui::Text("%.3f ms", result.CacheKeyDuration.ToMS()); });
+			Gui::Property::PropertyTextValueFunc("Song Cache: Cold Write", [&]
+			{
+				if (!result.CacheWriteSucceeded)
+					Gui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "(Failed to write entry)");
+				else
+					Gui::Text("%.3f ms (%.2f MB)", result.CacheWriteDuration.ToMS(), static_cast<f64>(result.CacheEntryByteSize) / (1024.0 * 1024.0));
+			});
+			Gui::Property::PropertyTextValueFunc("Song Cache: Cold Load", [&] { Gui::Text("%.3f ms", (result.CacheKeyDuration + result.StreamingDuration).ToMS()); });
+			Gui::Property::PropertyTextValueFunc("Song Cache: Warm Load", [&]
+			{
+				Gui::TextColored(result.CacheMatches ? Gui::GetStyleColorVec4(ImGuiCol_Text) : ImVec4(1.0f, 0.3f, 0.3f, 1.0f),
+					"%.3f ms (identical: %s)", (result.CacheKeyDuration + result.CacheWarmDuration).ToMS(), result.CacheMatches ? "Yes" : "No");
+			});
+		});
+	}
+
+	void AudioTestWindow::RunSongLoadingBenchmark()
+	{
+		const std::string filePath = std::move(songLoadingBenchmark.FilePath);
+		songLoadingBenchmark = {};
+		songLoadingBenchmark.FilePath = filePath;
+		songLoadingBenchmark.HasRun = true;
+		songLoadingBenchmark.FailedToLoad = true;
+
+		// NOTE: Read upfront so that neither of the two includes any disk access
+		const File::UniqueFileContent fileContent = File::ReadAllBytes(filePath);
+		if (fileContent.Content == nullptr || fileContent.Size == 0)
+			return;
+
+		static constexpr u32 targetSampleRate = Audio::AudioEngine::OutputSampleRate;
+
+		// NOTE: Neither audio nor waveform being available before everything is done
+		Audio::PCMSampleBuffer entireBuffer;
+		Audio::WaveformMipChain entireWaveformL, entireWaveformR;
+		CPUStopwatch stopwatch = CPUStopwatch::StartNew();
+		if (Audio::DecodeEntireFile(filePath, fileContent.Content.get(), fileContent.Size, entireBuffer) != Audio::DecodeFileResult::FeelsGoodMan || entireBuffer.FrameCount <= 0)
+			return;
+		songLoadingBenchmark.SourceSampleRate = entireBuffer.SampleRate;
+		if (entireBuffer.SampleRate != targetSampleRate)
+			Audio::ResampleBuffer(entireBuffer.InterleavedSamples, entireBuffer.FrameCount, entireBuffer.SampleRate, entireBuffer.ChannelCount, targetSampleRate);
+		Audio::WaveformMipChain::GenerateEntireStereoMipChainsFromSampleBuffer(entireWaveformL, &entireWaveformR, entireBuffer);
+		songLoadingBenchmark.EntireDuration = stopwatch.Stop();
+
+		// NOTE: Same as the chart editor, except for the waveform being generated on the decoding thread instead of the main thread
+		Audio::BlockDecoder decoder;
+		Audio::PCMSampleBuffer streamedBuffer;
+		Audio::WaveformMipChain streamedWaveformL, streamedWaveformR;
+		stopwatch.Restart();
+		if (!decoder.Open(filePath, fileContent.Content.get(), fileContent.Size, targetSampleRate))
+			return;
+		streamedBuffer.ChannelCount = decoder.GetChannelCount();
+		streamedBuffer.SampleRate = decoder.GetSampleRate();
+		streamedBuffer.FrameCount = decoder.GetFrameCount();
+		streamedBuffer.InterleavedSamples = std::unique_ptr<i16[]>(new i16[streamedBuffer.SampleCount()]);
+		streamedWaveformL.BeginIncrementalMipChainGeneration(streamedBuffer.FrameCount, streamedBuffer.SampleRate);
+		if (streamedBuffer.ChannelCount > 1)
+			streamedWaveformR.BeginIncrementalMipChainGeneration(streamedBuffer.FrameCount, streamedBuffer.SampleRate);
+		while (!decoder.IsFinished())
+		{
+			const i64 decodedFrameCount = decoder.DecodeNextBlock(streamedBuffer.InterleavedSamples.get());
+			if (songLoadingBenchmark.BlockCount++ == 0)
+				songLoadingBenchmark.StreamingTimeToFirstAudio = stopwatch.GetElapsed();
+
+			Audio::WaveformMipChain::ContinueIncrementalStereoMipChainGeneration(streamedWaveformL, &streamedWaveformR, streamedBuffer, decodedFrameCount);
+			if (songLoadingBenchmark.BlockCount == 1)
+				songLoadingBenchmark.StreamingTimeToFirstWaveform = stopwatch.GetElapsed();
+		}
+		songLoadingBenchmark.StreamingDuration = stopwatch.Stop();
+
+		songLoadingBenchmark.FailedToLoad = false;
+		songLoadingBenchmark.ChannelCount = streamedBuffer.ChannelCount;
+		songLoadingBenchmark.FrameCount = streamedBuffer.FrameCount;
+		songLoadingBenchmark.SamplesMatch = (streamedBuffer.FrameCount == entireBuffer.FrameCount && streamedBuffer.ChannelCount == entireBuffer.ChannelCount) &&
+			(::memcmp(streamedBuffer.InterleavedSamples.get(), entireBuffer.InterleavedSamples.get(), entireBuffer.ByteSize()) == 0);
+		songLoadingBenchmark.WaveformMatches = (streamedWaveformL.BucketData == entireWaveformL.BucketData && streamedWaveformR.BucketData == entireWaveformR.BucketData);
+
+		// NOTE: Inside a separate directory that is emptied before and after so that neither the actual song cache nor a previous run can affect the result.
+		//		 The warm load is the same as when the chart editor hits the cache, except for the samples being copied all at once instead of block by block
+		static constexpr std::string_view cacheDirectory = "song_loading_benchmark_cache";
+		Audio::EvictDecodeCacheEntries(cacheDirectory, 0);
+		defer { Audio::EvictDecodeCacheEntries(cacheDirectory, 0); };
+
+		stopwatch.Restart();
+		const Audio::DecodeCacheKey cacheKey = Audio::ComputeDecodeCacheKey(fileContent.Content.get(), fileContent.Size);
+		songLoadingBenchmark.CacheKeyDuration = stopwatch.Restart();
+
+		const Audio::WaveformMipChain streamedWaveforms[2] = { std::move(streamedWaveformL), std::move(streamedWaveformR) };
+		songLoadingBenchmark.CacheWriteSucceeded = Audio::WriteDecodeCacheEntry(cacheDirectory, cacheKey, streamedBuffer, Audio::DefaultResamplerQuality, streamedWaveforms, Min<size_t>(streamedBuffer.ChannelCount, 2));
+		songLoadingBenchmark.CacheWriteDuration = stopwatch.Stop();
+		if (!songLoadingBenchmark.CacheWriteSucceeded)
+			return;
+
+		Audio::PCMSampleBuffer cachedBuffer;
+		Audio::WaveformMipChain cachedWaveforms[2];
+		stopwatch.Restart();
+		{
+			Audio::DecodeCacheEntry cacheEntry;
+			if (!cacheEntry.Open(cacheDirectory, cacheKey, targetSampleRate, Audio::DefaultResamplerQuality))
+				return;
+
+			cachedBuffer.ChannelCount = cacheEntry.GetChannelCount();
+			cachedBuffer.SampleRate = cacheEntry.GetSampleRate();
+			cachedBuffer.FrameCount = cacheEntry.GetFrameCount();
+			cachedBuffer.InterleavedSamples = std::unique_ptr<i16[]>(new i16[cachedBuffer.SampleCount()]);
+			::memcpy(cachedBuffer.InterleavedSamples.get(), cacheEntry.GetInterleavedSamples(), cachedBuffer.ByteSize());
+			for (size_t i = 0; i < cacheEntry.GetWaveformCount(); i++)
+				cacheEntry.CopyWaveform(i, cachedWaveforms[i]);
+			songLoadingBenchmark.CacheEntryByteSize = cacheEntry.GetFileSize();
+
+			// NOTE: Only the coarse mips are stored so the finer ones have to be generated from the cached samples, same as the chart editor does afterwards
+			Audio::WaveformMipChain::ContinueIncrementalStereoMipChainGeneration(cachedWaveforms[0], (cacheEntry.GetWaveformCount() > 1) ? &cachedWaveforms[1] : nullptr, cachedBuffer, cachedBuffer.FrameCount);
+		}
+		songLoadingBenchmark.CacheWarmDuration = stopwatch.Stop();
+
+		songLoadingBenchmark.CacheMatches = (cachedBuffer.FrameCount == streamedBuffer.FrameCount && cachedBuffer.ChannelCount == streamedBuffer.ChannelCount) &&
+			(::memcmp(cachedBuffer.InterleavedSamples.get(), streamedBuffer.InterleavedSamples.get(), streamedBuffer.ByteSize()) == 0) &&
+			(cachedWaveforms[0].BucketData == streamedWaveforms[0].BucketData && cachedWaveforms[1].BucketData == streamedWaveforms[1].BucketData);
+	}
+
+	void AudioTestWindow::WaveformTabContent()
+	{
+		if (Gui::Button("Run Benchmark", vec2(Gui::GetContentRegionAvail().x, 0.0f)))
+			RunWaveformBenchmark();
+
+		const WaveformBenchmarkResult& result = waveformBenchmark;
+		Gui::Property::Table(ImGuiTableFlags_BordersInner | ImGuiTableFlags_ScrollY, [&]
+		{
+			if (!result.HasRun)
+			{
+				Gui::Property::PropertyTextValueFunc("Result", [&] { Gui::TextDisabled("(Not run)"); });
+				return;
+			}
+
+			Gui::Property::PropertyTextValueFunc("Mip Chain", [&] { Gui::Text("%d mips, %.2f MB per channel", result.MipCount, static_cast<f64>(result.BucketDataByteSize) / (1024.0 * 1024.0)); });
+			for (size_t setIndex = 0; setIndex < EnumCount<Audio::MixKernelSet>; setIndex++)
+			{
+				Gui::Property::PropertyTextValueFunc(Audio::MixKernelSetNames[setIndex], [&]
+				{
+					if (!Audio::IsMixKernelSetSupported(static_cast<Audio::MixKernelSet>(setIndex)))
+						Gui::TextDisabled("(Unsupported)");
+					else
+						Gui::TextColored(result.MatchesScalar[setIndex] ? Gui::GetStyleColorVec4(ImGuiCol_Text) : ImVec4(1.0f, 0.3f, 0.3f, 1.0f),
+							"%.3f ms for both channels (identical to scalar: %s)", result.GenerationDuration[setIndex].ToMS(), result.MatchesScalar[setIndex] ? "Yes" : "No");
+				});
+			}
+			Gui::Property::PropertyTextValueFunc("Stereo: Single Thread", [&] { Gui::Text("%.3f ms for both channels", result.StereoSingleThreadDuration.ToMS()); });
+			Gui::Property::PropertyTextValueFunc("Stereo: Parallel", [&]
+			{
+				Gui::TextColored(result.StereoMatchesScalar ? Gui::GetStyleColorVec4(ImGuiCol_Text) : ImVec4(1.0f, 0.3f, 0.3f, 1.0f),
+					"%.3f ms for both channels on %u threads (identical to scalar: %s)", result.StereoParallelDuration.ToMS(), result.StereoThreadCount, result.StereoMatchesScalar ? "Yes" : "No");
+			});
+			Gui::Property::PropertyTextValueFunc("Amplitude Query", [&] { Gui::Text("%.3f ns/pixel", result.NanosecondsPerPixelQuery); });
+			Gui::Property::PropertyTextValueFunc("Source Reads: Identical", [&]
+			{
+				Gui::TextColored(result.SourceReadsMatchFullSizeMip ? Gui::GetStyleColorVec4(ImGuiCol_Text) : ImVec4(1.0f, 0.3f, 0.3f, 1.0f), result.SourceReadsMatchFullSizeMip ? "Yes" : "No");
+			});
+			Gui::Property::PropertyTextValueFunc("Chunk Cache: Identical", [&]
+			{
+				Gui::TextColored(result.ChunkCacheMatchesUncached ? Gui::GetStyleColorVec4(ImGuiCol_Text) : ImVec4(1.0f, 0.3f, 0.3f, 1.0f), result.ChunkCacheMatchesUncached ? "Yes" : "No");
+			});
+			Gui::Property::PropertyTextValueFunc("Chunk Cache: Computed", [&] { Gui::Text("%d of %d visible chunks", result.ChunkCacheComputedChunks, result.ChunkCacheVisibleChunks); });
+			Gui::Property::PropertyTextValueFunc("Chunk Cache: Frame Time", [&] { Gui::Text("%.3f us cached, %.3f us uncached", result.CachedMicrosecondsPerFrame, result.UncachedMicrosecondsPerFrame); });
+		});
+	}
+
+	void AudioTestWindow::RunWaveformBenchmark()
+	{
+		static constexpr u32 sampleRate = Audio::AudioEngine::OutputSampleRate;
+		static constexpr i64 frameCount = (sampleRate * 60 * 5);
+		static constexpr i32 queryPixelCount = 1920;
+
+		waveformBenchmark = {};
+		waveformBenchmark.HasRun = true;
+
+		// NOTE: Noise on top of a slowly changing sine with an occasional full scale peak, which averaging would have smoothed away
+		u32 randomState = 0x1234567;
+		auto nextRandom = [&]() { randomState = (randomState * 1664525u) + 1013904223u; return randomState; };
+
+		Audio::PCMSampleBuffer sampleBuffer;
+		sampleBuffer.ChannelCount = 2;
+		sampleBuffer.SampleRate = sampleRate;
+		sampleBuffer.FrameCount = frameCount;
+		sampleBuffer.InterleavedSamples = std::unique_ptr<i16[]>(new i16[sampleBuffer.SampleCount()]);
+		for (size_t i = 0; i < sampleBuffer.SampleCount(); i++)
+		{
+			const u32 random = nextRandom();
+			const f32 sine = static_cast<f32>(::sin(static_cast<f64>(i) * 0.0005)) * 16000.0f;
+			sampleBuffer.InterleavedSamples[i] = ((random % 100000) == 0) ? I16Max : static_cast<i16>(sine + static_cast<f32>(static_cast<i16>(random >> 16) / 4));
+		}
+
+		Audio::WaveformMipChain scalarWaveforms[2];
+		for (size_t setIndex = 0; setIndex < EnumCount<Audio::MixKernelSet>; setIndex++)
+		{
+			if (!Audio::IsMixKernelSetSupported(static_cast<Audio::MixKernelSet>(setIndex)))
+				continue;
+
+			const Audio::WaveformKernels& kernels = Audio::GetWaveformKernels(static_cast<Audio::MixKernelSet>(setIndex));
+			Audio::WaveformMipChain waveforms[2];
+			CPUStopwatch stopwatch = CPUStopwatch::StartNew();
+			for (u32 channelIndex = 0; channelIndex < 2; channelIndex++)
+				waveforms[channelIndex].GenerateEntireMipChainFromSampleBuffer(sampleBuffer, channelIndex, false, kernels);
+			waveformBenchmark.GenerationDuration[setIndex] = stopwatch.Stop();
+
+			if (setIndex == EnumToIndex(Audio::MixKernelSet::Scalar))
+			{
+				scalarWaveforms[0] = std::move(waveforms[0]);
+				scalarWaveforms[1] = std::move(waveforms[1]);
+			}
+			waveformBenchmark.MatchesScalar[setIndex] = (setIndex == EnumToIndex(Audio::MixKernelSet::Scalar)) ||
+				(waveforms[0].BucketData == scalarWaveforms[0].BucketData && waveforms[1].BucketData == scalarWaveforms[1].BucketData);
+		}
+
+		// NOTE: Same as when loading a song in the chart editor
+		{
+			Audio::WaveformMipChain stereoWaveforms[2];
+			CPUStopwatch stopwatch = CPUStopwatch::StartNew();
+			Audio::WaveformMipChain::GenerateEntireStereoMipChainsFromSampleBuffer(stereoWaveforms[0], &stereoWaveforms[1], sampleBuffer, false, 1);
+			waveformBenchmark.StereoSingleThreadDuration = stopwatch.Restart();
+			Audio::WaveformMipChain::GenerateEntireStereoMipChainsFromSampleBuffer(stereoWaveforms[0], &stereoWaveforms[1], sampleBuffer, false, 0);
+			waveformBenchmark.StereoParallelDuration = stopwatch.Stop();
+
+			waveformBenchmark.StereoThreadCount = Max(std::thread::hardware_concurrency(), 1u);
+			waveformBenchmark.StereoMatchesScalar = (stereoWaveforms[0].BucketData == scalarWaveforms[0].BucketData && stereoWaveforms[1].BucketData == scalarWaveforms[1].BucketData);
+		}
+
+		const Audio::WaveformMipChain& waveform = scalarWaveforms[0];
+		waveformBenchmark.MipCount = waveform.GetUsedMipCount();
+		waveformBenchmark.BucketDataByteSize = (waveform.BucketData.size() * sizeof(i16));
+
+		// NOTE: From a single frame per pixel up to the entire song fitting on screen, summed up so that the queries can't be optimized away
+		f32 amplitudeSum = 0.0f;
+		i32 queryCount = 0;
+		CPUStopwatch stopwatch = CPUStopwatch::StartNew();
+		for (Time timePerPixel = Time::FromSec(1.0 / sampleRate); timePerPixel.Seconds * queryPixelCount < (waveform.Duration.Seconds * 2.0); timePerPixel = timePerPixel * 2.0)
+		{
+			const Audio::WaveformMip& mip = waveform.FindClosestMip(timePerPixel);
+			const Time startTime = Time::FromSec(Max(0.0, (waveform.Duration.Seconds - (timePerPixel.Seconds * queryPixelCount)) * 0.5));
+			for (i32 pixel = 0; pixel < queryPixelCount; pixel++)
+				amplitudeSum += waveform.GetAmplitudeAt(mip, startTime + (timePerPixel * static_cast<f64>(pixel)), timePerPixel);
+			queryCount += queryPixelCount;
+		}
+		waveformBenchmark.NanosecondsPerPixelQuery = (stopwatch.Stop().ToSec() * 1000000000.0) / static_cast<f64>(Max(queryCount, 1));
+		volatile f32 amplitudeSumSink = amplitudeSum; (void)amplitudeSumSink;
+
+		// NOTE: Zoomed in further than the base mip the source samples are read directly instead, which at a single frame per pixel has to match the full size mip.
+		//		 Only compared for the first few seconds as the full size mip of the entire song would take up hundreds of MB
+		{
+			Audio::PCMSampleBuffer shortBuffer;
+			shortBuffer.ChannelCount = sampleBuffer.ChannelCount;
+			shortBuffer.SampleRate = sampleBuffer.SampleRate;
+			shortBuffer.FrameCount = Min<i64>(sampleRate * 4, sampleBuffer.FrameCount);
+			shortBuffer.InterleavedSamples = std::unique_ptr<i16[]>(new i16[shortBuffer.SampleCount()]);
+			::memcpy(shortBuffer.InterleavedSamples.get(), sampleBuffer.InterleavedSamples.get(), shortBuffer.ByteSize());
+
+			Audio::WaveformMipChain shortWaveform, fullSizeWaveform;
+			shortWaveform.GenerateEntireMipChainFromSampleBuffer(shortBuffer, 1);
+			fullSizeWaveform.GenerateEntireMipChainFromSampleBuffer(shortBuffer, 1, true);
+
+			const Time timePerPixel = Time::FromSec(1.0 / sampleRate);
+			waveformBenchmark.SourceReadsMatchFullSizeMip = true;
+			for (i64 frame = 0; frame < shortBuffer.FrameCount; frame++)
+			{
+				const Time time = (timePerPixel * static_cast<f64>(frame));
+				waveformBenchmark.SourceReadsMatchFullSizeMip &= (shortWaveform.GetSourceAmplitudeAt(shortBuffer, 1, time, timePerPixel) == fullSizeWaveform.GetAmplitudeAt(fullSizeWaveform.AllMips[0], time, timePerPixel));
+			}
+		}
+
+		// NOTE: Scrolling across the song at a few zoom levels while the waveform is still being generated (same as when streaming in a song),
+		//		 comparing every chunk returned by the cache to the uncached path at that point in time. The first zoom level reads the source samples directly
+		static constexpr i32 scrollFrameCount = 240;
+		static constexpr f32 scrollPixelsPerFrame = 37.0f;
+		static constexpr i64 visibleChunkCount = (queryPixelCount / CustomDraw::WaveformPixelsPerChunk) + 1;
+		static constexpr f64 scrollTimePerPixelSec[] = { 4.0 / sampleRate, 0.001, 0.01 };
+
+		Audio::WaveformMipChain streamedWaveform;
+		TimelineWaveformChunkCache chunkCache;
+		CustomDraw::WaveformChunk uncachedChunk;
+		waveformBenchmark.ChunkCacheMatchesUncached = true;
+		for (const f64 timePerPixelSec : scrollTimePerPixelSec)
+		{
+			const Time timePerPixel = TimelineWaveformChunkCache::QuantizeTimePerPixel(Time::FromSec(timePerPixelSec));
+			streamedWaveform.BeginIncrementalMipChainGeneration(sampleBuffer.FrameCount, sampleBuffer.SampleRate);
+			chunkCache.Invalidate();
+
+			for (i32 frame = 0; frame < scrollFrameCount; frame++)
+			{
+				streamedWaveform.ContinueIncrementalMipChainGeneration(sampleBuffer, 0, (frameCount * (frame + 1)) / (scrollFrameCount / 2));
+				chunkCache.BeginFrame(streamedWaveform, timePerPixel, &sampleBuffer, 0);
+
+				const i64 firstChunkIndex = TimelineWaveformChunkCache::GetChunkIndexAtTime(timePerPixel * static_cast<f64>(frame * scrollPixelsPerFrame), timePerPixel);
+				for (i64 chunkIndex = firstChunkIndex; chunkIndex < (firstChunkIndex + visibleChunkCount); chunkIndex++)
+				{
+					const CustomDraw::WaveformChunk& cachedChunk = chunkCache.GetChunk(chunkIndex);
+					TimelineWaveformChunkCache::ComputeChunk(streamedWaveform, streamedWaveform.FindClosestMip(timePerPixel), timePerPixel, chunkIndex, uncachedChunk, &sampleBuffer, 0);
+					waveformBenchmark.ChunkCacheMatchesUncached &= (::memcmp(&cachedChunk, &uncachedChunk, sizeof(uncachedChunk)) == 0);
+				}
+				waveformBenchmark.ChunkCacheVisibleChunks += static_cast<i32>(visibleChunkCount);
+				waveformBenchmark.ChunkCacheComputedChunks += chunkCache.ChunksComputedThisFrame;
+			}
+		}
+
+		// NOTE: Same scrolling with the entire waveform available, once through the cache and once computing every visible chunk each frame
+		for (size_t cached = 0; cached < 2; cached++)
+		{
+			stopwatch.Restart();
+			for (const f64 timePerPixelSec : scrollTimePerPixelSec)
+			{
+				const Time timePerPixel = TimelineWaveformChunkCache::QuantizeTimePerPixel(Time::FromSec(timePerPixelSec));
+				const Audio::WaveformMip& mip = waveform.FindClosestMip(timePerPixel);
+				chunkCache.Invalidate();
+
+				for (i32 frame = 0; frame < scrollFrameCount; frame++)
+				{
+					if (cached) chunkCache.BeginFrame(waveform, timePerPixel, &sampleBuffer, 0);
+					const i64 firstChunkIndex = TimelineWaveformChunkCache::GetChunkIndexAtTime(timePerPixel * static_cast<f64>(frame * scrollPixelsPerFrame), timePerPixel);
+					for (i64 chunkIndex = firstChunkIndex; chunkIndex < (firstChunkIndex + visibleChunkCount); chunkIndex++)
+						amplitudeSum += cached ? chunkCache.GetChunk(chunkIndex).PerPixelAmplitude[0] : (TimelineWaveformChunkCache::ComputeChunk(waveform, mip, timePerPixel, chunkIndex, uncachedChunk, &sampleBuffer, 0), uncachedChunk.PerPixelAmplitude[0]);
+				}
+			}
+			(cached ? waveformBenchmark.CachedMicrosecondsPerFrame : waveformBenchmark.UncachedMicrosecondsPerFrame) = (stopwatch.Stop().ToSec() * 1000000.0) / static_cast<f64>(scrollFrameCount * ArrayCount(scrollTimePerPixelSec));
+		}
+		amplitudeSumSink = amplitudeSum;
+	}
+
+	void AudioTestWindow::ResamplerTabContent()
+	{
+		if (Gui::Button("Run Benchmark", vec2(Gui::GetContentRegionAvail().x, 0.0f)))
+			RunResamplerBenchmark();
+
+		const ResamplerBenchmarkResult& result = resamplerBenchmark;
+		Gui::Property::Table(ImGuiTableFlags_BordersInner | ImGuiTableFlags_ScrollY, [&]
+		{
+			if (!result.HasRun)
+			{
+				Gui::Property::PropertyTextValueFunc("Result", [&] { Gui::TextDisabled("(Not run)"); });
+				return;
+			}
+
+			auto qualityProperties = [&](size_t qualityIndex)
+			{
+				Gui::Property::PropertyTextValueFunc("Passband SNR", [&] { Gui::Text("%.1f dB", result.PassbandSNR[qualityIndex]); });
+				Gui::Property::PropertyTextValueFunc("Stopband Rejection", [&] { Gui::Text("%.1f dB", result.StopbandRejection[qualityIndex]); });
+			};
+
+			Gui::Property::PropertyTextValueFunc("Conversion", [&] { Gui::Text("%u Hz -> %u Hz, %.0f sec stereo", result.SourceSampleRate, result.TargetSampleRate, result.AudioDuration.ToSec()); });
+			for (size_t qualityIndex = 0; qualityIndex < EnumCount<Audio::ResamplerQuality>; qualityIndex++)
+			{
+				char label[64]; sprintf_s(label, "%s (%u taps, %u phases)", Audio::ResamplerQualityNames[qualityIndex], result.TapCount[qualityIndex], result.PhaseCount[qualityIndex]);
+				Gui::PushID(static_cast<int>(qualityIndex));
+				Gui::Property::PropertyTreeNodeValueFunc(label, ImGuiTreeNodeFlags_DefaultOpen, [&]
+				{
+					for (size_t setIndex = 0; setIndex < EnumCount<Audio::MixKernelSet>; setIndex++)
+					{
+						Gui::Property::PropertyTextValueFunc(Audio::MixKernelSetNames[setIndex], [&]
+						{
+							const Time duration = result.Duration[qualityIndex][setIndex];
+							if (!Audio::IsMixKernelSetSupported(static_cast<Audio::MixKernelSet>(setIndex)))
+								Gui::TextDisabled("(Unsupported)");
+							else
+								Gui::TextColored(result.MatchesScalar[qualityIndex][setIndex] ? Gui::GetStyleColorVec4(ImGuiCol_Text) : ImVec4(1.0f, 0.3f, 0.3f, 1.0f),
+									"%.3f ms (%.0fx realtime, identical to scalar: %s)", duration.ToMS(), result.AudioDuration.ToSec() / Max(duration.ToSec(), 0.000001), result.MatchesScalar[qualityIndex][setIndex] ? "Yes" : "No");
+						});
+					}
+					qualityProperties(qualityIndex);
+				});
+				Gui::PopID();
+			}
+			Gui::Property::PropertyTreeNodeValueFunc("Linear (Previous)", ImGuiTreeNodeFlags_DefaultOpen, [&] { qualityProperties(EnumCount<Audio::ResamplerQuality>); });
+		});
+	}
+
+	// NOTE: Exponential sweep at half of full scale, faded in and out so that neither end introduces any broadband clicks
+	static std::vector<i16> GenerateSineSweep(u32 sampleRate, f64 durationSec, f64 startFrequency, f64 endFrequency)
+	{
+		static constexpr f64 fadeDurationSec = 0.02;
+		const f64 sweepRate = ::log(endFrequency / startFrequency) / durationSec;
+
+		std::vector<i16> samples(static_cast<size_t>(durationSec * sampleRate));
+		for (size_t i = 0; i < samples.size(); i++)
+		{
+			const f64 second = static_cast<f64>(i) / static_cast<f64>(sampleRate);
+			const f64 phase = (2.0 * 3.14159265358979323846) * startFrequency * (::exp(second * sweepRate) - 1.0) / sweepRate;
+			const f64 fade = Clamp(Min(second, durationSec - second) / fadeDurationSec, 0.0, 1.0);
+			const f64 envelope = 0.5 - (0.5 * ::cos(3.14159265358979323846 * fade));
+			samples[i] = static_cast<i16>(::round(::sin(phase) * envelope * (I16Max / 2)));
+		}
+		return samples;
+	}
+
+	void AudioTestWindow::RunResamplerBenchmark()
+	{
+		static constexpr u32 sourceSampleRate = 48000;
+		static constexpr u32 targetSampleRate = Audio::AudioEngine::OutputSampleRate;
+		static constexpr i64 frameCount = (sourceSampleRate * 60);
+		static constexpr f64 sweepDurationSec = 4.0;
+		static constexpr size_t linearIndex = EnumCount<Audio::ResamplerQuality>;
+		static_assert(sourceSampleRate != targetSampleRate);
+
+		resamplerBenchmark = {};
+		resamplerBenchmark.HasRun = true;
+		resamplerBenchmark.SourceSampleRate = sourceSampleRate;
+		resamplerBenchmark.TargetSampleRate = targetSampleRate;
+		resamplerBenchmark.AudioDuration = Time::FromSec(static_cast<f64>(frameCount) / sourceSampleRate);
+
+		u32 randomState = 0x1234567;
+		auto nextRandom = [&]() { randomState = (randomState * 1664525u) + 1013904223u; return randomState; };
+
+		std::vector<i16> songSamples(frameCount * 2);
+		for (size_t i = 0; i < songSamples.size(); i++)
+			songSamples[i] = static_cast<i16>(static_cast<f32>(::sin(static_cast<f64>(i) * 0.01)) * 12000.0f + static_cast<f32>(static_cast<i16>(nextRandom() >> 16) / 4));
+
+		// NOTE: Same block size as the song decoder
+		auto resampleInBlocks = [](const std::vector<i16>& inSamples, u32 channelCount, Audio::ResamplerQuality quality, const Audio::ResamplerKernels& kernels)
+		{
+			const i64 inFrameCount = static_cast<i64>(inSamples.size() / channelCount);
+			Audio::BlockResampler resampler;
+			resampler.Reset(channelCount, sourceSampleRate, targetSampleRate, static_cast<size_t>(inFrameCount), quality, kernels);
+
+			std::vector<i16> outSamples(resampler.OutputFrameCount * channelCount);
+			for (i64 frame = 0; frame < inFrameCount; frame += Audio::BlockDecoder::BlockFrameCount)
+			{
+				const i64 blockFrameCount = Min(Audio::BlockDecoder::BlockFrameCount, inFrameCount - frame);
+				resampler.ProcessBlock(&inSamples[frame * channelCount], blockFrameCount, outSamples.data(), (frame + blockFrameCount) >= inFrameCount);
+			}
+			return outSamples;
+		};
+
+		// NOTE: Same as the previous LinearlyResampleBuffer(), truncating towards zero and without any low pass filter
+		auto resampleLinearly = [](const std::vector<i16>& inSamples)
+		{
+			std::vector<i16> outSamples(static_cast<size_t>(inSamples.size() * static_cast<f64>(targetSampleRate) / sourceSampleRate + 0.5));
+			for (size_t i = 0; i < outSamples.size(); i++)
+			{
+				const f64 frameFraction = (static_cast<f64>(i) * sourceSampleRate / targetSampleRate);
+				const size_t startFrame = static_cast<size_t>(frameFraction);
+				const f64 start = (startFrame < inSamples.size()) ? inSamples[startFrame] : 0.0;
+				const f64 end = ((startFrame + 1) < inSamples.size()) ? inSamples[startFrame + 1] : 0.0;
+				outSamples[i] = static_cast<i16>(start + ((end - start) * (frameFraction - static_cast<f64>(startFrame))));
+			}
+			return outSamples;
+		};
+
+		for (size_t qualityIndex = 0; qualityIndex < EnumCount<Audio::ResamplerQuality>; qualityIndex++)
+		{
+			const Audio::ResamplerQuality quality = static_cast<Audio::ResamplerQuality>(qualityIndex);
+			Audio::PolyphaseFilterTable table;
+			table.Build(sourceSampleRate, targetSampleRate, quality);
+			resamplerBenchmark.TapCount[qualityIndex] = table.TapCount;
+			resamplerBenchmark.PhaseCount[qualityIndex] = table.PhaseCount;
+
+			std::vector<i16> scalarSamples;
+			for (size_t setIndex = 0; setIndex < EnumCount<Audio::MixKernelSet>; setIndex++)
+			{
+				if (!Audio::IsMixKernelSetSupported(static_cast<Audio::MixKernelSet>(setIndex)))
+					continue;
+
+				CPUStopwatch stopwatch = CPUStopwatch::StartNew();
+				std::vector<i16> samples = resampleInBlocks(songSamples, 2, quality, Audio::GetResamplerKernels(static_cast<Audio::MixKernelSet>(setIndex)));
+				resamplerBenchmark.Duration[qualityIndex][setIndex] = stopwatch.Stop();
+
+				if (setIndex == EnumToIndex(Audio::MixKernelSet::Scalar))
+					scalarSamples = std::move(samples);
+				resamplerBenchmark.MatchesScalar[qualityIndex][setIndex] = (setIndex == EnumToIndex(Audio::MixKernelSet::Scalar)) || (samples == scalarSamples);
+			}
+		}
+
+		// NOTE: The in-band sweep stays well below the target Nyquist frequency while the stopband sweep lies entirely between the two Nyquist frequencies
+		const std::vector<i16> passbandSweep = GenerateSineSweep(sourceSampleRate, sweepDurationSec, 20.0, 16000.0);
+		const std::vector<i16> passbandReference = GenerateSineSweep(targetSampleRate, sweepDurationSec, 20.0, 16000.0);
+		const std::vector<i16> stopbandSweep = GenerateSineSweep(sourceSampleRate, sweepDurationSec, (targetSampleRate * 0.5) + 50.0, (sourceSampleRate * 0.5) - 100.0);
+
+		f64 stopbandSweepEnergy = 0.0;
+		for (const i16 sample : stopbandSweep)
+			stopbandSweepEnergy += static_cast<f64>(sample) * sample;
+
+		for (size_t qualityIndex = 0; qualityIndex <= linearIndex; qualityIndex++)
+		{
+			auto resample = [&](const std::vector<i16>& inSamples) { return (qualityIndex == linearIndex) ? resampleLinearly(inSamples) : resampleInBlocks(inSamples, 1, static_cast<Audio::ResamplerQuality>(qualityIndex), Audio::GetResamplerKernels()); };
+			const std::vector<i16> passbandOutput = resample(passbandSweep);
+			const std::vector<i16> stopbandOutput = resample(stopbandSweep);
+
+			f64 referenceEnergy = 0.0, errorEnergy = 0.0, aliasEnergy = 0.0;
+			for (size_t i = 0; i < Min(passbandOutput.size(), passbandReference.size()); i++)
+			{
+				const f64 error = static_cast<f64>(passbandOutput[i]) - passbandReference[i];
+				referenceEnergy += static_cast<f64>(passbandReference[i]) * passbandReference[i];
+				errorEnergy += (error * error);
+			}
+			for (const i16 sample : stopbandOutput)
+				aliasEnergy += static_cast<f64>(sample) * sample;
+
+			// NOTE: Energy per second instead of per sample so that the two different sample rates can be compared directly
+			const f64 aliasEnergyRatio = (aliasEnergy / targetSampleRate) / (stopbandSweepEnergy / sourceSampleRate);
+			resamplerBenchmark.PassbandSNR[qualityIndex] = 10.0 * ::log10(referenceEnergy / Max(errorEnergy, 1.0));
+			resamplerBenchmark.StopbandRejection[qualityIndex] = 10.0 * ::log10(Max(aliasEnergyRatio, 1e-15));
+		}
+	}
+
+	void AudioTestWindow::StressTestTabContent()
+	{
+		Gui::SetNextItemWidth(Gui::GetContentRegionAvail().x);
+		if (Gui::BeginCombo("##StressTestMode", StressTestModeNames[EnumToIndex(stressTestMode)], ImGuiComboFlags_None))
+		{
+			for (size_t i = 0; i < EnumCount<StressTestMode>; i++)
+			{
+				if (Gui::Selectable(StressTestModeNames[i], (i == EnumToIndex(stressTestMode))))
+					stressTestMode = static_cast<StressTestMode>(i);
+			}
+			Gui::EndCombo();
+		}
+		if (Gui::Button("Run Stress Test", vec2(Gui::GetContentRegionAvail().x, 0.0f)))
+			RunStressTest();
+
+		const StressTestResult& result = stressTest;
+		Gui::Property::Table(ImGuiTableFlags_BordersInner | ImGuiTableFlags_ScrollY, [&]
+		{
+			if (!result.HasRun)
+			{
+				Gui::Property::PropertyTextValueFunc("Result", [&] { Gui::TextDisabled("(Not run)"); });
+				return;
+			}
+
+			const ImVec4 failedColor = ImVec4(1.0f, 0.3f, 0.3f, 1.0f);
+			Gui::Property::PropertyTextValueFunc("Mode", [&] { Gui::Text("%s (%u producer threads)", StressTestModeNames[EnumToIndex(result.Mode)], result.ThreadCount); });
+			Gui::Property::PropertyTextValueFunc("Iterations", [&]
+			{
+				Gui::Text("%llu in %.0f ms (%.0f per second)", static_cast<unsigned long long>(result.Iterations), result.Duration.ToMS(), static_cast<f64>(result.Iterations) / Max(result.Duration.ToSec(), 0.000001));
+			});
+			if (result.Mode == StressTestMode::ReopenedStream)
+				Gui::Property::PropertyTextValueFunc("Stream Reopened", [&] { Gui::Text("%u times", result.StreamReopenCount); });
+			Gui::Property::PropertyTextValueFunc("Failed Iterations", [&]
+			{
+				Gui::TextColored((result.FailedIterations == 0) ? Gui::GetStyleColorVec4(ImGuiCol_Text) : failedColor, "%llu", static_cast<unsigned long long>(result.FailedIterations));
+			});
+			Gui::Property::PropertyTextValueFunc("Leaked Slots", [&]
+			{
+				const b8 leaked = (result.LeakedVoiceSlots != 0 || result.LeakedSourceSlots != 0);
+				Gui::TextColored(!leaked ? Gui::GetStyleColorVec4(ImGuiCol_Text) : failedColor, "Voices: %lld, Sources: %lld", static_cast<long long>(result.LeakedVoiceSlots), static_cast<long long>(result.LeakedSourceSlots));
+			});
+			Gui::Property::PropertyTextValueFunc("Max Unload Duration", [&] { Gui::Text("%.3f ms", result.MaxUnloadDuration.ToMS()); });
+		});
+	}
+
+	void AudioTestWindow::RunStressTest()
+	{
+		static constexpr Time testDuration = Time::FromSec(2.0);
+		static constexpr Time streamReopenInterval = Time::FromMS(20.0);
+		static constexpr u32 offlineRenderFrameCount = 256;
+
+		stressTest = {};
+		stressTest.HasRun = true;
+		stressTest.Mode = stressTestMode;
+		stressTest.ThreadCount = Clamp<u32>(std::thread::hardware_concurrency(), 2, 8);
+
+		const b8 streamWasRunning = Audio::Engine.GetIsStreamOpenRunning();
+		if (stressTestMode == StressTestMode::OfflineRender)
+			Audio::Engine.StopCloseStream();
+		else
+			Audio::Engine.EnsureStreamRunning();
+
+		// NOTE: Giving the render callback (or the next voice slot claim without a stream) the chance to release everything removed so far
+		auto renderUntilSettled = [&]()
+		{
+			std::vector<i16> outputBuffer(offlineRenderFrameCount * Audio::AudioEngine::OutputChannelCount);
+			if (!Audio::Engine.DebugRenderWithoutStream(outputBuffer.data(), offlineRenderFrameCount))
+				std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		};
+		renderUntilSettled();
+		const auto claimedSlotsBefore = Audio::Engine.DebugGetClaimedSlotCounts();
+
+		struct ProducerResult { u64 Iterations, FailedIterations; Time MaxUnloadDuration; };
+		std::vector<ProducerResult> producerResults(stressTest.ThreadCount);
+		std::atomic<b8> stopRequested = false;
+
+		const auto producerFunc = [&](u32 threadIndex)
+		{
+			ProducerResult& producerResult = producerResults[threadIndex];
+			u32 randomState = 0x1234567 + threadIndex;
+			auto nextRandom = [&]() { randomState = (randomState * 1664525u) + 1013904223u; return (randomState >> 8); };
+
+			while (!stopRequested)
+			{
+				Audio::PCMSampleBuffer sampleBuffer = {};
+				sampleBuffer.ChannelCount = Audio::AudioEngine::OutputChannelCount;
+				sampleBuffer.SampleRate = Audio::AudioEngine::OutputSampleRate;
+				sampleBuffer.FrameCount = 64 + (nextRandom() % 256);
+				sampleBuffer.InterleavedSamples = std::make_unique<i16[]>(sampleBuffer.FrameCount * sampleBuffer.ChannelCount);
+				for (i64 i = 0; i < (sampleBuffer.FrameCount * sampleBuffer.ChannelCount); i++)
+					sampleBuffer.InterleavedSamples[i] = static_cast<i16>(nextRandom());
+
+				// NOTE: All silent so that running this while a song is playing is at least bearable
+				const Audio::SourceHandle source = Audio::Engine.LoadSourceFromBufferMove("StressTestSource", std::move(sampleBuffer));
+				Audio::Engine.PlayOneShotSound(source, "StressTestOneShot", 0.0f);
+				Audio::Voice voice = Audio::Engine.AddVoice(source, "StressTestVoice", false, 0.0f);
+				voice.SetPauseOnEnd(true);
+				voice.SetPosition(Time::FromMS(-1.0));
+				voice.SetIsPlaying(true);
+				std::this_thread::sleep_for(std::chrono::microseconds(nextRandom() % 1500));
+				voice.SetPosition(Time::Zero());
+				voice.SetPlaybackSpeed(1.5f);
+				Audio::Engine.RemoveVoice(voice.Handle);
+
+				CPUStopwatch unloadStopwatch = CPUStopwatch::StartNew();
+				Audio::Engine.UnloadSource(source);
+				producerResult.MaxUnloadDuration = Max(producerResult.MaxUnloadDuration, unloadStopwatch.Stop());
+
+				producerResult.Iterations++;
+				producerResult.FailedIterations += (source == Audio::SourceHandle::Invalid || voice.Handle == Audio::VoiceHandle::Invalid);
+			}
+		};
+
+		std::thread offlineRenderThread;
+		if (stressTestMode == StressTestMode::OfflineRender)
+		{
+			offlineRenderThread = std::thread([&]()
+			{
+				std::vector<i16> outputBuffer(offlineRenderFrameCount * Audio::AudioEngine::OutputChannelCount);
+				while (!stopRequested)
+				{
+					Audio::Engine.DebugRenderWithoutStream(outputBuffer.data(), offlineRenderFrameCount);
+					std::this_thread::yield();
+				}
+			});
+		}
+
+		CPUStopwatch stopwatch = CPUStopwatch::StartNew();
+		std::vector<std::thread> producerThreads;
+		for (u32 i = 0; i < stressTest.ThreadCount; i++)
+			producerThreads.emplace_back(producerFunc, i);
+
+		while (stopwatch.GetElapsed() < testDuration)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<i64>(streamReopenInterval.ToMS())));
+			if (stressTestMode == StressTestMode::ReopenedStream)
+			{
+				Audio::Engine.StopCloseStream();
+				Audio::Engine.OpenStartStream();
+				stressTest.StreamReopenCount++;
+			}
+		}
+
+		stopRequested = true;
+		for (std::thread& thread : producerThreads)
+			thread.join();
+		if (offlineRenderThread.joinable())
+			offlineRenderThread.join();
+		stressTest.Duration = stopwatch.Stop();
+
+		renderUntilSettled();
+		const auto claimedSlotsAfter = Audio::Engine.DebugGetClaimedSlotCounts();
+		stressTest.LeakedVoiceSlots = static_cast<i64>(claimedSlotsAfter.Voices) - static_cast<i64>(claimedSlotsBefore.Voices);
+		stressTest.LeakedSourceSlots = static_cast<i64>(claimedSlotsAfter.Sources) - static_cast<i64>(claimedSlotsBefore.Sources);
+
+		for (const ProducerResult& producerResult : producerResults)
+		{
+			stressTest.Iterations += producerResult.Iterations;
+			stressTest.FailedIterations += producerResult.FailedIterations;
+			stressTest.MaxUnloadDuration = Max(stressTest.MaxUnloadDuration, producerResult.MaxUnloadDuration);
+		}
+
+		if (streamWasRunning)
+			Audio::Engine.EnsureStreamRunning();
+		else
+			Audio::Engine.StopCloseStream();
+	}
+
+	void AudioTestWindow::ScheduledSoundsTabContent()
+	{
+		if (Gui::Button("Run Test", vec2(Gui::GetContentRegionAvail().x, 0.0f)))
+			RunScheduledSoundsTest();
+
+		const ScheduledSoundsTestResult& result = scheduledSoundsTest;
+		Gui::Property::Table(ImGuiTableFlags_BordersInner | ImGuiTableFlags_ScrollY, [&]
+		{
+			if (!result.HasRun)
+			{
+				Gui::Property::PropertyTextValueFunc("Result", [&] { Gui::TextDisabled("(Not run)"); });
+				return;
+			}
+			if (result.SkippedBecauseOfPlayingVoices)
+			{
+				Gui::Property::PropertyTextValueFunc("Result", [&] { Gui::TextDisabled("(Skipped, pause all other voices first)"); });
+				return;
+			}
+
+			const ImVec4 failedColor = ImVec4(1.0f, 0.3f, 0.3f, 1.0f);
+			Gui::Property::PropertyTextValueFunc("Schedules", [&] { Gui::Text("%d per case (%u frame buffers)", result.SchedulesPerCase, result.BufferFrameCount); });
+			for (size_t i = 0; i < ArrayCount(ScheduledSoundsTestCases); i++)
+			{
+				Gui::Property::PropertyTextValueFunc(ScheduledSoundsTestCases[i].Name, [&]
+				{
+					const b8 passed = (result.MissedCount[i] == 0 && result.MaxErrorFrames[i] <= 1.0);
+					Gui::TextColored(passed ? Gui::GetStyleColorVec4(ImGuiCol_Text) : failedColor, "Max Error: %.3f frames, Missed: %d", result.MaxErrorFrames[i], result.MissedCount[i]);
+				});
+			}
+		});
+	}
+
+	void AudioTestWindow::RunScheduledSoundsTest()
+	{
+		static constexpr i32 schedulesPerCase = 32;
+		static constexpr u32 clickFrameCount = 4;
+		static constexpr i16 clickSampleValue = 16384;
+
+		scheduledSoundsTest = {};
+		scheduledSoundsTest.HasRun = true;
+		scheduledSoundsTest.SchedulesPerCase = schedulesPerCase;
+
+		// NOTE: Any other playing voice would also end up in the rendered output, making it impossible to tell when the click started
+		const auto activeVoices = Audio::Engine.DebugGetAllActiveVoices();
+		for (size_t i = 0; i < activeVoices.Count; i++)
+		{
+			if (activeVoices.Slots[i].GetIsPlaying())
+			{
+				scheduledSoundsTest.SkippedBecauseOfPlayingVoices = true;
+				return;
+			}
+		}
+
+		const b8 streamWasRunning = Audio::Engine.GetIsStreamOpenRunning();
+		const f32 masterVolumeBefore = Audio::Engine.GetMasterVolume();
+		Audio::Engine.StopCloseStream();
+		Audio::Engine.SetMasterVolume(Audio::AudioEngine::MaxVolume);
+		defer
+		{
+			Audio::Engine.SetMasterVolume(masterVolumeBefore);
+			if (streamWasRunning)
+				Audio::Engine.EnsureStreamRunning();
+		};
+		scheduledSoundsTest.BufferFrameCount = Audio::Engine.GetBufferFrameSize();
+
+		Audio::PCMSampleBuffer clickBuffer = {};
+		clickBuffer.ChannelCount = Audio::AudioEngine::OutputChannelCount;
+		clickBuffer.SampleRate = Audio::AudioEngine::OutputSampleRate;
+		clickBuffer.FrameCount = clickFrameCount;
+		clickBuffer.InterleavedSamples = std::make_unique<i16[]>(clickBuffer.SampleCount());
+		for (u32 c = 0; c < clickBuffer.ChannelCount; c++)
+			clickBuffer.InterleavedSamples[c] = clickSampleValue;
+		const Audio::SourceHandle clickSource = Audio::Engine.LoadSourceFromBufferMove("ScheduledSoundsTestClick", std::move(clickBuffer));
+
+		u32 randomState = 0x7654321;
+		auto nextRandomNormalized = [&]() { randomState = (randomState * 1664525u) + 1013904223u; return static_cast<f64>(randomState >> 8) / static_cast<f64>(1u << 24); };
+
+		std::vector<i16> outputBuffer;
+		for (size_t caseIndex = 0; caseIndex < ArrayCount(ScheduledSoundsTestCases); caseIndex++)
+		{
+			const ScheduledSoundsTestCase& testCase = ScheduledSoundsTestCases[caseIndex];
+
+			Audio::PCMSampleBuffer clockBuffer = {};
+			clockBuffer.ChannelCount = Audio::AudioEngine::OutputChannelCount;
+			clockBuffer.SampleRate = testCase.ClockSampleRate;
+			clockBuffer.FrameCount = static_cast<i64>(testCase.ClockSampleRate) * 4;
+			clockBuffer.InterleavedSamples = std::make_unique<i16[]>(clockBuffer.SampleCount());
+			const Audio::SourceHandle clockSource = Audio::Engine.LoadSourceFromBufferMove("ScheduledSoundsTestClock", std::move(clockBuffer));
+			Audio::Voice clockVoice = Audio::Engine.AddVoice(clockSource, "ScheduledSoundsTestClock", false, 0.0f);
+			clockVoice.SetPlaybackSpeed(testCase.PlaybackSpeed);
+
+			for (i32 i = 0; i < schedulesPerCase; i++)
+			{
+				// NOTE: Read back after setting it as the position of a voice playing at normal speed is rounded to the nearest frame of its source
+				clockVoice.SetPosition(Time::FromSec(0.1 + nextRandomNormalized()));
+				const Time clockStartPosition = clockVoice.GetPosition();
+				const Time scheduledPosition = clockStartPosition + Time::FromSec(nextRandomNormalized() * 0.5);
+				const f64 expectedStartFrame = (scheduledPosition - clockStartPosition).ToSec() * static_cast<f64>(testCase.ClockSampleRate) / testCase.PlaybackSpeed;
+
+				clockVoice.SetIsPlaying(true);
+				Audio::Engine.ScheduleOneShotSound(clickSource, clockVoice.Handle, scheduledPosition);
+
+				const u32 renderFrameCount = static_cast<u32>(expectedStartFrame) + (clickFrameCount * 16);
+				outputBuffer.assign(static_cast<size_t>(renderFrameCount) * Audio::AudioEngine::OutputChannelCount, 0);
+				Audio::Engine.DebugRenderWithoutStream(outputBuffer.data(), renderFrameCount);
+				clockVoice.SetIsPlaying(false);
+
+				i64 actualStartFrame = -1;
+				for (size_t s = 0; s < outputBuffer.size() && actualStartFrame < 0; s++)
+				{
+					if (outputBuffer[s] != 0)
+						actualStartFrame = static_cast<i64>(s / Audio::AudioEngine::OutputChannelCount);
+				}
+
+				if (actualStartFrame < 0)
+					scheduledSoundsTest.MissedCount[caseIndex]++;
+				else
+					scheduledSoundsTest.MaxErrorFrames[caseIndex] = Max(scheduledSoundsTest.MaxErrorFrames[caseIndex], Absolute(static_cast<f64>(actualStartFrame) - expectedStartFrame));
+			}
+
+			Audio::Engine.RemoveVoice(clockVoice.Handle);
+			Audio::Engine.UnloadSource(clockSource);
+		}
+		Audio::Engine.UnloadSource(clickSource);
+	}
+
 	void AudioTestWindow::StartSourcePreview(Audio::SourceHandle source, Time startTime)
 	{
 		if (source == Audio::SourceHandle::Invalid)
@@ -1,6 +1,7 @@
 #pragma once
 #include "core_types.h"
 #include "audio/audio_engine.h"
+#include "audio/audio_resampler.h"
 
 namespace PeepoDrumKit
 {
@@ -15,6 +16,19 @@ namespace PeepoDrumKit
 		void AudioEngineTabContent();
 		void ActiveVoicesTabContent();
 		void LoadedSourcesTabContent();
+		void MixKernelsTabContent();
+		void SongLoadingTabContent();
+		void WaveformTabContent();
+		void ResamplerTabContent();
+		void StressTestTabContent();
+		void ScheduledSoundsTabContent();
+
+		void RunMixKernelBenchmark();
+		void RunSongLoadingBenchmark();
+		void RunWaveformBenchmark();
+		void RunResamplerBenchmark();
+		void RunStressTest();
+		void RunScheduledSoundsTest();
 
 		void StartSourcePreview(Audio::SourceHandle source, Time startTime = Time::Zero());
 		void StopSourcePreview();
@@ -25,5 +39,119 @@ namespace PeepoDrumKit
 		Audio::Voice sourcePreviewVoice = Audio::VoiceHandle::Invalid;
 		std::string voiceFlagsBuffer;
 		u32 newBufferFrameCount = 64;
+
+		struct MixKernelBenchmarkResult
+		{
+			b8 Supported;
+			f64 NanosecondsPerFrame[6];
+			f64 MaxDeviationFromScalar[6];
+		};
+		std::array<MixKernelBenchmarkResult, EnumCount<Audio::MixKernelSet>> mixKernelBenchmarkResults = {};
+		b8 mixKernelBenchmarkHasRun = false;
+
+		// NOTE: Entirely decoding, resampling and generating the waveform upfront (as done previously) vs streaming it in block by block,
+		//		 as well as a cold (decoded and then written) vs warm (read back in) song cache entry
+		struct SongLoadingBenchmarkResult
+		{
+			std::string FilePath;
+			b8 HasRun;
+			b8 FailedToLoad;
+			u32 ChannelCount;
+			u32 SourceSampleRate;
+			i64 FrameCount;
+			i64 BlockCount;
+			Time EntireDuration;
+			Time StreamingTimeToFirstAudio;
+			Time StreamingTimeToFirstWaveform;
+			Time StreamingDuration;
+			b8 SamplesMatch;
+			b8 WaveformMatches;
+			Time CacheKeyDuration;
+			Time CacheWriteDuration;
+			Time CacheWarmDuration;
+			u64 CacheEntryByteSize;
+			b8 CacheWriteSucceeded;
+			b8 CacheMatches;
+		} songLoadingBenchmark = {};
+
+		// NOTE: Generating the min / max / RMS mip chain of a synthetic 5 minute stereo song with each kernel set and querying it across all zoom levels.
+		//		 Each channel on its own vs both from a single pass over the interleaved samples, on one thread and split across all cores
+		struct WaveformBenchmarkResult
+		{
+			b8 HasRun;
+			i32 MipCount;
+			size_t BucketDataByteSize;
+			Time GenerationDuration[EnumCount<Audio::MixKernelSet>];
+			b8 MatchesScalar[EnumCount<Audio::MixKernelSet>];
+			u32 StereoThreadCount;
+			Time StereoSingleThreadDuration;
+			Time StereoParallelDuration;
+			b8 StereoMatchesScalar;
+			f64 NanosecondsPerPixelQuery;
+			b8 SourceReadsMatchFullSizeMip;
+			b8 ChunkCacheMatchesUncached;
+			i32 ChunkCacheVisibleChunks;
+			i32 ChunkCacheComputedChunks;
+			f64 CachedMicrosecondsPerFrame;
+			f64 UncachedMicrosecondsPerFrame;
+		} waveformBenchmark = {};
+
+		// NOTE: Resampling a synthetic 60 second stereo song from 48 kHz to the output sample rate with every quality preset and kernel set.
+		//		 Quality is measured as the SNR of an in-band sine sweep against an analytically resampled one and as the rejection of a sweep above
+		//		 the target Nyquist frequency (which can only show up as aliasing), with the previous linear interpolation as a baseline
+		struct ResamplerBenchmarkResult
+		{
+			b8 HasRun;
+			u32 SourceSampleRate;
+			u32 TargetSampleRate;
+			Time AudioDuration;
+			u32 TapCount[EnumCount<Audio::ResamplerQuality>];
+			u32 PhaseCount[EnumCount<Audio::ResamplerQuality>];
+			Time Duration[EnumCount<Audio::ResamplerQuality>][EnumCount<Audio::MixKernelSet>];
+			b8 MatchesScalar[EnumCount<Audio::ResamplerQuality>][EnumCount<Audio::MixKernelSet>];
+			f64 PassbandSNR[EnumCount<Audio::ResamplerQuality> + 1];
+			f64 StopbandRejection[EnumCount<Audio::ResamplerQuality> + 1];
+		} resamplerBenchmark = {};
+
+		// NOTE: Loading, playing, restarting and unloading short silent sources from several threads at once while being rendered by either the open stream
+		//		 (optionally closed and reopened throughout) or an offline render thread, checking that all voice and source slots have been released again afterwards
+		enum class StressTestMode : u8 { OfflineRender, Stream, ReopenedStream, Count };
+		static constexpr cstr StressTestModeNames[EnumCount<StressTestMode>] = { "Offline Render Thread", "Open Stream", "Repeatedly Reopened Stream", };
+		StressTestMode stressTestMode = StressTestMode::Stream;
+
+		struct StressTestResult
+		{
+			b8 HasRun;
+			StressTestMode Mode;
+			u32 ThreadCount;
+			Time Duration;
+			u64 Iterations;
+			u64 FailedIterations;
+			u32 StreamReopenCount;
+			i64 LeakedVoiceSlots;
+			i64 LeakedSourceSlots;
+			Time MaxUnloadDuration;
+		} stressTest = {};
+
+		// NOTE: Offline rendering a click scheduled against a silent clock voice at random positions, checking that it starts within a single frame of
+		//		 where the clock voice reaches the scheduled position. At normal and variable playback speeds as well as with a mismatched clock sample rate
+		struct ScheduledSoundsTestCase { cstr Name; u32 ClockSampleRate; f32 PlaybackSpeed; };
+		static constexpr ScheduledSoundsTestCase ScheduledSoundsTestCases[] =
+		{
+			{ "Normal Speed", Audio::AudioEngine::OutputSampleRate, 1.0f },
+			{ "Variable Speed (150%)", Audio::AudioEngine::OutputSampleRate, 1.5f },
+			{ "Variable Speed (75%)", Audio::AudioEngine::OutputSampleRate, 0.75f },
+			{ "Clock at 48 kHz", 48000, 1.0f },
+		};
+
+		struct ScheduledSoundsTestResult
+		{
+			b8 HasRun;
+			b8 SkippedBecauseOfPlayingVoices;
+			i32 SchedulesPerCase;
+			u32 BufferFrameCount;
+			f64 MaxErrorFrames[ArrayCount(ScheduledSoundsTestCases)];
+			i32 MissedCount[ArrayCount(ScheduledSoundsTestCases)];
+		} scheduledSoundsTest = {};
 	};
 }
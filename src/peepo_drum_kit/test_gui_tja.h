@@ -19,7 +19,6 @@ namespace PeepoDrumKit
 		File::UniqueFileContent FileContentBytes;
 		std::string FileContentUTF8;
 
-		std::vector<std::string_view> Lines;
 		std::vector<TJA::Token> Tokens;
 		TJA::ErrorList ParseErrors;
 		TJA::ParsedTJA Parsed;
@@ -32,10 +31,7 @@ namespace PeepoDrumKit
 			FileContentBytes = File::ReadAllBytes(filePath);
 
 			const std::string_view fileContentView = std::string_view(reinterpret_cast<const char*>(FileContentBytes.Content.get()), FileContentBytes.Size);
-			if (UTF8::HasBOM(fileContentView))
-				FileContentUTF8 = UTF8::TrimBOM(fileContentView);
-			else
-				FileContentUTF8 = UTF8::FromShiftJIS(fileContentView);
+			FileContentUTF8 = TJA::ConvertFileContentToUTF8(fileContentView);
 
 			DebugReloadFromModifiedFileContentUTF8();
 			return (FileContentBytes.Content != nullptr);
@@ -43,8 +39,7 @@ namespace PeepoDrumKit
 
 		inline b8 DebugReloadFromModifiedFileContentUTF8()
 		{
-			Lines = TJA::SplitLines(FileContentUTF8);
-			Tokens = TJA::TokenizeLines(Lines);
+			TJA::TokenizeFileContent(FileContentUTF8, Tokens);
 			ParseErrors.Clear();
 			Parsed = ParseTokens(Tokens, ParseErrors);
 
@@ -68,6 +63,122 @@ namespace PeepoDrumKit
 		b8 WasTJAEditedThisFrame = false;
 		i32 TabIndexToSelectThisFrame = -1;
 
+		struct TokenizerBenchmarkResult
+		{
+			size_t InputByteSize;
+			size_t TokenCount;
+			f64 SplitLinesThenTokenizeLinesMBPerSec;
+			f64 TokenizeFileContentMBPerSec;
+		} TokenizerBenchmark = {};
+
+		struct ImportExportBenchmarkResult
+		{
+			i32 Iterations;
+			Time ImportDuration;
+			Time ExportDuration;
+			size_t ArenaNoteCount;
+			size_t ArenaStringByteSize;
+			size_t ArenaBackedCommandCount;
+		} ImportExportBenchmark = {};
+
+		struct ChartConversionBenchmarkResult
+		{
+			Time SerialDuration;
+			Time ParallelDuration;
+			size_t CourseCount;
+			std::string DebugCompareLog;
+			b8 HasRun;
+		} ChartConversionBenchmark = {};
+
+		struct RoundTripBenchmarkResult
+		{
+			std::string DirectoryPath;
+			size_t FileCount;
+			size_t ExportedByteSize;
+			Time ExportDuration;
+			std::string MismatchLog;
+			b8 HasRun;
+		} RoundTripBenchmark = {};
+
+		struct TempoMapTestResult
+		{
+			size_t FileCount;
+			size_t TempoMapCount;
+			size_t TempoChangeCount;
+			size_t CheckCount;
+			size_t MismatchCount;
+			size_t PerTickTableByteSize;
+			size_t SegmentByteSize;
+			Time PerTickTableRebuildDuration;
+			Time SegmentRebuildDuration;
+			std::string MismatchLog;
+			b8 HasRun;
+		} TempoMapTest = {};
+
+		struct TempoMapRebuildTestResult
+		{
+			size_t EditCount;
+			size_t TempoChangeCount;
+			size_t CheckCount;
+			size_t MismatchCount;
+			Time FullRebuildDuration;
+			Time IncrementalRebuildDuration;
+			std::string MismatchLog;
+			b8 HasRun;
+		} TempoMapRebuildTest = {};
+
+		struct BeatSortedListBenchmarkResult
+		{
+			size_t NoteCount;
+			size_t LookupCount;
+			Time LinearInsertDuration;
+			Time BinaryInsertDuration;
+			Time SortedRangeInsertDuration;
+			Time LinearLookupDuration;
+			Time BinaryLookupDuration;
+			std::string MismatchLog;
+			b8 HasRun;
+		} BeatSortedListBenchmark = {};
+
+		struct GameLaneVisibilityTestResult
+		{
+			size_t FileCount;
+			size_t CourseCount;
+			size_t NoteCount;
+			size_t CursorCount;
+			size_t VisibleNoteCount;
+			size_t VisibleBarCount;
+			size_t WindowedNoteCount;
+			size_t WindowedBarCount;
+			size_t MismatchCount;
+			Time FullWalkDuration;
+			Time WindowedDuration;
+			std::string MismatchLog;
+			b8 HasRun;
+		} GameLaneVisibilityTest = {};
+
+		struct ShiftJISBenchmarkResult
+		{
+			size_t ValidatedSequenceCount;
+			size_t MismatchCount;
+			std::string MismatchLog;
+			size_t InputByteSize;
+			f64 TableDecodeMBPerSec;
+			f64 Win32DecodeMBPerSec;
+			f64 TableEncodeMBPerSec;
+			f64 Win32EncodeMBPerSec;
+			b8 HasRun;
+		} ShiftJISBenchmark = {};
+
+		struct MappedViewTestResult
+		{
+			size_t LargeFileByteSize;
+			Time MappedViewDuration;
+			Time ReadAllBytesDuration;
+			std::string FailureLog;
+			b8 HasRun;
+		} MappedViewTest = {};
+
 	public:
 		void DrawGui();
 
@@ -75,5 +186,6 @@ namespace PeepoDrumKit
 		void DrawGuiFileContentTabContent();
 		void DrawGuiTokensTabContent();
 		void DrawGuiParsedTabContent();
+		void DrawGuiBenchmarkTabContent();
 	};
 }
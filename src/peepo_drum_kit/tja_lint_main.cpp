@@ -0,0 +1,245 @@
+#include "core_types.h"
+#include "core_string.h"
+#include "core_io.h"
+#include "file_format_tja.h"
+#include "chart.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <filesystem>
+
+// NOTE: Headless batch validation of whole TJA song libraries, without any GUI or audio dependency.
+//		 Every file is tokenized, parsed and converted to a chart, then exported and imported again to detect round trip differences.
+//		 One JSON object is written per line for each file (in completion order) followed by a final summary line
+namespace PeepoDrumKit
+{
+	static constexpr cstr TJALintUsage =
+		"Usage: PeepoDrumKitTJALint <directory> [options]\n"
+		"  -j <count>        Number of worker threads (default: all cores)\n"
+		"  --no-round-trip   Skip exporting and re-importing each chart\n";
+
+	struct TJALintOptions
+	{
+		std::string DirectoryPath;
+		i32 ThreadCount = 0;
+		b8 RoundTrip = true;
+	};
+
+	struct TJALintFileResult
+	{
+		std::string JSONLine;
+		b8 HasErrors;
+		b8 HasRoundTripDiffs;
+		b8 FailedToRead;
+	};
+
+	static void AppendJSONString(std::string& out, std::string_view value)
+	{
+		out += '"';
+		for (const char c : value)
+		{
+			switch (c)
+			{
+			case '"': out += "\\\""; break;
+			case '\\': out += "\\\\"; break;
+			case '\n': out += "\\n"; break;
+			case '\r': out += "\\r"; break;
+			case '\t': out += "\\t"; break;
+			default:
+				if (static_cast<u8>(c) < 0x20) { char buffer[8]; out.append(buffer, sprintf_s(buffer, "\\u%04X", static_cast<u8>(c))); }
+				else { out += c; }
+				break;
+			}
+		}
+		out += '"';
+	}
+
+	static size_t CountChartNotes(const ChartProject& chart)
+	{
+		size_t noteCount = 0;
+		for (const auto& course : chart.Courses)
+		{
+			for (BranchType branch = BranchType::Normal; branch < BranchType::Count; IncrementEnum(branch))
+				noteCount += course->GetNotes(branch).size();
+		}
+		return noteCount;
+	}
+
+	static TJALintFileResult LintTJAFile(const std::string& filePath, const TJALintOptions& options)
+	{
+		TJALintFileResult result = {};
+		char buffer[64];
+
+		std::string& json = result.JSONLine;
+		json += "{\"file\":";
+		AppendJSONString(json, filePath);
+
+		File::MappedView fileView;
+		if (!fileView.Open(filePath))
+		{
+			json += ",\"error\":\"Failed to read file\"}\n";
+			result.FailedToRead = true;
+			return result;
+		}
+
+		const size_t fileSize = fileView.Size();
+		const TJA::Encoding encoding = TJA::DetectFileContentEncoding(fileView.AsString());
+		CPUStopwatch stopwatch = CPUStopwatch::StartNew();
+		const std::string fileContentUTF8 = TJA::ConvertFileContentToUTF8(fileView.AsString(), encoding);
+		fileView.Close();
+		const Time decodeDuration = stopwatch.Restart();
+
+		std::vector<TJA::Token> tokens;
+		TJA::TokenizeFileContent(fileContentUTF8, tokens);
+		TJA::ErrorList parseErrors;
+		const TJA::ParsedTJA parsed = TJA::ParseTokens(tokens, parseErrors);
+		const Time parseDuration = stopwatch.Restart();
+
+		ChartProject chart;
+		const b8 conversionSucceeded = CreateChartProjectFromTJA(parsed, chart);
+		const Time convertDuration = stopwatch.Stop();
+
+		json += ",\"encoding\":";
+		json += (encoding == TJA::Encoding::ShiftJIS) ? "\"shift_jis\"" : "\"utf8\"";
+		json.append(buffer, sprintf_s(buffer, ",\"bytes\":%zu", fileSize));
+		json.append(buffer, sprintf_s(buffer, ",\"decode_ms\":%.3f", decodeDuration.ToMS()));
+		json.append(buffer, sprintf_s(buffer, ",\"parse_ms\":%.3f", parseDuration.ToMS()));
+		json.append(buffer, sprintf_s(buffer, ",\"convert_ms\":%.3f", convertDuration.ToMS()));
+		json.append(buffer, sprintf_s(buffer, ",\"courses\":%zu", chart.Courses.size()));
+		json.append(buffer, sprintf_s(buffer, ",\"notes\":%zu", CountChartNotes(chart)));
+
+		json += ",\"errors\":[";
+		for (size_t i = 0; i < parseErrors.Errors.size(); i++)
+		{
+			json.append(buffer, sprintf_s(buffer, "%s{\"line\":%d,\"message\":", (i > 0) ? "," : "", parseErrors.Errors[i].LineIndex + 1));
+			AppendJSONString(json, parseErrors.Errors[i].Description);
+			json += '}';
+		}
+		if (!conversionSucceeded)
+			json += parseErrors.Errors.empty() ? "{\"line\":0,\"message\":\"Failed to create chart\"}" : ",{\"line\":0,\"message\":\"Failed to create chart\"}";
+		json += ']';
+		result.HasErrors = (!parseErrors.Errors.empty() || !conversionSucceeded);
+
+		if (options.RoundTrip && conversionSucceeded)
+		{
+			// NOTE: Without the comment so the export doesn't depend on the current date
+			TJA::ParsedTJA exported;
+			ConvertChartProjectToTJA(chart, exported, false);
+			std::string exportedText;
+			TJA::ConvertParsedToText(exported, exportedText, TJA::Encoding::UTF8);
+
+			std::vector<TJA::Token> reimportedTokens;
+			TJA::TokenizeFileContent(UTF8::TrimBOM(exportedText), reimportedTokens);
+			TJA::ErrorList reimportedErrors;
+			ChartProject reimportedChart;
+			CreateChartProjectFromTJA(TJA::ParseTokens(reimportedTokens, reimportedErrors), reimportedChart);
+
+			struct RoundTripDiffs { std::string JSON; size_t Count; } diffs = {};
+			DebugCompareCharts(chart, reimportedChart, [](std::string_view message, void* userData)
+			{
+				RoundTripDiffs& diffs = *static_cast<RoundTripDiffs*>(userData);
+				if (diffs.Count++ > 0)
+					diffs.JSON += ',';
+				AppendJSONString(diffs.JSON, message);
+			}, &diffs);
+
+			json += ",\"round_trip_diffs\":[";
+			json += diffs.JSON;
+			json += ']';
+			result.HasRoundTripDiffs = (diffs.Count > 0);
+		}
+
+		json += "}\n";
+		return result;
+	}
+
+	static b8 ParseTJALintOptions(const CommandLine::CommandLineArrayView& commandLine, TJALintOptions& out)
+	{
+		for (size_t i = 1; i < commandLine.Count; i++)
+		{
+			const std::string_view argument = commandLine.Arguments[i];
+			if (argument == "-j" && (i + 1) < commandLine.Count)
+			{
+				if (!ASCII::TryParse(commandLine.Arguments[++i], out.ThreadCount) || out.ThreadCount <= 0)
+					return false;
+			}
+			else if (argument == "--no-round-trip")
+			{
+				out.RoundTrip = false;
+			}
+			else if (out.DirectoryPath.empty() && !argument.empty() && argument[0] != '-')
+			{
+				out.DirectoryPath = argument;
+			}
+			else
+			{
+				return false;
+			}
+		}
+		return !out.DirectoryPath.empty();
+	}
+
+	int TJALintEntryPoint()
+	{
+		TJALintOptions options = {};
+		if (!ParseTJALintOptions(CommandLine::GetCommandLineUTF8(), options))
+		{
+			fprintf(stderr, "%s", TJALintUsage);
+			return 2;
+		}
+
+		std::vector<std::string> filePaths;
+		std::error_code errorCode;
+		// NOTE: Advancing through increment() instead of a range-for so that errors are reported through the error code instead of thrown,
+		//		 with unreadable sub directories skipped rather than aborting the entire run
+		const auto directoryEnd = std::filesystem::recursive_directory_iterator();
+		for (auto it = std::filesystem::recursive_directory_iterator(std::filesystem::u8path(options.DirectoryPath), std::filesystem::directory_options::skip_permission_denied, errorCode); !errorCode && it != directoryEnd; it.increment(errorCode))
+		{
+			std::error_code entryErrorCode;
+			if (it->is_regular_file(entryErrorCode) && Path::HasExtension(it->path().u8string(), TJA::Extension))
+				filePaths.push_back(it->path().u8string());
+		}
+		if (errorCode)
+		{
+			fprintf(stderr, "Failed to iterate directory '%s': %s\n", options.DirectoryPath.c_str(), errorCode.message().c_str());
+			return 2;
+		}
+
+		const size_t threadCount = Clamp<size_t>((options.ThreadCount > 0) ? options.ThreadCount : std::thread::hardware_concurrency(), 1, Max<size_t>(filePaths.size(), 1));
+		const CPUStopwatch totalStopwatch = CPUStopwatch::StartNew();
+
+		// NOTE: Each worker grabs the next file index and writes its whole line at once, so the output lines never interleave
+		std::atomic<size_t> nextFileIndex = 0;
+		std::atomic<size_t> filesWithErrors = 0, filesWithRoundTripDiffs = 0, filesFailedToRead = 0;
+		std::mutex outputMutex;
+		const auto workerFunc = [&]()
+		{
+			for (size_t fileIndex = nextFileIndex++; fileIndex < filePaths.size(); fileIndex = nextFileIndex++)
+			{
+				const TJALintFileResult result = LintTJAFile(filePaths[fileIndex], options);
+				filesWithErrors += result.HasErrors;
+				filesWithRoundTripDiffs += result.HasRoundTripDiffs;
+				filesFailedToRead += result.FailedToRead;
+
+				const std::lock_guard lock(outputMutex);
+				fwrite(result.JSONLine.data(), sizeof(char), result.JSONLine.size(), stdout);
+			}
+		};
+
+		std::vector<std::thread> workerThreads;
+		workerThreads.reserve(threadCount - 1);
+		for (size_t i = 1; i < threadCount; i++)
+			workerThreads.emplace_back(workerFunc);
+		workerFunc();
+		for (std::thread& thread : workerThreads)
+			thread.join();
+
+		printf("{\"summary\":{\"files\":%zu,\"files_with_errors\":%zu,\"files_with_round_trip_diffs\":%zu,\"files_failed_to_read\":%zu,\"threads\":%zu,\"total_ms\":%.3f}}\n",
+			filePaths.size(), filesWithErrors.load(), filesWithRoundTripDiffs.load(), filesFailedToRead.load(), threadCount, totalStopwatch.GetElapsed().ToMS());
+		fflush(stdout);
+
+		return (filesWithErrors > 0 || filesWithRoundTripDiffs > 0 || filesFailedToRead > 0) ? 1 : 0;
+	}
+}
+
+int main(int, const char**) { return PeepoDrumKit::TJALintEntryPoint(); }